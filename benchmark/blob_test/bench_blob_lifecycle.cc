@@ -0,0 +1,127 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+struct PhaseTiming {
+  double create = 0;
+  double seal = 0;
+  double del = 0;
+};
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static void worker(std::string const& ipc_socket, size_t iterations,
+                   size_t blob_size, PhaseTiming& timing) {
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  std::vector<ObjectID> blobs;
+  blobs.reserve(iterations);
+
+  auto start = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(client.CreateBlob(blob_size, writer));
+    blobs.emplace_back(writer->id());
+  }
+  timing.create = elapsed_seconds(start);
+
+  start = clock_type::now();
+  for (auto const& id : blobs) {
+    VINEYARD_CHECK_OK(client.Seal(id));
+  }
+  timing.seal = elapsed_seconds(start);
+
+  start = clock_type::now();
+  for (auto const& id : blobs) {
+    VINEYARD_CHECK_OK(client.DelData(id));
+  }
+  timing.del = elapsed_seconds(start);
+
+  client.Disconnect();
+}
+
+static void bench(std::string const& ipc_socket, size_t threads,
+                  size_t iterations, size_t blob_size) {
+  std::vector<PhaseTiming> timings(threads);
+  std::vector<std::thread> workers;
+  auto start = clock_type::now();
+  for (size_t i = 0; i < threads; ++i) {
+    workers.emplace_back(worker, ipc_socket, iterations, blob_size,
+                         std::ref(timings[i]));
+  }
+  for (auto& t : workers) {
+    t.join();
+  }
+  double total = elapsed_seconds(start);
+
+  // the slowest thread determines the throughput of each phase
+  PhaseTiming slowest;
+  for (auto const& timing : timings) {
+    slowest.create = std::max(slowest.create, timing.create);
+    slowest.seal = std::max(slowest.seal, timing.seal);
+    slowest.del = std::max(slowest.del, timing.del);
+  }
+  double ops = static_cast<double>(threads * iterations);
+  std::cout << "threads: " << threads << ", blob size: " << blob_size
+            << ", create: " << static_cast<size_t>(ops / slowest.create)
+            << " ops/s, seal: " << static_cast<size_t>(ops / slowest.seal)
+            << " ops/s, delete: " << static_cast<size_t>(ops / slowest.del)
+            << " ops/s, total: " << total << " s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_blob_lifecycle <ipc_socket> [<max threads>] "
+        "[<iterations per thread>] [<blob size>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  size_t max_threads = 64, iterations = 10000, blob_size = 1024;
+  if (argc >= 3) {
+    max_threads = static_cast<size_t>(atoll(argv[2]));
+  }
+  if (argc >= 4) {
+    iterations = static_cast<size_t>(atoll(argv[3]));
+  }
+  if (argc >= 5) {
+    blob_size = static_cast<size_t>(atoll(argv[4]));
+  }
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    bench(ipc_socket, threads, iterations, blob_size);
+  }
+
+  LOG(INFO) << "Finish blob create/seal/delete benchmarks...";
+  return 0;
+}
@@ -0,0 +1,161 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+#include "graph/fragment/property_graph_types.h"
+#include "graph/fragment/property_graph_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+using vid_t = uint64_t;
+using eid_t = uint64_t;
+using nbr_unit_t = property_graph_utils::NbrUnit<vid_t, eid_t>;
+using vid_array_t = ArrowArrayType<vid_t>;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// Generates a power-law like edge list, where a few vertices have very large
+// degrees, in chunks of 1M edges.
+static void generate_edges(IdParser<vid_t>& parser, vid_t vnum, int64_t enum_,
+                           std::vector<std::shared_ptr<vid_array_t>>& srcs,
+                           std::vector<std::shared_ptr<vid_array_t>>& dsts) {
+  const int64_t chunk_size = 1024 * 1024;
+  std::mt19937_64 gen(0);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  auto random_vertex = [&]() -> vid_t {
+    double x = dist(gen);
+    vid_t offset = static_cast<vid_t>(x * x * x * vnum) % vnum;
+    return parser.GenerateId(0, offset);
+  };
+  for (int64_t begin = 0; begin < enum_; begin += chunk_size) {
+    int64_t size = std::min(chunk_size, enum_ - begin);
+    arrow::UInt64Builder src_builder, dst_builder;
+    CHECK_ARROW_ERROR(src_builder.Reserve(size));
+    CHECK_ARROW_ERROR(dst_builder.Reserve(size));
+    for (int64_t i = 0; i < size; ++i) {
+      src_builder.UnsafeAppend(random_vertex());
+      dst_builder.UnsafeAppend(random_vertex());
+    }
+    std::shared_ptr<vid_array_t> src, dst;
+    CHECK_ARROW_ERROR(src_builder.Finish(&src));
+    CHECK_ARROW_ERROR(dst_builder.Finish(&dst));
+    srcs.emplace_back(src);
+    dsts.emplace_back(dst);
+  }
+}
+
+static bool same_csr(
+    const std::shared_ptr<PodArrayBuilder<nbr_unit_t>>& lhs,
+    const std::shared_ptr<FixedInt64Builder>& lhs_offsets,
+    const std::shared_ptr<PodArrayBuilder<nbr_unit_t>>& rhs,
+    const std::shared_ptr<FixedInt64Builder>& rhs_offsets, vid_t vnum) {
+  for (vid_t v = 0; v <= vnum; ++v) {
+    if (lhs_offsets->data()[v] != rhs_offsets->data()[v]) {
+      return false;
+    }
+  }
+  for (int64_t i = 0; i < lhs_offsets->data()[vnum]; ++i) {
+    // edge ids of parallel edges may be in different orders
+    if (lhs->data()[i].vid != rhs->data()[i].vid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_csr_build <ipc_socket> [<number of vertices>] "
+        "[<number of edges>] [<concurrency>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  vid_t vnum = 10 * 1000 * 1000;
+  int64_t enum_ = 100 * 1000 * 1000;
+  int concurrency = std::thread::hardware_concurrency();
+  if (argc >= 3) {
+    vnum = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    enum_ = atoll(argv[3]);
+  }
+  if (argc >= 5) {
+    concurrency = atoi(argv[4]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  IdParser<vid_t> parser;
+  parser.Init(1, 1);
+  std::vector<vid_t> tvnums = {vnum};
+  std::vector<std::shared_ptr<vid_array_t>> srcs, dsts;
+  generate_edges(parser, vnum, enum_, srcs, dsts);
+
+  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> scatter_oe(1),
+      scatter_ie(1), radix_oe(1), radix_ie(1);
+  std::vector<std::shared_ptr<FixedInt64Builder>> scatter_oe_offsets(1),
+      scatter_ie_offsets(1), radix_oe_offsets(1), radix_ie_offsets(1);
+  bool is_multigraph = false;
+
+  auto start = clock_type::now();
+  generate_directed_csr<vid_t, eid_t>(client, parser, srcs, dsts, tvnums, 1,
+                                      concurrency, scatter_oe,
+                                      scatter_oe_offsets, is_multigraph);
+  generate_directed_csc<vid_t, eid_t>(client, parser, tvnums, 1, concurrency,
+                                      scatter_oe, scatter_oe_offsets,
+                                      scatter_ie, scatter_ie_offsets,
+                                      is_multigraph);
+  double scatter_seconds = elapsed_seconds(start);
+
+  start = clock_type::now();
+  generate_directed_csr_radix<vid_t, eid_t>(client, parser, srcs, dsts, tvnums,
+                                            1, concurrency, radix_oe,
+                                            radix_oe_offsets, is_multigraph);
+  generate_directed_csc_radix<vid_t, eid_t>(
+      client, parser, tvnums, 1, concurrency, radix_oe, radix_oe_offsets,
+      radix_ie, radix_ie_offsets, is_multigraph);
+  double radix_seconds = elapsed_seconds(start);
+
+  CHECK(same_csr(scatter_oe[0], scatter_oe_offsets[0], radix_oe[0],
+                 radix_oe_offsets[0], vnum));
+  CHECK(same_csr(scatter_ie[0], scatter_ie_offsets[0], radix_ie[0],
+                 radix_ie_offsets[0], vnum));
+
+  std::cout << "scatter: " << enum_ / scatter_seconds / 1e6
+            << " M edges/s, radix sort: " << enum_ / radix_seconds / 1e6
+            << " M edges/s" << std::endl;
+
+  client.Disconnect();
+  LOG(INFO) << "Finish CSR build benchmarks...";
+  return 0;
+}
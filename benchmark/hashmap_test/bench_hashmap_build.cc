@@ -0,0 +1,110 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic/ds/hashmap.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// the peak RSS of the process in MB, the peak is not resettable, thus each
+// builder is measured in a separate process.
+static double peak_rss_mb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+static ObjectID build_sequential(Client& client, int64_t num_keys) {
+  HashmapBuilder<int64_t, uint64_t> builder(client);
+  builder.reserve(num_keys);
+  for (int64_t key = 0; key < num_keys; ++key) {
+    builder.emplace(key * 7919, static_cast<uint64_t>(key));
+  }
+  return builder.Seal(client)->id();
+}
+
+static ObjectID build_concurrent(Client& client, int64_t num_keys,
+                                 int threads) {
+  ConcurrentHashmapBuilder<int64_t, uint64_t> builder(client, num_keys,
+                                                      threads);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() {
+      for (int64_t key = t; key < num_keys; key += threads) {
+        VINEYARD_CHECK_OK(
+            builder.emplace(key * 7919, static_cast<uint64_t>(key)));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return builder.Seal(client)->id();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    printf(
+        "usage ./bench_hashmap_build <ipc_socket> <sequential or concurrent> "
+        "[<number of keys>] [<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  std::string mode = std::string(argv[2]);
+  int64_t num_keys = 100000000;
+  int threads = std::thread::hardware_concurrency();
+  if (argc >= 4) {
+    num_keys = atoll(argv[3]);
+  }
+  if (argc >= 5) {
+    threads = atoi(argv[4]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  double rss_before = peak_rss_mb();
+  auto start = clock_type::now();
+  ObjectID id = mode == "sequential"
+                    ? build_sequential(client, num_keys)
+                    : build_concurrent(client, num_keys, threads);
+  double elapsed = elapsed_seconds(start);
+  std::cout << "mode: " << mode << ", keys: " << num_keys
+            << ", threads: " << (mode == "sequential" ? 1 : threads)
+            << ", build: " << elapsed << " s, peak rss: " << peak_rss_mb()
+            << " MB (before: " << rss_before << " MB)" << std::endl;
+
+  VINEYARD_CHECK_OK(client.DelData(id, true, true));
+  client.Disconnect();
+
+  LOG(INFO) << "Finish hashmap build benchmarks...";
+  return 0;
+}
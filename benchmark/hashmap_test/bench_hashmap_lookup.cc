@@ -0,0 +1,177 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "basic/ds/hashmap.h"
+#include "basic/ds/swiss_hashmap.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// Looks up the queries (half of them are missing) in the sealed map, and
+// reports the throughput in million lookups per second.
+template <typename MAP_T, typename K>
+static void bench_lookup(std::string const& name, Client& client,
+                         ObjectID id, std::vector<K> const& queries,
+                         int rounds) {
+  auto map = client.GetObject<MAP_T>(id);
+  CHECK(map != nullptr);
+  uint64_t checksum = 0, found = 0;
+  auto start = clock_type::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (auto const& key : queries) {
+      auto iter = map->find(key);
+      if (iter != map->end()) {
+        checksum += iter->second;
+        found += 1;
+      }
+    }
+  }
+  double seconds = elapsed_seconds(start);
+  double ops = static_cast<double>(queries.size()) * rounds;
+  std::cout << name << ": " << ops / seconds / 1e6 << " Mops/s, "
+            << "memory: " << map->nbytes() / 1024 / 1024 << " MB, "
+            << "found: " << found << ", checksum: " << checksum << std::endl;
+}
+
+template <typename BUILDER_T, typename K>
+static ObjectID build(Client& client, std::vector<K> const& keys,
+                      std::shared_ptr<Blob> const& data_buffer) {
+  BUILDER_T builder(client);
+  if (data_buffer != nullptr) {
+    builder.AssociateDataBuffer(data_buffer);
+  }
+  builder.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    builder.emplace(keys[i], static_cast<uint64_t>(i));
+  }
+  return builder.Seal(client)->id();
+}
+
+static void bench_int64(Client& client, int64_t num_keys, int rounds) {
+  std::vector<int64_t> keys(num_keys);
+  for (int64_t i = 0; i < num_keys; ++i) {
+    keys[i] = i * 7919;
+  }
+  std::vector<int64_t> queries;
+  queries.reserve(num_keys * 2);
+  for (int64_t i = 0; i < num_keys; ++i) {
+    queries.emplace_back(keys[i]);
+    queries.emplace_back(keys[i] + 1);
+  }
+  std::shuffle(queries.begin(), queries.end(), std::mt19937_64(0));
+
+  using hashmap_t = Hashmap<int64_t, uint64_t>;
+  using swiss_hashmap_t = SwissHashmap<int64_t, uint64_t>;
+  ObjectID hashmap_id =
+      build<HashmapBuilder<int64_t, uint64_t>>(client, keys, nullptr);
+  ObjectID swiss_hashmap_id =
+      build<SwissHashmapBuilder<int64_t, uint64_t>>(client, keys, nullptr);
+  bench_lookup<hashmap_t>("int64 hashmap", client, hashmap_id, queries,
+                          rounds);
+  bench_lookup<swiss_hashmap_t>("int64 swiss", client, swiss_hashmap_id,
+                                queries, rounds);
+  VINEYARD_DISCARD(client.DelData({hashmap_id, swiss_hashmap_id}));
+}
+
+static void bench_string(Client& client, int64_t num_keys, int rounds) {
+  std::vector<std::string> values(num_keys);
+  size_t total_size = 0;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    values[i] = "vertex-" + std::to_string(i * 7919);
+    total_size += values[i].size();
+  }
+
+  // the keys live in a blob, as the oid arrays of vertex maps
+  std::unique_ptr<BlobWriter> writer;
+  VINEYARD_CHECK_OK(client.CreateBlob(total_size, writer));
+  std::vector<arrow_string_view> keys(num_keys);
+  size_t offset = 0;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    memcpy(writer->data() + offset, values[i].data(), values[i].size());
+    keys[i] = arrow_string_view(writer->data() + offset, values[i].size());
+    offset += values[i].size();
+  }
+  auto data_buffer = std::dynamic_pointer_cast<Blob>(writer->Seal(client));
+
+  std::vector<std::string> missing(num_keys);
+  std::vector<arrow_string_view> queries;
+  queries.reserve(num_keys * 2);
+  for (int64_t i = 0; i < num_keys; ++i) {
+    missing[i] = "vertex-" + std::to_string(i * 7919 + 1);
+    queries.emplace_back(values[i]);
+    queries.emplace_back(missing[i]);
+  }
+  std::shuffle(queries.begin(), queries.end(), std::mt19937_64(0));
+
+  using hashmap_t = Hashmap<arrow_string_view, uint64_t>;
+  using swiss_hashmap_t = SwissHashmap<arrow_string_view, uint64_t>;
+  ObjectID hashmap_id = build<HashmapBuilder<arrow_string_view, uint64_t>>(
+      client, keys, data_buffer);
+  ObjectID swiss_hashmap_id =
+      build<SwissHashmapBuilder<arrow_string_view, uint64_t>>(client, keys,
+                                                               data_buffer);
+  bench_lookup<hashmap_t>("string hashmap", client, hashmap_id, queries,
+                          rounds);
+  bench_lookup<swiss_hashmap_t>("string swiss", client, swiss_hashmap_id,
+                                queries, rounds);
+  VINEYARD_DISCARD(
+      client.DelData({hashmap_id, swiss_hashmap_id, data_buffer->id()}));
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_hashmap_lookup <ipc_socket> [<number of keys>] "
+        "[<rounds>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t num_keys = 10 * 1000 * 1000;
+  int rounds = 3;
+  if (argc >= 3) {
+    num_keys = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    rounds = atoi(argv[3]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  bench_int64(client, num_keys, rounds);
+  bench_string(client, num_keys, rounds);
+
+  client.Disconnect();
+  LOG(INFO) << "Finish hashmap lookup benchmarks...";
+  return 0;
+}
@@ -0,0 +1,112 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/util/logging.h"
+#include "io/io/local_io_adaptor.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// generate a csv file with `src,dst,weight` columns.
+static void generate(std::string const& path, size_t nbytes) {
+  std::ofstream out(path);
+  out << "src,dst,weight\n";
+  size_t written = 0, row = 0;
+  while (written < nbytes) {
+    std::string line = std::to_string(row) + "," +
+                       std::to_string((row * 2654435761ULL) % 100000007) +
+                       "," + std::to_string(row % 1000) + ".5\n";
+    out << line;
+    written += line.size();
+    row += 1;
+  }
+}
+
+static void load(std::string const& location, int index, int total_parts,
+                 std::string const& parallel_read, int64_t& rows) {
+  LocalIOAdaptor adaptor(location + "#header_row=true&parallel_read=" +
+                         parallel_read);
+  VINEYARD_CHECK_OK(adaptor.SetPartialRead(index, total_parts));
+  VINEYARD_CHECK_OK(adaptor.Open());
+  std::shared_ptr<arrow::Table> table;
+  VINEYARD_CHECK_OK(adaptor.ReadTable(&table));
+  rows = table == nullptr ? 0 : table->num_rows();
+  VINEYARD_CHECK_OK(adaptor.Close());
+}
+
+static void bench(std::string const& location, int threads,
+                  std::string const& parallel_read) {
+  std::vector<int64_t> rows(threads, 0);
+  std::vector<std::thread> workers;
+  auto start = clock_type::now();
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back(load, location, i, threads, parallel_read,
+                         std::ref(rows[i]));
+  }
+  for (auto& t : workers) {
+    t.join();
+  }
+  double elapsed = elapsed_seconds(start);
+  int64_t total_rows = 0;
+  for (auto const& r : rows) {
+    total_rows += r;
+  }
+  std::cout << "threads: " << threads << ", parallel read: " << parallel_read
+            << ", rows: " << total_rows << ", elapsed: " << elapsed << " s"
+            << std::endl;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_local_io <csv file> [<max threads>] "
+        "[<generate size in bytes if the file doesn't exist>]");
+    return 1;
+  }
+  std::string location = std::string(argv[1]);
+  int max_threads = 16;
+  size_t generate_size = 4LL * 1024 * 1024 * 1024;
+  if (argc >= 3) {
+    max_threads = atoi(argv[2]);
+  }
+  if (argc >= 4) {
+    generate_size = static_cast<size_t>(atoll(argv[3]));
+  }
+  if (!std::ifstream(location).good()) {
+    LOG(INFO) << "Generating " << generate_size << " bytes to " << location;
+    generate(location, generate_size);
+  }
+
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    bench(location, threads, "false");
+    bench(location, threads, "true");
+  }
+
+  LOG(INFO) << "Finish local io benchmarks...";
+  return 0;
+}
@@ -0,0 +1,83 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "common/memory/memcpy.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+template <typename F>
+static double bandwidth(F&& fn, const size_t size, const size_t rounds) {
+  double best = std::numeric_limits<double>::max();
+  for (size_t round = 0; round < rounds; ++round) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    best = std::min(best, std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+  }
+  return static_cast<double>(size) / best / 1e9;
+}
+
+int main(int argc, char** argv) {
+  size_t max_size = 4UL * 1024 * 1024 * 1024;
+  if (argc >= 2) {
+    max_size = static_cast<size_t>(atoll(argv[1]));
+  }
+
+  auto const& profile = memory::GetMemcpyProfile();
+  std::cout << "memcpy profile: cached = "
+            << memory::MemcpyStrategyName(profile.cached)
+            << ", streaming = " << memory::MemcpyStrategyName(profile.streaming)
+            << " (above " << profile.streaming_threshold
+            << " bytes), parallel threshold = " << profile.parallel_threshold
+            << ", concurrency = " << profile.max_concurrency
+            << ", llc size = " << profile.llc_size << std::endl;
+
+  std::unique_ptr<char[]> src(new char[max_size]), dst(new char[max_size]);
+  memset(src.get(), 0x5a, max_size);
+  memset(dst.get(), 0xa5, max_size);
+
+  std::cout << std::setw(14) << "size" << std::setw(12) << "memcpy"
+            << std::setw(12) << "inline" << std::setw(12) << "single"
+            << std::setw(12) << "concurrent" << "  (GB/s)" << std::endl;
+  for (size_t size = 4096; size <= max_size; size *= 4) {
+    size_t rounds = std::max<size_t>(3, (64UL << 20) / size);
+    double libc = bandwidth([&]() { memcpy(dst.get(), src.get(), size); },
+                            size, rounds);
+    double inlined = bandwidth(
+        [&]() { memory::inline_memcpy(dst.get(), src.get(), size); }, size,
+        rounds);
+    double single = bandwidth(
+        [&]() { memory::concurrent_memcpy(dst.get(), src.get(), size, 1); },
+        size, rounds);
+    double concurrent = bandwidth(
+        [&]() { memory::concurrent_memcpy(dst.get(), src.get(), size); },
+        size, rounds);
+    std::cout << std::setw(14) << size << std::fixed << std::setprecision(2)
+              << std::setw(12) << libc << std::setw(12) << inlined
+              << std::setw(12) << single << std::setw(12) << concurrent
+              << std::endl;
+  }
+  return 0;
+}
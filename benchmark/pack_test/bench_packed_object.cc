@@ -0,0 +1,125 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "basic/ds/tensor.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+#include "msgpack/packed_object.h"
+#include "msgpack/pickle.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static void report(std::string const& phase, size_t const bytes,
+                   double const seconds) {
+  std::cout << phase << ": " << bytes << " bytes in " << seconds << " s, "
+            << bytes / seconds / (1024.0 * 1024 * 1024) << " GiB/s"
+            << std::endl;
+}
+
+// usage: ./bench_packed_object <ipc_socket> [<tensor size in MiB>]
+//            [<output file>]
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage: ./bench_packed_object <ipc_socket> [<tensor size in MiB>] "
+        "[<output file>]\n");
+    return 1;
+  }
+  std::string ipc_socket = argv[1];
+  size_t size_in_mb = 1024;
+  std::string output = "/dev/null";
+  if (argc >= 3) {
+    size_in_mb = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    output = argv[3];
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  int64_t elements = size_in_mb * 1024 * 1024 / sizeof(double);
+  std::shared_ptr<Object> tensor;
+  {
+    TensorBuilder<double> builder(client, {elements});
+    for (int64_t index = 0; index < elements; ++index) {
+      builder.data()[index] = static_cast<double>(index);
+    }
+    tensor = builder.Seal(client);
+  }
+  auto const& blobs = tensor->meta().GetBufferSet()->AllBuffers();
+
+  // the baseline: copies the metadata and blobs into a contiguous buffer
+  {
+    auto start = clock_type::now();
+    std::string metadata = tensor->meta().MetaData().dump();
+    size_t total = metadata.size();
+    for (auto const& item : blobs) {
+      total += item.second->size();
+    }
+    std::unique_ptr<uint8_t[]> flattened(new uint8_t[total]);
+    memcpy(flattened.get(), metadata.data(), metadata.size());
+    size_t offset = metadata.size();
+    for (auto const& item : blobs) {
+      memcpy(flattened.get() + offset, item.second->data(),
+             item.second->size());
+      offset += item.second->size();
+    }
+    report("flatten", total, elapsed_seconds(start));
+  }
+
+  {
+    auto start = clock_type::now();
+    PackedObject packed(tensor);
+    report("pack", packed.size(), elapsed_seconds(start));
+
+    int fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    CHECK_GE(fd, 0);
+    start = clock_type::now();
+    VINEYARD_CHECK_OK(packed.WriteTo(fd));
+    report("writev", packed.size(), elapsed_seconds(start));
+    close(fd);
+  }
+
+  {
+    auto start = clock_type::now();
+    Pickler pickled(tensor);
+    report("pickle", pickled.size(), elapsed_seconds(start));
+    std::cout << "pickle: " << pickled.pickled().size()
+              << " bytes in band, " << pickled.buffer().buffers().size() - 1
+              << " out-of-band buffers" << std::endl;
+  }
+
+  VINEYARD_CHECK_OK(client.DelData(tensor->id(), true, true));
+  client.Disconnect();
+  LOG(INFO) << "Finish packed object benchmarks...";
+  return 0;
+}
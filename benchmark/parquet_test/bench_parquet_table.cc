@@ -0,0 +1,118 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+#include "parquet/arrow/reader.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/arrow_shim/memory_pool.h"
+#include "client/client.h"
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static std::shared_ptr<arrow::Table> read_parquet(std::string const& path,
+                                                  arrow::MemoryPool* pool) {
+  std::shared_ptr<arrow::io::ReadableFile> file;
+  CHECK_ARROW_ERROR_AND_ASSIGN(file, arrow::io::ReadableFile::Open(path));
+  parquet::arrow::FileReaderBuilder builder;
+  CHECK_ARROW_ERROR(builder.Open(file));
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  CHECK_ARROW_ERROR(builder.memory_pool(pool)->Build(&reader));
+  std::shared_ptr<arrow::Table> table;
+  CHECK_ARROW_ERROR(reader->ReadTable(&table));
+  return table;
+}
+
+// the buffers are allocated in arrow's default pool, and copied into vineyard
+static void load_with_default_pool(Client& client, std::string const& path) {
+  auto start = clock_type::now();
+  auto table = read_parquet(path, arrow::default_memory_pool());
+  double read_seconds = elapsed_seconds(start);
+
+  start = clock_type::now();
+  TableBuilder builder(client, table);
+  auto object = builder.Seal(client);
+  double seal_seconds = elapsed_seconds(start);
+
+  std::cout << "default pool: " << table->num_rows() << " rows, read "
+            << read_seconds << " s, seal " << seal_seconds << " s, total "
+            << read_seconds + seal_seconds << " s" << std::endl;
+  table.reset();
+  VINEYARD_CHECK_OK(client.DelData(object->id(), true, true));
+}
+
+// the buffers are allocated as blobs, and sealed in place
+static void load_with_vineyard_pool(Client& client, std::string const& path) {
+  memory::VineyardMemoryPool pool(client);
+
+  auto start = clock_type::now();
+  auto table = read_parquet(path, &pool);
+  double read_seconds = elapsed_seconds(start);
+  int64_t allocated = pool.bytes_allocated();
+
+  start = clock_type::now();
+  TableBuilder builder(client, table);
+  auto object = builder.Seal(client);
+  double seal_seconds = elapsed_seconds(start);
+  int64_t sealed = allocated - pool.bytes_allocated();
+
+  std::cout << "vineyard pool: " << table->num_rows() << " rows, read "
+            << read_seconds << " s, seal " << seal_seconds << " s, total "
+            << read_seconds + seal_seconds << " s, sealed in place " << sealed
+            << " of " << allocated << " bytes" << std::endl;
+  table.reset();
+  VINEYARD_CHECK_OK(client.DelData(object->id(), true, true));
+}
+
+// usage: ./bench_parquet_table <ipc_socket> <parquet file> [<rounds>]
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    printf(
+        "usage: ./bench_parquet_table <ipc_socket> <parquet file> "
+        "[<rounds>]\n");
+    return 1;
+  }
+  std::string ipc_socket = argv[1];
+  std::string path = argv[2];
+  int rounds = 3;
+  if (argc >= 4) {
+    rounds = atoi(argv[3]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  for (int round = 0; round < rounds; ++round) {
+    load_with_default_pool(client, path);
+    load_with_vineyard_pool(client, path);
+  }
+  client.Disconnect();
+
+  LOG(INFO) << "Finish parquet table benchmarks...";
+  return 0;
+}
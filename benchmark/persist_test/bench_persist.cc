@@ -0,0 +1,116 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "client/client.h"
+#include "client/ds/object_meta.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_microseconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double, std::micro>(clock_type::now() - start)
+      .count();
+}
+
+// the persisted objects link to a persisted member, whose key is compared
+// by the optimistic persists as well
+static ObjectID create_object(Client& client, size_t index,
+                              const ObjectMeta& member) {
+  ObjectMeta meta;
+  meta.SetTypeName("vineyard::PersistBenchmark");
+  meta.AddKeyValue("index", index);
+  meta.AddMember("member", member);
+  meta.SetNBytes(0);
+  ObjectID id = InvalidObjectID();
+  VINEYARD_CHECK_OK(client.CreateMetaData(meta, id));
+  return id;
+}
+
+// usage: ./bench_persist <ipc_socket> [<max persisted objects>] [<samples>]
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage: ./bench_persist <ipc_socket> [<max persisted objects>] "
+        "[<samples>]\n");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  size_t max_objects = 100000;
+  size_t samples = 1000;
+  if (argc >= 3) {
+    max_objects = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    samples = atoll(argv[3]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  ObjectMeta member;
+  {
+    ObjectMeta meta;
+    meta.SetTypeName("vineyard::PersistBenchmarkMember");
+    meta.SetNBytes(0);
+    ObjectID id = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.CreateMetaData(meta, id));
+    VINEYARD_CHECK_OK(client.Persist(id));
+    VINEYARD_CHECK_OK(client.GetMetaData(id, member));
+  }
+
+  std::vector<ObjectID> objects;
+  std::vector<double> latencies;
+  for (size_t size = 1000; size <= max_objects; size *= 10) {
+    // grow the cluster metadata to `size` persisted objects
+    while (objects.size() + samples < size) {
+      ObjectID id = create_object(client, objects.size(), member);
+      VINEYARD_CHECK_OK(client.Persist(id));
+      objects.emplace_back(id);
+    }
+
+    latencies.clear();
+    for (size_t i = 0; i < samples; ++i) {
+      ObjectID id = create_object(client, objects.size(), member);
+      auto start = clock_type::now();
+      VINEYARD_CHECK_OK(client.Persist(id));
+      latencies.emplace_back(elapsed_microseconds(start));
+      objects.emplace_back(id);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double latency : latencies) {
+      total += latency;
+    }
+    std::cout << "persisted objects: " << objects.size()
+              << ", persist latency (us): mean " << total / samples << ", p50 "
+              << latencies[samples / 2] << ", p99 "
+              << latencies[samples * 99 / 100] << std::endl;
+  }
+
+  VINEYARD_CHECK_OK(client.DelData(objects, true, true));
+  VINEYARD_CHECK_OK(client.DelData(member.GetId(), true, true));
+  client.Disconnect();
+  LOG(INFO) << "Finish persist benchmarks...";
+  return 0;
+}
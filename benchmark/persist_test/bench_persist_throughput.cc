@@ -0,0 +1,104 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/client.h"
+#include "client/ds/object_meta.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static void persist_objects(std::string const& ipc_socket, size_t const count,
+                            std::vector<ObjectID>& objects) {
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  for (size_t index = 0; index < count; ++index) {
+    ObjectMeta meta;
+    meta.SetTypeName("vineyard::PersistBenchmark");
+    meta.AddKeyValue("index", index);
+    meta.SetNBytes(0);
+    ObjectID id = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.CreateMetaData(meta, id));
+    VINEYARD_CHECK_OK(client.Persist(id));
+    objects.emplace_back(id);
+  }
+  client.Disconnect();
+}
+
+// usage: ./bench_persist_throughput <ipc_socket> [<ipc_socket> ...]
+//            [-n <objects per client>] [-c <clients per socket>]
+int main(int argc, char** argv) {
+  std::vector<std::string> ipc_sockets;
+  size_t num_objects = 10000;
+  size_t num_clients = 4;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      num_objects = atoll(argv[++i]);
+    } else if (arg == "-c" && i + 1 < argc) {
+      num_clients = atoll(argv[++i]);
+    } else {
+      ipc_sockets.emplace_back(arg);
+    }
+  }
+  if (ipc_sockets.empty()) {
+    printf(
+        "usage: ./bench_persist_throughput <ipc_socket> [<ipc_socket> ...] "
+        "[-n <objects per client>] [-c <clients per socket>]\n");
+    return 1;
+  }
+
+  // the instances persist concurrently, thus contend on the shared metadata
+  std::vector<std::vector<ObjectID>> objects(ipc_sockets.size() *
+                                             num_clients);
+  std::vector<std::thread> clients;
+  auto start = clock_type::now();
+  for (size_t i = 0; i < objects.size(); ++i) {
+    clients.emplace_back(persist_objects,
+                         std::cref(ipc_sockets[i % ipc_sockets.size()]),
+                         num_objects, std::ref(objects[i]));
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  double seconds = elapsed_seconds(start);
+
+  size_t total = objects.size() * num_objects;
+  std::cout << "instances: " << ipc_sockets.size()
+            << ", clients per instance: " << num_clients
+            << ", persisted objects: " << total << " in " << seconds << " s, "
+            << total / seconds << " persists/s" << std::endl;
+
+  for (size_t i = 0; i < objects.size(); ++i) {
+    Client client;
+    VINEYARD_CHECK_OK(client.Connect(ipc_sockets[i % ipc_sockets.size()]));
+    VINEYARD_CHECK_OK(client.DelData(objects[i], true, true));
+    client.Disconnect();
+  }
+  LOG(INFO) << "Finish persist throughput benchmarks...";
+  return 0;
+}
@@ -0,0 +1,150 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "grape/worker/comm_spec.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "common/util/env.h"
+#include "common/util/logging.h"
+#include "graph/utils/partitioner.h"
+#include "graph/utils/table_pipeline.h"
+#include "graph/utils/table_shuffler.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// Generates a vertex table of (id, value, name) in batches of `batch_size`
+// rows, the ids are random thus the rows are evenly shuffled among workers.
+static std::shared_ptr<arrow::Table> generate_table(int worker_id,
+                                                    int64_t num_rows,
+                                                    int64_t batch_size) {
+  std::mt19937_64 gen(worker_id);
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("value", arrow::float64()),
+                               arrow::field("name", arrow::large_utf8())});
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int64_t begin = 0; begin < num_rows; begin += batch_size) {
+    int64_t size = std::min(batch_size, num_rows - begin);
+    arrow::Int64Builder id_builder;
+    arrow::DoubleBuilder value_builder;
+    arrow::LargeStringBuilder name_builder;
+    for (int64_t i = 0; i < size; ++i) {
+      int64_t id = static_cast<int64_t>(gen() >> 1);
+      CHECK_ARROW_ERROR(id_builder.Append(id));
+      CHECK_ARROW_ERROR(value_builder.Append(static_cast<double>(i)));
+      CHECK_ARROW_ERROR(name_builder.Append("vertex-" + std::to_string(id)));
+    }
+    std::shared_ptr<arrow::Array> ids, values, names;
+    CHECK_ARROW_ERROR(id_builder.Finish(&ids));
+    CHECK_ARROW_ERROR(value_builder.Finish(&values));
+    CHECK_ARROW_ERROR(name_builder.Finish(&names));
+    batches.push_back(
+        arrow::RecordBatch::Make(schema, size, {ids, values, names}));
+  }
+  std::shared_ptr<arrow::Table> table;
+  VINEYARD_CHECK_OK(RecordBatchesToTable(schema, batches, &table));
+  return table;
+}
+
+// Reports the slowest worker, as the shuffle is bounded by it.
+static void report(const grape::CommSpec& comm_spec, std::string const& name,
+                   double seconds, int64_t rows_in, int64_t rows_out) {
+  double max_seconds = 0;
+  int64_t total_in = 0, total_out = 0;
+  MPI_Reduce(&seconds, &max_seconds, 1, MPI_DOUBLE, MPI_MAX, 0,
+             comm_spec.comm());
+  MPI_Reduce(&rows_in, &total_in, 1, MPI_INT64_T, MPI_SUM, 0,
+             comm_spec.comm());
+  MPI_Reduce(&rows_out, &total_out, 1, MPI_INT64_T, MPI_SUM, 0,
+             comm_spec.comm());
+  if (comm_spec.worker_id() == 0) {
+    CHECK_EQ(total_in, total_out);
+    std::cout << name << ": " << max_seconds << " s, "
+              << total_in / max_seconds / 1e6 << " M rows/s, "
+              << "peak rss (worker-0): " << get_peak_rss_pretty()
+              << std::endl;
+  }
+}
+
+// usage: mpirun -n <workers> ./bench_shuffle_pipeline [<rows per worker>]
+//            [<batch size>]
+int main(int argc, char** argv) {
+  int64_t num_rows = 10 * 1000 * 1000;
+  int64_t batch_size = 64 * 1024;
+  if (argc >= 2) {
+    num_rows = atoll(argv[1]);
+  }
+  if (argc >= 3) {
+    batch_size = atoll(argv[2]);
+  }
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    HashPartitioner<int64_t> partitioner;
+    partitioner.Init(comm_spec.fnum());
+
+    auto table = generate_table(comm_spec.worker_id(), num_rows, batch_size);
+    if (comm_spec.worker_id() == 0) {
+      std::cout << "workers: " << comm_spec.worker_num()
+                << ", rows per worker: " << num_rows
+                << ", batch size: " << batch_size << std::endl;
+    }
+
+    // the pipelined shuffle comes first as the peak rss never decreases
+    {
+      MPI_Barrier(comm_spec.comm());
+      auto start = clock_type::now();
+      auto out = ShufflePropertyVertexTable(
+                     comm_spec, partitioner,
+                     std::static_pointer_cast<ITablePipeline>(
+                         std::make_shared<TablePipeline>(table)))
+                     .value();
+      report(comm_spec, "pipelined shuffle", elapsed_seconds(start),
+             table->num_rows(), out->num_rows());
+    }
+
+    {
+      MPI_Barrier(comm_spec.comm());
+      auto start = clock_type::now();
+      auto out =
+          ShufflePropertyVertexTable(comm_spec, partitioner, table).value();
+      report(comm_spec, "materialized shuffle", elapsed_seconds(start),
+             table->num_rows(), out->num_rows());
+    }
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Finish shuffle benchmarks...";
+  return 0;
+}
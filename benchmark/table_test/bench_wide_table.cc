@@ -0,0 +1,136 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/dataframe.h"
+#include "basic/ds/tensor.h"
+#include "client/client.h"
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static void report(std::string const& kind, int64_t const columns,
+                   double const seconds) {
+  std::cout << kind << " (" << columns << " columns): " << seconds << " s, "
+            << columns / seconds << " columns/s" << std::endl;
+}
+
+static std::shared_ptr<arrow::Table> make_table(int64_t const rows,
+                                                int64_t const chunks,
+                                                int64_t const columns) {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> arrays;
+  for (int64_t cindex = 0; cindex < columns; ++cindex) {
+    std::vector<std::shared_ptr<arrow::Array>> column_chunks;
+    for (int64_t chunk = 0; chunk < chunks; ++chunk) {
+      arrow::DoubleBuilder builder;
+      CHECK_ARROW_ERROR(builder.Reserve(rows / chunks));
+      for (int64_t index = 0; index < rows / chunks; ++index) {
+        builder.UnsafeAppend(static_cast<double>(cindex * rows + index));
+      }
+      std::shared_ptr<arrow::Array> array;
+      CHECK_ARROW_ERROR(builder.Finish(&array));
+      column_chunks.emplace_back(array);
+    }
+    fields.emplace_back(
+        arrow::field("f" + std::to_string(cindex), arrow::float64()));
+    arrays.emplace_back(std::make_shared<arrow::ChunkedArray>(column_chunks));
+  }
+  return arrow::Table::Make(arrow::schema(fields), arrays);
+}
+
+static void seal_table(Client& client, int64_t const rows,
+                       int64_t const chunks, int64_t const columns) {
+  auto table = make_table(rows, chunks, columns);
+
+  auto start = clock_type::now();
+  TableBuilder builder(client, table, true);
+  auto object = builder.Seal(client);
+  report("table", columns, elapsed_seconds(start));
+
+  VINEYARD_CHECK_OK(client.DelData(object->id(), true, true));
+}
+
+static void seal_dataframe(Client& client, int64_t const rows,
+                           int64_t const columns) {
+  DataFrameBuilder builder(client);
+  for (int64_t cindex = 0; cindex < columns; ++cindex) {
+    auto column = std::make_shared<TensorBuilder<double>>(
+        client, std::vector<int64_t>{rows});
+    auto data = column->data();
+    for (int64_t index = 0; index < rows; ++index) {
+      data[index] = static_cast<double>(cindex * rows + index);
+    }
+    builder.AddColumn("f" + std::to_string(cindex), column);
+  }
+
+  auto start = clock_type::now();
+  auto object = builder.Seal(client);
+  report("dataframe", columns, elapsed_seconds(start));
+
+  VINEYARD_CHECK_OK(client.DelData(object->id(), true, true));
+}
+
+// usage: ./bench_wide_table <ipc_socket> [<rows>] [<chunks>] [<columns> ...]
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage: ./bench_wide_table <ipc_socket> [<rows>] [<chunks>] "
+        "[<columns> ...]\n");
+    return 1;
+  }
+  std::string ipc_socket = argv[1];
+  int64_t rows = 10000;
+  int64_t chunks = 4;
+  std::vector<int64_t> column_counts;
+  if (argc >= 3) {
+    rows = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    chunks = atoll(argv[3]);
+  }
+  for (int i = 4; i < argc; ++i) {
+    column_counts.emplace_back(atoll(argv[i]));
+  }
+  if (column_counts.empty()) {
+    column_counts = {1, 10, 100, 500, 1000};
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  for (auto const columns : column_counts) {
+    seal_table(client, rows, chunks, columns);
+    seal_dataframe(client, rows, columns);
+  }
+  client.Disconnect();
+
+  LOG(INFO) << "Finish wide table benchmarks...";
+  return 0;
+}
@@ -0,0 +1,198 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+#include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/arrow_vertex_map.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+
+using oid_t = int64_t;
+using vid_t = uint64_t;
+using label_id_t = property_graph_types::LABEL_ID_TYPE;
+using vertex_map_t = ArrowVertexMap<oid_t, vid_t>;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// Generates `vnum` distinct oids in chunks of 1M, starting from `begin`
+// with a random stride so that the keys are not inserted in order.
+static std::shared_ptr<arrow::ChunkedArray> generate_oids(oid_t begin,
+                                                          int64_t vnum) {
+  const int64_t chunk_size = 1024 * 1024;
+  std::mt19937_64 gen(begin);
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  for (int64_t offset = 0; offset < vnum; offset += chunk_size) {
+    int64_t size = std::min(chunk_size, vnum - offset);
+    arrow::Int64Builder builder;
+    CHECK_ARROW_ERROR(builder.Reserve(size));
+    for (int64_t i = 0; i < size; ++i) {
+      builder.UnsafeAppend(begin + (offset + i) * 16 + (gen() & 15));
+    }
+    std::shared_ptr<arrow::Array> chunk;
+    CHECK_ARROW_ERROR(builder.Finish(&chunk));
+    chunks.emplace_back(chunk);
+  }
+  return arrow::ChunkedArray::Make(chunks, arrow::int64()).ValueOrDie();
+}
+
+static void check_vertex_map(
+    const std::shared_ptr<vertex_map_t>& vertex_map,
+    const std::vector<std::vector<std::shared_ptr<arrow::ChunkedArray>>>&
+        oids) {
+  for (size_t label = 0; label < oids.size(); ++label) {
+    for (size_t fid = 0; fid < oids[label].size(); ++fid) {
+      if (oids[label][fid]->num_chunks() == 0) {
+        continue;
+      }
+      auto const& chunk = oids[label][fid]->chunk(0);
+      auto array = std::dynamic_pointer_cast<arrow::Int64Array>(chunk);
+      for (int64_t i = 0; i < array->length(); i += 997) {
+        vid_t gid;
+        oid_t oid;
+        CHECK(vertex_map->GetGid(fid, label, array->Value(i), gid));
+        CHECK(vertex_map->GetOid(gid, oid));
+        CHECK_EQ(oid, array->Value(i));
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_vertex_map_build <ipc_socket> [<number of vertices>] "
+        "[<fnum>] [<label num>] [<max concurrency>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t vnum = 100 * 1000 * 1000;
+  fid_t fnum = 1;
+  label_id_t label_num = 1;
+  int max_concurrency = std::thread::hardware_concurrency();
+  if (argc >= 3) {
+    vnum = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    fnum = atoi(argv[3]);
+  }
+  if (argc >= 5) {
+    label_num = atoi(argv[4]);
+  }
+  if (argc >= 6) {
+    max_concurrency = atoi(argv[5]);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  int64_t piece = vnum / (fnum * label_num);
+  std::vector<std::vector<std::shared_ptr<arrow::ChunkedArray>>> oids(
+      label_num);
+  for (label_id_t label = 0; label < label_num; ++label) {
+    for (fid_t fid = 0; fid < fnum; ++fid) {
+      oids[label].emplace_back(
+          generate_oids((label * fnum + fid) * piece * 16, piece));
+    }
+  }
+  std::cout << "vertices: " << vnum << ", fnum: " << fnum
+            << ", label num: " << label_num << std::endl;
+
+  // build time against the number of threads
+  ObjectID vertex_map_id = InvalidObjectID();
+  for (int concurrency = 1; concurrency <= max_concurrency;
+       concurrency *= 2) {
+    auto start = clock_type::now();
+    BasicArrowVertexMapBuilder<oid_t, vid_t> builder(client, fnum, label_num,
+                                                     oids);
+    builder.set_concurrency(concurrency);
+    auto vertex_map =
+        std::dynamic_pointer_cast<vertex_map_t>(builder.Seal(client));
+    double seconds = elapsed_seconds(start);
+    check_vertex_map(vertex_map, oids);
+    std::cout << "build with " << concurrency << " threads: " << seconds
+              << " s, " << vnum / seconds / 1e6 << " M vertices/s"
+              << std::endl;
+    if (vertex_map_id != InvalidObjectID()) {
+      VINEYARD_CHECK_OK(client.DelData(vertex_map_id));
+    }
+    vertex_map_id = vertex_map->id();
+  }
+
+  // add 1% vertices to the existing labels, and compare with a rebuild
+  auto vertex_map =
+      std::dynamic_pointer_cast<vertex_map_t>(client.GetObject(vertex_map_id));
+  std::vector<std::vector<std::shared_ptr<arrow::ChunkedArray>>> added_oids(
+      label_num);
+  std::map<label_id_t, std::vector<std::shared_ptr<arrow::ChunkedArray>>>
+      added;
+  for (label_id_t label = 0; label < label_num; ++label) {
+    for (fid_t fid = 0; fid < fnum; ++fid) {
+      added_oids[label].emplace_back(generate_oids(
+          (label_num * fnum + label * fnum + fid) * piece * 16, piece / 100));
+    }
+    added[label] = added_oids[label];
+  }
+  auto start = clock_type::now();
+  auto extended = std::dynamic_pointer_cast<vertex_map_t>(
+      client.GetObject(vertex_map->AddVertices(client, added)));
+  double incremental_seconds = elapsed_seconds(start);
+  check_vertex_map(extended, oids);
+  check_vertex_map(extended, added_oids);
+
+  start = clock_type::now();
+  for (label_id_t label = 0; label < label_num; ++label) {
+    for (fid_t fid = 0; fid < fnum; ++fid) {
+      auto chunks = oids[label][fid]->chunks();
+      for (auto const& chunk : added_oids[label][fid]->chunks()) {
+        chunks.emplace_back(chunk);
+      }
+      oids[label][fid] =
+          arrow::ChunkedArray::Make(chunks, arrow::int64()).ValueOrDie();
+    }
+  }
+  BasicArrowVertexMapBuilder<oid_t, vid_t> builder(client, fnum, label_num,
+                                                   oids);
+  auto rebuilt = builder.Seal(client);
+  double rebuild_seconds = elapsed_seconds(start);
+
+  std::cout << "add " << piece / 100 * fnum * label_num
+            << " vertices: incremental " << incremental_seconds
+            << " s, rebuild " << rebuild_seconds << " s" << std::endl;
+
+  VINEYARD_CHECK_OK(client.DelData(rebuilt->id()));
+  VINEYARD_CHECK_OK(client.DelData(extended->id()));
+  VINEYARD_CHECK_OK(client.DelData(vertex_map_id));
+  client.Disconnect();
+  LOG(INFO) << "Finish vertex map build benchmarks...";
+  return 0;
+}
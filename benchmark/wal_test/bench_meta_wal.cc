@@ -0,0 +1,146 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/util/logging.h"
+#include "common/util/status.h"
+#include "server/util/meta_wal.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using clock_type = std::chrono::steady_clock;
+using op_t = meta_tree::op_t;
+
+static double elapsed_seconds(clock_type::time_point const& start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+// The flattened metadata of a (persisted) blob, as what the server commits.
+static std::vector<op_t> make_object(int64_t const index) {
+  std::string prefix = "/data/o" + std::to_string(index);
+  return {
+      op_t::Put(prefix + "/id", "\"o" + std::to_string(index) + "\"", 0),
+      op_t::Put(prefix + "/typename", "\"vineyard::Blob\"", 0),
+      op_t::Put(prefix + "/length", std::to_string(index * 64), 0),
+      op_t::Put(prefix + "/nbytes", std::to_string(index * 64), 0),
+      op_t::Put(prefix + "/instance_id", "0", 0),
+      op_t::Put(prefix + "/transient", "false", 0),
+      op_t::Put(prefix + "/signature", std::to_string(index), 0),
+      op_t::Put("/signatures/" + std::to_string(index),
+                "\"o" + std::to_string(index) + "\"", 0),
+  };
+}
+
+// Commits `count` objects with at most `inflight` commits pending, as the
+// meta service doesn't wait for a commit before issuing the next one.
+static void commit_objects(MetaWal& wal, int64_t const begin,
+                           int64_t const count, int64_t const inflight) {
+  if (count <= 0) {
+    return;
+  }
+  std::mutex mutex;
+  std::condition_variable cv;
+  int64_t pending = 0;
+  std::vector<double> latencies(count);
+
+  auto start = clock_type::now();
+  for (int64_t index = begin; index < begin + count; ++index) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return pending < inflight; });
+      ++pending;
+    }
+    auto issued = clock_type::now();
+    wal.Commit(make_object(index), [&, index, issued](const Status& status,
+                                                      unsigned) {
+      VINEYARD_CHECK_OK(status);
+      latencies[index - begin] = elapsed_seconds(issued) * 1e6;
+      std::lock_guard<std::mutex> lock(mutex);
+      --pending;
+      cv.notify_one();
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return pending == 0; });
+  }
+  double seconds = elapsed_seconds(start);
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "commit (inflight " << inflight << "): " << count
+            << " objects in " << seconds << " s, " << count / seconds
+            << " commits/s, latency p50: " << latencies[count / 2]
+            << " us, p99: " << latencies[count * 99 / 100] << " us"
+            << std::endl;
+}
+
+static void recover(std::string const& directory, size_t compaction_size,
+                    int64_t const expected) {
+  auto start = clock_type::now();
+  MetaWal wal(directory, compaction_size);
+  VINEYARD_CHECK_OK(wal.Open());
+  double seconds = elapsed_seconds(start);
+  CHECK_EQ(wal.Size(), static_cast<size_t>(expected * 8));
+  std::cout << "recover: " << wal.Size() << " keys at revision "
+            << wal.Revision() << " in " << seconds << " s" << std::endl;
+}
+
+// usage: ./bench_meta_wal <directory> [<objects>] [<inflight commits>]
+//            [<compaction size>]
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage: ./bench_meta_wal <directory> [<objects>] [<inflight commits>] "
+        "[<compaction size>]\n");
+    return 1;
+  }
+  std::string directory = argv[1];
+  int64_t num_objects = 1000 * 1000;
+  int64_t inflight = 256;
+  size_t compaction_size = 64 * 1024 * 1024;
+  if (argc >= 3) {
+    num_objects = atoll(argv[2]);
+  }
+  if (argc >= 4) {
+    inflight = atoll(argv[3]);
+  }
+  if (argc >= 5) {
+    compaction_size = atoll(argv[4]);
+  }
+  // keys of different runs would be mixed up
+  std::string command = "rm -rf " + directory;
+  CHECK_EQ(system(command.c_str()), 0);
+
+  {
+    MetaWal wal(directory, compaction_size);
+    VINEYARD_CHECK_OK(wal.Open());
+    // a commit per fsync, as the baseline of group commits
+    commit_objects(wal, 0, std::min<int64_t>(1000, num_objects), 1);
+    commit_objects(wal, std::min<int64_t>(1000, num_objects),
+                   std::max<int64_t>(num_objects - 1000, 0), inflight);
+  }
+  recover(directory, compaction_size, num_objects);
+
+  LOG(INFO) << "Finish meta wal benchmarks...";
+  return 0;
+}
@@ -15,8 +15,10 @@ limitations under the License.
 
 #include "basic/ds/arrow.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -234,6 +236,72 @@ std::shared_ptr<arrow::Array> CastToArray(std::shared_ptr<Object> object) {
   return nullptr;
 }
 
+std::shared_ptr<arrow::ChunkedArray> CastToChunkedArray(
+    std::shared_ptr<Object> object) {
+  if (auto arr = std::dynamic_pointer_cast<ChunkedArray>(object)) {
+    return arr->GetArray();
+  }
+  auto array = CastToArray(object);
+  if (array == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<arrow::ChunkedArray>(array);
+}
+
+/**
+ * Whether the buffers of the array (excluding the children's) are vineyard
+ * blobs already, or are allocated by a `VineyardMemoryPool` (and will be
+ * sealed in place), in which case the array can be built without copying.
+ *
+ * The slices of the buffers allocated by a `VineyardMemoryPool` are copied,
+ * as the unsealed blobs cannot be referenced.
+ */
+static bool IsAdoptable(Client& client,
+                        const std::shared_ptr<arrow::Array>& array) {
+  auto const& buffers = array->data()->buffers;
+  for (size_t index = 0; index < buffers.size(); ++index) {
+    auto const& buffer = buffers[index];
+    if (buffer == nullptr || buffer->size() == 0) {
+      continue;
+    }
+    if (index == 0 && array->null_count() == 0) {
+      continue;  // the null bitmap won't be referenced
+    }
+    if (memory::VineyardMemoryPool::IsAllocated(client, buffer)) {
+      continue;
+    }
+    if (memory::VineyardMemoryPool::IsInAllocated(client, buffer->data())) {
+      return false;
+    }
+    ObjectID object_id = InvalidObjectID();
+    if (!client.IsSharedMemory(buffer->data(), object_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::shared_ptr<ObjectBase> AdoptBuffer(
+    Client& client, const std::shared_ptr<arrow::Buffer>& buffer) {
+  if (buffer == nullptr || buffer->size() == 0) {
+    return Blob::MakeEmpty(client);
+  }
+  std::unique_ptr<BlobWriter> blob;
+  if (memory::VineyardMemoryPool::TakeAllocated(client, buffer, blob).ok()) {
+    return std::move(blob);
+  }
+  return Blob::FromPointer(client, reinterpret_cast<uintptr_t>(buffer->data()),
+                           buffer->size());
+}
+
+static std::shared_ptr<ObjectBase> AdoptNullBitmap(
+    Client& client, const std::shared_ptr<arrow::Array>& array) {
+  if (array->null_bitmap() && array->null_count() > 0) {
+    return AdoptBuffer(client, array->null_bitmap());
+  }
+  return Blob::MakeEmpty(client);
+}
+
 }  // namespace detail
 
 #ifndef TAKE_BUFFER_AND_APPLY
@@ -332,6 +400,18 @@ NumericArrayBuilder<T>::NumericArrayBuilder(
 
 template <typename T>
 Status NumericArrayBuilder<T>::Build(Client& client) {
+  if (this->arrays_.size() == 1 &&
+      detail::IsAdoptable(client, this->arrays_[0])) {
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    this->set_length_(array_->length());
+    this->set_null_count_(array_->null_count());
+    this->set_offset_(array_->offset());
+    this->set_buffer_(detail::AdoptBuffer(client, array_->values()));
+    this->set_null_bitmap_(detail::AdoptNullBitmap(client, array_));
+    return Status::OK();
+  }
+
   memory::VineyardMemoryPool pool(client);
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
@@ -453,6 +533,18 @@ BooleanArrayBuilder::BooleanArrayBuilder(
 }
 
 Status BooleanArrayBuilder::Build(Client& client) {
+  if (this->arrays_.size() == 1 &&
+      detail::IsAdoptable(client, this->arrays_[0])) {
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    this->set_length_(array_->length());
+    this->set_null_count_(array_->null_count());
+    this->set_offset_(array_->offset());
+    this->set_buffer_(detail::AdoptBuffer(client, array_->values()));
+    this->set_null_bitmap_(detail::AdoptNullBitmap(client, array_));
+    return Status::OK();
+  }
+
   memory::VineyardMemoryPool pool(client);
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
@@ -523,6 +615,20 @@ GenericBinaryArrayBuilder<ArrayType, BuilderType>::GenericBinaryArrayBuilder(
 template <typename ArrayType, typename BuilderType>
 Status GenericBinaryArrayBuilder<ArrayType, BuilderType>::Build(
     Client& client) {
+  if (this->arrays_.size() == 1 &&
+      detail::IsAdoptable(client, this->arrays_[0])) {
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    this->set_length_(array_->length());
+    this->set_null_count_(array_->null_count());
+    this->set_offset_(array_->offset());
+    this->set_buffer_offsets_(
+        detail::AdoptBuffer(client, array_->value_offsets()));
+    this->set_buffer_data_(detail::AdoptBuffer(client, array_->value_data()));
+    this->set_null_bitmap_(detail::AdoptNullBitmap(client, array_));
+    return Status::OK();
+  }
+
   memory::VineyardMemoryPool pool(client);
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
@@ -592,6 +698,19 @@ FixedSizeBinaryArrayBuilder::FixedSizeBinaryArrayBuilder(
 }
 
 Status FixedSizeBinaryArrayBuilder::Build(Client& client) {
+  if (this->arrays_.size() == 1 &&
+      detail::IsAdoptable(client, this->arrays_[0])) {
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    this->set_byte_width_(array_->byte_width());
+    this->set_length_(array_->length());
+    this->set_null_count_(array_->null_count());
+    this->set_offset_(array_->offset());
+    this->set_buffer_(detail::AdoptBuffer(client, array_->values()));
+    this->set_null_bitmap_(detail::AdoptNullBitmap(client, array_));
+    return Status::OK();
+  }
+
   memory::VineyardMemoryPool pool(client);
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
@@ -699,6 +818,20 @@ BaseListArrayBuilder<ArrayType>::BaseListArrayBuilder(
 
 template <typename ArrayType>
 Status BaseListArrayBuilder<ArrayType>::Build(Client& client) {
+  if (this->arrays_.size() == 1 &&
+      detail::IsAdoptable(client, this->arrays_[0])) {
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    this->set_length_(array_->length());
+    this->set_null_count_(array_->null_count());
+    this->set_offset_(array_->offset());
+    this->set_buffer_offsets_(
+        detail::AdoptBuffer(client, array_->value_offsets()));
+    this->set_values_(detail::BuildArray(client, array_->values()));
+    this->set_null_bitmap_(detail::AdoptNullBitmap(client, array_));
+    return Status::OK();
+  }
+
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
       array, arrow_shim::Concatenate(std::move(this->arrays_)));
@@ -780,6 +913,20 @@ FixedSizeListArrayBuilder::FixedSizeListArrayBuilder(
 }
 
 Status FixedSizeListArrayBuilder::Build(Client& client) {
+  if (this->arrays_.size() == 1) {
+    // there are no buffers to copy except the values, and the values array
+    // decides whether to adopt on its own.
+    std::shared_ptr<ArrayType> array_ =
+        std::dynamic_pointer_cast<ArrayType>(this->arrays_[0]);
+    int32_t list_size = array_->list_type()->list_size();
+    this->set_length_(array_->length());
+    this->set_list_size_(list_size);
+    this->set_values_(detail::BuildArray(
+        client, array_->values()->Slice(array_->offset() * list_size,
+                                        array_->length() * list_size)));
+    return Status::OK();
+  }
+
   std::shared_ptr<arrow::Array> array;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
       array, arrow_shim::Concatenate(std::move(this->arrays_)));
@@ -800,6 +947,63 @@ Status FixedSizeListArrayBuilder::Build(Client& client) {
   return Status::OK();
 }
 
+void ChunkedArray::PostConstruct(const ObjectMeta& meta) {
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  for (auto const& chunk : this->chunks_) {
+    chunks.emplace_back(detail::CastToArray(chunk));
+  }
+  // the builder guarantees there is at least one chunk
+  this->array_ = std::make_shared<arrow::ChunkedArray>(chunks);
+}
+
+std::shared_ptr<arrow::Array> ChunkedArray::ToArray() const {
+  if (this->array_->num_chunks() == 1) {
+    return this->array_->chunk(0);
+  }
+  std::lock_guard<std::mutex> lock(this->concatenated_mutex_);
+  if (this->concatenated_ == nullptr) {
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        this->concatenated_,
+        arrow_shim::Concatenate(std::vector<std::shared_ptr<arrow::Array>>(
+            this->array_->chunks())));
+  }
+  return this->concatenated_;
+}
+
+ChunkedArrayBuilder::ChunkedArrayBuilder(
+    Client& client, const std::shared_ptr<arrow::ChunkedArray> array,
+    const bool concatenate)
+    : ChunkedArrayBaseBuilder(client), concatenate_(concatenate) {
+  VINEYARD_CHECK_OK(detail::Copy(array, this->array_, true));
+}
+
+Status ChunkedArrayBuilder::Build(Client& client) {
+  this->set_length_(array_->length());
+  if (concatenate_) {
+    this->add_chunks_(detail::BuildArray(client, array_));
+  } else if (array_->num_chunks() == 0) {
+    // keeps an empty chunk to retain the data type
+    std::shared_ptr<arrow::Array> empty;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        empty, arrow::MakeArrayOfNull(array_->type(), 0));
+    this->add_chunks_(detail::BuildArray(client, empty));
+  } else {
+    // the chunks are sealed in the calling thread, and their metadata are
+    // created with a single request
+    std::vector<std::shared_ptr<ObjectBuilder>> builders;
+    for (auto const& chunk : array_->chunks()) {
+      builders.emplace_back(detail::BuildArray(client, chunk));
+    }
+    std::vector<std::shared_ptr<Object>> chunks;
+    RETURN_ON_ERROR(ObjectBuilder::_SealBatch(client, builders, chunks));
+    for (auto const& chunk : chunks) {
+      this->add_chunks_(chunk);
+    }
+  }
+  array_.reset();  // release the reference
+  return Status::OK();
+}
+
 void SchemaProxy::PostConstruct(const ObjectMeta& meta) {
   std::shared_ptr<arrow::Buffer> wrapper;
   // the binary value is not roundtrip, see also:
@@ -855,19 +1059,47 @@ Status SchemaProxyBuilder::Build(Client& client) {
 }
 
 void RecordBatch::PostConstruct(const ObjectMeta& meta) {
-  for (size_t idx = 0; idx < columns_.size(); ++idx) {
-    arrow_columns_.emplace_back(detail::CastToArray(columns_[idx]));
+  // the columns are resolved lazily, see also `arrow_columns()`, as the
+  // chunks of `ChunkedArray` columns are concatenated there.
+}
+
+std::vector<std::shared_ptr<arrow::Array>> const& RecordBatch::arrow_columns()
+    const {
+  std::lock_guard<std::mutex> lock(this->arrow_columns_mutex_);
+  if (arrow_columns_.size() != columns_.size()) {
+    std::vector<std::shared_ptr<arrow::Array>> arrow_columns;
+    for (size_t idx = 0; idx < columns_.size(); ++idx) {
+      arrow_columns.emplace_back(detail::CastToArray(columns_[idx]));
+    }
+    arrow_columns_ = std::move(arrow_columns);
   }
+  return arrow_columns_;
+}
+
+std::shared_ptr<arrow::ChunkedArray> RecordBatch::chunked_column(int i) const {
+  return detail::CastToChunkedArray(columns_[i]);
 }
 
 std::shared_ptr<arrow::RecordBatch> RecordBatch::GetRecordBatch() const {
   if (this->batch_ == nullptr) {
     this->batch_ = arrow::RecordBatch::Make(this->schema_.GetSchema(),
-                                            this->row_num_, arrow_columns_);
+                                            this->row_num_, arrow_columns());
   }
   return this->batch_;
 }
 
+std::shared_ptr<arrow::Table> RecordBatch::GetTable() const {
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (size_t idx = 0; idx < columns_.size(); ++idx) {
+    auto column = chunked_column(idx);
+    VINEYARD_ASSERT(column != nullptr,
+                    "Unresolvable column: " + std::to_string(idx));
+    columns.emplace_back(column);
+  }
+  return arrow::Table::Make(this->schema_.GetSchema(), columns,
+                            this->row_num_);
+}
+
 RecordBatchBuilder::RecordBatchBuilder(
     Client& client, const std::shared_ptr<arrow::RecordBatch> batch)
     : RecordBatchBaseBuilder(client) {
@@ -882,33 +1114,60 @@ RecordBatchBuilder::RecordBatchBuilder(
   this->batches_ = std::move(batches);
 }
 
+RecordBatchBuilder::RecordBatchBuilder(
+    Client& client, const std::shared_ptr<arrow::Table> table)
+    : RecordBatchBaseBuilder(client), table_(table) {}
+
 Status RecordBatchBuilder::Build(Client& client) {
-  int64_t num_rows = 0, num_columns = batches_[0]->num_columns();
-  for (auto const& batch : batches_) {
-    num_rows += batch->num_rows();
-  }
-
-  this->set_schema_(
-      std::make_shared<SchemaProxyBuilder>(client, batches_[0]->schema()));
-  this->set_row_num_(num_rows);
-  this->set_column_num_(num_columns);
-
-  // column_chunks[column_index][chunk_index]
-  std::vector<std::vector<std::shared_ptr<arrow::Array>>> column_chunks(
-      num_columns);
-  for (auto& batch : batches_) {
-    for (int64_t cindex = 0; cindex < batch->num_columns(); ++cindex) {
-      column_chunks[cindex].emplace_back(batch->column(cindex));
+  std::vector<std::shared_ptr<ObjectBuilder>> builders;
+  if (table_ != nullptr) {
+    this->set_schema_(
+        std::make_shared<SchemaProxyBuilder>(client, table_->schema()));
+    this->set_row_num_(table_->num_rows());
+    this->set_column_num_(table_->num_columns());
+    for (auto const& column : table_->columns()) {
+      builders.emplace_back(
+          std::make_shared<ChunkedArrayBuilder>(client, column));
+    }
+    table_.reset();  // release the reference
+  } else {
+    int64_t num_rows = 0, num_columns = batches_[0]->num_columns();
+    for (auto const& batch : batches_) {
+      num_rows += batch->num_rows();
+    }
+
+    this->set_schema_(
+        std::make_shared<SchemaProxyBuilder>(client, batches_[0]->schema()));
+    this->set_row_num_(num_rows);
+    this->set_column_num_(num_columns);
+
+    // column_chunks[column_index][chunk_index]
+    std::vector<std::vector<std::shared_ptr<arrow::Array>>> column_chunks(
+        num_columns);
+    for (auto& batch : batches_) {
+      for (int64_t cindex = 0; cindex < batch->num_columns(); ++cindex) {
+        column_chunks[cindex].emplace_back(batch->column(cindex));
+      }
+      batch.reset();  // release the reference
+    }
+    batches_.clear();  // release the reference
+
+    // the builders are lazy, the concatenation happens when sealing
+    for (auto& chunks : column_chunks) {
+      std::shared_ptr<ObjectBuilder> builder;
+      RETURN_ON_ERROR(detail::BuildArray(
+          client, std::make_shared<arrow::ChunkedArray>(std::move(chunks)),
+          builder));
+      builders.emplace_back(builder);
     }
-    batch.reset();  // release the reference
   }
-  batches_.clear();  // release the reference
 
-  // build the columns into vineyard
-  for (int64_t idx = 0; idx < num_columns; ++idx) {
-    this->add_columns_(detail::BuildArray(
-        client, std::make_shared<arrow::ChunkedArray>(column_chunks[idx])));
-    column_chunks[idx].clear();  // release the reference
+  // build the columns into vineyard in parallel, and create the metadata of
+  // columns with a single request
+  std::vector<std::shared_ptr<Object>> columns;
+  RETURN_ON_ERROR(ObjectBuilder::_SealBatch(client, builders, columns, 0));
+  for (auto const& column : columns) {
+    this->add_columns_(column);
   }
   return Status::OK();
 }
@@ -1038,11 +1297,23 @@ void Table::PostConstruct(const ObjectMeta& meta) {
 std::shared_ptr<arrow::Table> Table::GetTable() const {
   if (this->table_ == nullptr) {
     if (batch_num_ > 0) {
-      arrow_batches_.resize(batch_num_);
-      for (size_t i = 0; i < batch_num_; ++i) {
-        arrow_batches_[i] = batches_[i]->GetRecordBatch();
+      // collects the columns chunk by chunk, rather than by record batches,
+      // to avoid concatenating the `ChunkedArray` columns.
+      auto schema = batches_[0]->schema();
+      std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+      for (int i = 0; i < schema->num_fields(); ++i) {
+        std::vector<std::shared_ptr<arrow::Array>> chunks;
+        for (size_t j = 0; j < batch_num_; ++j) {
+          auto column = batches_[j]->chunked_column(i);
+          VINEYARD_ASSERT(column != nullptr,
+                          "Unresolvable column: " + std::to_string(i));
+          chunks.insert(chunks.end(), column->chunks().begin(),
+                        column->chunks().end());
+        }
+        columns.emplace_back(std::make_shared<arrow::ChunkedArray>(
+            chunks, schema->field(i)->type()));
       }
-      VINEYARD_CHECK_OK(RecordBatchesToTable(arrow_batches_, &this->table_));
+      this->table_ = arrow::Table::Make(schema, columns, num_rows_);
     } else {
       CHECK_ARROW_ERROR_AND_ASSIGN(
           this->table_,
@@ -1054,46 +1325,65 @@ std::shared_ptr<arrow::Table> Table::GetTable() const {
 
 TableBuilder::TableBuilder(Client& client,
                            const std::shared_ptr<arrow::Table> table,
-                           const bool merge_chunks)
-    : CollectionBuilder<RecordBatch>(client), merge_chunks_(merge_chunks) {
+                           const bool merge_chunks, const bool preserve_chunks)
+    : CollectionBuilder<RecordBatch>(client),
+      merge_chunks_(merge_chunks),
+      preserve_chunks_(preserve_chunks) {
   this->tables_.emplace_back(table);
 }
 
 TableBuilder::TableBuilder(
     Client& client, const std::vector<std::shared_ptr<arrow::Table>>& tables,
-    const bool merge_chunks)
-    : CollectionBuilder<RecordBatch>(client), merge_chunks_(merge_chunks) {
+    const bool merge_chunks, const bool preserve_chunks)
+    : CollectionBuilder<RecordBatch>(client),
+      merge_chunks_(merge_chunks),
+      preserve_chunks_(preserve_chunks) {
   VINEYARD_ASSERT(tables.size() > 0, "at least one batch is required");
   this->tables_ = std::move(tables);
 }
 
 Status TableBuilder::Build(Client& client) {
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  std::vector<std::shared_ptr<RecordBatchBuilder>> builders;
   int64_t num_rows = 0;
+  auto schema = tables_[0]->schema();
   for (auto const& table : tables_) {
     num_rows += table->num_rows();
     std::vector<std::shared_ptr<arrow::RecordBatch>> chunks;
-    RETURN_ON_ERROR(TableToRecordBatches(table, &chunks));
-    batches.insert(batches.end(), chunks.begin(), chunks.end());
+    if (preserve_chunks_ && !merge_chunks_ && !IsChunkAligned(table)) {
+      // keeps the chunks of columns as they are, see also `ChunkedArray`
+      builders.emplace_back(
+          std::make_shared<RecordBatchBuilder>(client, table));
+    } else {
+      RETURN_ON_ERROR(TableToRecordBatches(table, &chunks));
+    }
+    if (merge_chunks_) {
+      batches.insert(batches.end(), chunks.begin(), chunks.end());
+    } else {
+      for (auto const& chunk : chunks) {
+        builders.emplace_back(
+            std::make_shared<RecordBatchBuilder>(client, chunk));
+      }
+    }
   }
   tables_.clear();  // release the reference
 
   this->set_num_rows_(num_rows);
-  this->set_num_columns_(batches[0]->num_columns());
-  RETURN_ON_ERROR(this->set_schema(batches[0]->schema()));
+  this->set_num_columns_(schema->num_fields());
+  RETURN_ON_ERROR(this->set_schema(schema));
 
   if (merge_chunks_) {
+    // concatenates the columns in parallel, see also `RecordBatchBuilder`
     this->set_batch_num_(1);
     RETURN_ON_ERROR(
         this->AddMember(std::make_shared<RecordBatchBuilder>(client, batches)));
     batches.clear();  // release the reference
   } else {
-    this->set_batch_num_(batches.size());
-    for (auto const& batch : batches) {
-      RETURN_ON_ERROR(
-          this->AddMember(std::make_shared<RecordBatchBuilder>(client, batch)));
+    this->set_batch_num_(builders.size());
+    for (auto const& builder : builders) {
+      RETURN_ON_ERROR(this->AddMember(builder));
     }
-    batches.clear();  // release the reference
+    builders.clear();  // release the reference
   }
   return Status::OK();
 }
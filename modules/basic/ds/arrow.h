@@ -338,6 +338,27 @@ class FixedSizeListArrayBuilder : public FixedSizeListArrayBaseBuilder {
   std::vector<std::shared_ptr<arrow::Array>> arrays_;
 };
 
+/**
+ * @brief ChunkedArrayBuilder is designed for constructing chunked arrays,
+ * where every chunk is built as an array on its own, and the buffers that
+ * are vineyard blobs already are reused rather than being copied.
+ *
+ * The chunks are concatenated only if `concatenate` is set.
+ *
+ */
+class ChunkedArrayBuilder : public ChunkedArrayBaseBuilder {
+ public:
+  ChunkedArrayBuilder(Client& client,
+                      const std::shared_ptr<arrow::ChunkedArray> array,
+                      const bool concatenate = false);
+
+  Status Build(Client& client) override;
+
+ private:
+  std::shared_ptr<arrow::ChunkedArray> array_;
+  bool concatenate_ = false;
+};
+
 #undef BUILD_NULL_BITMAP
 
 /**
@@ -370,10 +391,17 @@ class RecordBatchBuilder : public RecordBatchBaseBuilder {
       Client& client,
       const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches);
 
+  /**
+   * NOTE: the columns of `table` are built as `ChunkedArray`, thus the
+   * chunks of columns are not required to be aligned.
+   */
+  RecordBatchBuilder(Client& client, const std::shared_ptr<arrow::Table> table);
+
   Status Build(Client& client) override;
 
  private:
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+  std::shared_ptr<arrow::Table> table_;
 };
 
 /**
@@ -429,12 +457,21 @@ class RecordBatchConsolidator : public RecordBatchBaseBuilder {
  */
 class TableBuilder : public CollectionBuilder<RecordBatch> {
  public:
+  /**
+   * @param merge_chunks Concatenates the chunks of every column into a
+   * single record batch.
+   * @param preserve_chunks Keeps a table whose columns are not chunked in the
+   * same way as a single record batch of `ChunkedArray` columns, rather than
+   * slicing the chunks into multiple record batches.
+   */
   TableBuilder(Client& client, const std::shared_ptr<arrow::Table> table,
-               const bool merge_chunks = false);
+               const bool merge_chunks = false,
+               const bool preserve_chunks = false);
 
   TableBuilder(Client& client,
                const std::vector<std::shared_ptr<arrow::Table>>& table,
-               const bool merge_chunks = false);
+               const bool merge_chunks = false,
+               const bool preserve_chunks = false);
 
   Status Build(Client& client) override;
 
@@ -459,6 +496,7 @@ class TableBuilder : public CollectionBuilder<RecordBatch> {
  private:
   std::vector<std::shared_ptr<arrow::Table>> tables_;
   bool merge_chunks_ = false;
+  bool preserve_chunks_ = false;
 };
 
 /**
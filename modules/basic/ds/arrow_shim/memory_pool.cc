@@ -15,8 +15,10 @@ limitations under the License.
 
 #include "basic/ds/arrow_shim/memory_pool.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -27,14 +29,41 @@ namespace vineyard {
 
 namespace memory {
 
+namespace detail {
+
+// the zero-size allocations, as what arrow's builtin pools do
+alignas(64) static uint8_t zero_size_area[1] = {0};
+
+// the live pools, for recognizing the buffers allocated by producers
+static std::mutex& pools_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+static std::set<VineyardMemoryPool*>& pools() {
+  static std::set<VineyardMemoryPool*> pools;
+  return pools;
+}
+
+}  // namespace detail
+
 VineyardMemoryPool::VineyardMemoryPool(Client& client) : client_(client) {
   bytes_allocated_.store(0);
+  max_memory_.store(0);
+  total_bytes_allocated_.store(0);
+  num_allocations_.store(0);
+  std::lock_guard<std::mutex> lock(detail::pools_mutex());
+  detail::pools().emplace(this);
 }
 
 VineyardMemoryPool::~VineyardMemoryPool() {
+  {
+    std::lock_guard<std::mutex> lock(detail::pools_mutex());
+    detail::pools().erase(this);
+  }
   std::lock_guard<std::mutex> lock(mutex_);
   for (auto& it : buffers_) {
-    VINEYARD_DISCARD(it.second->Abort(client_));
+    VINEYARD_DISCARD(it.second.blob->Abort(client_));
   }
 }
 
@@ -49,32 +78,51 @@ arrow::Status VineyardMemoryPool::Allocate(int64_t size, uint8_t** out) {
     *out = reinterpret_cast<uint8_t*>(sbuffer->Buffer()->mutable_data());
     {
       std::lock_guard<std::mutex> lock(mutex_);
-      bytes_allocated_.fetch_add(size);
-      buffers_.emplace(reinterpret_cast<uintptr_t>(*out), std::move(sbuffer));
+      int64_t allocated = bytes_allocated_.fetch_add(size) + size;
+      buffers_.emplace(reinterpret_cast<uintptr_t>(*out),
+                       Allocation{size, std::move(sbuffer)});
+      max_memory_.store(std::max(max_memory_.load(), allocated));
     }
+    total_bytes_allocated_.fetch_add(size);
+    num_allocations_.fetch_add(1);
     return arrow::Status::OK();
   } else {
-    *out = nullptr;
+    *out = detail::zero_size_area;
     return arrow::Status::OK();
   }
 }
 
 arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
                                              uint8_t** ptr) {
+  if (old_size == 0 || *ptr == nullptr || *ptr == detail::zero_size_area) {
+    return this->Allocate(new_size, ptr);
+  }
+  if (new_size == 0) {
+    this->Free(*ptr, old_size);
+    *ptr = detail::zero_size_area;
+    return arrow::Status::OK();
+  }
   if (old_size >= new_size) {
+    // the blob won't be shrunk, but the size arrow knows does
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(reinterpret_cast<uintptr_t>(*ptr));
+    if (it != buffers_.end()) {
+      bytes_allocated_.fetch_sub(it->second.size - new_size);
+      it->second.size = new_size;
+    }
     return arrow::Status::OK();
   }
-  std::unique_ptr<BlobWriter> sbuffer;
+  Allocation allocation{0, nullptr};
   {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = buffers_.find(reinterpret_cast<uintptr_t>(*ptr));
     if (it != buffers_.end()) {
-      sbuffer = std::move(it->second);
-      bytes_allocated_.fetch_sub(old_size);
+      allocation = std::move(it->second);
+      bytes_allocated_.fetch_sub(allocation.size);
       buffers_.erase(it);
     }
   }
-  if (sbuffer == nullptr) {
+  if (allocation.blob == nullptr) {
     return arrow::Status(arrow::StatusCode::OutOfMemory,
                          "Reallocate from an unknown buffer");
   }
@@ -84,23 +132,27 @@ arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
     {
       // fill the old buffer back
       std::lock_guard<std::mutex> lock(mutex_);
-      bytes_allocated_.fetch_add(old_size);
-      *ptr = reinterpret_cast<uint8_t*>(sbuffer->Buffer()->mutable_data());
-      buffers_.emplace(reinterpret_cast<uintptr_t>(*ptr), std::move(sbuffer));
+      bytes_allocated_.fetch_add(allocation.size);
+      buffers_.emplace(reinterpret_cast<uintptr_t>(*ptr),
+                       std::move(allocation));
     }
     return arrow::Status(arrow::StatusCode::OutOfMemory, status.ToString());
   }
 
   // copy to the new one
   *ptr = reinterpret_cast<uint8_t*>(nsbuffer->Buffer()->mutable_data());
-  inline_memcpy(*ptr, sbuffer->Buffer()->data(), sbuffer->Buffer()->size());
+  concurrent_memcpy(*ptr, allocation.blob->Buffer()->data(), allocation.size);
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    bytes_allocated_.fetch_add(new_size);
-    buffers_.emplace(reinterpret_cast<uintptr_t>(*ptr), std::move(nsbuffer));
+    int64_t allocated = bytes_allocated_.fetch_add(new_size) + new_size;
+    buffers_.emplace(reinterpret_cast<uintptr_t>(*ptr),
+                     Allocation{new_size, std::move(nsbuffer)});
+    max_memory_.store(std::max(max_memory_.load(), allocated));
   }
+  total_bytes_allocated_.fetch_add(new_size - allocation.size);
+  num_allocations_.fetch_add(1);
   // remove the original buffer
-  VINEYARD_CHECK_OK(sbuffer->Abort(client_));
+  VINEYARD_CHECK_OK(allocation.blob->Abort(client_));
   return arrow::Status::OK();
 }
 
@@ -110,8 +162,8 @@ void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer));
     if (it != buffers_.end()) {
-      sbuffer = std::move(it->second);
-      bytes_allocated_.fetch_sub(size);
+      sbuffer = std::move(it->second.blob);
+      bytes_allocated_.fetch_sub(it->second.size);
       buffers_.erase(it);
     }
   }
@@ -139,24 +191,90 @@ void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size,
 
 Status VineyardMemoryPool::Take(const uint8_t* buffer,
                                 std::unique_ptr<BlobWriter>& sbuffer) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer));
-    if (it != buffers_.end()) {
-      sbuffer = std::move(it->second);
-      bytes_allocated_.fetch_sub(sbuffer->size());
-      buffers_.erase(it);
+  return take(buffer, -1, sbuffer);
+}
+
+Status VineyardMemoryPool::Take(const std::shared_ptr<arrow::Buffer>& buffer,
+                                std::unique_ptr<BlobWriter>& sbuffer) {
+  return Take(buffer->data(), sbuffer);
+}
+
+bool VineyardMemoryPool::IsAllocated(
+    Client& client, const std::shared_ptr<arrow::Buffer>& buffer) {
+  std::lock_guard<std::mutex> lock(detail::pools_mutex());
+  for (auto pool : detail::pools()) {
+    if (&pool->client_ == &client && pool->isAllocated(buffer)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool VineyardMemoryPool::IsInAllocated(Client& client,
+                                       const uint8_t* pointer) {
+  std::lock_guard<std::mutex> lock(detail::pools_mutex());
+  for (auto pool : detail::pools()) {
+    if (&pool->client_ == &client && pool->isInAllocated(pointer)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Status VineyardMemoryPool::TakeAllocated(
+    Client& client, const std::shared_ptr<arrow::Buffer>& buffer,
+    std::unique_ptr<BlobWriter>& sbuffer) {
+  std::lock_guard<std::mutex> lock(detail::pools_mutex());
+  for (auto pool : detail::pools()) {
+    if (&pool->client_ == &client &&
+        pool->take(buffer->data(), buffer->capacity(), sbuffer).ok()) {
       return Status::OK();
     }
   }
   return Status::ObjectNotExists(
       "cannot find the blob for pointer " +
-      std::to_string(reinterpret_cast<uintptr_t>(buffer)));
+      std::to_string(reinterpret_cast<uintptr_t>(buffer->data())));
 }
 
-Status VineyardMemoryPool::Take(const std::shared_ptr<arrow::Buffer>& buffer,
+bool VineyardMemoryPool::isAllocated(
+    const std::shared_ptr<arrow::Buffer>& buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer->data()));
+  return it != buffers_.end() && it->second.size == buffer->capacity() &&
+         buffer->size() <= buffer->capacity();
+}
+
+bool VineyardMemoryPool::isInAllocated(const uint8_t* pointer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.upper_bound(reinterpret_cast<uintptr_t>(pointer));
+  if (it == buffers_.begin()) {
+    return false;
+  }
+  --it;
+  return reinterpret_cast<uintptr_t>(pointer) <
+         it->first + it->second.blob->size();
+}
+
+// takes the blob, and checks the size of the allocation if `size` is not -1
+Status VineyardMemoryPool::take(const uint8_t* buffer, const int64_t size,
                                 std::unique_ptr<BlobWriter>& sbuffer) {
-  return Take(buffer->data(), sbuffer);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer));
+  if (it == buffers_.end()) {
+    return Status::ObjectNotExists(
+        "cannot find the blob for pointer " +
+        std::to_string(reinterpret_cast<uintptr_t>(buffer)));
+  }
+  if (size != -1 && it->second.size != size) {
+    return Status::Invalid(
+        "the buffer is a slice of the allocated blob of size " +
+        std::to_string(it->second.size) + ", got size " +
+        std::to_string(size));
+  }
+  sbuffer = std::move(it->second.blob);
+  bytes_allocated_.fetch_sub(it->second.size);
+  buffers_.erase(it);
+  return Status::OK();
 }
 
 /// The number of bytes that were allocated and not yet free'd through
@@ -169,7 +287,17 @@ int64_t VineyardMemoryPool::bytes_allocated() const {
 ///
 /// \return Maximum bytes allocated. If not known (or not implemented),
 /// returns -1
-int64_t VineyardMemoryPool::max_memory() const { return -1; }
+int64_t VineyardMemoryPool::max_memory() const { return max_memory_.load(); }
+
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 13000000
+int64_t VineyardMemoryPool::total_bytes_allocated() const {
+  return total_bytes_allocated_.load();
+}
+
+int64_t VineyardMemoryPool::num_allocations() const {
+  return num_allocations_.load();
+}
+#endif
 
 std::string VineyardMemoryPool::backend_name() const { return "vineyard"; }
 
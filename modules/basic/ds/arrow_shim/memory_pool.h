@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MODULES_BASIC_DS_ARROW_SHIM_MEMORY_POOL_H_
 #define MODULES_BASIC_DS_ARROW_SHIM_MEMORY_POOL_H_
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -30,6 +31,17 @@ namespace vineyard {
 
 namespace memory {
 
+/**
+ * @brief VineyardMemoryPool allocates arrow buffers as unsealed vineyard
+ * blobs.
+ *
+ * Producers could hand the pool to arrow (e.g., the CSV and Parquet readers,
+ * and the compute kernels), then the array builders (see also
+ * `NumericArrayBuilder` and `TableBuilder`) seal the blobs in place rather
+ * than copying the buffers into vineyard. The pool must outlive the buffers
+ * it allocates, and the blobs that haven't been taken will be aborted when
+ * the pool is destroyed.
+ */
 class VineyardMemoryPool : public arrow::MemoryPool {
  public:
   explicit VineyardMemoryPool(Client& client);
@@ -65,6 +77,29 @@ class VineyardMemoryPool : public arrow::MemoryPool {
   Status Take(const std::shared_ptr<arrow::Buffer>& buffer,
               std::unique_ptr<BlobWriter>& sbuffer);
 
+  /**
+   * @brief Whether the buffer is allocated by a live VineyardMemoryPool of
+   * the client, hasn't been taken yet, and spans the whole allocation (i.e.,
+   * it is not a slice of the allocated buffer).
+   */
+  static bool IsAllocated(Client& client,
+                          const std::shared_ptr<arrow::Buffer>& buffer);
+
+  /**
+   * @brief Whether the pointer falls in a blob allocated by a live
+   * VineyardMemoryPool of the client that hasn't been taken yet.
+   */
+  static bool IsInAllocated(Client& client, const uint8_t* pointer);
+
+  /**
+   * @brief Take the unsealed blob of the buffer from the live
+   * VineyardMemoryPool of the client that allocates it, see also
+   * `IsAllocated()`.
+   */
+  static Status TakeAllocated(Client& client,
+                              const std::shared_ptr<arrow::Buffer>& buffer,
+                              std::unique_ptr<BlobWriter>& sbuffer);
+
   /// The number of bytes that were allocated and not yet free'd through
   /// this allocator.
   int64_t bytes_allocated() const override;
@@ -75,13 +110,33 @@ class VineyardMemoryPool : public arrow::MemoryPool {
   /// returns -1
   int64_t max_memory() const override;
 
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 13000000
+  int64_t total_bytes_allocated() const override;
+
+  int64_t num_allocations() const override;
+#endif
+
   std::string backend_name() const override;
 
  private:
   Client& client_;
   std::atomic_size_t bytes_allocated_;
+  std::atomic<int64_t> max_memory_, total_bytes_allocated_, num_allocations_;
   std::mutex mutex_;
-  std::map<uintptr_t, std::unique_ptr<BlobWriter>> buffers_;
+
+  // the blob may be larger than the size arrow knows, after shrinking
+  struct Allocation {
+    int64_t size;
+    std::unique_ptr<BlobWriter> blob;
+  };
+  std::map<uintptr_t, Allocation> buffers_;
+
+  bool isAllocated(const std::shared_ptr<arrow::Buffer>& buffer);
+
+  bool isInAllocated(const uint8_t* pointer);
+
+  Status take(const uint8_t* buffer, const int64_t size,
+              std::unique_ptr<BlobWriter>& sbuffer);
 };
 
 }  // namespace memory
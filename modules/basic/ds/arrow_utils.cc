@@ -405,6 +405,22 @@ Status CombineRecordBatches(
   return Status::OK();
 }
 
+bool IsChunkAligned(const std::shared_ptr<arrow::Table>& table) {
+  for (int i = 1; i < table->num_columns(); ++i) {
+    auto const& lhs = table->column(0);
+    auto const& rhs = table->column(i);
+    if (lhs->num_chunks() != rhs->num_chunks()) {
+      return false;
+    }
+    for (int j = 0; j < lhs->num_chunks(); ++j) {
+      if (lhs->chunk(j)->length() != rhs->chunk(j)->length()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 Status TableToRecordBatches(
     const std::shared_ptr<arrow::Table> table,
     std::vector<std::shared_ptr<arrow::RecordBatch>>* batches) {
@@ -421,6 +437,18 @@ Status TableToRecordBatches(
     batches->push_back(batch);
     return Status::OK();
   }
+  if (!IsChunkAligned(fixed_table)) {
+    batches->clear();
+    arrow::TableBatchReader reader(*fixed_table);
+    std::shared_ptr<arrow::RecordBatch> batch;
+    do {
+      RETURN_ON_ARROW_ERROR(reader.ReadNext(&batch));
+      if (batch != nullptr) {
+        batches->push_back(batch);
+      }
+    } while (batch != nullptr);
+    return Status::OK();
+  }
 
   // chunks[row_index][column_index]
   std::vector<std::vector<std::shared_ptr<arrow::Array>>> chunks;
@@ -221,6 +221,16 @@ Status CombineRecordBatches(
     const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
     std::shared_ptr<arrow::RecordBatch>* batch);
 
+/**
+ * Whether the columns of the table are chunked in the same way, i.e., the
+ * table can be split into record batches without slicing the chunks.
+ */
+bool IsChunkAligned(const std::shared_ptr<arrow::Table>& table);
+
+/**
+ * Splits the table into record batches by the chunks, the chunks are sliced
+ * (without copying) if the columns are not chunked in the same way.
+ */
 Status TableToRecordBatches(
     const std::shared_ptr<arrow::Table> table,
     std::vector<std::shared_ptr<arrow::RecordBatch>>* batches);
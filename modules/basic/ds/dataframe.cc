@@ -165,10 +165,19 @@ void DataFrameBuilder::DropColumn(json const& column) {
 
 Status DataFrameBuilder::Build(Client& client) {
   this->set_columns_(columns_);
+  std::vector<json> keys;
+  std::vector<std::shared_ptr<ObjectBuilder>> builders;
   for (auto const& kv : values_) {
-    this->set_values_(
-        kv.first,
-        std::dynamic_pointer_cast<ObjectBuilder>(kv.second)->Seal(client));
+    keys.emplace_back(kv.first);
+    builders.emplace_back(std::dynamic_pointer_cast<ObjectBuilder>(kv.second));
+  }
+  // build the columns in parallel, and create the metadata of columns with a
+  // single request
+  std::vector<std::shared_ptr<Object>> values;
+  RETURN_ON_ERROR(ObjectBuilder::_SealBatch(client, builders, values, 0));
+  for (size_t idx = 0; idx < values.size(); ++idx) {
+    RETURN_ON_ERROR(client.PostSeal(values[idx]->meta()));
+    this->set_values_(keys[idx], values[idx]);
   }
   return Status::OK();
 }
@@ -17,10 +17,15 @@ limitations under the License.
 #define MODULES_BASIC_DS_HASHMAP_H_
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "flat_hash_map/flat_hash_map.hpp"
 #include "wyhash/wyhash.hpp"
@@ -30,6 +35,7 @@ limitations under the License.
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
 #include "common/util/arrow.h"
+#include "common/util/parallel.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
@@ -217,6 +223,327 @@ class HashmapBuilder : public HashmapBaseBuilder<K, V, H, E> {
   std::shared_ptr<Blob> data_buffer_;
 };
 
+namespace detail {
+
+/**
+ * The smallest prime that is not less than `n`, the sealed `Hashmap` uses
+ * "hash % prime" to locate the home slot.
+ */
+inline size_t hashmap_next_prime(size_t n) {
+  auto is_prime = [](size_t v) -> bool {
+    if (v < 2) {
+      return false;
+    }
+    for (size_t d = 2; d * d <= v; ++d) {
+      if (v % d == 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+  while (!is_prime(n)) {
+    ++n;
+  }
+  return n;
+}
+
+/**
+ * Entries of the hashmap hold a union, so they are moved as raw bytes (the
+ * key and value types are required to be trivially copyable anyway).
+ */
+template <typename Entry>
+inline void hashmap_swap_entries(Entry* lhs, Entry* rhs) {
+  typename std::aligned_storage<sizeof(Entry), alignof(Entry)>::type tmp;
+  memcpy(&tmp, static_cast<void*>(lhs), sizeof(Entry));
+  memcpy(static_cast<void*>(lhs), static_cast<void*>(rhs), sizeof(Entry));
+  memcpy(static_cast<void*>(rhs), &tmp, sizeof(Entry));
+}
+
+/**
+ * In-place MSD radix sort (American flag sort) of entries by their home slot,
+ * the home slots are recomputed rather than stored, as there is no room for
+ * them in the entries.
+ */
+template <typename Entry, typename HomeFn>
+inline void hashmap_sort_by_home(Entry* begin, Entry* end, const int shift,
+                                 const HomeFn& home) {
+  constexpr int kRadixBits = 8;
+  constexpr size_t kRadix = 1 << kRadixBits;
+  constexpr ptrdiff_t kInsertionSortThreshold = 32;
+
+  if (end - begin <= kInsertionSortThreshold || shift < 0) {
+    for (Entry* it = begin + 1; it < end; ++it) {
+      size_t h = home(*it);
+      for (Entry* jt = it; jt > begin && home(*(jt - 1)) > h; --jt) {
+        hashmap_swap_entries(jt, jt - 1);
+      }
+    }
+    return;
+  }
+
+  auto digit = [&](const Entry& entry) -> size_t {
+    return (home(entry) >> shift) & (kRadix - 1);
+  };
+  size_t counts[kRadix] = {0}, heads[kRadix], tails[kRadix];
+  for (Entry* it = begin; it < end; ++it) {
+    counts[digit(*it)] += 1;
+  }
+  size_t offset = 0;
+  for (size_t d = 0; d < kRadix; ++d) {
+    heads[d] = offset;
+    offset += counts[d];
+    tails[d] = offset;
+  }
+  size_t starts[kRadix];
+  std::copy(heads, heads + kRadix, starts);
+  for (size_t d = 0; d < kRadix; ++d) {
+    while (heads[d] < tails[d]) {
+      size_t target = digit(begin[heads[d]]);
+      if (target == d) {
+        heads[d] += 1;
+      } else {
+        hashmap_swap_entries(begin + heads[d], begin + heads[target]);
+        heads[target] += 1;
+      }
+    }
+  }
+  for (size_t d = 0; d < kRadix; ++d) {
+    hashmap_sort_by_home(begin + starts[d], begin + tails[d],
+                         shift - kRadixBits, home);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief ConcurrentHashmapBuilder builds a hashmap directly in the vineyard
+ * blob that backs the sealed `Hashmap`.
+ *
+ * The table is sized up front from the capacity (an upper bound of the number
+ * of elements), and `emplace()` can be called from multiple threads
+ * concurrently. Unlike `HashmapBuilder`, no private heap hashmap is filled
+ * and then copied into the blob, so the peak memory is a single table and
+ * there is no rehash and copy pass when building.
+ *
+ * Elements are appended to the blob when inserted, and are arranged into the
+ * robin-hood layout expected by `Hashmap` (i.e., ordered by the home slot)
+ * with an in-place parallel radix sort when building. If some keys are
+ * inserted more than once, an arbitrary one of the values is kept.
+ *
+ * @tparam K The type for the key.
+ * @tparam V The type for the value.
+ * @tparam std::hash<K> The hash function for the key.
+ * @tparam std::equal_to<K> The compare function for the key.
+ */
+template <typename K, typename V, typename H = prime_number_hash_wy<K>,
+          typename E = std::equal_to<K>>
+class ConcurrentHashmapBuilder : public HashmapBaseBuilder<K, V, H, E> {
+ public:
+  using entry_t = typename Hashmap<K, V, H, E>::Entry;
+
+  // the distance from the desired slot is stored in an int8_t.
+  static constexpr int8_t kMaxLookups = 127;
+
+  /**
+   * @param capacity The maximum number of elements to insert.
+   * @param concurrency The number of threads used when building, 0 means
+   *        the number of hardware threads.
+   */
+  ConcurrentHashmapBuilder(Client& client, const size_t capacity,
+                           const size_t concurrency = 0,
+                           const float max_load_factor = 0.5f)
+      : HashmapBaseBuilder<K, V, H, E>(client),
+        capacity_(capacity),
+        concurrency_(concurrency),
+        cursor_(0) {
+    if (concurrency_ == 0) {
+      concurrency_ = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    num_slots_ = static_cast<size_t>(
+        std::ceil(std::max(capacity, static_cast<size_t>(1)) /
+                  static_cast<double>(max_load_factor)));
+    num_slots_ = detail::hashmap_next_prime(num_slots_);
+    entries_builder_ = std::make_shared<ArrayBuilder<entry_t>>(
+        client, num_slots_ + kMaxLookups);
+  }
+
+  /**
+   * @brief Insert a key-value pair, thread-safe.
+   *
+   * Returns an error when the capacity is exhausted.
+   */
+  Status emplace(const K& key, const V& value) {
+    size_t slot = cursor_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= capacity_) {
+      return Status::Invalid(
+          "The capacity of the concurrent hashmap builder is exhausted: " +
+          std::to_string(capacity_));
+    }
+    entries_builder_->data()[slot].emplace(0, key, value);
+    return Status::OK();
+  }
+
+  /**
+   * @brief The number of inserted elements, including duplicated keys.
+   */
+  size_t size() const {
+    return std::min(cursor_.load(std::memory_order_relaxed), capacity_);
+  }
+
+  size_t bucket_count() const { return num_slots_; }
+
+  /**
+   * @brief Associated with a given data buffer
+   */
+  void AssociateDataBuffer(std::shared_ptr<Blob> data_buffer) {
+    this->data_buffer_ = data_buffer;
+  }
+
+  /**
+   * @brief Build the hashmap object, must not race with `emplace()`.
+   */
+  Status Build(Client& client) override {
+    entry_t* entries = entries_builder_->data();
+    const size_t total = num_slots_ + kMaxLookups;
+    const size_t staged = size();
+    H hasher;
+    const size_t num_slots = num_slots_;
+    auto home = [&hasher, num_slots](const entry_t& entry) -> size_t {
+      return hasher(entry.value.first) % num_slots;
+    };
+
+    // 1. mark the slots after the staged elements as empty
+    const size_t chunk = 1024 * 1024;
+    RETURN_ON_ERROR(parallel_for_status(
+        (total - staged + chunk - 1) / chunk, concurrency_,
+        [&](size_t i) -> Status {
+          size_t end = std::min(total, staged + (i + 1) * chunk);
+          for (size_t k = staged + i * chunk; k < end; ++k) {
+            entries[k].distance_from_desired = -1;
+          }
+          return Status::OK();
+        }));
+
+    // 2. sort the staged elements by their home slots: partition by the top
+    // digit first, and sort the partitions in parallel
+    int bits = 0;
+    while ((static_cast<size_t>(1) << bits) < num_slots) {
+      ++bits;
+    }
+    int top_shift = std::max(bits - 8, 0);
+    {
+      const size_t kRadix = 256;
+      std::vector<size_t> counts(kRadix + 1, 0);
+      auto digit = [&](const entry_t& entry) -> size_t {
+        return (home(entry) >> top_shift) & (kRadix - 1);
+      };
+      for (size_t i = 0; i < staged; ++i) {
+        counts[digit(entries[i]) + 1] += 1;
+      }
+      for (size_t d = 0; d < kRadix; ++d) {
+        counts[d + 1] += counts[d];
+      }
+      std::vector<size_t> heads(counts.begin(), counts.end() - 1);
+      for (size_t d = 0; d < kRadix; ++d) {
+        while (heads[d] < counts[d + 1]) {
+          size_t target = digit(entries[heads[d]]);
+          if (target == d) {
+            heads[d] += 1;
+          } else {
+            detail::hashmap_swap_entries(entries + heads[d],
+                                         entries + heads[target]);
+            heads[target] += 1;
+          }
+        }
+      }
+      RETURN_ON_ERROR(
+          parallel_for_status(kRadix, concurrency_, [&](size_t d) -> Status {
+            detail::hashmap_sort_by_home(entries + counts[d],
+                                         entries + counts[d + 1],
+                                         top_shift - 8, home);
+            return Status::OK();
+          }));
+    }
+
+    // 3. drop duplicated keys and compute the final positions, the distance
+    // to the home slot is kept in the entry
+    E equal;
+    size_t kept = 0, group_begin = 0, group_home = 0;
+    int64_t last_position = -1;
+    for (size_t i = 0; i < staged; ++i) {
+      size_t h = home(entries[i]);
+      if (kept == 0 || h != group_home) {
+        group_begin = kept;
+        group_home = h;
+      }
+      bool duplicated = false;
+      for (size_t j = group_begin; j < kept; ++j) {
+        if (equal(entries[j].value.first, entries[i].value.first)) {
+          duplicated = true;
+          break;
+        }
+      }
+      if (duplicated) {
+        continue;
+      }
+      int64_t position =
+          std::max(static_cast<int64_t>(h), last_position + 1);
+      if (position - static_cast<int64_t>(h) >= kMaxLookups - 1 ||
+          position >= static_cast<int64_t>(total) - 1) {
+        return Status::Invalid(
+            "Too many collisions in the concurrent hashmap builder, try a "
+            "lower load factor");
+      }
+      if (kept != i) {
+        memcpy(static_cast<void*>(entries + kept), entries + i,
+               sizeof(entry_t));
+      }
+      entries[kept].distance_from_desired =
+          static_cast<int8_t>(position - static_cast<int64_t>(h));
+      last_position = position;
+      kept += 1;
+    }
+    for (size_t i = kept; i < staged; ++i) {
+      entries[i].distance_from_desired = -1;
+    }
+
+    // 4. move the elements to their final positions, backwards, as the final
+    // position of each element is not less than its current index
+    for (size_t i = kept; i-- > 0;) {
+      size_t position = home(entries[i]) + entries[i].distance_from_desired;
+      if (position != i) {
+        memcpy(static_cast<void*>(entries + position), entries + i,
+               sizeof(entry_t));
+        entries[i].distance_from_desired = -1;
+      }
+    }
+    entries[total - 1].distance_from_desired = entry_t::special_end_value;
+
+    this->set_num_slots_minus_one_(num_slots_ - 1);
+    this->set_max_lookups_(kMaxLookups);
+    this->set_num_elements_(kept);
+    this->set_entries_(std::static_pointer_cast<ObjectBase>(entries_builder_));
+
+    if (this->data_buffer_ != nullptr) {
+      this->set_data_buffer_(
+          reinterpret_cast<uintptr_t>(this->data_buffer_->data()));
+      this->set_data_buffer_mapped_(this->data_buffer_);
+    } else {
+      this->set_data_buffer_(reinterpret_cast<uintptr_t>(nullptr));
+      this->set_data_buffer_mapped_(Blob::MakeEmpty(client));
+    }
+    return Status::OK();
+  }
+
+ private:
+  size_t capacity_;
+  size_t concurrency_;
+  size_t num_slots_;
+  std::atomic<size_t> cursor_;
+  std::shared_ptr<ArrayBuilder<entry_t>> entries_builder_;
+  std::shared_ptr<Blob> data_buffer_;
+};
+
 }  // namespace vineyard
 
 #endif  // MODULES_BASIC_DS_HASHMAP_H_
@@ -0,0 +1,177 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_BASIC_DS_SWISS_HASHMAP_H_
+#define MODULES_BASIC_DS_SWISS_HASHMAP_H_
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "wyhash/wyhash.hpp"
+
+#include "basic/ds/array.h"
+#include "basic/ds/swiss_hashmap.vineyard.h"
+#include "client/ds/blob.h"
+#include "client/ds/i_object.h"
+#include "common/util/arrow.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * @brief SwissHashmapBuilder is used for constructing the immutable
+ * SwissHashmap.
+ *
+ * Key-value pairs are staged by `emplace()` and inserted into the slots in
+ * vineyard's shared memory in `Build()`. Like `std::unordered_map::emplace()`,
+ * the first inserted value is kept when the key is duplicated.
+ *
+ * @tparam K The type for the key.
+ * @tparam V The type for the value.
+ * @tparam H The hash function for the key.
+ * @tparam E The compare function for the key.
+ */
+template <typename K, typename V, typename H = wy::hash<K>,
+          typename E = std::equal_to<K>>
+class SwissHashmapBuilder : public SwissHashmapBaseBuilder<K, V, H, E> {
+  using slot_t = typename SwissHashmap<K, V, H, E>::value_type;
+
+ public:
+  // the maximum load factor is 7/8
+  static constexpr size_t kMaxLoadNumerator = 7;
+  static constexpr size_t kMaxLoadDenominator = 8;
+
+  explicit SwissHashmapBuilder(Client& client)
+      : SwissHashmapBaseBuilder<K, V, H, E>(client) {}
+
+  /**
+   * @brief Emplace key-value pair into the hashmap.
+   *
+   */
+  template <typename Key, typename Value>
+  inline void emplace(Key&& key, Value&& value) {
+    slot_t slot;
+    slot.first = std::forward<Key>(key);
+    slot.second = std::forward<Value>(value);
+    staged_.emplace_back(slot);
+  }
+
+  /**
+   * @brief Reserve the size for the hashmap.
+   *
+   */
+  void reserve(size_t size) { staged_.reserve(size); }
+
+  /**
+   * @brief Get the number of staged key-value pairs, including the duplicated
+   * ones.
+   *
+   */
+  size_t size() const { return staged_.size(); }
+
+  /**
+   * @brief Associated with a given data buffer, see also
+   * `HashmapBuilder::AssociateDataBuffer()`.
+   */
+  void AssociateDataBuffer(std::shared_ptr<Blob> data_buffer) {
+    this->data_buffer_ = data_buffer;
+  }
+
+  /**
+   * @brief Build the hashmap object.
+   *
+   */
+  Status Build(Client& client) override {
+    size_t num_groups = 1;
+    // keep at least one empty slot to terminate the probing of missing keys
+    while (num_groups * swiss::kGroupWidth * kMaxLoadNumerator <
+           (staged_.size() + 1) * kMaxLoadDenominator) {
+      num_groups <<= 1;
+    }
+    const size_t capacity = num_groups * swiss::kGroupWidth;
+    auto ctrl_builder =
+        std::make_shared<ArrayBuilder<int8_t>>(client, capacity);
+    auto slots_builder =
+        std::make_shared<ArrayBuilder<slot_t>>(client, capacity);
+    int8_t* ctrl = ctrl_builder->data();
+    slot_t* slots = slots_builder->data();
+    memset(ctrl, swiss::kEmpty, capacity * sizeof(int8_t));
+    memset(static_cast<void*>(slots), 0, capacity * sizeof(slot_t));
+
+    H hasher;
+    E equal;
+    const size_t mask = num_groups - 1;
+    size_t num_elements = 0;
+    for (auto const& item : staged_) {
+      const uint64_t hash = hasher(item.first);
+      const int8_t tag = swiss::hash_tag(hash);
+      size_t group = swiss::hash_group(hash) & mask;
+      for (size_t probe = 1; probe <= num_groups; ++probe) {
+        int8_t* group_ctrl = ctrl + group * swiss::kGroupWidth;
+        bool duplicated = false;
+        uint32_t matches = swiss::match_byte(group_ctrl, tag);
+        while (matches != 0) {
+          size_t index =
+              group * swiss::kGroupWidth + swiss::lowest_bit_index(matches);
+          if (equal(item.first, slots[index].first)) {
+            duplicated = true;
+            break;
+          }
+          matches &= matches - 1;
+        }
+        if (duplicated) {
+          break;
+        }
+        uint32_t empties = swiss::match_byte(group_ctrl, swiss::kEmpty);
+        if (empties != 0) {
+          size_t offset = swiss::lowest_bit_index(empties);
+          group_ctrl[offset] = tag;
+          slots[group * swiss::kGroupWidth + offset] = item;
+          num_elements += 1;
+          break;
+        }
+        group = (group + probe) & mask;
+      }
+    }
+    // release the staging memory
+    std::vector<slot_t>().swap(staged_);
+
+    this->set_num_groups_(num_groups);
+    this->set_num_elements_(num_elements);
+    this->set_ctrl_(std::static_pointer_cast<ObjectBase>(ctrl_builder));
+    this->set_slots_(std::static_pointer_cast<ObjectBase>(slots_builder));
+
+    if (this->data_buffer_ != nullptr) {
+      this->set_data_buffer_(
+          reinterpret_cast<uintptr_t>(this->data_buffer_->data()));
+      this->set_data_buffer_mapped_(this->data_buffer_);
+    } else {
+      this->set_data_buffer_(reinterpret_cast<uintptr_t>(nullptr));
+      this->set_data_buffer_mapped_(Blob::MakeEmpty(client));
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::vector<slot_t> staged_;
+  std::shared_ptr<Blob> data_buffer_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_BASIC_DS_SWISS_HASHMAP_H_
@@ -85,23 +85,10 @@ Status DataframeStream::ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
                                   const bool copy) {
   RETURN_ON_ASSERT(client_ != nullptr && this->readonly_ == true,
                    "Expect a readonly stream");
-  std::shared_ptr<Object> result = nullptr;
-  RETURN_ON_ERROR(client_->ClientBase::PullNextStreamChunk(this->id_, result));
-
-  if (auto chunk = std::dynamic_pointer_cast<DataFrame>(result)) {
-    batch = chunk->AsBatch();
-  }
-  if (auto chunk = std::dynamic_pointer_cast<RecordBatch>(result)) {
-    batch = chunk->GetRecordBatch();
-  } else if (auto chunk = std::dynamic_pointer_cast<Blob>(result)) {
-    auto buffer = chunk->Buffer();
-    RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
-    batch = AddMetadataToRecordBatch(batch, params_);
-  } else {
-    return Status::Invalid("Failed to cast object with type '" +
-                           result->meta().GetTypeName() + "' to type '" +
-                           type_name<RecordBatch>() + "'");
+  if (batches_.empty()) {
+    RETURN_ON_ERROR(batches_.Fetch(client_, this->id_, params_, 1));
   }
+  batches_.Pop(batch);
   if (batch != nullptr && copy) {
     RETURN_ON_ERROR(detail::Copy(batch, batch, false));
   }
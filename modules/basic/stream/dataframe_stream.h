@@ -22,6 +22,7 @@ limitations under the License.
 #include <vector>
 
 #include "basic/ds/dataframe.h"
+#include "basic/stream/recordbatch_stream.h"
 #include "client/client.h"
 
 namespace vineyard {
@@ -48,6 +49,11 @@ class DataframeStream : public BareRegistered<DataframeStream>,
   Status ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch, const bool copy);
 
   Status GetHeaderLine(bool& header_row, std::string& header_line);
+
+ private:
+  detail::StreamBatchQueue batches_;
+
+  friend class RecordBatchStreamReader;
 };
 
 template <>
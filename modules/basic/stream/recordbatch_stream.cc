@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "basic/stream/recordbatch_stream.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -26,14 +28,151 @@ limitations under the License.
 #include "basic/ds/arrow.h"
 #include "basic/ds/arrow.vineyard.h"
 #include "basic/ds/arrow_utils.h"
+#include "basic/ds/dataframe.h"
+#include "basic/stream/dataframe_stream.h"
 #include "client/client.h"
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
+#include "client/ds/object_factory.h"
 #include "common/util/status.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
 
+namespace detail {
+
+static inline Status get_member_tree(json const& tree, std::string const& name,
+                                     json const*& member) {
+  auto iter = tree.find(name);
+  RETURN_ON_ASSERT(iter != tree.end() && iter->is_object(),
+                   "Failed to get member '" + name + "'");
+  member = &(*iter);
+  return Status::OK();
+}
+
+template <typename T>
+static inline Status get_value_from_tree(json const& tree,
+                                         std::string const& name, T& value) {
+  auto iter = tree.find(name);
+  RETURN_ON_ASSERT(iter != tree.end() && iter->is_number(),
+                   "Failed to get value '" + name + "'");
+  value = iter->get<T>();
+  return Status::OK();
+}
+
+/**
+ * Resolves the mapped buffer of a blob member without constructing the
+ * member's metadata and the `Blob` object.
+ */
+static Status get_buffer_from_tree(ObjectMeta const& meta, json const& tree,
+                                   std::string const& name, bool const nullable,
+                                   std::shared_ptr<arrow::Buffer>& buffer) {
+  json const* member = nullptr;
+  RETURN_ON_ERROR(get_member_tree(tree, name, member));
+  auto iter = member->find("id");
+  RETURN_ON_ASSERT(iter != member->end() && iter->is_string(),
+                   "Invalid blob member '" + name + "'");
+  ObjectID blob_id = ObjectIDFromString(iter->get_ref<std::string const&>());
+  if (blob_id == EmptyBlobID()) {
+    buffer = nullable ? nullptr : std::make_shared<arrow::Buffer>(nullptr, 0);
+    return Status::OK();
+  }
+  RETURN_ON_ERROR(meta.GetBuffer(blob_id, buffer));
+  if (buffer == nullptr) {
+    return Status::Invalid("The payload of blob '" + ObjectIDToString(blob_id) +
+                           "' is not locally available");
+  }
+  return Status::OK();
+}
+
+/**
+ * Assembles the array data from the metadata tree of a vineyard array,
+ * following the layouts of arrays in "basic/ds/arrow.vineyard-mod".
+ *
+ * Returns `NotImplemented` for unknown layouts, where the caller should fall
+ * back to constructing the vineyard objects.
+ */
+static Status decode_array_from_tree(
+    ObjectMeta const& meta, json const& tree,
+    std::shared_ptr<arrow::DataType> const& type,
+    std::shared_ptr<arrow::ArrayData>& data) {
+  int64_t length = 0, null_count = 0, offset = 0;
+  RETURN_ON_ERROR(get_value_from_tree(tree, "length_", length));
+  if (type->id() != arrow::Type::NA &&
+      type->id() != arrow::Type::FIXED_SIZE_LIST) {
+    RETURN_ON_ERROR(get_value_from_tree(tree, "null_count_", null_count));
+    RETURN_ON_ERROR(get_value_from_tree(tree, "offset_", offset));
+  }
+
+  std::shared_ptr<arrow::Buffer> null_bitmap, values, offsets;
+  switch (type->id()) {
+  case arrow::Type::NA: {
+    data = arrow::ArrayData::Make(type, length, {nullptr}, length);
+    return Status::OK();
+  }
+  case arrow::Type::BOOL:
+  case arrow::Type::INT8:
+  case arrow::Type::UINT8:
+  case arrow::Type::INT16:
+  case arrow::Type::UINT16:
+  case arrow::Type::INT32:
+  case arrow::Type::UINT32:
+  case arrow::Type::INT64:
+  case arrow::Type::UINT64:
+  case arrow::Type::FLOAT:
+  case arrow::Type::DOUBLE:
+  case arrow::Type::FIXED_SIZE_BINARY: {
+    RETURN_ON_ERROR(
+        get_buffer_from_tree(meta, tree, "null_bitmap_", true, null_bitmap));
+    RETURN_ON_ERROR(get_buffer_from_tree(meta, tree, "buffer_", false, values));
+    data = arrow::ArrayData::Make(type, length, {null_bitmap, values},
+                                  null_count, offset);
+    return Status::OK();
+  }
+  case arrow::Type::STRING:
+  case arrow::Type::BINARY:
+  case arrow::Type::LARGE_STRING:
+  case arrow::Type::LARGE_BINARY: {
+    RETURN_ON_ERROR(
+        get_buffer_from_tree(meta, tree, "null_bitmap_", true, null_bitmap));
+    RETURN_ON_ERROR(
+        get_buffer_from_tree(meta, tree, "buffer_offsets_", false, offsets));
+    RETURN_ON_ERROR(
+        get_buffer_from_tree(meta, tree, "buffer_data_", false, values));
+    data = arrow::ArrayData::Make(type, length, {null_bitmap, offsets, values},
+                                  null_count, offset);
+    return Status::OK();
+  }
+  case arrow::Type::LIST:
+  case arrow::Type::LARGE_LIST:
+  case arrow::Type::FIXED_SIZE_LIST: {
+    json const* values_tree = nullptr;
+    RETURN_ON_ERROR(get_member_tree(tree, "values_", values_tree));
+    std::shared_ptr<arrow::ArrayData> child;
+    RETURN_ON_ERROR(decode_array_from_tree(
+        meta, *values_tree,
+        std::dynamic_pointer_cast<arrow::BaseListType>(type)->value_type(),
+        child));
+    if (type->id() == arrow::Type::FIXED_SIZE_LIST) {
+      data = arrow::ArrayData::Make(type, length, {nullptr}, {child}, 0, 0);
+    } else {
+      RETURN_ON_ERROR(
+          get_buffer_from_tree(meta, tree, "null_bitmap_", true, null_bitmap));
+      RETURN_ON_ERROR(
+          get_buffer_from_tree(meta, tree, "buffer_offsets_", false, offsets));
+      data = arrow::ArrayData::Make(type, length, {null_bitmap, offsets},
+                                    {child}, null_count, offset);
+    }
+    return Status::OK();
+  }
+  default:
+    return Status::NotImplemented("Decoding arrays of type '" +
+                                  type->ToString() + "' from metadata");
+  }
+}
+
+}  // namespace detail
+
 Status RecordBatchStream::WriteTable(
     std::shared_ptr<arrow::Table> const& table) {
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
@@ -89,24 +228,266 @@ Status RecordBatchStream::ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
                                     bool const copy) {
   RETURN_ON_ASSERT(client_ != nullptr && this->readonly_ == true,
                    "Expect a readonly stream");
-  std::shared_ptr<Object> result = nullptr;
-  RETURN_ON_ERROR(client_->ClientBase::PullNextStreamChunk(this->id_, result));
+  if (batches_.empty()) {
+    RETURN_ON_ERROR(batches_.Fetch(client_, this->id_, params_, 1));
+  }
+  batches_.Pop(batch);
+  if (batch != nullptr && copy) {
+    RETURN_ON_ERROR(detail::Copy(batch, batch, false));
+  }
+  return Status::OK();
+}
 
-  if (auto chunk = std::dynamic_pointer_cast<RecordBatch>(result)) {
-    batch = chunk->GetRecordBatch();
-  } else if (auto chunk = std::dynamic_pointer_cast<Blob>(result)) {
-    auto buffer = chunk->Buffer();
-    RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
-    batch = AddMetadataToRecordBatch(batch, params_);
+namespace detail {
+
+/**
+ * Constructs the vineyard object of a chunk, which is either a `RecordBatch`
+ * or a `DataFrame`, and returns the batch that references its blobs.
+ */
+static Status construct_batch(ObjectMeta const& meta,
+                              std::shared_ptr<arrow::RecordBatch>& batch) {
+  auto object = ObjectFactory::Create(meta.GetTypeName());
+  RETURN_ON_ASSERT(object != nullptr, "Failed to create the object of type '" +
+                                          meta.GetTypeName() + "'");
+  object->Construct(meta);
+  std::shared_ptr<Object> chunk(std::move(object));
+  if (auto recordbatch = std::dynamic_pointer_cast<RecordBatch>(chunk)) {
+    batch = recordbatch->GetRecordBatch();
+  } else if (auto dataframe = std::dynamic_pointer_cast<DataFrame>(chunk)) {
+    batch = dataframe->AsBatch();
   } else {
     return Status::Invalid("Failed to cast object with type '" +
-                           result->meta().GetTypeName() + "' to type '" +
+                           meta.GetTypeName() + "' to type '" +
                            type_name<RecordBatch>() + "'");
   }
-  if (batch != nullptr && copy) {
-    RETURN_ON_ERROR(detail::Copy(batch, batch, false));
+  return Status::OK();
+}
+
+Status StreamBatchQueue::Fetch(
+    Client* client, ObjectID const stream_id,
+    std::map<std::string, std::string> const& params, size_t const prefetch) {
+  // the batches handed out before the last one are not referenced anymore
+  if (!expired_holders_.empty()) {
+    RETURN_ON_ERROR(client->DelData(expired_holders_, false, true));
+    expired_holders_.clear();
+  }
+  size_t fetched = 0;
+  ObjectID chunk = InvalidObjectID();
+  Status status;
+  while (fetched < std::max(prefetch, static_cast<size_t>(1))) {
+    if (fetched > 0) {
+      // the server deletes the previously pulled chunk on the next pull
+      RETURN_ON_ERROR(hold(client, chunk, pending_.back()));
+    }
+    status = client->ClientBase::PullNextStreamChunk(stream_id, chunk);
+    if (!status.ok()) {
+      break;
+    }
+    // resolve the chunk right after pulling it, before it could be released
+    ObjectMeta meta;
+    RETURN_ON_ERROR(client->GetMetaData(chunk, meta, false));
+    std::shared_ptr<arrow::RecordBatch> batch;
+    RETURN_ON_ERROR(decode(meta, params, batch));
+    pending_.emplace_back(batch, InvalidObjectID());
+    fetched += 1;
+  }
+  if (fetched == 0) {
+    // e.g., stream drained, the status will be reported again when pulling
+    // next time if some chunks have been pulled.
+    if (status.IsStreamDrained()) {
+      RETURN_ON_ERROR(Release(client));
+    }
+    return status;
   }
   return Status::OK();
 }
 
+void StreamBatchQueue::Pop(std::shared_ptr<arrow::RecordBatch>& batch) {
+  if (current_holder_ != InvalidObjectID()) {
+    expired_holders_.push_back(current_holder_);
+  }
+  batch = pending_.front().first;
+  current_holder_ = pending_.front().second;
+  pending_.pop_front();
+}
+
+Status StreamBatchQueue::Release(Client* client) {
+  if (current_holder_ != InvalidObjectID()) {
+    expired_holders_.push_back(current_holder_);
+    current_holder_ = InvalidObjectID();
+  }
+  for (auto const& item : pending_) {
+    if (item.second != InvalidObjectID()) {
+      expired_holders_.push_back(item.second);
+    }
+  }
+  pending_.clear();
+  if (expired_holders_.empty()) {
+    return Status::OK();
+  }
+  auto status = client->DelData(expired_holders_, false, true);
+  expired_holders_.clear();
+  return status;
+}
+
+Status StreamBatchQueue::hold(
+    Client* client, ObjectID const chunk,
+    std::pair<std::shared_ptr<arrow::RecordBatch>, ObjectID>& item) {
+  if (IsBlob(chunk)) {
+    // blob chunks are deleted regardless of the objects that reference them
+    return Copy(item.first, item.first, false);
+  }
+  // the server only deletes the chunk once no object references it
+  ObjectMeta holder;
+  holder.SetTypeName("vineyard::StreamChunkHolder");
+  holder.SetNBytes(0);
+  holder.AddMember("chunk_", chunk);
+  return client->CreateMetaData(holder, item.second);
+}
+
+Status StreamBatchQueue::decode(
+    ObjectMeta const& meta, std::map<std::string, std::string> const& params,
+    std::shared_ptr<arrow::RecordBatch>& batch) {
+  if (meta.GetTypeName() == type_name<Blob>()) {
+    std::shared_ptr<arrow::Buffer> buffer;
+    if (meta.GetId() == EmptyBlobID()) {
+      buffer = std::make_shared<arrow::Buffer>(nullptr, 0);
+    } else {
+      RETURN_ON_ERROR(meta.GetBuffer(meta.GetId(), buffer));
+    }
+    RETURN_ON_ERROR(DeserializeRecordBatch(buffer, &batch));
+    batch = AddMetadataToRecordBatch(batch, params);
+    return Status::OK();
+  }
+  if (meta.GetTypeName() != type_name<RecordBatch>()) {
+    return construct_batch(meta, batch);
+  }
+
+  json const& tree = meta.MetaData();
+  json const* schema_tree = nullptr;
+  RETURN_ON_ERROR(get_member_tree(tree, "schema_", schema_tree));
+  // compare the serialized schema (or the whole schema object for the legacy
+  // layout) rather than decoding it for every chunk
+  json const& schema_key = schema_tree->contains("schema_binary_")
+                               ? (*schema_tree)["schema_binary_"]
+                               : *schema_tree;
+  if (cached_schema_ == nullptr || cached_schema_binary_ != schema_key) {
+    ObjectMeta schema_meta;
+    RETURN_ON_ERROR(meta.GetMemberMeta("schema_", schema_meta));
+    SchemaProxy proxy;
+    proxy.Construct(schema_meta);
+    cached_schema_ = proxy.GetSchema();
+    cached_schema_binary_ = schema_key;
+  }
+
+  size_t num_columns = 0;
+  int64_t num_rows = 0;
+  RETURN_ON_ERROR(
+      get_value_from_tree(tree, "column_num_", num_columns));
+  RETURN_ON_ERROR(get_value_from_tree(tree, "row_num_", num_rows));
+  RETURN_ON_ASSERT(
+      static_cast<int>(num_columns) == cached_schema_->num_fields(),
+      "The number of columns doesn't match the schema");
+
+  std::vector<std::shared_ptr<arrow::ArrayData>> columns(num_columns);
+  Status status;
+  for (size_t idx = 0; idx < num_columns && status.ok(); ++idx) {
+    json const* column_tree = nullptr;
+    status = get_member_tree(
+        tree, "__columns_-" + std::to_string(idx), column_tree);
+    if (status.ok()) {
+      status = decode_array_from_tree(
+          meta, *column_tree, cached_schema_->field(idx)->type(),
+          columns[idx]);
+    }
+  }
+  if (status.IsNotImplemented()) {
+    // unknown array layout: construct the vineyard objects instead
+    return construct_batch(meta, batch);
+  }
+  RETURN_ON_ERROR(status);
+  batch = arrow::RecordBatch::Make(cached_schema_, num_rows, columns);
+  return Status::OK();
+}
+
+}  // namespace detail
+
+template <typename StreamT>
+RecordBatchStreamReader::RecordBatchStreamReader(
+    std::shared_ptr<StreamT> const& stream, size_t const prefetch)
+    : stream_(stream),
+      client_(stream->client_),
+      stream_id_(stream->id()),
+      params_(&stream->params_),
+      batches_(&stream->batches_),
+      prefetch_(std::max(prefetch, static_cast<size_t>(1))) {}
+
+RecordBatchStreamReader::~RecordBatchStreamReader() {
+  // the batches that are still fetched or referenced are dropped
+  VINEYARD_DISCARD(batches_->Release(client_));
+}
+
+template <typename StreamT>
+Status RecordBatchStreamReader::make(
+    Client& client, std::shared_ptr<StreamT> const& stream,
+    std::shared_ptr<RecordBatchStreamReader>& reader, size_t const prefetch) {
+  RETURN_ON_ASSERT(stream != nullptr, "The stream shouldn't be null");
+  if (!stream->IsOpen()) {
+    RETURN_ON_ERROR(stream->OpenReader(&client));
+  }
+  RETURN_ON_ASSERT(stream->readonly_, "Expect a readonly stream");
+  reader = std::shared_ptr<RecordBatchStreamReader>(
+      new RecordBatchStreamReader(stream, prefetch));
+  return reader->Init();
+}
+
+Status RecordBatchStreamReader::Make(
+    Client& client, std::shared_ptr<RecordBatchStream> const& stream,
+    std::shared_ptr<RecordBatchStreamReader>& reader, size_t const prefetch) {
+  return make(client, stream, reader, prefetch);
+}
+
+Status RecordBatchStreamReader::Make(
+    Client& client, std::shared_ptr<DataframeStream> const& stream,
+    std::shared_ptr<RecordBatchStreamReader>& reader, size_t const prefetch) {
+  return make(client, stream, reader, prefetch);
+}
+
+Status RecordBatchStreamReader::Init() {
+  if (batches_->empty()) {
+    auto status = batches_->Fetch(client_, stream_id_, *params_, prefetch_);
+    if (!status.ok() && !status.IsStreamDrained()) {
+      return status;
+    }
+  }
+  if (!batches_->empty()) {
+    schema_ = batches_->front()->schema();
+  } else {
+    // an empty stream
+    schema_ = arrow::schema({});
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<arrow::Schema> RecordBatchStreamReader::schema() const {
+  return schema_;
+}
+
+arrow::Status RecordBatchStreamReader::ReadNext(
+    std::shared_ptr<arrow::RecordBatch>* batch) {
+  if (batches_->empty()) {
+    auto status = batches_->Fetch(client_, stream_id_, *params_, prefetch_);
+    if (status.IsStreamDrained()) {
+      // end of stream
+      *batch = nullptr;
+      return arrow::Status::OK();
+    }
+    if (!status.ok()) {
+      return arrow::Status::IOError(status.ToString());
+    }
+  }
+  batches_->Pop(*batch);
+  return arrow::Status::OK();
+}
+
 }  // namespace vineyard
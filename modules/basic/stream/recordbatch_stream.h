@@ -16,11 +16,16 @@ limitations under the License.
 #ifndef MODULES_BASIC_STREAM_RECORDBATCH_STREAM_H_
 #define MODULES_BASIC_STREAM_RECORDBATCH_STREAM_H_
 
+#include <deque>
+#include <map>
 #include <memory>
+#include <utility>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "arrow/api.h"
+
 #include "basic/ds/arrow.h"
 #include "basic/ds/dataframe.h"
 #include "client/client.h"
@@ -28,6 +33,71 @@ limitations under the License.
 
 namespace vineyard {
 
+class DataframeStream;
+class RecordBatchStreamReader;
+
+namespace detail {
+
+/**
+ * @brief The record batches decoded from the chunks of a stream ahead of the
+ * consumer, shared by `RecordBatchStream` and `DataframeStream`.
+ *
+ * The server deletes the chunk that was pulled last on every pull. When
+ * several chunks are fetched at once, all but the last one are referenced by
+ * a holder object before pulling the next, which keeps their blobs alive, so
+ * the batches are handed out without copying. A batch stays valid until the
+ * batch after it is handed out, then its holder is deleted on the next fetch.
+ */
+class StreamBatchQueue {
+ public:
+  bool empty() const { return pending_.empty(); }
+
+  std::shared_ptr<arrow::RecordBatch> const& front() const {
+    return pending_.front().first;
+  }
+
+  /**
+   * @brief Pull at most `prefetch` chunks and decode them, returns
+   * `StreamDrained` when no chunk is available anymore, where all holders
+   * are deleted.
+   */
+  Status Fetch(Client* client, ObjectID const stream_id,
+               std::map<std::string, std::string> const& params,
+               size_t const prefetch);
+
+  /**
+   * @brief Hand out the first fetched batch.
+   */
+  void Pop(std::shared_ptr<arrow::RecordBatch>& batch);
+
+  /**
+   * @brief Drop the fetched batches and delete all holders.
+   */
+  Status Release(Client* client);
+
+ private:
+  Status hold(Client* client, ObjectID const chunk,
+              std::pair<std::shared_ptr<arrow::RecordBatch>, ObjectID>& item);
+
+  Status decode(ObjectMeta const& meta,
+                std::map<std::string, std::string> const& params,
+                std::shared_ptr<arrow::RecordBatch>& batch);
+
+  // the fetched batches and the holders of their chunks, if any
+  std::deque<std::pair<std::shared_ptr<arrow::RecordBatch>, ObjectID>>
+      pending_;
+  // the holder of the batch handed out last
+  ObjectID current_holder_ = InvalidObjectID();
+  // the holders of the batches that have been superseded
+  std::vector<ObjectID> expired_holders_;
+
+  // the schema is decoded once and reused as long as the chunks share it
+  json cached_schema_binary_;
+  std::shared_ptr<arrow::Schema> cached_schema_;
+};
+
+}  // namespace detail
+
 class RecordBatchStream : public BareRegistered<RecordBatchStream>,
                           public RecordBatchStreamBase {
  public:
@@ -49,6 +119,74 @@ class RecordBatchStream : public BareRegistered<RecordBatchStream>,
 
   Status ReadBatch(std::shared_ptr<arrow::RecordBatch>& batch,
                    bool const copy = false);
+
+ private:
+  detail::StreamBatchQueue batches_;
+
+  friend class RecordBatchStreamReader;
+};
+
+/**
+ * @brief A zero-copy `arrow::RecordBatchReader` over a `RecordBatchStream`
+ * or a `DataframeStream`.
+ *
+ * The record batches are assembled directly from the metadata tree and the
+ * mapped blobs of the chunks, without constructing the vineyard `RecordBatch`
+ * and array objects, and the schema is only decoded once per stream. Hence it
+ * can feed arrow compute kernels or writers (e.g., parquet) efficiently.
+ *
+ * A batch references the shared memory of its chunk, which is released once
+ * the next batch is read, hence it shouldn't be kept after reading the next
+ * batch (copy it with `detail::Copy()` otherwise). The client must outlive
+ * the reader.
+ */
+class RecordBatchStreamReader : public arrow::RecordBatchReader {
+ public:
+  ~RecordBatchStreamReader() override;
+
+  /**
+   * @brief Make a reader, the stream will be opened for reading if it
+   * hasn't been opened yet.
+   *
+   * It blocks until the first chunk arrives to resolve the schema.
+   *
+   * @param prefetch The number of chunks to fetch ahead. Pulling blocks until
+   *        the writer pushes enough chunks (or finishes the stream), thus a
+   *        larger value trades latency for fewer blocking round trips.
+   */
+  static Status Make(Client& client,
+                     std::shared_ptr<RecordBatchStream> const& stream,
+                     std::shared_ptr<RecordBatchStreamReader>& reader,
+                     size_t const prefetch = 1);
+
+  static Status Make(Client& client,
+                     std::shared_ptr<DataframeStream> const& stream,
+                     std::shared_ptr<RecordBatchStreamReader>& reader,
+                     size_t const prefetch = 1);
+
+  std::shared_ptr<arrow::Schema> schema() const override;
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+
+ private:
+  template <typename StreamT>
+  RecordBatchStreamReader(std::shared_ptr<StreamT> const& stream,
+                          size_t const prefetch);
+
+  template <typename StreamT>
+  static Status make(Client& client, std::shared_ptr<StreamT> const& stream,
+                     std::shared_ptr<RecordBatchStreamReader>& reader,
+                     size_t const prefetch);
+
+  Status Init();
+
+  std::shared_ptr<Object> stream_;
+  Client* client_;
+  ObjectID stream_id_;
+  std::map<std::string, std::string> const* params_;
+  detail::StreamBatchQueue* batches_;
+  size_t prefetch_;
+  std::shared_ptr<arrow::Schema> schema_;
 };
 
 template <>
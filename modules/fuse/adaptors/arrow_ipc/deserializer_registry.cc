@@ -14,6 +14,12 @@ limitations under the License.
 */
 
 #include "fuse/adaptors/arrow_ipc/deserializer_registry.h"
+
+#include "arrow/ipc/api.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "common/util/arrow.h"
+
 namespace vineyard {
 namespace fuse {
 
@@ -31,100 +37,93 @@ std::shared_ptr<arrow::KeyValueMetadata> extractVineyardMetaToArrowMeta(
   return kvmeta;
 }
 
+static Status write_arrow_ipc_view(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+    arrow::io::OutputStream* sink) {
+  arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+  options.allow_64bit = true;
+
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+#if defined(ARROW_VERSION) && ARROW_VERSION < 2000000
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      writer, arrow::ipc::NewFileWriter(sink, schema, options));
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      writer, arrow::ipc::MakeFileWriter(sink, schema, options));
+#endif
+  for (auto const& batch : batches) {
+    RETURN_ON_ARROW_ERROR(writer->WriteRecordBatch(*batch));
+  }
+  RETURN_ON_ARROW_ERROR(writer->Close());
+  return Status::OK();
+}
+
 template <typename T>
-std::shared_ptr<internal::ChunkBuffer> numeric_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p) {
+Status numeric_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                    arrow::io::OutputStream* sink) {
   auto arr = std::dynamic_pointer_cast<vineyard::NumericArray<T>>(p);
   DLOG(INFO) << "numeric_array_arrow_ipc_view" << type_name<T>()
              << " is called";
-  auto cbuffer = std::make_shared<internal::ChunkBuffer>();
-  DLOG(INFO) << "buffer successfully created";
-
   auto kvmeta = extractVineyardMetaToArrowMeta(arr);
   auto schema = arrow::schema(
       {arrow::field("a", ConvertToArrowType<T>::TypeValue())}, kvmeta);
-  std::shared_ptr<arrow::Table> my_table =
-      arrow::Table::Make(schema, {arr->GetArray()});
-  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
-  CHECK_ARROW_ERROR_AND_ASSIGN(writer,
-                               arrow::ipc::MakeFileWriter(cbuffer, schema));
-
-  VINEYARD_CHECK_OK(writer->WriteTable(*my_table));
-  DLOG(INFO) << "table is written";
-  writer->Close();
-  DLOG(INFO) << "buffer is extracted";
-  return cbuffer;
+  auto array = arr->GetArray();
+  return write_arrow_ipc_view(
+      schema, {arrow::RecordBatch::Make(schema, array->length(), {array})},
+      sink);
 }
 
-std::shared_ptr<internal::ChunkBuffer> string_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p) {
+Status string_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                   arrow::io::OutputStream* sink) {
   auto arr = std::dynamic_pointer_cast<
       vineyard::BaseBinaryArray<arrow::LargeStringArray>>(p);
   DLOG(INFO) << "string_array_arrow_ipc_view is called";
-  auto cbuffer = std::make_shared<internal::ChunkBuffer>();
-
-  DLOG(INFO) << "buffer successfully created";
-
   auto kvmeta = extractVineyardMetaToArrowMeta(arr);
   auto schema = arrow::schema(
       {arrow::field("a", ConvertToArrowType<std::string>::TypeValue())},
       kvmeta);
-  std::shared_ptr<arrow::Table> my_table =
-      arrow::Table::Make(schema, {arr->GetArray()});
-
-  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
-  CHECK_ARROW_ERROR_AND_ASSIGN(writer,
-                               arrow::ipc::MakeFileWriter(cbuffer, schema));
-
-  VINEYARD_CHECK_OK(writer->WriteTable(*my_table));
-  DLOG(INFO) << "table is written";
-  writer->Close();
-  std::shared_ptr<internal::ChunkBuffer> buffer_;
-  DLOG(INFO) << "writer is closed";
-  return cbuffer;
+  auto array = arr->GetArray();
+  return write_arrow_ipc_view(
+      schema, {arrow::RecordBatch::Make(schema, array->length(), {array})},
+      sink);
 }
 
-std::shared_ptr<internal::ChunkBuffer> bool_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p) {
+Status bool_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                 arrow::io::OutputStream* sink) {
   auto arr = std::dynamic_pointer_cast<vineyard::BooleanArray>(p);
   DLOG(INFO) << "bool_array_arrow_ipc_view is called";
-  auto cbuffer = std::make_shared<internal::ChunkBuffer>();
   auto kvmeta = extractVineyardMetaToArrowMeta(arr);
-  DLOG(INFO) << "buffer successfully created";
-
   auto schema = arrow::schema(
       {arrow::field("a", ConvertToArrowType<bool>::TypeValue())}, kvmeta);
-  std::shared_ptr<arrow::Table> my_table =
-      arrow::Table::Make(schema, {arr->GetArray()});
-
-  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
-  CHECK_ARROW_ERROR_AND_ASSIGN(writer,
-                               arrow::ipc::MakeFileWriter(cbuffer, schema));
-
-  VINEYARD_CHECK_OK(writer->WriteTable(*my_table));
-  DLOG(INFO) << "table is written";
-  writer->Close();
-
-  return cbuffer;
+  auto array = arr->GetArray();
+  return write_arrow_ipc_view(
+      schema, {arrow::RecordBatch::Make(schema, array->length(), {array})},
+      sink);
 }
 
-std::shared_ptr<internal::ChunkBuffer> dataframe_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p) {
+Status dataframe_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                arrow::io::OutputStream* sink) {
   auto df = std::dynamic_pointer_cast<vineyard::DataFrame>(p);
-  auto kvmeta = extractVineyardMetaToArrowMeta(df);
+  // references the columns in place, rather than copying them
+  auto batch = df->AsBatch(false);
+  return write_arrow_ipc_view(batch->schema(), {batch}, sink);
+}
 
-  auto batch = df->AsBatch(true);
-  std::shared_ptr<arrow::Table> table;
-  VINEYARD_CHECK_OK(RecordBatchesToTable({batch}, &table));
-  auto cbuffer = std::make_shared<internal::ChunkBuffer>();
-  std::clog << batch->column_data(2)->GetValues<_Float64>(1) << std::endl;
-  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
-  CHECK_ARROW_ERROR_AND_ASSIGN(
-      writer, arrow::ipc::MakeFileWriter(cbuffer, batch->schema()));
-  VINEYARD_CHECK_OK(writer->WriteTable(*table));
-  std::shared_ptr<internal::ChunkBuffer> buffer;
-  writer->Close();
-  return cbuffer;
+Status recordbatch_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                  arrow::io::OutputStream* sink) {
+  auto rb = std::dynamic_pointer_cast<vineyard::RecordBatch>(p);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  RETURN_ON_ERROR(TableToRecordBatches(rb->GetTable(), &batches));
+  return write_arrow_ipc_view(rb->schema(), batches, sink);
+}
+
+Status table_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                            arrow::io::OutputStream* sink) {
+  auto tb = std::dynamic_pointer_cast<vineyard::Table>(p);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  RETURN_ON_ERROR(TableToRecordBatches(tb->GetTable(), &batches));
+  return write_arrow_ipc_view(tb->schema(), batches, sink);
 }
 
 std::unordered_map<std::string, vineyard::fuse::vineyard_deserializer_nt>
@@ -178,6 +177,18 @@ arrow_ipc_register_once() {
 
     d_array_registry.emplace(t_name, &dataframe_arrow_ipc_view);
   }
+  {
+    std::string t_name = type_name<vineyard::RecordBatch>();
+    DLOG(INFO) << "register type: " << t_name << std::endl;
+
+    d_array_registry.emplace(t_name, &recordbatch_arrow_ipc_view);
+  }
+  {
+    std::string t_name = type_name<vineyard::Table>();
+    DLOG(INFO) << "register type: " << t_name << std::endl;
+
+    d_array_registry.emplace(t_name, &table_arrow_ipc_view);
+  }
   return d_array_registry;
 }
 
@@ -34,6 +34,7 @@ limitations under the License.
 #include "arrow/util/macros.h"
 
 #include "basic/ds/array.h"
+#include "basic/ds/arrow.h"
 #include "basic/ds/dataframe.h"
 #include "client/client.h"
 #include "client/ds/blob.h"
@@ -49,18 +50,29 @@ limitations under the License.
 namespace vineyard {
 namespace fuse {
 
-using vineyard_deserializer_nt = std::shared_ptr<internal::ChunkBuffer> (*)(
-    const std::shared_ptr<vineyard::Object>&);
+/**
+ * @brief Writes the object as an arrow IPC file to the sink.
+ *
+ * The buffers of the object are written as they are, thus a `ChunkBuffer`
+ * sink references the (mapped) blobs without copying, and an
+ * `arrow::io::MockOutputStream` sink counts the size of the view only.
+ */
+using vineyard_deserializer_nt = Status (*)(
+    const std::shared_ptr<vineyard::Object>&, arrow::io::OutputStream* sink);
 
 template <typename T>
-std::shared_ptr<internal::ChunkBuffer> numeric_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p);
-std::shared_ptr<internal::ChunkBuffer> string_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p);
-std::shared_ptr<internal::ChunkBuffer> bool_array_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p);
-std::shared_ptr<internal::ChunkBuffer> dataframe_arrow_ipc_view(
-    const std::shared_ptr<vineyard::Object>& p);
+Status numeric_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                    arrow::io::OutputStream* sink);
+Status string_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                   arrow::io::OutputStream* sink);
+Status bool_array_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                 arrow::io::OutputStream* sink);
+Status dataframe_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                arrow::io::OutputStream* sink);
+Status recordbatch_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                                  arrow::io::OutputStream* sink);
+Status table_arrow_ipc_view(const std::shared_ptr<vineyard::Object>& p,
+                            arrow::io::OutputStream* sink);
 std::unordered_map<std::string, vineyard::fuse::vineyard_deserializer_nt>
 arrow_ipc_register_once();
 
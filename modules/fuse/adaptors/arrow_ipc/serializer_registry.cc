@@ -74,17 +74,16 @@ std::shared_ptr<arrow::Buffer> arrow_view(
 std::shared_ptr<arrow::Buffer> arrow_view(
     std::shared_ptr<vineyard::RecordBatch>& rb) {
   auto estimate_size = rb->meta().MemoryUsage();
-  auto batch = rb->GetRecordBatch();
-  return view(estimate_size, {batch});
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  VINEYARD_CHECK_OK(TableToRecordBatches(rb->GetTable(), &batches));
+  return view(estimate_size, batches);
 }
 
 std::shared_ptr<arrow::Buffer> arrow_view(
     std::shared_ptr<vineyard::Table>& tb) {
   auto estimate_size = tb->meta().MemoryUsage();
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
-  for (auto const& batch : tb->batches()) {
-    batches.emplace_back(batch->GetRecordBatch());
-  }
+  VINEYARD_CHECK_OK(TableToRecordBatches(tb->GetTable(), &batches));
   return view(estimate_size, batches);
 }
 
@@ -16,6 +16,7 @@ limitations under the License.
 #include <algorithm>
 #include <memory>
 #include "arrow/buffer.h"
+#include "arrow/result.h"
 #include "common/util/logging.h"
 #include "iostream"
 
@@ -29,7 +30,7 @@ arrow::Status ChunkBuffer::Close() {
   return arrow::Status::OK();
 }
 arrow::Status ChunkBuffer::Abort() {
-  this->chunks.~map();
+  this->chunks.clear();
   this->open = false;
   this->size_ = 0;
   return arrow::Status::OK();
@@ -49,10 +50,9 @@ arrow::Status ChunkBuffer::Write(const void* data, int64_t nbytes) {
   if (nbytes == 0) {
     return arrow::Status::OK();
   }
-  void* copy = malloc(nbytes);
-  memcpy(copy, data, nbytes);
-
-  auto chunk = arrow::Buffer::Wrap(reinterpret_cast<uint8_t*>(copy), nbytes);
+  std::shared_ptr<arrow::Buffer> chunk;
+  ARROW_ASSIGN_OR_RAISE(chunk, arrow::AllocateBuffer(nbytes));
+  memcpy(chunk->mutable_data(), data, nbytes);
   std::pair<int64_t, int64_t> id = {size_, size_ + nbytes - 1};
   this->chunks.emplace(id, chunk);
   this->size_ += nbytes;
@@ -64,6 +64,11 @@ arrow::Status ChunkBuffer::Write(const std::shared_ptr<arrow::Buffer>& data) {
              << data->size();
 
   auto chunk_size = data->size();
+  if (chunk_size == 0) {
+    return arrow::Status::OK();
+  }
+  // the buffer is referenced rather than copied, e.g., the body buffers of
+  // record batches, which are slices of the blobs in vineyard
   std::pair<int64_t, int64_t> id = {size_, size_ + chunk_size - 1};
   this->chunks.emplace(id, data);
   this->size_ += chunk_size;
@@ -79,46 +84,25 @@ typename C::const_iterator find_key_less_equal(
   return --iter;
 }
 int64_t ChunkBuffer::readAt(int64_t position, int64_t nbytes, void* out) {
-  if (nbytes == 0) {
+  if (position < 0 || position >= this->size_ || nbytes <= 0) {
     return 0;
   }
+  nbytes = std::min(nbytes, this->size_ - position);
   auto it = find_key_less_equal(this->chunks, {position, INT64_MAX});
 
-  if (it == this->chunks.cend()) {
-    return 0;
-  } else {
-    if (position + nbytes > this->size_) {
-      nbytes = (this->size_ - 1) - position + 1;
-    }
-    auto byteout = reinterpret_cast<uint8_t*>(out);
-    int64_t remaining = nbytes;
-    {
-      auto chunk_start = it->first.first;
-      auto chunk_end = it->first.second;
-      // load the first buffer
-      auto chunk = it->second;
-      auto chunk_p = chunk->data();
-      chunk_p += position - chunk_start;
-      auto chunk_copied_len = chunk_end - position + 1;
-      memcpy(byteout, chunk_p, chunk_copied_len);
-      byteout += chunk_copied_len;
-      remaining -= chunk_copied_len;
-      it++;
-    }
-
-    while (remaining > 0 && it != this->chunks.end()) {
-      auto chunk = it->second;
-      auto chunk_p = chunk->data();
-      auto readByte = std::min(remaining, chunk->size());
-      memcpy(byteout, chunk_p, readByte);
-      byteout += readByte;
-
-      remaining -= readByte;
-      it++;
-    }
-
-    return nbytes;
+  auto byteout = reinterpret_cast<uint8_t*>(out);
+  int64_t remaining = nbytes;
+  while (remaining > 0 && it != this->chunks.cend()) {
+    auto const& chunk = it->second;
+    auto chunk_offset = position - it->first.first;
+    auto readByte = std::min(remaining, chunk->size() - chunk_offset);
+    memcpy(byteout, chunk->data() + chunk_offset, readByte);
+    byteout += readByte;
+    position += readByte;
+    remaining -= readByte;
+    it++;
   }
+  return nbytes - remaining;
 }
 int64_t ChunkBuffer::size() const { return this->size_; }
 
@@ -15,8 +15,15 @@ limitations under the License.
 
 #include "fuse/fuse_impl.h"
 
+#include <algorithm>
 #include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -32,6 +39,7 @@ limitations under the License.
 #include "client/ds/blob.h"
 #include "client/ds/core_types.h"
 #include "client/ds/i_object.h"
+#include "common/util/env.h"
 #include "common/util/logging.h"
 #include "common/util/uuid.h"
 #include "fuse/adaptors/arrow_ipc/deserializer_registry.h"
@@ -62,77 +70,487 @@ std::shared_ptr<arrow::Buffer> generate_fuse_view(
   return nullptr;
 }
 
-int fs::fuse_getattr(const char* path, struct stat* stbuf,
-                     struct fuse_file_info*) {
-  DLOG(INFO) << "fuse: getattr on " << path;
-  std::lock_guard<std::mutex> guard(state.mtx_);
+static const std::string kNamesDir = "/names";
+static const std::string kTypesDir = "/types";
+
+using dir_t = std::vector<std::pair<std::string, struct stat>>;
+
+static std::string strip_view_suffix(std::string const& base) {
+  return base.substr(0, base.length() - 6 /* .arrow */);
+}
+
+// escapes the metacharacters of the (fnmatch) glob patterns of `ListNames`
+static std::string escape_glob(std::string const& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '*' || c == '?' || c == '[' || c == ']' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
 
+static std::mutex& path_lock(std::string const& key) {
+  return fs::state.path_mtx_[std::hash<std::string>()(key) %
+                             fs::state.path_mtx_.size()];
+}
+
+static void fill_stat(mode_t const mode, int64_t const size,
+                      struct stat* stbuf) {
   memset(stbuf, 0, sizeof(struct stat));
-  if (strcmp(path, "/") == 0) {
+  if (S_ISDIR(mode)) {
     stbuf->st_mode = S_IFDIR | 0755;
     stbuf->st_nlink = 2;
+  } else {
+    stbuf->st_mode = S_IFREG | 0444;
+    stbuf->st_nlink = 1;
+    stbuf->st_size = size;
+  }
+}
+
+// requires the `state.mtx_` been held
+static void erase_attr(
+    std::unordered_map<std::string, fs::fs_state_t::attr_t>::iterator iter) {
+  auto paths = fs::state.attr_paths.find(iter->second.id);
+  if (paths != fs::state.attr_paths.end()) {
+    paths->second.erase(iter->first);
+    if (paths->second.empty()) {
+      fs::state.attr_paths.erase(paths);
+    }
+  }
+  fs::state.attrs_lru.erase(iter->second.lru);
+  fs::state.attrs.erase(iter);
+}
+
+// requires the `state.mtx_` been held
+static bool find_attr(std::string const& path, fs::fs_state_t::attr_t& attr) {
+  auto iter = fs::state.attrs.find(path);
+  if (iter == fs::state.attrs.end()) {
+    return false;
+  }
+  if (iter->second.expire < std::chrono::steady_clock::now()) {
+    erase_attr(iter);
+    return false;
+  }
+  fs::state.attrs_lru.splice(fs::state.attrs_lru.begin(), fs::state.attrs_lru,
+                             iter->second.lru);
+  attr = iter->second;
+  return true;
+}
+
+// requires the `state.mtx_` been held
+static fs::fs_state_t::attr_t cache_attr(std::string const& path,
+                                         mode_t const mode, ObjectID const id,
+                                         int64_t const size) {
+  auto iter = fs::state.attrs.find(path);
+  if (iter != fs::state.attrs.end()) {
+    erase_attr(iter);
+  }
+  fs::state.attrs_lru.emplace_front(path);
+  fs::fs_state_t::attr_t attr;
+  attr.mode = mode;
+  attr.id = id;
+  attr.size = size;
+  attr.expire = std::chrono::steady_clock::now() + fs::state.attrs_ttl;
+  attr.lru = fs::state.attrs_lru.begin();
+  fs::state.attrs.emplace(path, attr);
+  // directories have no object to be invalidated with
+  if (id != InvalidObjectID()) {
+    fs::state.attr_paths[id].emplace(path);
+  }
+  auto capacity = std::max<size_t>(fs::state.attrs_capacity, 1);
+  while (fs::state.attrs.size() > capacity) {
+    erase_attr(fs::state.attrs.find(fs::state.attrs_lru.back()));
+  }
+  return attr;
+}
+
+// requires the `state.mtx_` been held
+static bool find_view(ObjectID const id,
+                      std::shared_ptr<internal::ChunkBuffer>& buffer) {
+  auto iter = fs::state.views.find(id);
+  if (iter == fs::state.views.end()) {
+    return false;
+  }
+  fs::state.views_lru.splice(fs::state.views_lru.begin(), fs::state.views_lru,
+                             iter->second.lru);
+  buffer = iter->second.buffer;
+  return true;
+}
+
+// requires the `state.mtx_` been held
+static void cache_view(ObjectID const id,
+                       std::shared_ptr<internal::ChunkBuffer> const& buffer) {
+  if (fs::state.views.find(id) != fs::state.views.end()) {
+    return;
+  }
+  fs::state.views_lru.emplace_front(id);
+  fs::state.views.emplace(
+      id, fs::fs_state_t::view_t{buffer, fs::state.views_lru.begin()});
+  // the opened files still hold their views after being evicted
+  auto capacity = std::max<size_t>(fs::state.views_capacity, 1);
+  while (fs::state.views.size() > capacity) {
+    fs::state.views.erase(fs::state.views_lru.back());
+    fs::state.views_lru.pop_back();
+  }
+}
+
+// requires the `state.mtx_` been held
+static void invalidate(ObjectID const id) {
+  auto paths = fs::state.attr_paths.find(id);
+  if (paths != fs::state.attr_paths.end()) {
+    // `erase_attr` drops the paths of the object as well
+    std::vector<std::string> attr_paths(paths->second.begin(),
+                                        paths->second.end());
+    for (auto const& path : attr_paths) {
+      erase_attr(fs::state.attrs.find(path));
+    }
+  }
+  auto iter = fs::state.views.find(id);
+  if (iter != fs::state.views.end()) {
+    fs::state.views_lru.erase(iter->second.lru);
+    fs::state.views.erase(iter);
+  }
+}
+
+/**
+ * The size is counted by writing the IPC file to a mock output stream, which
+ * takes the schema and buffer sizes of the object only, without copying any
+ * data.
+ */
+static int view_size(std::shared_ptr<Object> const& object, int64_t& size) {
+  auto deserializer =
+      fs::state.ipc_desearilizer_registry.find(object->meta().GetTypeName());
+  if (deserializer == fs::state.ipc_desearilizer_registry.end()) {
+    DLOG(INFO) << "fuse: unsupported type " << object->meta().GetTypeName();
+    return -ENOENT;
+  }
+  arrow::io::MockOutputStream sink;
+  auto status = deserializer->second(object, &sink);
+  if (!status.ok()) {
+    LOG(ERROR) << "fuse: failed to resolve the view of "
+               << ObjectIDToString(object->id()) << ": " << status.ToString();
+    return -EIO;
+  }
+  size = sink.GetExtentBytesWritten();
+  return 0;
+}
+
+/**
+ * Resolves the object of the file, which is
+ *
+ *  - "/names/<name>.arrow", where the name may contain "/", or
+ *  - "/types/<typename>/<object id>.arrow", or
+ *  - "/<name or object id>.arrow", which isn't listed in any directory.
+ */
+static int resolve_object(std::string const& path,
+                          std::shared_ptr<Object>& object) {
+  if (!boost::algorithm::ends_with(path, ".arrow")) {
+    return -ENOENT;
+  }
+  ObjectID target = InvalidObjectID();
+  std::string type_name;
+  if (boost::algorithm::starts_with(path, kNamesDir + "/")) {
+    auto name = strip_view_suffix(path.substr(kNamesDir.length() + 1));
+    if (!fs::state.client->GetName(name, target).ok()) {
+      return -ENOENT;
+    }
+  } else if (boost::algorithm::starts_with(path, kTypesDir + "/")) {
+    auto sep = path.rfind('/');
+    if (sep <= kTypesDir.length()) {
+      return -ENOENT;
+    }
+    type_name = path.substr(kTypesDir.length() + 1,
+                            sep - kTypesDir.length() - 1);
+    target = ObjectIDFromString(strip_view_suffix(path.substr(sep + 1)));
+  } else {
+    auto name = name_from_path(path);
+    if (name.find('/') != std::string::npos) {
+      return -ENOENT;
+    }
+    if (!fs::state.client->GetName(name, target).ok()) {
+      target = ObjectIDFromString(name);
+    }
+  }
+  if (!fs::state.client->GetObject(target, object).ok() || object == nullptr) {
+    return -ENOENT;
+  }
+  if (!type_name.empty() && object->meta().GetTypeName() != type_name) {
+    return -ENOENT;
+  }
+  return 0;
+}
+
+static bool is_directory(std::string const& path) {
+  if (path == "/" || path == kNamesDir || path == kTypesDir) {
+    return true;
+  }
+  if (boost::algorithm::starts_with(path, kTypesDir + "/")) {
+    return fs::state.ipc_desearilizer_registry.find(path.substr(
+               kTypesDir.length() + 1)) !=
+           fs::state.ipc_desearilizer_registry.end();
+  }
+  if (boost::algorithm::starts_with(path, kNamesDir + "/")) {
+    std::map<std::string, ObjectID> names;
+    auto prefix = path.substr(kNamesDir.length() + 1) + "/";
+    auto status = fs::state.client->ListNames(escape_glob(prefix) + "*",
+                                              false, 1, names);
+    return status.ok() && !names.empty();
+  }
+  return false;
+}
+
+static int resolve_attr(std::string const& path,
+                        fs::fs_state_t::attr_t& attr) {
+  auto lookup = [&]() -> bool {
+    std::lock_guard<std::mutex> guard(fs::state.mtx_);
+    return find_attr(path, attr);
+  };
+  if (lookup()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> path_guard(path_lock(path));
+  // may have been resolved by others when waiting for the lock
+  if (lookup()) {
     return 0;
   }
 
-  stbuf->st_mode = S_IFREG | 0444;
-  stbuf->st_nlink = 1;
+  mode_t mode = S_IFREG;
+  ObjectID id = InvalidObjectID();
+  int64_t size = 0;
+  std::shared_ptr<Object> object;
+  if (resolve_object(path, object) == 0) {
+    int err = view_size(object, size);
+    if (err != 0) {
+      return err;
+    }
+    id = object->id();
+  } else if (is_directory(path)) {
+    mode = S_IFDIR;
+  } else {
+    return -ENOENT;
+  }
 
-  {
-    auto iter = state.views.find(path);
-    if (iter != state.views.end()) {
-      DLOG(INFO) << "fuse: getattr found " << path;
+  std::lock_guard<std::mutex> guard(fs::state.mtx_);
+  attr = cache_attr(path, mode, id, size);
+  return 0;
+}
 
-      stbuf->st_size = iter->second->size();
-      return 0;
+/**
+ * Materializes the content of the view, i.e., the IPC headers stitched with
+ * the zero-copy slices of the blobs.
+ */
+static int resolve_view(std::string const& path,
+                        std::shared_ptr<internal::ChunkBuffer>& buffer) {
+  fs::fs_state_t::attr_t attr;
+  int err = resolve_attr(path, attr);
+  if (err != 0) {
+    return err;
+  }
+  if (S_ISDIR(attr.mode)) {
+    return -EISDIR;
+  }
+  auto lookup = [&]() -> bool {
+    std::lock_guard<std::mutex> guard(fs::state.mtx_);
+    return find_view(attr.id, buffer);
+  };
+  if (lookup()) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> object_guard(
+      path_lock(ObjectIDToString(attr.id)));
+  if (lookup()) {
+    return 0;
+  }
+
+  std::shared_ptr<Object> object;
+  if (!fs::state.client->GetObject(attr.id, object).ok() ||
+      object == nullptr) {
+    std::lock_guard<std::mutex> guard(fs::state.mtx_);
+    invalidate(attr.id);
+    return -ENOENT;
+  }
+  auto deserializer =
+      fs::state.ipc_desearilizer_registry.find(object->meta().GetTypeName());
+  if (deserializer == fs::state.ipc_desearilizer_registry.end()) {
+    return -ENOENT;
+  }
+  buffer = std::make_shared<internal::ChunkBuffer>();
+  auto status = deserializer->second(object, buffer.get());
+  if (!status.ok()) {
+    LOG(ERROR) << "fuse: failed to resolve the view of " << path << ": "
+               << status.ToString();
+    return -EIO;
+  }
+  std::lock_guard<std::mutex> guard(fs::state.mtx_);
+  cache_view(attr.id, buffer);
+  return 0;
+}
+
+/**
+ * Lists the directory, with the attributes of entries filled from the
+ * listed metadata, which are cached as well for the following `getattr`.
+ *
+ * The layout of the namespace is
+ *
+ *  - "/names/", the named objects, where names are split by "/" as
+ *    sub-directories,
+ *  - "/types/<typename>/", the objects of each supported type.
+ */
+static int list_directory(std::string const& path, dir_t& entries) {
+  struct entry_t {
+    std::string base;
+    mode_t mode;
+    ObjectID id;
+    int64_t size;
+  };
+  std::vector<entry_t> children;
+
+  if (path == "/") {
+    children.push_back({kNamesDir.substr(1), S_IFDIR, InvalidObjectID(), 0});
+    children.push_back({kTypesDir.substr(1), S_IFDIR, InvalidObjectID(), 0});
+  } else if (path == kTypesDir) {
+    for (auto const& item : fs::state.ipc_desearilizer_registry) {
+      children.push_back({item.first, S_IFDIR, InvalidObjectID(), 0});
+    }
+  } else if (boost::algorithm::starts_with(path, kTypesDir + "/")) {
+    auto type_name = path.substr(kTypesDir.length() + 1);
+    if (fs::state.ipc_desearilizer_registry.find(type_name) ==
+        fs::state.ipc_desearilizer_registry.end()) {
+      return -ENOENT;
+    }
+    // a single listing request, with the blobs of all objects fetched in
+    // batch
+    for (auto const& object : fs::state.client->ListObjects(
+             type_name, false, std::numeric_limits<size_t>::max())) {
+      int64_t size = 0;
+      if (view_size(object, size) == 0) {
+        children.push_back({ObjectIDToString(object->id()) + ".arrow",
+                            S_IFREG, object->id(), size});
+      }
+    }
+  } else if (path == kNamesDir ||
+             boost::algorithm::starts_with(path, kNamesDir + "/")) {
+    std::string prefix;
+    if (path != kNamesDir) {
+      prefix = path.substr(kNamesDir.length() + 1) + "/";
+    }
+    std::map<std::string, ObjectID> names;
+    auto status = fs::state.client->ListNames(
+        escape_glob(prefix) + "*", false, std::numeric_limits<size_t>::max(),
+        names);
+    if (!status.ok()) {
+      LOG(ERROR) << "fuse: failed to list names: " << status.ToString();
+      return -EIO;
+    }
+    std::set<std::string> directories;
+    std::vector<std::string> files;
+    std::vector<ObjectID> ids;
+    for (auto const& item : names) {
+      if (!boost::algorithm::starts_with(item.first, prefix)) {
+        continue;
+      }
+      auto base = item.first.substr(prefix.length());
+      auto sep = base.find('/');
+      if (sep != std::string::npos) {
+        directories.emplace(base.substr(0, sep));
+      } else {
+        files.emplace_back(base);
+        ids.emplace_back(item.second);
+      }
     }
+    if (directories.empty() && files.empty() && path != kNamesDir) {
+      return -ENOENT;
+    }
+    for (auto const& base : directories) {
+      children.push_back({base, S_IFDIR, InvalidObjectID(), 0});
+    }
+    auto objects = fs::state.client->GetObjects(ids);
+    for (size_t index = 0; index < objects.size(); ++index) {
+      int64_t size = 0;
+      if (objects[index] != nullptr && view_size(objects[index], size) == 0) {
+        children.push_back(
+            {files[index] + ".arrow", S_IFREG, ids[index], size});
+      }
+    }
+  } else {
+    return -ENOENT;
   }
+
+  struct stat stbuf;
+  fill_stat(S_IFDIR, 0, &stbuf);
+  entries.emplace_back(".", stbuf);
+  entries.emplace_back("..", stbuf);
+  std::string parent = path == "/" ? path : path + "/";
+  std::lock_guard<std::mutex> guard(fs::state.mtx_);
+  for (auto const& child : children) {
+    fill_stat(child.mode, child.size, &stbuf);
+    entries.emplace_back(child.base, stbuf);
+    cache_attr(parent + child.base, child.mode, child.id, child.size);
+  }
+  return 0;
+}
+
+int fs::fuse_getattr(const char* path, struct stat* stbuf,
+                     struct fuse_file_info*) {
+  DLOG(INFO) << "fuse: getattr on " << path;
+
   {
+    std::lock_guard<std::mutex> guard(state.mtx_);
     auto iter = state.mutable_views.find(path);
     if (iter != state.mutable_views.end()) {
-      stbuf->st_size = iter->second->length();
+      fill_stat(S_IFREG, iter->second->length(), stbuf);
       return 0;
     }
   }
 
+  fs_state_t::attr_t attr;
+  int err = resolve_attr(path, attr);
+  if (err != 0) {
+    return err;
+  }
+  fill_stat(attr.mode, attr.size, stbuf);
+  return 0;
+}
+
+int fs::fuse_unlink(const char* path) {
+  DLOG(INFO) << "fuse: unlink " << path;
+
+  std::string path_string(path);
+  fs_state_t::attr_t attr;
+  int err = resolve_attr(path_string, attr);
+  if (err != 0) {
+    return err;
+  }
+  if (S_ISDIR(attr.mode)) {
+    return -EISDIR;
+  }
+
+  // drops the name as well, if the file is referenced by name
+  std::string name;
+  if (boost::algorithm::starts_with(path_string, kNamesDir + "/")) {
+    name = strip_view_suffix(path_string.substr(kNamesDir.length() + 1));
+  } else if (!boost::algorithm::starts_with(path_string, kTypesDir + "/")) {
+    name = name_from_path(path_string);
+  }
+  ObjectID target = InvalidObjectID();
+  if (!name.empty() && state.client->GetName(name, target).ok() &&
+      target == attr.id) {
+    VINEYARD_DISCARD(state.client->DropName(name));
+  }
+  auto status = state.client->DelData(attr.id, false, true);
   {
-    std::string path_string(path);
-    if (!boost::algorithm::ends_with(path_string, ".arrow")) {
-      DLOG(INFO) << path_string << "should end with arrow";
-      return -ENOENT;
-    }
-    ObjectID target = InvalidObjectID();
-    auto prefix = name_from_path(path);
-    auto status = state.client->GetName(prefix, target);
-    if (status.ok()) {
-      DLOG(INFO) << "get attr name not exists";
-      bool exists = false;
-      VINEYARD_CHECK_OK(state.client->Exists(target, exists));
-      if (!exists) {
-        return -ENOENT;
-      }
-      auto obj = state.client->GetObject(target);
-      DLOG(INFO) << "tryting to deserialize" << obj->meta().GetTypeName();
-      auto d =
-          fs::state.ipc_desearilizer_registry.at(obj->meta().GetTypeName());
-      auto buffer = d(obj);
-      state.views[path_string] = buffer;
-
-      stbuf->st_size = buffer->size();
-    } else {
-      auto obj = state.client->GetObject(ObjectIDFromString(prefix));
-      DLOG(INFO) << "trying to deserialize " << obj->meta().GetTypeName();
-
-      if (obj == nullptr) {
-        return -ENOENT;
-      }
-      auto d =
-          fs::state.ipc_desearilizer_registry.at(obj->meta().GetTypeName());
-      auto buffer = d(obj);
-      state.views[path_string] = buffer;
-      stbuf->st_size = buffer->size();
-    }
-    return 0;
+    std::lock_guard<std::mutex> guard(state.mtx_);
+    invalidate(attr.id);
+  }
+  if (!status.ok()) {
+    LOG(ERROR) << "fuse: failed to delete " << path << ": "
+               << status.ToString();
+    return -EIO;
   }
+  return 0;
 }
 
 int fs::fuse_open(const char* path, struct fuse_file_info* fi) {
@@ -141,37 +559,17 @@ int fs::fuse_open(const char* path, struct fuse_file_info* fi) {
     return -EACCES;
   }
 
-  std::lock_guard<std::mutex> guard(state.mtx_);
-
-  // check for the existence todo: switch the name store from the vineyard to
-  // fuse
-
-  // the opened file referenced by the user-defined name
-  auto filename = name_from_path(path);
-  auto target = InvalidObjectID();
-  auto loc = state.views.find(path);
-  std::string path_string(path);
-  std::shared_ptr<vineyard::Object> object = nullptr;
-  if (loc == state.views.end()) {
-    if (state.client->GetName(filename, target).ok()) {
-      object = state.client->GetObject(target);
-    }
-
-    if (object == nullptr) {
-      object = state.client->GetObject(ObjectIDFromString(filename.substr(1)));
-    }
-    if (object == nullptr) {
-      return -ENOENT;
-    } else {
-      auto d =
-          fs::state.ipc_desearilizer_registry.at(object->meta().GetTypeName());
-      state.views[path_string] = d(object);
-    }
+  std::shared_ptr<internal::ChunkBuffer> buffer;
+  int err = resolve_view(path, buffer);
+  if (err != 0) {
+    return err;
   }
+  // pins the view until released, as it may be evicted from the cache
+  fi->fh = reinterpret_cast<uint64_t>(
+      new std::shared_ptr<internal::ChunkBuffer>(buffer));
 
-  // bypass kernel's page cache to avoid knowing the size in `getattr`.
-  // see also:
-  // https://stackoverflow.com/questions/46267972/fuse-avoid-calculating-size-in-getattr
+  // bypass kernel's page cache, as the content is served from the mapped
+  // blobs of vineyard already
   fi->direct_io = 1;
   return 0;
 }
@@ -181,36 +579,32 @@ int fs::fuse_read(const char* path, char* buf, size_t size, off_t offset,
   DLOG(INFO) << "fuse: read " << path << " from " << offset << ", expect "
              << size << " bytes";
 
-  std::unordered_map<
-      std::string, std::shared_ptr<internal::ChunkBuffer>>::const_iterator loc;
-  {
-    std::lock_guard<std::mutex> guard(state.mtx_);
-    loc = state.views.find(path);
+  if (fi != nullptr && fi->fh != 0) {
+    auto const& buffer =
+        *reinterpret_cast<std::shared_ptr<internal::ChunkBuffer>*>(fi->fh);
+    return buffer->readAt(offset, size, buf);
   }
-  if (loc == state.views.end()) {
-    return -ENOENT;
+  std::shared_ptr<internal::ChunkBuffer> buffer;
+  int err = resolve_view(path, buffer);
+  if (err != 0) {
+    return err;
   }
-  auto cbuffer = loc->second;
-  auto readByte = cbuffer->readAt(offset, size, buf);
-  return readByte;
+  return buffer->readAt(offset, size, buf);
 }
 
 int fs::fuse_write(const char* path, const char* buf, size_t size, off_t offset,
                    struct fuse_file_info* fi) {
   DLOG(INFO) << "fuse: write " << path << " from " << offset << ", expect "
              << size << " bytes";
-  std::unordered_map<std::string,
-                     std::shared_ptr<arrow::BufferBuilder>>::const_iterator loc;
-
+  std::shared_ptr<arrow::BufferBuilder> buffer;
   {
     std::lock_guard<std::mutex> guard(state.mtx_);
-
-    loc = state.mutable_views.find(path);
-  }
-  if (loc == state.mutable_views.end()) {
-    return -ENOENT;
+    auto loc = state.mutable_views.find(path);
+    if (loc == state.mutable_views.end()) {
+      return -ENOENT;
+    }
+    buffer = loc->second;
   }
-  auto buffer = loc->second;
   if (static_cast<int64_t>(offset + size) >= buffer->capacity()) {
     VINEYARD_CHECK_OK(buffer->Reserve(offset + size));
   }
@@ -229,30 +623,28 @@ int fs::fuse_flush(const char* path, struct fuse_file_info*) {
   return 0;
 }
 
-int fs::fuse_release(const char* path, struct fuse_file_info*) {
+int fs::fuse_release(const char* path, struct fuse_file_info* fi) {
   DLOG(INFO) << "fuse: release " << path;
 
-  {
-      // TODO: ref count should be used
-      //
-      // auto loc = state.views.find(path);
-      // if (loc != state.views.end()) {
-      //   state.views.erase(loc);
-      //   return 0;
-      // }
+  if (fi != nullptr && fi->fh != 0) {
+    delete reinterpret_cast<std::shared_ptr<internal::ChunkBuffer>*>(fi->fh);
+    fi->fh = 0;
+    return 0;
   }
 
+  std::shared_ptr<arrow::BufferBuilder> buffer;
   {
+    std::lock_guard<std::mutex> guard(state.mtx_);
     auto loc = state.mutable_views.find(path);
-    if (loc != state.mutable_views.end()) {
-      fuse::from_arrow_view(state.client.get(), loc->first, loc->second);
-      loc->second->Reset();
-      state.mutable_views.erase(loc);
-      return 0;
+    if (loc == state.mutable_views.end()) {
+      return -ENOENT;
     }
+    buffer = loc->second;
+    state.mutable_views.erase(loc);
   }
-
-  return -ENOENT;
+  fuse::from_arrow_view(state.client.get(), path, buffer);
+  buffer->Reset();
+  return 0;
 }
 
 int fs::fuse_getxattr(const char* path, const char* name, char*, size_t) {
@@ -262,39 +654,41 @@ int fs::fuse_getxattr(const char* path, const char* name, char*, size_t) {
 
 int fs::fuse_opendir(const char* path, struct fuse_file_info* info) {
   DLOG(INFO) << "fuse: opendir " << path;
+
+  // the listing is taken once and paginated by the offsets of `readdir`
+  std::unique_ptr<dir_t> entries(new dir_t());
+  int err = list_directory(path, *entries);
+  if (err != 0) {
+    return err;
+  }
+  info->fh = reinterpret_cast<uint64_t>(entries.release());
   return 0;
 }
 
 int fs::fuse_readdir(const char* path, void* buf, fuse_fill_dir_t filler,
                      off_t offset, struct fuse_file_info* fi,
                      enum fuse_readdir_flags flags) {
-  DLOG(INFO) << "fuse: readdir " << path;
+  DLOG(INFO) << "fuse: readdir " << path << " from " << offset;
 
-  if (strcmp(path, "/") != 0) {
-    return -ENOENT;
+  if (fi == nullptr || fi->fh == 0) {
+    return -EBADF;
   }
+  auto const& entries = *reinterpret_cast<dir_t*>(fi->fh);
+  for (size_t index = offset; index < entries.size(); ++index) {
+    if (filler(buf, entries[index].first.c_str(), &entries[index].second,
+               index + 1, fuse_fill_dir_flags::FUSE_FILL_DIR_PLUS) != 0) {
+      break;
+    }
+  }
+  return 0;
+}
 
-  filler(buf, ".", NULL, 0, fuse_fill_dir_flags::FUSE_FILL_DIR_PLUS);
-  filler(buf, "..", NULL, 0, fuse_fill_dir_flags::FUSE_FILL_DIR_PLUS);
-
-  std::unordered_map<ObjectID, json> metas{};
-
-  VINEYARD_CHECK_OK(state.client->ListData(
-      ".*", true, std::numeric_limits<size_t>::max(), metas));
-  for (auto const& item : metas) {
-    if (item.second.contains("__name")) {
-      std::string base = item.second["__name"].get<std::string>() + ".arrow";
-      DLOG(INFO) << "open object with name" << base;
-      filler(buf, base.c_str(), NULL, 0,
-             fuse_fill_dir_flags::FUSE_FILL_DIR_PLUS);
-    } else {
-      std::string base = ObjectIDToString(item.first).c_str();
-      base.append(".arrow");
-      DLOG(INFO) << "open object without name" << base;
+int fs::fuse_releasedir(const char* path, struct fuse_file_info* fi) {
+  DLOG(INFO) << "fuse: releasedir " << path;
 
-      filler(buf, base.c_str(), NULL, 0,
-             fuse_fill_dir_flags::FUSE_FILL_DIR_PLUS);
-    }
+  if (fi != nullptr && fi->fh != 0) {
+    delete reinterpret_cast<dir_t*>(fi->fh);
+    fi->fh = 0;
   }
   return 0;
 }
@@ -305,6 +699,13 @@ void* fs::fuse_init(struct fuse_conn_info* conn, struct fuse_config* cfg) {
   state.client.reset(new vineyard::Client());
   state.client->Connect(state.vineyard_socket);
 
+  state.attrs_capacity =
+      std::stoul(read_env("VINEYARD_FUSE_ATTR_CACHE_SIZE", "1048576"));
+  state.attrs_ttl = std::chrono::seconds(
+      std::stol(read_env("VINEYARD_FUSE_ATTR_CACHE_TTL", "10")));
+  state.views_capacity =
+      std::stoul(read_env("VINEYARD_FUSE_VIEW_CACHE_SIZE", "1024"));
+
   fuse_apply_conn_info_opts(state.conn_opts, conn);
   // conn->max_read = conn->max_readahead;
 
@@ -315,8 +716,15 @@ void* fs::fuse_init(struct fuse_conn_info* conn, struct fuse_config* cfg) {
 void fs::fuse_destroy(void* private_data) {
   DLOG(INFO) << "fuse: destroy";
 
-  state.views.clear();
-  state.mutable_views.clear();
+  {
+    std::lock_guard<std::mutex> guard(state.mtx_);
+    state.attrs.clear();
+    state.attrs_lru.clear();
+    state.attr_paths.clear();
+    state.views.clear();
+    state.views_lru.clear();
+    state.mutable_views.clear();
+  }
   state.client->Disconnect();
 }
 
@@ -328,6 +736,7 @@ int fs::fuse_access(const char* path, int mode) {
 
 int fs::fuse_create(const char* path, mode_t mode, struct fuse_file_info*) {
   DLOG(INFO) << "fuse: create " << path << " with mode " << mode;
+  std::lock_guard<std::mutex> guard(state.mtx_);
   if (state.mutable_views.find(path) != state.mutable_views.end()) {
     LOG(ERROR) << "fuse: create: file already exists" << path;
     return EEXIST;
@@ -16,12 +16,16 @@ limitations under the License.
 #ifndef MODULES_FUSE_FUSE_IMPL_H_
 #define MODULES_FUSE_FUSE_IMPL_H_
 
+#include <array>
+#include <chrono>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <ostream>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -50,9 +54,47 @@ struct fs {
     struct fuse_conn_info_opts* conn_opts;
     std::string vineyard_socket;
     std::shared_ptr<Client> client;
+
+    // guards the caches and mutable_views only, and is never held while
+    // talking to vineyardd
     std::mutex mtx_;
-    std::unordered_map<std::string, std::shared_ptr<internal::ChunkBuffer>>
-        views;
+    // serializes the resolving of attributes and views per path or object
+    // (hashed to a fixed set of mutexes), thus different files are resolved
+    // concurrently
+    std::array<std::mutex, 64> path_mtx_;
+
+    // The attributes of files and directories, keyed by path, where the
+    // size of a file is the size of the view of the object (an arrow IPC
+    // file) resolved with no data copied. Entries expire after `attrs_ttl`,
+    // thus names rebound or objects deleted by others are picked up, and at
+    // most `attrs_capacity` entries are cached, see also
+    // `VINEYARD_FUSE_ATTR_CACHE_TTL` and `VINEYARD_FUSE_ATTR_CACHE_SIZE`.
+    struct attr_t {
+      mode_t mode;
+      ObjectID id;
+      int64_t size;
+      std::chrono::steady_clock::time_point expire;
+      std::list<std::string>::iterator lru;
+    };
+    size_t attrs_capacity;
+    std::chrono::seconds attrs_ttl;
+    std::list<std::string> attrs_lru;
+    std::unordered_map<std::string, attr_t> attrs;
+    // the cached paths of each object, for invalidating on deletion
+    std::unordered_map<ObjectID, std::unordered_set<std::string>> attr_paths;
+
+    // The content of views, i.e., the IPC headers stitched with the blobs in
+    // vineyard, keyed by object as objects are immutable. At most
+    // `views_capacity` views are cached and the least recently used ones are
+    // evicted, see also `VINEYARD_FUSE_VIEW_CACHE_SIZE`.
+    struct view_t {
+      std::shared_ptr<internal::ChunkBuffer> buffer;
+      std::list<ObjectID>::iterator lru;
+    };
+    size_t views_capacity;
+    std::list<ObjectID> views_lru;
+    std::unordered_map<ObjectID, view_t> views;
+
     std::unordered_map<std::string, std::shared_ptr<arrow::BufferBuilder>>
         mutable_views;
     std::unordered_map<std::string, vineyard::fuse::vineyard_deserializer_nt>
@@ -62,6 +104,8 @@ struct fs {
   static int fuse_getattr(const char* path, struct stat* stbuf,
                           struct fuse_file_info*);
 
+  static int fuse_unlink(const char* path);
+
   static int fuse_open(const char* path, struct fuse_file_info* fi);
 
   static int fuse_read(const char* path, char* buf, size_t size, off_t offset,
@@ -84,6 +128,8 @@ struct fs {
                           off_t offset, struct fuse_file_info* fi,
                           enum fuse_readdir_flags flags);
 
+  static int fuse_releasedir(const char* path, struct fuse_file_info* fi);
+
   static void* fuse_init(struct fuse_conn_info* conn, struct fuse_config* cfg);
 
   static void fuse_destroy(void* private_data);
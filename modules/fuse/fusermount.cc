@@ -96,6 +96,7 @@ static int process_args(struct fuse_args& args, int argc, char** argv) {
 
 static const struct fuse_operations vineyard_fuse_operations = {
     .getattr = vineyard::fuse::fs::fuse_getattr,
+    .unlink = vineyard::fuse::fs::fuse_unlink,
     .open = vineyard::fuse::fs::fuse_open,
     .read = vineyard::fuse::fs::fuse_read,
     .write = vineyard::fuse::fs::fuse_write,
@@ -105,6 +106,7 @@ static const struct fuse_operations vineyard_fuse_operations = {
     .getxattr = vineyard::fuse::fs::fuse_getxattr,
     .opendir = vineyard::fuse::fs::fuse_opendir,
     .readdir = vineyard::fuse::fs::fuse_readdir,
+    .releasedir = vineyard::fuse::fs::fuse_releasedir,
     .init = vineyard::fuse::fs::fuse_init,
     .destroy = vineyard::fuse::fs::fuse_destroy,
     .create = vineyard::fuse::fs::fuse_create,
@@ -40,7 +40,7 @@ std::vector<int64_t> randomChunks(int n, const int64_t len) {
     res.emplace(t);
   }
   res.emplace(0);
-  res.emplace(len - 1);
+  res.emplace(len);
 
   return std::vector<int64_t>(res.begin(), res.end());
 }
@@ -58,17 +58,21 @@ int main() {
     auto chunks = randomChunks(chunks_num, len);
 
     for (size_t i = 1; i < chunks.size(); i++) {
-      cb->Write(&test[chunks[i - 1]], chunks[i] - chunks[i - 1] + 1);
+      cb->Write(&test[chunks[i - 1]], chunks[i] - chunks[i - 1]);
     }
+    CHECK_EQ(cb->size(), len);
     for (int64_t i = 0; i < (int64_t) test.size(); ++i) {
-      for (int64_t j = 0; j < (int64_t) test.size(); ++i) {
-        int64_t chunk_len = i - j + 1;
-        cb->readAt(i, chunk_len, buf);
+      for (int64_t j = i; j < (int64_t) test.size(); ++j) {
+        int64_t chunk_len = j - i + 1;
+        CHECK_EQ(cb->readAt(i, chunk_len, buf), chunk_len);
         for (int64_t k = 0; k < chunk_len; k++) {
           CHECK_EQ(buf[k], test[i + k]);
         }
       }
     }
+    // reads beyond the end are truncated
+    CHECK_EQ(cb->readAt(len - 10, 100, buf), 10);
+    CHECK_EQ(cb->readAt(len, 100, buf), 0);
   }
 
   // test Write(const std::shared_ptr<arrow::Buffer>& data)
@@ -78,17 +82,16 @@ int main() {
 
     for (int64_t i = 1; i < (int64_t) chunks.size(); i++) {
       auto b = arrow::Buffer::Wrap(&test[chunks[i - 1]],
-                                   chunks[i] - chunks[i - 1] + 1);
+                                   chunks[i] - chunks[i - 1]);
       cb->Write(b);
     }
+    CHECK_EQ(cb->size(), len);
     for (int64_t i = 0; i < (int64_t) test.size(); ++i) {
-      for (int64_t j = 0; j < (int64_t) test.size(); ++i) {
-        int chunk_len = i - j + 1;
-        cb->readAt(i, chunk_len, buf);
-        for (int k = 0; k < (int64_t) chunk_len; k++) {
-          if (buf[k] != test[i + k]) {
-            CHECK_EQ(buf[k], test[i + k]);
-          }
+      for (int64_t j = i; j < (int64_t) test.size(); ++j) {
+        int64_t chunk_len = j - i + 1;
+        CHECK_EQ(cb->readAt(i, chunk_len, buf), chunk_len);
+        for (int64_t k = 0; k < chunk_len; k++) {
+          CHECK_EQ(buf[k], test[i + k]);
         }
       }
     }
@@ -158,3 +158,26 @@ def test_fuse_df(vineyard_client, vineyard_fuse_mount_dir):
         str(id)[11:28] + ".arrow", vineyard_fuse_mount_dir
     )
     assert_dataframe(data, extracted_data)
+
+
+def test_fuse_listing(vineyard_client, vineyard_fuse_mount_dir):
+    data = generate_dataframe()
+
+    id = vineyard_client.put(data)
+    vineyard_client.put_name(id, "fuse_test/listing")
+    names_dir = os.path.join(vineyard_fuse_mount_dir, "names")
+    assert "fuse_test" in os.listdir(names_dir)
+    assert "listing.arrow" in os.listdir(os.path.join(names_dir, "fuse_test"))
+
+    # the size is resolved without reading the content, and matches it
+    path = os.path.join(names_dir, "fuse_test", "listing.arrow")
+    with open(path, 'rb') as source:
+        assert os.path.getsize(path) == len(source.read())
+    extracted_data = read_data_from_fuse(
+        os.path.join("names", "fuse_test", "listing.arrow"),
+        vineyard_fuse_mount_dir,
+    )
+    assert_dataframe(data, extracted_data)
+
+    os.unlink(path)
+    assert "fuse_test" not in os.listdir(names_dir)
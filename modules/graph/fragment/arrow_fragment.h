@@ -19,6 +19,7 @@ limitations under the License.
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -52,6 +53,132 @@ namespace vineyard {
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
 class ArrowFragmentBaseBuilder;
 
+/**
+ * @brief The builder for fragments derived from an existing one (e.g., by
+ * adding labels), which additionally seals the delta outer vertex maps as the
+ * optional "ovg2l_delta_map_<label>" members, and the compressed adjacency
+ * lists as the optional "compressed_{ie,oe}_list_<v_label>_<e_label>"
+ * members.
+ */
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
+class DerivedArrowFragmentBuilder
+    : public ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> {
+  using Base = ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T>;
+  using fragment_t = ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>;
+  using label_id_t = property_graph_types::LABEL_ID_TYPE;
+
+ public:
+  explicit DerivedArrowFragmentBuilder(fragment_t const& fragment)
+      : Base(fragment),
+        ovg2l_delta_maps_(fragment.ovg2l_delta_maps_.begin(),
+                          fragment.ovg2l_delta_maps_.end()) {
+    if (fragment.compressed_) {
+      for (size_t i = 0; i < fragment.compressed_oe_lists_.size(); ++i) {
+        for (size_t j = 0; j < fragment.compressed_oe_lists_[i].size(); ++j) {
+          set_compressed_oe_list(i, j, fragment.compressed_oe_lists_[i][j]);
+          if (fragment.directed_) {
+            set_compressed_ie_list(i, j, fragment.compressed_ie_lists_[i][j]);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Replace the delta outer vertex map of the given label, a `nullptr`
+   * drops it.
+   */
+  void set_ovg2l_delta_map(label_id_t v_label,
+                           std::shared_ptr<ObjectBase> const& delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (static_cast<size_t>(v_label) >= ovg2l_delta_maps_.size()) {
+      ovg2l_delta_maps_.resize(v_label + 1);
+    }
+    ovg2l_delta_maps_[v_label] = delta;
+  }
+
+  /**
+   * @brief Replace the compressed outgoing adjacency list of the given labels,
+   * see also `ArrowFragment::CompressAdjLists()`.
+   */
+  void set_compressed_oe_list(label_id_t v_label, label_id_t e_label,
+                              std::shared_ptr<ObjectBase> const& list) {
+    set_compressed_list(compressed_oe_lists_, v_label, e_label, list);
+  }
+
+  /**
+   * @brief Replace the compressed incoming adjacency list of the given labels,
+   * which is absent for undirected fragments.
+   */
+  void set_compressed_ie_list(label_id_t v_label, label_id_t e_label,
+                              std::shared_ptr<ObjectBase> const& list) {
+    set_compressed_list(compressed_ie_lists_, v_label, e_label, list);
+  }
+
+  Status _Assemble(Client& client, std::shared_ptr<Object>& object) override {
+    RETURN_ON_ERROR(Base::_Assemble(client, object));
+    auto value = std::dynamic_pointer_cast<fragment_t>(object);
+    auto& meta = this->ValueMetaRef(value);
+    size_t nbytes = meta.GetNBytes();
+    for (size_t i = 0; i < ovg2l_delta_maps_.size(); ++i) {
+      if (ovg2l_delta_maps_[i] == nullptr) {
+        continue;
+      }
+      auto delta = ovg2l_delta_maps_[i]->_Seal(client);
+      RETURN_ON_ASSERT(delta != nullptr,
+                       "Failed to seal the delta outer vertex map");
+      meta.AddMember(generate_name_with_suffix("ovg2l_delta_map", i), delta);
+      nbytes += delta->nbytes();
+    }
+    bool compressed = false;
+    auto seal_lists = [&](const std::string& prefix,
+                          compressed_lists_t const& lists) -> Status {
+      for (size_t i = 0; i < lists.size(); ++i) {
+        for (size_t j = 0; j < lists[i].size(); ++j) {
+          if (lists[i][j] == nullptr) {
+            continue;
+          }
+          auto list = lists[i][j]->_Seal(client);
+          RETURN_ON_ASSERT(list != nullptr,
+                           "Failed to seal the compressed adjacency list");
+          meta.AddMember(generate_name_with_suffix(prefix, i, j), list);
+          nbytes += list->nbytes();
+          compressed = true;
+        }
+      }
+      return Status::OK();
+    };
+    RETURN_ON_ERROR(seal_lists("compressed_oe_list", compressed_oe_lists_));
+    RETURN_ON_ERROR(seal_lists("compressed_ie_list", compressed_ie_lists_));
+    if (compressed) {
+      meta.AddKeyValue("compressed_", true);
+    }
+    meta.SetNBytes(nbytes);
+    return Status::OK();
+  }
+
+ private:
+  using compressed_lists_t =
+      std::vector<std::vector<std::shared_ptr<ObjectBase>>>;
+
+  void set_compressed_list(compressed_lists_t& lists, label_id_t v_label,
+                           label_id_t e_label,
+                           std::shared_ptr<ObjectBase> const& list) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (static_cast<size_t>(v_label) >= lists.size()) {
+      lists.resize(v_label + 1);
+    }
+    if (static_cast<size_t>(e_label) >= lists[v_label].size()) {
+      lists[v_label].resize(e_label + 1);
+    }
+    lists[v_label][e_label] = list;
+  }
+
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<ObjectBase>> ovg2l_delta_maps_;
+  compressed_lists_t compressed_ie_lists_, compressed_oe_lists_;
+};
+
 template <typename OID_T, typename VID_T,
           typename VERTEX_MAP_T =
               ArrowVertexMap<typename InternalType<OID_T>::type, VID_T>>
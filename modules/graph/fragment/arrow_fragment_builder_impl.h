@@ -45,6 +45,7 @@ limitations under the License.
 #include "graph/fragment/arrow_fragment.h"
 #include "graph/fragment/fragment_traits.h"
 #include "graph/fragment/graph_schema.h"
+#include "graph/fragment/graph_statistics.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/fragment/property_graph_utils.h"
 #include "graph/utils/context_protocols.h"
@@ -151,6 +152,11 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
     const std::vector<std::set<std::pair<std::string, std::string>>>&
         edge_relations,
     int concurrency) {
+  if (compressed_) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "Cannot add labels to a fragment whose adjacency lists "
+                    "are compressed");
+  }
   int extra_vertex_label_num = vertex_tables.size();
   int total_vertex_label_num = vertex_label_num_ + extra_vertex_label_num;
   int extra_edge_label_num = edge_tables.size();
@@ -195,12 +201,17 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
   VLOG(100) << "Add new vertices and edges: before init the new vertex map: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
 
-  // Make a copy of ovg2l map, since we need to add some extra outer vertices
-  // pulled in this fragment by new edges.
+  // The extra outer vertices pulled in this fragment by new edges are added
+  // to a copy of the (small) delta map, the base map is shared with this
+  // fragment as is.
   std::vector<ovg2l_map_t> ovg2l_maps(total_vertex_label_num);
   for (int i = 0; i < vertex_label_num_; ++i) {
-    for (auto iter = ovg2l_maps_ptr_[i]->begin();
-         iter != ovg2l_maps_ptr_[i]->end(); ++iter) {
+    const auto* delta = ovg2l_delta_maps_ptr_[i];
+    if (delta == nullptr) {
+      continue;
+    }
+    ovg2l_maps[i].reserve(delta->size());
+    for (auto iter = delta->begin(); iter != delta->end(); ++iter) {
       ovg2l_maps[i].emplace(iter->first, iter->second);
     }
   }
@@ -214,7 +225,8 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
   // Add extra outer vertices to ovg2l map, and collect distinct gid of extra
   // outer vertices.
   generate_outer_vertices_map(vid_parser_, fid_, total_vertex_label_num, srcs,
-                              dsts, start_ids, ovg2l_maps, extra_ovgid_lists);
+                              dsts, start_ids, ovg2l_maps, extra_ovgid_lists,
+                              ovg2l_maps_ptr_);
 
   VLOG(100) << "Add new vertices and edges: after generate_outer_vertices_map: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
@@ -261,9 +273,9 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
   }
   for (int i = 0; i < extra_edge_label_num; ++i) {
     generate_local_id_list(vid_parser_, std::move(srcs[i]), fid_, ovg2l_maps,
-                           concurrency, edge_src[i], pool);
+                           concurrency, edge_src[i], pool, ovg2l_maps_ptr_);
     generate_local_id_list(vid_parser_, std::move(dsts[i]), fid_, ovg2l_maps,
-                           concurrency, edge_dst[i], pool);
+                           concurrency, edge_dst[i], pool, ovg2l_maps_ptr_);
   }
   VLOG(100) << "Add new vertices and edges: after generate_local_id_list: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
@@ -351,24 +363,12 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
     } else {
       auto cur_label_index = e_label - edge_label_num_;
       // Process v_num...total_v_num  X  0...e_num  part.
-      if (directed_) {
-        // Process 0...total_v_num  X  e_num...total_e_num  part.
-        generate_directed_csr<vid_t, eid_t>(
-            client, vid_parser_, std::move(edge_src[cur_label_index]),
-            std::move(edge_dst[cur_label_index]), tvnums,
-            total_vertex_label_num, concurrency, sub_oe_lists,
-            sub_oe_offset_lists, is_multigraph_);
-        generate_directed_csc<vid_t, eid_t>(
-            client, vid_parser_, tvnums, total_vertex_label_num, concurrency,
-            sub_oe_lists, sub_oe_offset_lists, sub_ie_lists,
-            sub_ie_offset_lists, is_multigraph_);
-      } else {
-        generate_undirected_csr_memopt<vid_t, eid_t>(
-            client, vid_parser_, std::move(edge_src[cur_label_index]),
-            std::move(edge_dst[cur_label_index]), tvnums,
-            total_vertex_label_num, concurrency, sub_oe_lists,
-            sub_oe_offset_lists, is_multigraph_);
-      }
+      // Process 0...total_v_num  X  e_num...total_e_num  part.
+      generate_csr_by_strategy<vid_t, eid_t>(
+          client, vid_parser_, std::move(edge_src[cur_label_index]),
+          std::move(edge_dst[cur_label_index]), tvnums, total_vertex_label_num,
+          concurrency, directed_, sub_oe_lists, sub_oe_offset_lists,
+          sub_ie_lists, sub_ie_offset_lists, is_multigraph_);
     }
 
     for (label_id_t v_label = 0; v_label < total_vertex_label_num; ++v_label) {
@@ -387,9 +387,10 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
   VLOG(100) << "Add new vertices and edges: after generate CSR: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
 
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   builder.set_vertex_label_num_(total_vertex_label_num);
   builder.set_edge_label_num_(total_edge_label_num);
+  builder.set_edge_statistics_json_(json::object());
 
   auto schema = schema_;  // make a copy
 
@@ -470,7 +471,8 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
   // If the map have no new entries, clear it to indicate using the old map
   // when seal.
   for (int i = 0; i < vertex_label_num_; ++i) {
-    if (ovg2l_maps_ptr_[i]->size() == ovg2l_maps[i].size()) {
+    const auto* delta = ovg2l_delta_maps_ptr_[i];
+    if ((delta == nullptr ? 0 : delta->size()) == ovg2l_maps[i].size()) {
       ovg2l_maps[i].clear();
     }
   }
@@ -483,12 +485,15 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexEdgeLabels(
         builder.set_ovgid_lists_(i, ovgid_lists[i]);
       }
 
-      if (i >= vertex_label_num_ || !ovg2l_maps[i].empty()) {
+      if (i >= vertex_label_num_) {
         vineyard::HashmapBuilder<vid_t, vid_t> ovg2l_builder(
             *client, std::move(ovg2l_maps[i]));
         std::shared_ptr<Object> ovg2l_map;
         RETURN_ON_ERROR(ovg2l_builder.Seal(*client, ovg2l_map));
         builder.set_ovg2l_maps_(i, ovg2l_map);
+      } else if (!ovg2l_maps[i].empty()) {
+        RETURN_ON_ERROR(sealOuterVertexMap(*client, i, std::move(ovg2l_maps[i]),
+                                           builder));
       }
       return Status::OK();
     };
@@ -548,6 +553,11 @@ boost::leaf::result<ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexLabels(
     Client& client, std::vector<std::shared_ptr<arrow::Table>>&& vertex_tables,
     ObjectID vm_id) {
+  if (compressed_) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "Cannot add labels to a fragment whose adjacency lists "
+                    "are compressed");
+  }
   int extra_vertex_label_num = vertex_tables.size();
   int total_vertex_label_num = vertex_label_num_ + extra_vertex_label_num;
 
@@ -569,8 +579,9 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewVertexLabels(
     tvnums[vertex_label_num_ + i] = ivnums[vertex_label_num_ + i];
   }
 
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   builder.set_vertex_label_num_(total_vertex_label_num);
+  builder.set_edge_statistics_json_(json::object());
 
   VLOG(100) << "Add new vertices: start: " << get_rss_pretty()
             << ", peak: " << get_peak_rss_pretty();
@@ -695,6 +706,11 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
     const std::vector<std::set<std::pair<std::string, std::string>>>&
         edge_relations,
     int concurrency) {
+  if (compressed_) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "Cannot add labels to a fragment whose adjacency lists "
+                    "are compressed");
+  }
   int extra_edge_label_num = edge_tables.size();
   int total_edge_label_num = edge_label_num_ + extra_edge_label_num;
 
@@ -713,12 +729,17 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   VLOG(100) << "Add new edges: before init the new vertex map: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
 
-  // Make a copy of ovg2l map, since we need to add some extra outer vertices
-  // pulled in this fragment by new edges.
+  // The extra outer vertices pulled in this fragment by new edges are added
+  // to a copy of the (small) delta map, the base map is shared with this
+  // fragment as is.
   std::vector<ovg2l_map_t> ovg2l_maps(vertex_label_num_);
   for (int i = 0; i < vertex_label_num_; ++i) {
-    for (auto iter = ovg2l_maps_ptr_[i]->begin();
-         iter != ovg2l_maps_ptr_[i]->end(); ++iter) {
+    const auto* delta = ovg2l_delta_maps_ptr_[i];
+    if (delta == nullptr) {
+      continue;
+    }
+    ovg2l_maps[i].reserve(delta->size());
+    for (auto iter = delta->begin(); iter != delta->end(); ++iter) {
       ovg2l_maps[i].emplace(iter->first, iter->second);
     }
   }
@@ -735,7 +756,8 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   std::vector<std::shared_ptr<vid_array_t>> extra_ovgid_lists(
       vertex_label_num_);
   generate_outer_vertices_map(vid_parser_, fid_, vertex_label_num_, srcs, dsts,
-                              start_ids, ovg2l_maps, extra_ovgid_lists);
+                              start_ids, ovg2l_maps, extra_ovgid_lists,
+                              ovg2l_maps_ptr_);
 
   VLOG(100) << "Init edges: after generate_outer_vertices_map: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
@@ -816,9 +838,9 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   }
   for (int i = 0; i < extra_edge_label_num; ++i) {
     generate_local_id_list(vid_parser_, std::move(srcs[i]), fid_, ovg2l_maps,
-                           concurrency, edge_src[i], pool);
+                           concurrency, edge_src[i], pool, ovg2l_maps_ptr_);
     generate_local_id_list(vid_parser_, std::move(dsts[i]), fid_, ovg2l_maps,
-                           concurrency, edge_dst[i], pool);
+                           concurrency, edge_dst[i], pool, ovg2l_maps_ptr_);
   }
   VLOG(100) << "Add new edges: after generate_local_id_list: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
@@ -851,21 +873,11 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
         vertex_label_num_);
     std::vector<std::shared_ptr<FixedInt64Builder>> sub_oe_offset_lists(
         vertex_label_num_);
-    if (directed_) {
-      generate_directed_csr<vid_t, eid_t>(
-          client, vid_parser_, std::move(edge_src[e_label]),
-          std::move(edge_dst[e_label]), tvnums, vertex_label_num_, concurrency,
-          sub_oe_lists, sub_oe_offset_lists, is_multigraph_);
-      generate_directed_csc<vid_t, eid_t>(
-          client, vid_parser_, tvnums, vertex_label_num_, concurrency,
-          sub_oe_lists, sub_oe_offset_lists, sub_ie_lists, sub_ie_offset_lists,
-          is_multigraph_);
-    } else {
-      generate_undirected_csr_memopt<vid_t, eid_t>(
-          client, vid_parser_, std::move(edge_src[e_label]),
-          std::move(edge_dst[e_label]), tvnums, vertex_label_num_, concurrency,
-          sub_oe_lists, sub_oe_offset_lists, is_multigraph_);
-    }
+    generate_csr_by_strategy<vid_t, eid_t>(
+        client, vid_parser_, std::move(edge_src[e_label]),
+        std::move(edge_dst[e_label]), tvnums, vertex_label_num_, concurrency,
+        directed_, sub_oe_lists, sub_oe_offset_lists, sub_ie_lists,
+        sub_ie_offset_lists, is_multigraph_);
 
     for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
       if (directed_) {
@@ -880,8 +892,9 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   VLOG(100) << "Add new edges: after generate CSR: " << get_rss_pretty()
             << ", peak: " << get_peak_rss_pretty();
 
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   builder.set_edge_label_num_(total_edge_label_num);
+  builder.set_edge_statistics_json_(json::object());
 
   auto schema = schema_;
   for (label_id_t extra_label_id = 0; extra_label_id < extra_edge_label_num;
@@ -929,25 +942,23 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   // If the map have no new entries, clear it to indicate using the old map
   // when seal.
   for (int i = 0; i < vertex_label_num_; ++i) {
-    if (ovg2l_maps_ptr_[i]->size() == ovg2l_maps[i].size()) {
+    const auto* delta = ovg2l_delta_maps_ptr_[i];
+    if ((delta == nullptr ? 0 : delta->size()) == ovg2l_maps[i].size()) {
       ovg2l_maps[i].clear();
     }
   }
   builder.ovgid_lists_.resize(vertex_label_num_);
   builder.ovg2l_maps_.resize(vertex_label_num_);
   for (label_id_t i = 0; i < vertex_label_num_; ++i) {
-    auto fn = [&builder, i, &ovgid_lists,
+    auto fn = [this, &builder, i, &ovgid_lists,
                &ovg2l_maps](Client* client) -> Status {
       if (ovgid_lists[i] != nullptr) {
         builder.set_ovgid_lists_(i, ovgid_lists[i]);
       }
 
       if (!ovg2l_maps[i].empty()) {
-        vineyard::HashmapBuilder<vid_t, vid_t> ovg2l_builder(
-            *client, std::move(ovg2l_maps[i]));
-        std::shared_ptr<Object> ovg2l_map_object;
-        RETURN_ON_ERROR(ovg2l_builder.Seal(*client, ovg2l_map_object));
-        builder.set_ovg2l_maps_(i, ovg2l_map_object);
+        RETURN_ON_ERROR(sealOuterVertexMap(*client, i, std::move(ovg2l_maps[i]),
+                                           builder));
       }
       return Status::OK();
     };
@@ -1008,6 +1019,77 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddNewEdgeLabels(
   return fragment_object->id();
 }
 
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
+boost::leaf::result<ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::CompactOuterVertexMaps(
+    Client& client) {
+  std::vector<label_id_t> labels;
+  for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+    if (ovg2l_delta_maps_ptr_[i] != nullptr &&
+        ovg2l_delta_maps_ptr_[i]->size() != 0) {
+      labels.push_back(i);
+    }
+  }
+  if (labels.empty()) {
+    return this->id();
+  }
+
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  ThreadGroup tg;
+  for (label_id_t i : labels) {
+    auto fn = [this, &builder, i](Client* client) -> Status {
+      ovg2l_map_t delta;
+      delta.reserve(ovg2l_delta_maps_ptr_[i]->size());
+      for (auto iter = ovg2l_delta_maps_ptr_[i]->begin();
+           iter != ovg2l_delta_maps_ptr_[i]->end(); ++iter) {
+        delta.emplace(iter->first, iter->second);
+      }
+      return sealOuterVertexMap(*client, i, std::move(delta), builder, true);
+    };
+    tg.AddTask(fn, &client);
+  }
+  Status status;
+  for (auto const& s : tg.TakeResults()) {
+    status += s;
+  }
+  VY_OK_OR_RAISE(status);
+
+  std::shared_ptr<Object> fragment_object;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_object));
+  return fragment_object->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
+Status ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::sealOuterVertexMap(
+    Client& client, label_id_t v_label, ovg2l_map_t&& delta,
+    DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>& builder,
+    bool compact) const {
+  const auto* base = ovg2l_maps_ptr_[v_label];
+  compact = compact || static_cast<double>(delta.size()) >
+                           DefaultOuterVertexCompactionRatio() *
+                               static_cast<double>(base->size());
+  std::shared_ptr<Object> object;
+  if (compact) {
+    VLOG(100) << "Compact the outer vertex map of label " << v_label
+              << ": base = " << base->size() << ", delta = " << delta.size();
+    delta.reserve(delta.size() + base->size());
+    for (auto iter = base->begin(); iter != base->end(); ++iter) {
+      delta.emplace(iter->first, iter->second);
+    }
+    vineyard::HashmapBuilder<vid_t, vid_t> ovg2l_builder(client,
+                                                         std::move(delta));
+    RETURN_ON_ERROR(ovg2l_builder.Seal(client, object));
+    builder.set_ovg2l_maps_(v_label, object);
+    builder.set_ovg2l_delta_map(v_label, nullptr);
+    return Status::OK();
+  }
+  vineyard::HashmapBuilder<vid_t, vid_t> delta_builder(client,
+                                                       std::move(delta));
+  RETURN_ON_ERROR(delta_builder.Seal(client, object));
+  builder.set_ovg2l_delta_map(v_label, object);
+  return Status::OK();
+}
+
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
 vineyard::Status BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
     vineyard::Client& client) {
@@ -1076,6 +1158,8 @@ vineyard::Status BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
   }
   Base::oe_lists_.resize(this->vertex_label_num_);
   Base::oe_offsets_lists_.resize(this->vertex_label_num_);
+  EdgeStatistics statistics(this->directed_, this->vertex_label_num_,
+                            this->edge_label_num_);
   for (label_id_t i = 0; i < this->vertex_label_num_; ++i) {
     if (this->directed_) {
       Base::ie_lists_[i].resize(this->edge_label_num_);
@@ -1084,7 +1168,13 @@ vineyard::Status BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
     Base::oe_lists_[i].resize(this->edge_label_num_);
     Base::oe_offsets_lists_[i].resize(this->edge_label_num_);
     for (label_id_t j = 0; j < this->edge_label_num_; ++j) {
-      auto fn = [this, i, j](Client* client) -> Status {
+      auto fn = [this, i, j, &statistics](Client* client) -> Status {
+        statistics.out_degrees(i, j) = DegreeStatistics::Compute(
+            oe_offsets_lists_[i][j]->data(), ivnums_[i]);
+        if (this->directed_) {
+          statistics.in_degrees(i, j) = DegreeStatistics::Compute(
+              ie_offsets_lists_[i][j]->data(), ivnums_[i]);
+        }
         std::shared_ptr<Object> object;
         if (this->directed_) {
           RETURN_ON_ERROR(ie_lists_[i][j]->Seal(*client, object));
@@ -1106,6 +1196,7 @@ vineyard::Status BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
 
   tg.TakeResults();
 
+  this->set_edge_statistics_json_(statistics.ToJSON());
   this->set_vm_ptr_(vm_ptr_);
 
   this->set_oid_type(type_name<oid_t>());
@@ -1242,21 +1333,11 @@ BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::initEdges(
         this->vertex_label_num_);
     std::vector<std::shared_ptr<FixedInt64Builder>> sub_oe_offset_lists(
         this->vertex_label_num_);
-    if (this->directed_) {
-      generate_directed_csr<vid_t, eid_t>(
-          client_, vid_parser_, std::move(edge_src[e_label]),
-          std::move(edge_dst[e_label]), tvnums_, this->vertex_label_num_,
-          concurrency, sub_oe_lists, sub_oe_offset_lists, this->is_multigraph_);
-      generate_directed_csc<vid_t, eid_t>(
-          client_, vid_parser_, tvnums_, this->vertex_label_num_, concurrency,
-          sub_oe_lists, sub_oe_offset_lists, sub_ie_lists, sub_ie_offset_lists,
-          this->is_multigraph_);
-    } else {
-      generate_undirected_csr_memopt<vid_t, eid_t>(
-          client_, vid_parser_, std::move(edge_src[e_label]),
-          std::move(edge_dst[e_label]), tvnums_, this->vertex_label_num_,
-          concurrency, sub_oe_lists, sub_oe_offset_lists, this->is_multigraph_);
-    }
+    generate_csr_by_strategy<vid_t, eid_t>(
+        client_, vid_parser_, std::move(edge_src[e_label]),
+        std::move(edge_dst[e_label]), tvnums_, this->vertex_label_num_,
+        concurrency, this->directed_, sub_oe_lists, sub_oe_offset_lists,
+        sub_ie_lists, sub_ie_offset_lists, this->is_multigraph_);
 
     for (label_id_t v_label = 0; v_label < this->vertex_label_num_; ++v_label) {
       if (this->directed_) {
@@ -43,6 +43,7 @@ limitations under the License.
 #include "common/util/typename.h"
 
 #include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/compressed_csr.h"
 #include "graph/fragment/fragment_traits.h"
 #include "graph/fragment/graph_schema.h"
 #include "graph/fragment/property_graph_types.h"
@@ -103,7 +104,7 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddVertexColumnsImpl(
         std::vector<std::pair<std::string, std::shared_ptr<ArrayType>>>>
         columns,
     bool replace) {
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   auto schema = schema_;
 
   /// If replace == true, invalidate all previous properties that have new
@@ -187,7 +188,7 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::AddEdgeColumnsImpl(
         std::vector<std::pair<std::string, std::shared_ptr<ArrayType>>>>
         columns,
     bool replace) {
-  vineyard::ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  vineyard::DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   auto schema = schema_;
 
   if (replace) {
@@ -238,7 +239,7 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::Project(
     vineyard::Client& client,
     std::map<label_id_t, std::vector<label_id_t>> vertices,
     std::map<label_id_t, std::vector<label_id_t>> edges) {
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
 
   auto schema = schema_;
 
@@ -331,8 +332,14 @@ template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
 boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::TransformDirection(
     vineyard::Client& client, int concurrency) {
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  if (compressed_) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "Cannot transform the direction of a fragment whose "
+                    "adjacency lists are compressed");
+  }
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   builder.set_directed_(!directed_);
+  builder.set_edge_statistics_json_(json::object());
 
   std::vector<std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>>
       oe_lists(vertex_label_num_);
@@ -363,6 +370,42 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::TransformDirection(
   return fragment_sealed->id();
 }
 
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
+boost::leaf::result<vineyard::ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::CompressAdjLists(
+    vineyard::Client& client, int concurrency) {
+  if (compressed_) {
+    return this->id();
+  }
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+    vid_t vid_base = vid_parser_.GenerateId(i, 0);
+    for (label_id_t j = 0; j < edge_label_num_; ++j) {
+      // the offsets are kept and shared with the compressed lists
+      builder.set_compressed_oe_list(
+          i, j,
+          std::make_shared<CompressedCSRBuilder<vid_t, eid_t>>(
+              client, oe_ptr_lists_[i][j], oe_offsets_lists_[i][j], vid_base,
+              concurrency));
+      builder.set_oe_lists_(
+          i, j, std::make_shared<PodArrayBuilder<nbr_unit_t>>(client, 0));
+      if (directed_) {
+        builder.set_compressed_ie_list(
+            i, j,
+            std::make_shared<CompressedCSRBuilder<vid_t, eid_t>>(
+                client, ie_ptr_lists_[i][j], ie_offsets_lists_[i][j],
+                vid_base, concurrency));
+        builder.set_ie_lists_(
+            i, j, std::make_shared<PodArrayBuilder<nbr_unit_t>>(client, 0));
+      }
+    }
+  }
+
+  std::shared_ptr<Object> fragment_sealed;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_sealed));
+  return fragment_sealed->id();
+}
+
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
 boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::ConsolidateVertexColumns(
@@ -386,7 +429,7 @@ boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::ConsolidateVertexColumns(
     vineyard::Client& client, const label_id_t vlabel,
     std::vector<prop_id_t> const& props, std::string const& consolidate_name) {
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   auto schema = schema_;
 
   auto& table = this->vertex_tables_[vlabel];
@@ -442,7 +485,7 @@ boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::ConsolidateEdgeColumns(
     vineyard::Client& client, const label_id_t elabel,
     std::vector<prop_id_t> const& props, std::string const& consolidate_name) {
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
+  DerivedArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T> builder(*this);
   auto schema = schema_;
 
   auto& table = this->edge_tables_[elabel];
@@ -521,9 +564,11 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::initPointers() {
 
   ovgid_lists_ptr_.resize(vertex_label_num_);
   ovg2l_maps_ptr_.resize(vertex_label_num_);
+  ovg2l_delta_maps_ptr_.resize(vertex_label_num_);
   for (label_id_t i = 0; i < vertex_label_num_; ++i) {
     ovgid_lists_ptr_[i] = ovgid_lists_[i]->GetArray()->raw_values();
     ovg2l_maps_ptr_[i] = ovg2l_maps_[i].get();
+    ovg2l_delta_maps_ptr_[i] = ovg2l_delta_maps_[i].get();
 
     oe_ptr_lists_[i].resize(edge_label_num_);
     oe_offsets_ptr_lists_[i].resize(edge_label_num_);
@@ -561,6 +606,21 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T>::initPointers() {
     ie_ptr_lists_ = oe_ptr_lists_;
     ie_offsets_ptr_lists_ = oe_offsets_ptr_lists_;
   }
+
+  compressed_oe_ptr_lists_.clear();
+  compressed_ie_ptr_lists_.clear();
+  if (compressed_) {
+    compressed_oe_ptr_lists_.resize(vertex_label_num_);
+    compressed_ie_ptr_lists_.resize(vertex_label_num_);
+    for (label_id_t i = 0; i < vertex_label_num_; ++i) {
+      compressed_oe_ptr_lists_[i].resize(edge_label_num_);
+      compressed_ie_ptr_lists_[i].resize(edge_label_num_);
+      for (label_id_t j = 0; j < edge_label_num_; ++j) {
+        compressed_oe_ptr_lists_[i][j] = compressed_oe_lists_[i][j].get();
+        compressed_ie_ptr_lists_[i][j] = compressed_ie_lists_[i][j].get();
+      }
+    }
+  }
 }
 
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T>
@@ -0,0 +1,161 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_FRAGMENT_COMPRESSED_CSR_H_
+#define MODULES_GRAPH_FRAGMENT_COMPRESSED_CSR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "basic/ds/array.h"
+#include "basic/ds/arrow.h"
+#include "client/client.h"
+#include "common/util/status.h"
+
+#include "graph/fragment/compressed_csr.vineyard.h"
+#include "graph/fragment/property_graph_types.h"
+#include "graph/fragment/property_graph_utils.h"
+
+namespace vineyard {
+
+/**
+ * @brief CompressedCSRBuilder encodes the `nbr_unit_t` array of a
+ * (vertex label, edge label) pair in `ArrowFragment` to the immutable
+ * `CompressedCSR`.
+ *
+ * The adjacency list of the i-th vertex (whose vid is `vid_base + i`) is
+ * `edges[offsets[i], offsets[i + 1])`, and the offsets array is shared with
+ * the resulting object. The neighbors are expected to be sorted to get the
+ * best compression ratio (see also `sort_edges_with_respect_to_vertex()`),
+ * but it is not required.
+ */
+template <typename VID_T, typename EID_T>
+class CompressedCSRBuilder : public CompressedCSRBaseBuilder<VID_T, EID_T> {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+
+ public:
+  CompressedCSRBuilder(Client& client, const nbr_unit_t* edges,
+                       const std::shared_ptr<Int64Array>& offsets,
+                       const VID_T vid_base, const int concurrency = 1)
+      : CompressedCSRBaseBuilder<VID_T, EID_T>(client),
+        edges_(edges),
+        offsets_(offsets),
+        vid_base_(vid_base),
+        concurrency_(std::max(concurrency, 1)) {}
+
+  Status Build(Client& client) override {
+    namespace codec = property_graph_utils::compressed_csr;
+    const int64_t* offsets = offsets_->GetArray()->raw_values();
+    const size_t vertex_num = static_cast<size_t>(offsets_->length() - 1);
+    const int64_t edge_num = offsets[vertex_num];
+    const int64_t block_num =
+        (edge_num + codec::kBlockSize - 1) / codec::kBlockSize;
+    const nbr_unit_t* edges = edges_;
+
+    // the edge ids can be elided if each of them equals to the position
+    std::atomic<bool> eid_elided(true);
+    parallel_for(
+        static_cast<int64_t>(0), block_num,
+        [&](const int64_t block) {
+          int64_t begin = block * codec::kBlockSize;
+          int64_t end = std::min(begin + codec::kBlockSize, edge_num);
+          for (int64_t position = begin; position < end; ++position) {
+            if (static_cast<int64_t>(edges[position].eid) != position) {
+              eid_elided.store(false);
+              return;
+            }
+          }
+        },
+        concurrency_);
+    const bool elided = eid_elided.load();
+
+    auto byte_offsets_builder =
+        std::make_shared<ArrayBuilder<int64_t>>(client, vertex_num + 1);
+    auto blocks_builder =
+        std::make_shared<ArrayBuilder<int64_t>>(client, block_num);
+    int64_t* byte_offsets = byte_offsets_builder->data();
+    int64_t* blocks = blocks_builder->data();
+
+    // compute the encoded size of each adjacency list, then the byte offsets
+    // by a prefix sum
+    byte_offsets[0] = 0;
+    parallel_for(
+        static_cast<size_t>(0), vertex_num,
+        [&](const size_t i) {
+          nbr_unit_t prev(0, 0);
+          size_t size = 0;
+          for (int64_t position = offsets[i]; position < offsets[i + 1];
+               ++position) {
+            if (position == offsets[i] || position % codec::kBlockSize == 0) {
+              codec::restart(vid_base_ + static_cast<VID_T>(i), position,
+                             prev);
+            }
+            size += codec::encoded_size(prev, edges[position], elided);
+            prev = edges[position];
+          }
+          byte_offsets[i + 1] = static_cast<int64_t>(size);
+        },
+        concurrency_);
+    for (size_t i = 0; i < vertex_num; ++i) {
+      byte_offsets[i + 1] += byte_offsets[i];
+    }
+
+    auto data_builder = std::make_shared<ArrayBuilder<uint8_t>>(
+        client, byte_offsets[vertex_num]);
+    uint8_t* data = data_builder->data();
+    std::fill_n(blocks, block_num, byte_offsets[vertex_num]);
+    parallel_for(
+        static_cast<size_t>(0), vertex_num,
+        [&](const size_t i) {
+          nbr_unit_t prev(0, 0);
+          uint8_t* ptr = data + byte_offsets[i];
+          for (int64_t position = offsets[i]; position < offsets[i + 1];
+               ++position) {
+            if (position % codec::kBlockSize == 0) {
+              blocks[position / codec::kBlockSize] = ptr - data;
+            }
+            if (position == offsets[i] || position % codec::kBlockSize == 0) {
+              codec::restart(vid_base_ + static_cast<VID_T>(i), position,
+                             prev);
+            }
+            ptr = codec::encode(prev, edges[position], elided, ptr);
+          }
+        },
+        concurrency_);
+
+    this->set_vertex_num_(vertex_num);
+    this->set_edge_num_(static_cast<size_t>(edge_num - offsets[0]));
+    this->set_vid_base_(vid_base_);
+    this->set_eid_elided_(elided);
+    this->set_offsets_(std::static_pointer_cast<ObjectBase>(offsets_));
+    this->set_byte_offsets_(
+        std::static_pointer_cast<ObjectBase>(byte_offsets_builder));
+    this->set_blocks_(std::static_pointer_cast<ObjectBase>(blocks_builder));
+    this->set_data_(std::static_pointer_cast<ObjectBase>(data_builder));
+    return Status::OK();
+  }
+
+ private:
+  const nbr_unit_t* edges_;
+  std::shared_ptr<Int64Array> offsets_;
+  VID_T vid_base_;
+  int concurrency_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_FRAGMENT_COMPRESSED_CSR_H_
@@ -259,6 +259,8 @@ vineyard::Status GARFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
   }
   Base::oe_lists_.resize(this->vertex_label_num_);
   Base::oe_offsets_lists_.resize(this->vertex_label_num_);
+  EdgeStatistics statistics(this->directed_, this->vertex_label_num_,
+                            this->edge_label_num_);
   for (label_id_t i = 0; i < this->vertex_label_num_; ++i) {
     if (this->directed_) {
       Base::ie_lists_[i].resize(this->edge_label_num_);
@@ -267,7 +269,13 @@ vineyard::Status GARFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
     Base::oe_lists_[i].resize(this->edge_label_num_);
     Base::oe_offsets_lists_[i].resize(this->edge_label_num_);
     for (label_id_t j = 0; j < this->edge_label_num_; ++j) {
-      auto fn = [this, i, j](Client* client) -> Status {
+      auto fn = [this, i, j, &statistics](Client* client) -> Status {
+        statistics.out_degrees(i, j) = DegreeStatistics::Compute(
+            oe_offsets_lists_[i][j]->raw_values(), ivnums_[i]);
+        if (this->directed_) {
+          statistics.in_degrees(i, j) = DegreeStatistics::Compute(
+              ie_offsets_lists_[i][j]->raw_values(), ivnums_[i]);
+        }
         std::shared_ptr<Object> object;
         if (this->directed_) {
           RETURN_ON_ERROR(ie_lists_[i][j]->Seal(*client, object));
@@ -293,6 +301,7 @@ vineyard::Status GARFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T>::Build(
 
   tg.TakeResults();
 
+  this->set_edge_statistics_json_(statistics.ToJSON());
   this->set_vm_ptr_(vm_ptr_);
 
   this->set_oid_type(type_name<oid_t>());
@@ -0,0 +1,190 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "graph/fragment/graph_statistics.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "common/util/json.h"
+
+namespace vineyard {
+
+DegreeStatistics DegreeStatistics::Compute(const int64_t* offsets,
+                                           int64_t vertex_num) {
+  DegreeStatistics stats;
+  stats.vertex_num = vertex_num;
+  if (vertex_num == 0) {
+    return stats;
+  }
+  stats.edge_num = offsets[vertex_num] - offsets[0];
+  stats.histogram.resize(1, 0);
+  for (int64_t v = 0; v < vertex_num; ++v) {
+    int64_t degree = offsets[v + 1] - offsets[v];
+    size_t bucket = 0;
+    while (degree >> bucket) {
+      ++bucket;
+    }
+    if (bucket >= stats.histogram.size()) {
+      stats.histogram.resize(bucket + 1, 0);
+    }
+    stats.histogram[bucket] += 1;
+    stats.max_degree = std::max(stats.max_degree, degree);
+  }
+  stats.nonzero_vertex_num = vertex_num - stats.histogram[0];
+  return stats;
+}
+
+json DegreeStatistics::ToJSON() const {
+  json root;
+  root["edge_num"] = edge_num;
+  root["vertex_num"] = vertex_num;
+  root["nonzero_vertex_num"] = nonzero_vertex_num;
+  root["max_degree"] = max_degree;
+  root["histogram"] = histogram;
+  return root;
+}
+
+void DegreeStatistics::FromJSON(const json& root) {
+  edge_num = root.value("edge_num", static_cast<int64_t>(0));
+  vertex_num = root.value("vertex_num", static_cast<int64_t>(0));
+  nonzero_vertex_num =
+      root.value("nonzero_vertex_num", static_cast<int64_t>(0));
+  max_degree = root.value("max_degree", static_cast<int64_t>(0));
+  histogram.clear();
+  if (root.contains("histogram")) {
+    histogram = root["histogram"].get<std::vector<int64_t>>();
+  }
+}
+
+EdgeStatistics::EdgeStatistics(bool directed, int vertex_label_num,
+                               int edge_label_num)
+    : directed_(directed),
+      vertex_label_num_(vertex_label_num),
+      edge_label_num_(edge_label_num) {
+  out_.resize(vertex_label_num,
+              std::vector<DegreeStatistics>(edge_label_num));
+  if (directed) {
+    in_.resize(vertex_label_num,
+               std::vector<DegreeStatistics>(edge_label_num));
+  }
+}
+
+int64_t EdgeStatistics::out_edge_num() const {
+  int64_t edge_num = 0;
+  for (auto const& stats : out_) {
+    for (auto const& item : stats) {
+      edge_num += item.edge_num;
+    }
+  }
+  return edge_num;
+}
+
+int64_t EdgeStatistics::in_edge_num() const {
+  if (!directed_) {
+    return out_edge_num();
+  }
+  int64_t edge_num = 0;
+  for (auto const& stats : in_) {
+    for (auto const& item : stats) {
+      edge_num += item.edge_num;
+    }
+  }
+  return edge_num;
+}
+
+bool EdgeStatistics::Match(
+    bool directed, int vertex_label_num, int edge_label_num,
+    const std::vector<std::vector<int64_t>>& oe_nums,
+    const std::vector<std::vector<int64_t>>& ie_nums) const {
+  if (empty() || directed_ != directed ||
+      vertex_label_num_ != vertex_label_num ||
+      edge_label_num_ != edge_label_num) {
+    return false;
+  }
+  for (int i = 0; i < vertex_label_num; ++i) {
+    for (int j = 0; j < edge_label_num; ++j) {
+      if (out_degrees(i, j).edge_num != oe_nums[i][j] ||
+          in_degrees(i, j).edge_num != ie_nums[i][j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+json EdgeStatistics::ToJSON() const {
+  json root;
+  root["directed"] = directed_;
+  root["vertex_label_num"] = vertex_label_num_;
+  root["edge_label_num"] = edge_label_num_;
+  auto to_json = [](const std::vector<std::vector<DegreeStatistics>>& stats) {
+    json tree = json::array();
+    for (auto const& items : stats) {
+      json items_tree = json::array();
+      for (auto const& item : items) {
+        items_tree.emplace_back(item.ToJSON());
+      }
+      tree.emplace_back(items_tree);
+    }
+    return tree;
+  };
+  root["out"] = to_json(out_);
+  if (directed_) {
+    root["in"] = to_json(in_);
+  }
+  root["out_edge_num"] = out_edge_num();
+  root["in_edge_num"] = in_edge_num();
+  return root;
+}
+
+void EdgeStatistics::FromJSON(const json& root) {
+  *this = EdgeStatistics();
+  if (!root.is_object() || !root.contains("out")) {
+    return;
+  }
+  EdgeStatistics stats(root.value("directed", false),
+                       root.value("vertex_label_num", 0),
+                       root.value("edge_label_num", 0));
+  auto from_json = [&stats](const json& tree,
+                            std::vector<std::vector<DegreeStatistics>>& out) {
+    if (!tree.is_array() ||
+        tree.size() != static_cast<size_t>(stats.vertex_label_num_)) {
+      return false;
+    }
+    for (int i = 0; i < stats.vertex_label_num_; ++i) {
+      const json& items = tree[i];
+      if (!items.is_array() ||
+          items.size() != static_cast<size_t>(stats.edge_label_num_)) {
+        return false;
+      }
+      for (int j = 0; j < stats.edge_label_num_; ++j) {
+        out[i][j].FromJSON(items[j]);
+      }
+    }
+    return true;
+  };
+  if (!from_json(root["out"], stats.out_)) {
+    return;
+  }
+  if (stats.directed_ &&
+      (!root.contains("in") || !from_json(root["in"], stats.in_))) {
+    return;
+  }
+  *this = std::move(stats);
+}
+
+}  // namespace vineyard
@@ -0,0 +1,122 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_FRAGMENT_GRAPH_STATISTICS_H_
+#define MODULES_GRAPH_FRAGMENT_GRAPH_STATISTICS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "common/util/json.h"
+
+namespace vineyard {
+
+/**
+ * @brief The degree distribution of the inner vertices of a vertex label
+ * along the edges of an edge label, in one direction.
+ *
+ * The histogram is bucketed by powers of two: `histogram[0]` is the number of
+ * vertices without edges, and `histogram[k]` is the number of vertices whose
+ * degree is in [2^(k-1), 2^k).
+ */
+struct DegreeStatistics {
+  int64_t edge_num = 0;
+  int64_t vertex_num = 0;
+  int64_t nonzero_vertex_num = 0;
+  int64_t max_degree = 0;
+  std::vector<int64_t> histogram;
+
+  double average_degree() const {
+    return vertex_num == 0 ? 0.0 : static_cast<double>(edge_num) / vertex_num;
+  }
+
+  /**
+   * @brief Computes the statistics of the first `vertex_num` vertices from
+   * the CSR offsets.
+   */
+  static DegreeStatistics Compute(const int64_t* offsets, int64_t vertex_num);
+
+  json ToJSON() const;
+  void FromJSON(const json& root);
+};
+
+/**
+ * @brief The edge numbers and degree statistics of a fragment, which are
+ * computed by the fragment builders and persisted in the metadata of the
+ * fragment, thus they are available without scanning the CSR when the
+ * fragment is loaded, e.g., for cost-based decisions of analytical engines.
+ *
+ * For undirected graphs the incoming statistics are the outgoing ones.
+ */
+class EdgeStatistics {
+ public:
+  EdgeStatistics() = default;
+
+  EdgeStatistics(bool directed, int vertex_label_num, int edge_label_num);
+
+  bool empty() const { return out_.empty(); }
+
+  bool directed() const { return directed_; }
+
+  int vertex_label_num() const { return vertex_label_num_; }
+
+  int edge_label_num() const { return edge_label_num_; }
+
+  DegreeStatistics& out_degrees(int v_label, int e_label) {
+    return out_[v_label][e_label];
+  }
+
+  const DegreeStatistics& out_degrees(int v_label, int e_label) const {
+    return out_[v_label][e_label];
+  }
+
+  DegreeStatistics& in_degrees(int v_label, int e_label) {
+    return directed_ ? in_[v_label][e_label] : out_[v_label][e_label];
+  }
+
+  const DegreeStatistics& in_degrees(int v_label, int e_label) const {
+    return directed_ ? in_[v_label][e_label] : out_[v_label][e_label];
+  }
+
+  int64_t out_edge_num() const;
+
+  int64_t in_edge_num() const;
+
+  /**
+   * @brief Whether the statistics describe a fragment of the given shape,
+   * used to detect statistics inherited from a fragment whose topology has
+   * been changed afterwards.
+   *
+   * @param oe_nums The number of outgoing edges of inner vertices for each
+   *                (vertex label, edge label).
+   * @param ie_nums The number of incoming edges, ditto.
+   */
+  bool Match(bool directed, int vertex_label_num, int edge_label_num,
+             const std::vector<std::vector<int64_t>>& oe_nums,
+             const std::vector<std::vector<int64_t>>& ie_nums) const;
+
+  json ToJSON() const;
+  void FromJSON(const json& root);
+
+ private:
+  bool directed_ = false;
+  int vertex_label_num_ = 0;
+  int edge_label_num_ = 0;
+  std::vector<std::vector<DegreeStatistics>> out_, in_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_FRAGMENT_GRAPH_STATISTICS_H_
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MODULES_GRAPH_FRAGMENT_PROPERTY_GRAPH_TYPES_H_
 #define MODULES_GRAPH_FRAGMENT_PROPERTY_GRAPH_TYPES_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -165,6 +166,175 @@ struct NbrUnit {
 template <typename VID_T>
 using NbrUnitDefault = NbrUnit<VID_T, property_graph_types::EID_TYPE>;
 
+/**
+ * The compressed layout of adjacency lists, see also `CompressedCSR`.
+ *
+ * Neighbors and edge ids are zigzag delta encoded as varints. At the
+ * beginning of a list and at every kBlockSize-th edge the encoding restarts,
+ * where the neighbor is relative to the source vertex and the edge id to the
+ * position of the edge. Otherwise they are relative to the previous neighbor
+ * and the previous edge id plus one, thus sorted neighbors and the edge ids of
+ * edges loaded in order take one or two bytes. The edge ids are not encoded at
+ * all if each of them equals to the position of the edge.
+ */
+namespace compressed_csr {
+
+static constexpr int64_t kBlockSize = 64;
+
+inline uint64_t zigzag_encode(const int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t zigzag_decode(const uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline size_t varint_size(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size += 1;
+  }
+  return size;
+}
+
+inline uint8_t* varint_encode(uint64_t value, uint8_t* ptr) {
+  while (value >= 0x80) {
+    *ptr++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *ptr++ = static_cast<uint8_t>(value);
+  return ptr;
+}
+
+inline const uint8_t* varint_decode(const uint8_t* ptr, uint64_t& value) {
+  uint64_t byte = *ptr++;
+  value = byte & 0x7f;
+  int shift = 7;
+  while (byte & 0x80) {
+    byte = *ptr++;
+    value |= (byte & 0x7f) << shift;
+    shift += 7;
+  }
+  return ptr;
+}
+
+// the differences are computed in unsigned arithmetic, as vids carry the
+// label in their highest bits
+template <typename T>
+inline int64_t delta(const T next, const T prev) {
+  return static_cast<int64_t>(static_cast<uint64_t>(next) -
+                              static_cast<uint64_t>(prev));
+}
+
+template <typename T>
+inline T forward(const T prev, const int64_t delta) {
+  return static_cast<T>(static_cast<uint64_t>(prev) +
+                        static_cast<uint64_t>(delta));
+}
+
+/**
+ * @brief Resets `prev` as the base of the edge at `position`, which starts
+ * an adjacency list of `src` or a block.
+ */
+template <typename VID_T, typename EID_T>
+inline void restart(const VID_T src, const int64_t position,
+                    NbrUnit<VID_T, EID_T>& prev) {
+  prev.vid = src;
+  prev.eid = static_cast<EID_T>(position - 1);
+}
+
+template <typename VID_T, typename EID_T>
+inline size_t encoded_size(const NbrUnit<VID_T, EID_T>& prev,
+                           const NbrUnit<VID_T, EID_T>& next,
+                           const bool eid_elided) {
+  size_t size = varint_size(zigzag_encode(delta(next.vid, prev.vid)));
+  if (!eid_elided) {
+    size += varint_size(zigzag_encode(
+        delta(next.eid, static_cast<EID_T>(prev.eid + 1))));
+  }
+  return size;
+}
+
+template <typename VID_T, typename EID_T>
+inline uint8_t* encode(NbrUnit<VID_T, EID_T>& prev,
+                       const NbrUnit<VID_T, EID_T>& next,
+                       const bool eid_elided, uint8_t* ptr) {
+  ptr = varint_encode(zigzag_encode(delta(next.vid, prev.vid)), ptr);
+  if (!eid_elided) {
+    ptr = varint_encode(
+        zigzag_encode(delta(next.eid, static_cast<EID_T>(prev.eid + 1))),
+        ptr);
+  }
+  prev = next;
+  return ptr;
+}
+
+// decodes the next edge in place of `prev`
+template <typename VID_T, typename EID_T>
+inline const uint8_t* decode(NbrUnit<VID_T, EID_T>& prev,
+                             const bool eid_elided, const uint8_t* ptr) {
+  uint64_t value;
+  ptr = varint_decode(ptr, value);
+  prev.vid = forward(prev.vid, zigzag_decode(value));
+  if (eid_elided) {
+    prev.eid += 1;
+  } else {
+    ptr = varint_decode(ptr, value);
+    prev.eid = forward(static_cast<EID_T>(prev.eid + 1), zigzag_decode(value));
+  }
+  return ptr;
+}
+
+/**
+ * @brief The position in a compressed adjacency list of `src` that ends at
+ * `end`, where `ptr` points to the encoded edge at `position`.
+ */
+template <typename VID_T>
+struct Cursor {
+  const uint8_t* ptr = nullptr;
+  int64_t position = 0;
+  int64_t end = 0;
+  VID_T src = 0;
+  bool eid_elided = false;
+  bool compressed = false;
+
+  Cursor() = default;
+
+  Cursor(const uint8_t* ptr, const int64_t position, const int64_t end,
+         const VID_T src, const bool eid_elided)
+      : ptr(ptr),
+        position(position),
+        end(end),
+        src(src),
+        eid_elided(eid_elided),
+        compressed(true) {}
+
+  // decodes the first edge, as the list starts at `position`
+  template <typename EID_T>
+  inline void Begin(NbrUnit<VID_T, EID_T>& unit) {
+    if (position < end) {
+      restart(src, position, unit);
+      ptr = decode(unit, eid_elided, ptr);
+    }
+  }
+
+  // moves to and decodes the next edge
+  template <typename EID_T>
+  inline void Next(NbrUnit<VID_T, EID_T>& unit) {
+    position += 1;
+    if (position < end) {
+      if (position % kBlockSize == 0) {
+        restart(src, position, unit);
+      }
+      ptr = decode(unit, eid_elided, ptr);
+    }
+  }
+};
+
+}  // namespace compressed_csr
+
 template <typename DATA_T, typename NBR_T>
 class EdgeDataColumn {
  public:
@@ -291,30 +461,51 @@ struct ValueGetter<std::string> {
   }
 };
 
+/**
+ * @brief The neighbor in an adjacency list, which works as the iterator as
+ * well. The neighbors in compressed adjacency lists are decoded on the fly,
+ * and the decrements are not supported for them.
+ */
 template <typename VID_T, typename EID_T>
 struct Nbr {
  private:
   using vid_t = VID_T;
   using eid_t = EID_T;
   using prop_id_t = property_graph_types::PROP_ID_TYPE;
+  using cursor_t = compressed_csr::Cursor<VID_T>;
 
  public:
   Nbr() : nbr_(NULL), edata_arrays_(nullptr) {}
   Nbr(const NbrUnit<VID_T, EID_T>* nbr, const void** edata_arrays)
       : nbr_(nbr), edata_arrays_(edata_arrays) {}
-  Nbr(const Nbr& rhs) : nbr_(rhs.nbr_), edata_arrays_(rhs.edata_arrays_) {}
+  Nbr(const cursor_t& cursor, const void** edata_arrays)
+      : nbr_(&unit_), edata_arrays_(edata_arrays), cursor_(cursor) {
+    cursor_.Begin(unit_);
+  }
+  Nbr(const Nbr& rhs)
+      : nbr_(rhs.cursor_.compressed ? &unit_ : rhs.nbr_),
+        edata_arrays_(rhs.edata_arrays_),
+        unit_(rhs.unit_),
+        cursor_(rhs.cursor_) {}
   Nbr(Nbr&& rhs)
-      : nbr_(std::move(rhs.nbr_)), edata_arrays_(rhs.edata_arrays_) {}
+      : nbr_(rhs.cursor_.compressed ? &unit_ : std::move(rhs.nbr_)),
+        edata_arrays_(rhs.edata_arrays_),
+        unit_(rhs.unit_),
+        cursor_(rhs.cursor_) {}
 
   Nbr& operator=(const Nbr& rhs) {
-    nbr_ = rhs.nbr_;
+    nbr_ = rhs.cursor_.compressed ? &unit_ : rhs.nbr_;
     edata_arrays_ = rhs.edata_arrays_;
+    unit_ = rhs.unit_;
+    cursor_ = rhs.cursor_;
     return *this;
   }
 
   Nbr& operator=(Nbr&& rhs) {
-    nbr_ = std::move(rhs.nbr_);
+    nbr_ = rhs.cursor_.compressed ? &unit_ : std::move(rhs.nbr_);
     edata_arrays_ = std::move(rhs.edata_arrays_);
+    unit_ = rhs.unit_;
+    cursor_ = rhs.cursor_;
     return *this;
   }
 
@@ -346,7 +537,11 @@ struct Nbr {
   }
 
   inline const Nbr& operator++() const {
-    ++nbr_;
+    if (cursor_.compressed) {
+      cursor_.Next(unit_);
+    } else {
+      ++nbr_;
+    }
     return *this;
   }
 
@@ -367,16 +562,28 @@ struct Nbr {
     return ret;
   }
 
-  inline bool operator==(const Nbr& rhs) const { return nbr_ == rhs.nbr_; }
-  inline bool operator!=(const Nbr& rhs) const { return nbr_ != rhs.nbr_; }
+  inline bool operator==(const Nbr& rhs) const {
+    return cursor_.compressed ? cursor_.position == rhs.cursor_.position
+                              : nbr_ == rhs.nbr_;
+  }
+  inline bool operator!=(const Nbr& rhs) const {
+    return cursor_.compressed ? cursor_.position != rhs.cursor_.position
+                              : nbr_ != rhs.nbr_;
+  }
 
-  inline bool operator<(const Nbr& rhs) const { return nbr_ < rhs.nbr_; }
+  inline bool operator<(const Nbr& rhs) const {
+    return cursor_.compressed ? cursor_.position < rhs.cursor_.position
+                              : nbr_ < rhs.nbr_;
+  }
 
   inline const Nbr& operator*() const { return *this; }
 
  private:
   const mutable NbrUnit<VID_T, EID_T>* nbr_;
   const void** edata_arrays_;
+  // the decoded neighbor and the decoding state for compressed lists
+  mutable NbrUnit<VID_T, EID_T> unit_{};
+  mutable cursor_t cursor_;
 };
 
 template <typename VID_T>
@@ -515,6 +722,11 @@ class RawAdjList {
 template <typename VID_T>
 using RawAdjListDefault = RawAdjList<VID_T, property_graph_types::EID_TYPE>;
 
+/**
+ * @brief The adjacency list of a vertex, which is either a range of
+ * `NbrUnit`s or a compressed list that is decoded during the iteration, see
+ * also `CompressedCSR`.
+ */
 template <typename VID_T, typename EID_T>
 class AdjList {
  public:
@@ -522,31 +734,58 @@ class AdjList {
   AdjList(const NbrUnit<VID_T, EID_T>* begin, const NbrUnit<VID_T, EID_T>* end,
           const void** edata_arrays)
       : begin_(begin), end_(end), edata_arrays_(edata_arrays) {}
+  /**
+   * @brief The compressed adjacency list of `src` that consists of the edges
+   * in [begin, end), where `data` points to the encoded edge at `begin`.
+   */
+  AdjList(const uint8_t* data, int64_t begin, int64_t end, VID_T src,
+          bool eid_elided, const void** edata_arrays)
+      : begin_(NULL),
+        end_(NULL),
+        edata_arrays_(edata_arrays),
+        cursor_(data, begin, end, src, eid_elided) {}
 
   inline Nbr<VID_T, EID_T> begin() const {
+    if (cursor_.compressed) {
+      return Nbr<VID_T, EID_T>(cursor_, edata_arrays_);
+    }
     return Nbr<VID_T, EID_T>(begin_, edata_arrays_);
   }
 
   inline Nbr<VID_T, EID_T> end() const {
+    if (cursor_.compressed) {
+      auto cursor = cursor_;
+      cursor.position = cursor_.end;
+      return Nbr<VID_T, EID_T>(cursor, edata_arrays_);
+    }
     return Nbr<VID_T, EID_T>(end_, edata_arrays_);
   }
 
-  inline size_t Size() const { return end_ - begin_; }
+  inline size_t Size() const {
+    return cursor_.compressed ? cursor_.end - cursor_.position : end_ - begin_;
+  }
 
-  inline bool Empty() const { return end_ == begin_; }
+  inline bool Empty() const { return Size() == 0; }
 
-  inline bool NotEmpty() const { return end_ != begin_; }
+  inline bool NotEmpty() const { return Size() != 0; }
 
-  size_t size() const { return end_ - begin_; }
+  size_t size() const { return Size(); }
 
+  /**
+   * The units are not available for compressed adjacency lists, and nullptr
+   * is returned.
+   */
   inline const NbrUnit<VID_T, EID_T>* begin_unit() const { return begin_; }
 
   inline const NbrUnit<VID_T, EID_T>* end_unit() const { return end_; }
 
+  inline bool compressed() const { return cursor_.compressed; }
+
  private:
   const NbrUnit<VID_T, EID_T>* begin_;
   const NbrUnit<VID_T, EID_T>* end_;
   const void** edata_arrays_;
+  compressed_csr::Cursor<VID_T> cursor_;
 };
 
 template <typename VID_T>
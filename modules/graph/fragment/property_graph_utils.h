@@ -17,6 +17,7 @@ limitations under the License.
 #define MODULES_GRAPH_FRAGMENT_PROPERTY_GRAPH_UTILS_H_
 
 #include <algorithm>
+#include <cctype>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,6 +37,8 @@ limitations under the License.
 #include "grape/utils/vertex_array.h"
 
 #include "basic/ds/hashmap.h"
+#include "common/util/env.h"
+#include "common/util/logging.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/error.h"
 #include "graph/utils/mpi_utils.h"
@@ -82,7 +85,8 @@ boost::leaf::result<void> generate_outer_vertices_map(
     const std::vector<VID_T>& start_ids,
     std::vector<ska::flat_hash_map<
         VID_T, VID_T, typename Hashmap<VID_T, VID_T>::KeyHash>>& ovg2l_maps,
-    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& ovgid_lists);
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& ovgid_lists,
+    const std::vector<Hashmap<VID_T, VID_T>*>& base_ovg2l_maps = {});
 
 template <typename VID_T>
 boost::leaf::result<void> generate_local_id_list(
@@ -92,7 +96,8 @@ boost::leaf::result<void> generate_local_id_list(
         VID_T, VID_T, typename Hashmap<VID_T, VID_T>::KeyHash>>& ovg2l_maps,
     int concurrency,
     std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& lid_list,
-    arrow::MemoryPool* pool = arrow::default_memory_pool());
+    arrow::MemoryPool* pool = arrow::default_memory_pool(),
+    const std::vector<Hashmap<VID_T, VID_T>*>& base_ovg2l_maps = {});
 
 template <typename VID_T, typename EID_T>
 void sort_edges_with_respect_to_vertex(
@@ -165,6 +170,120 @@ boost::leaf::result<void> generate_undirected_csr_memopt(
     std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
     bool& is_multigraph);
 
+/**
+ * @brief The algorithm used to build the CSR/CSC of fragments.
+ *
+ * - kScatter: counts the degrees, scatters the edges with atomic cursors, and
+ *   then sorts each adjacency list, the default.
+ * - kRadixSort: buckets the edges by the source vertex without atomics in a
+ *   single scatter pass, then sorts each bucket with in-place radix sorts,
+ *   see also `generate_directed_csr_radix()`.
+ *
+ * The default can be overridden by the environment variable
+ * `VINEYARD_CSR_BUILD_STRATEGY` ("scatter" or "radix").
+ */
+enum class CSRBuildStrategy {
+  kScatter = 0,
+  kRadixSort = 1,
+};
+
+inline CSRBuildStrategy DefaultCSRBuildStrategy() {
+  static const CSRBuildStrategy strategy = []() {
+    std::string name = read_env("VINEYARD_CSR_BUILD_STRATEGY");
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    if (name == "radix" || name == "radix_sort" || name == "radixsort") {
+      return CSRBuildStrategy::kRadixSort;
+    }
+    if (!name.empty() && name != "scatter") {
+      LOG(WARNING) << "Unknown CSR build strategy: '" << name
+                   << "', fallback to 'scatter'";
+    }
+    return CSRBuildStrategy::kScatter;
+  }();
+  return strategy;
+}
+
+/**
+ * @brief The outer vertices pulled in by new edges are kept in delta maps
+ * that overlay the (shared) outer vertex maps of the base fragment, and are
+ * merged into new base maps once the delta grows beyond this ratio of the
+ * base.
+ *
+ * The default (0.1) can be overridden by the environment variable
+ * `VINEYARD_OUTER_VERTEX_COMPACTION_RATIO`.
+ */
+inline double DefaultOuterVertexCompactionRatio() {
+  static const double ratio =
+      read_env_ratio("VINEYARD_OUTER_VERTEX_COMPACTION_RATIO", 0.1);
+  return ratio;
+}
+
+/**
+ * @brief Generate CSR from given COO with radix sort, the result is the same
+ * as `generate_directed_csr()`.
+ */
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_directed_csr_radix(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
+/**
+ * @brief Generate CSC from given CSR with radix sort, the result is the same
+ * as `generate_directed_csc()`.
+ */
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_directed_csc_radix(
+    Client& client, IdParser<VID_T>& parser, std::vector<VID_T> tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph);
+
+/**
+ * @brief Generate CSR and CSC from given COO with radix sort, the result is
+ * the same as `generate_undirected_csr_memopt()`.
+ */
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_undirected_csr_radix(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
+/**
+ * @brief Generate the CSR (and the CSC, for directed graphs) from given COO
+ * with the given strategy.
+ */
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_csr_by_strategy(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    bool directed,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph,
+    CSRBuildStrategy strategy = DefaultCSRBuildStrategy());
+
 }  // namespace vineyard
 
 #endif  // MODULES_GRAPH_FRAGMENT_PROPERTY_GRAPH_UTILS_H_
@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "graph/fragment/property_graph_types.h"
@@ -85,7 +87,8 @@ boost::leaf::result<void> generate_outer_vertices_map(
     const std::vector<VID_T>& start_ids,
     std::vector<ska::flat_hash_map<
         VID_T, VID_T, typename Hashmap<VID_T, VID_T>::KeyHash>>& ovg2l_maps,
-    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& ovgid_lists) {
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& ovgid_lists,
+    const std::vector<Hashmap<VID_T, VID_T>*>& base_ovg2l_maps) {
   using vid_array_t = ArrowArrayType<VID_T>;
 
   ovg2l_maps.resize(vertex_label_num);
@@ -105,6 +108,10 @@ boost::leaf::result<void> generate_outer_vertices_map(
       for (int64_t i = 0; i < array->length(); ++i) {
         if (parser.GetFid(arr[i]) != fid) {
           auto label = parser.GetLabelId(arr[i]);
+          if (static_cast<size_t>(label) < base_ovg2l_maps.size() &&
+              base_ovg2l_maps[label]->count(arr[i]) != 0) {
+            continue;
+          }
           if (ovg2l_maps[label].find(arr[i]) == ovg2l_maps[label].end()) {
             // for de-dup, the value will be updated later
             ovg2l_maps[label].emplace(arr[i], -1);
@@ -140,14 +147,15 @@ boost::leaf::result<void> generate_local_id_list(
         VID_T, VID_T, typename Hashmap<VID_T, VID_T>::KeyHash>>& ovg2l_maps,
     int concurrency,
     std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& lid_list,
-    arrow::MemoryPool* pool) {
+    arrow::MemoryPool* pool,
+    const std::vector<Hashmap<VID_T, VID_T>*>& base_ovg2l_maps) {
   std::vector<std::shared_ptr<arrow::Array>> chunks = gid_list->chunks();
   lid_list.resize(gid_list->num_chunks());  // reserve the space
   gid_list.reset();  // release the reference of chunked arrays
 
   parallel_for(
       static_cast<size_t>(0), chunks.size(),
-      [pool, fid, &parser, &ovg2l_maps, &chunks,
+      [pool, fid, &parser, &ovg2l_maps, &base_ovg2l_maps, &chunks,
        &lid_list](size_t chunk_index) -> boost::leaf::result<void> {
         ArrowBuilderType<VID_T> builder(pool);
         auto chunk = std::dynamic_pointer_cast<ArrowArrayType<VID_T>>(
@@ -162,7 +170,13 @@ boost::leaf::result<void> generate_local_id_list(
             builder[i] = parser.GenerateId(0, parser.GetLabelId(gid),
                                            parser.GetOffset(gid));
           } else {
-            builder[i] = ovg2l_maps[parser.GetLabelId(gid)].at(gid);
+            // the (small) overlay first, then the base maps
+            auto const& ovg2l_map = ovg2l_maps[parser.GetLabelId(gid)];
+            auto iter = ovg2l_map.find(gid);
+            builder[i] =
+                iter != ovg2l_map.end()
+                    ? iter->second
+                    : base_ovg2l_maps.at(parser.GetLabelId(gid))->at(gid);
           }
         }
         ARROW_OK_OR_RAISE(builder.Advance(chunk->length()));
@@ -679,6 +693,583 @@ boost::leaf::result<void> generate_undirected_csr_memopt(
   return {};
 }
 
+namespace detail {
+
+// Adjacency lists that are longer than this are sorted by multiple threads.
+static constexpr size_t kRadixCSRParallelThreshold = 1 << 20;
+
+static constexpr size_t kRadixCSRInsertionThreshold = 32;
+
+template <typename NBR_T>
+inline void insertion_sort_nbrs(NBR_T* begin, NBR_T* end) {
+  for (NBR_T* iter = begin + 1; iter < end; ++iter) {
+    NBR_T value = *iter;
+    NBR_T* loc = iter;
+    while (loc > begin && value.vid < (loc - 1)->vid) {
+      *loc = *(loc - 1);
+      --loc;
+    }
+    *loc = value;
+  }
+}
+
+/**
+ * @brief Returns the shift of the highest byte that differs among the vids,
+ * or -1 if all vids are the same.
+ */
+template <typename NBR_T>
+inline int highest_differing_byte(const NBR_T* begin, const NBR_T* end) {
+  using vid_t = typename NBR_T::vid_t;
+  if (begin == end) {
+    return -1;
+  }
+  vid_t diff = 0;
+  const vid_t first = begin->vid;
+  for (const NBR_T* iter = begin; iter != end; ++iter) {
+    diff |= iter->vid ^ first;
+  }
+  if (diff == 0) {
+    return -1;
+  }
+  int bit = 0;
+  while (bit + 8 < static_cast<int>(sizeof(vid_t) * 8) &&
+         (diff >> (bit + 8)) != 0) {
+    bit += 8;
+  }
+  return bit;
+}
+
+/**
+ * @brief In-place MSD radix sort (American flag sort) of neighbors by vid,
+ * from the byte at `shift` downwards. The sub-ranges of each byte value are
+ * returned via `bounds` when it is not nullptr, rather than being sorted
+ * recursively.
+ */
+template <typename NBR_T>
+void radix_sort_nbrs(NBR_T* begin, NBR_T* end, int shift,
+                     std::vector<std::pair<NBR_T*, NBR_T*>>* bounds = nullptr) {
+  size_t size = end - begin;
+  if (size <= kRadixCSRInsertionThreshold || shift < 0) {
+    insertion_sort_nbrs(begin, end);
+    return;
+  }
+  size_t counts[256] = {0};
+  for (NBR_T* iter = begin; iter != end; ++iter) {
+    counts[(iter->vid >> shift) & 0xff] += 1;
+  }
+  if (counts[(begin->vid >> shift) & 0xff] == size) {
+    // all neighbors share the same byte
+    radix_sort_nbrs(begin, end, shift - 8, bounds);
+    return;
+  }
+  size_t heads[256], tails[256];
+  size_t offset = 0;
+  for (int digit = 0; digit < 256; ++digit) {
+    heads[digit] = offset;
+    offset += counts[digit];
+    tails[digit] = offset;
+  }
+  for (int digit = 0; digit < 256; ++digit) {
+    while (heads[digit] < tails[digit]) {
+      NBR_T value = begin[heads[digit]];
+      int target = (value.vid >> shift) & 0xff;
+      while (target != digit) {
+        std::swap(value, begin[heads[target]++]);
+        target = (value.vid >> shift) & 0xff;
+      }
+      begin[heads[digit]++] = value;
+    }
+  }
+  offset = 0;
+  for (int digit = 0; digit < 256; ++digit) {
+    NBR_T* sub_begin = begin + offset;
+    NBR_T* sub_end = sub_begin + counts[digit];
+    offset += counts[digit];
+    if (counts[digit] > 1) {
+      if (bounds != nullptr) {
+        bounds->emplace_back(sub_begin, sub_end);
+      } else {
+        radix_sort_nbrs(sub_begin, sub_end, shift - 8);
+      }
+    }
+  }
+}
+
+template <typename NBR_T>
+void sort_nbrs(NBR_T* begin, NBR_T* end, int concurrency) {
+  if (static_cast<size_t>(end - begin) <= kRadixCSRInsertionThreshold) {
+    insertion_sort_nbrs(begin, end);
+    return;
+  }
+  int shift = highest_differing_byte(begin, end);
+  if (shift < 0) {
+    return;
+  }
+  if (concurrency <= 1 ||
+      static_cast<size_t>(end - begin) < kRadixCSRParallelThreshold) {
+    radix_sort_nbrs(begin, end, shift);
+    return;
+  }
+  // partition by the highest byte, then sort the partitions in parallel
+  std::vector<std::pair<NBR_T*, NBR_T*>> bounds;
+  radix_sort_nbrs(begin, end, shift, &bounds);
+  parallel_for(
+      static_cast<size_t>(0), bounds.size(),
+      [&bounds, shift](size_t index) {
+        radix_sort_nbrs(bounds[index].first, bounds[index].second, shift - 8);
+      },
+      concurrency, 1);
+}
+
+/**
+ * @brief Edges from COO chunks, the edge id is the global index of the edge
+ * in the chunks. For undirected graphs each edge is visited in both
+ * directions.
+ */
+template <typename VID_T, typename EID_T>
+class COOEdgeSource {
+ public:
+  COOEdgeSource(
+      std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>&& src_chunks,
+      std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>&& dst_chunks,
+      bool undirected, size_t num_tasks)
+      : src_chunks_(std::move(src_chunks)),
+        dst_chunks_(std::move(dst_chunks)),
+        undirected_(undirected),
+        num_tasks_(num_tasks) {
+    chunk_offsets_.resize(src_chunks_.size() + 1, 0);
+    for (size_t i = 0; i < src_chunks_.size(); ++i) {
+      chunk_offsets_[i + 1] = chunk_offsets_[i] + src_chunks_[i]->length();
+    }
+  }
+
+  size_t num_tasks() const { return num_tasks_; }
+
+  // the COO chunks are not needed anymore once the edges are scattered
+  void Release() {
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>().swap(src_chunks_);
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>().swap(dst_chunks_);
+  }
+
+  template <typename FUNC_T>
+  void ForEach(size_t task, const FUNC_T& func) const {
+    const int64_t total = chunk_offsets_.back();
+    const int64_t begin = total * task / num_tasks_;
+    const int64_t end = total * (task + 1) / num_tasks_;
+    size_t chunk = std::upper_bound(chunk_offsets_.begin(),
+                                    chunk_offsets_.end(), begin) -
+                   chunk_offsets_.begin() - 1;
+    for (; chunk < src_chunks_.size() && chunk_offsets_[chunk] < end;
+         ++chunk) {
+      const int64_t base = chunk_offsets_[chunk];
+      const int64_t from = std::max(begin, base) - base;
+      const int64_t to = std::min(end, chunk_offsets_[chunk + 1]) - base;
+      const VID_T* src_list_ptr = src_chunks_[chunk]->raw_values();
+      const VID_T* dst_list_ptr = dst_chunks_[chunk]->raw_values();
+      for (int64_t i = from; i < to; ++i) {
+        EID_T eid = static_cast<EID_T>(base + i);
+        func(src_list_ptr[i], dst_list_ptr[i], eid);
+        if (undirected_) {
+          func(dst_list_ptr[i], src_list_ptr[i], eid);
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks_;
+  std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks_;
+  const bool undirected_;
+  const size_t num_tasks_;
+  std::vector<int64_t> chunk_offsets_;
+};
+
+/**
+ * @brief Edges of a CSR in the reversed direction, used to generate the CSC.
+ */
+template <typename VID_T, typename EID_T>
+class ReversedCSREdgeSource {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+
+ public:
+  ReversedCSREdgeSource(
+      const IdParser<VID_T>& parser, const std::vector<VID_T>& tvnums,
+      int vertex_label_num,
+      const std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>& edges,
+      const std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+      size_t num_tasks)
+      : parser_(parser),
+        tvnums_(tvnums),
+        edges_(edges),
+        edge_offsets_(edge_offsets),
+        num_tasks_(num_tasks) {
+    label_offsets_.resize(vertex_label_num + 1, 0);
+    for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+      const int64_t* offsets = edge_offsets[v_label]->data();
+      label_offsets_[v_label + 1] =
+          label_offsets_[v_label] + offsets[tvnums[v_label]];
+    }
+  }
+
+  size_t num_tasks() const { return num_tasks_; }
+
+  // the CSR is still part of the fragment
+  void Release() {}
+
+  template <typename FUNC_T>
+  void ForEach(size_t task, const FUNC_T& func) const {
+    const int64_t total = label_offsets_.back();
+    const int64_t begin = total * task / num_tasks_;
+    const int64_t end = total * (task + 1) / num_tasks_;
+    for (size_t v_label = 0; v_label + 1 < label_offsets_.size(); ++v_label) {
+      const int64_t base = label_offsets_[v_label];
+      const int64_t from = std::max(begin, base) - base;
+      const int64_t to = std::min(end, label_offsets_[v_label + 1]) - base;
+      if (from >= to) {
+        continue;
+      }
+      const nbr_unit_t* oe = edges_[v_label]->data();
+      const int64_t* oe_offsets = edge_offsets_[v_label]->data();
+      const int64_t* offsets_end = oe_offsets + tvnums_[v_label] + 1;
+      VID_T src_offset = static_cast<VID_T>(
+          std::upper_bound(oe_offsets, offsets_end, from) - oe_offsets - 1);
+      for (int64_t i = from; i < to; ++i) {
+        while (oe_offsets[src_offset + 1] <= i) {
+          ++src_offset;
+        }
+        func(oe[i].vid, parser_.GenerateId(v_label, src_offset),
+             static_cast<EID_T>(oe[i].eid));
+      }
+    }
+  }
+
+ private:
+  const IdParser<VID_T>& parser_;
+  const std::vector<VID_T>& tvnums_;
+  const std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>& edges_;
+  const std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets_;
+  const size_t num_tasks_;
+  std::vector<int64_t> label_offsets_;
+};
+
+/**
+ * @brief Builds the sorted adjacency lists with a two-level radix sort.
+ *
+ * Vertices are grouped into buckets of 2^shift consecutive vertices. Edges
+ * are counted per (task, bucket) without atomics, then each edge is scattered
+ * once, using the per-task cursors of its bucket, directly into the bucket's
+ * final range in the adjacency array, along with the local offset of the
+ * source vertex in the bucket (4 bytes per edge). The edge source is released
+ * after scattering. Each bucket is then sorted in place by the
+ * local offset (which yields the vertex offsets as well) and then by the
+ * neighbor vid, thus the per-vertex `std::sort`, the degree array and the
+ * atomic cursors are not needed.
+ */
+template <typename VID_T, typename EID_T, typename SOURCE_T>
+void radix_generate_csr(
+    Client& client, const IdParser<VID_T>& parser,
+    const std::vector<VID_T>& tvnums, int vertex_label_num, int concurrency,
+    SOURCE_T& source,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph) {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+  concurrency = std::max(concurrency, 1);
+  const size_t num_tasks = source.num_tasks();
+
+  // choose the bucket width to bound the size of the histograms
+  int64_t total_vnum = 0;
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    total_vnum += tvnums[v_label];
+  }
+  int shift = 10;
+  while (shift < 24 &&
+         static_cast<size_t>((total_vnum >> shift) + vertex_label_num) *
+                 num_tasks >
+             (static_cast<size_t>(1) << 24)) {
+    ++shift;
+  }
+  const int64_t bucket_width = static_cast<int64_t>(1) << shift;
+
+  std::vector<size_t> label_buckets(vertex_label_num + 1, 0);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    int64_t tvnum = tvnums[v_label];
+    label_buckets[v_label + 1] =
+        label_buckets[v_label] + (tvnum + bucket_width - 1) / bucket_width;
+  }
+  const size_t num_buckets = label_buckets[vertex_label_num];
+  std::vector<int> bucket_labels(num_buckets);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    std::fill(bucket_labels.begin() + label_buckets[v_label],
+              bucket_labels.begin() + label_buckets[v_label + 1], v_label);
+  }
+  auto bucket_of = [&parser, &label_buckets, shift](VID_T vid) -> size_t {
+    return label_buckets[parser.GetLabelId(vid)] +
+           static_cast<size_t>(parser.GetOffset(vid) >> shift);
+  };
+
+  // 1. count the edges per (task, bucket)
+  std::vector<std::vector<int64_t>> cursors(num_tasks);
+  parallel_for(
+      static_cast<size_t>(0), num_tasks,
+      [&](size_t task) {
+        auto& counts = cursors[task];
+        counts.resize(num_buckets, 0);
+        source.ForEach(task, [&](VID_T src, VID_T, EID_T) {
+          counts[bucket_of(src)] += 1;
+        });
+      },
+      concurrency, 1);
+
+  // 2. compute the ranges of buckets, and turn the counts into cursors
+  std::vector<int64_t> bucket_begins(num_buckets + 1, 0);
+  std::vector<int64_t> label_sizes(vertex_label_num, 0);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    int64_t offset = 0;
+    for (size_t bucket = label_buckets[v_label];
+         bucket < label_buckets[v_label + 1]; ++bucket) {
+      bucket_begins[bucket] = offset;
+      for (size_t task = 0; task < num_tasks; ++task) {
+        int64_t count = cursors[task][bucket];
+        cursors[task][bucket] = offset;
+        offset += count;
+      }
+    }
+    label_sizes[v_label] = offset;
+  }
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    edges[v_label] = std::make_shared<PodArrayBuilder<nbr_unit_t>>(
+        client, label_sizes[v_label]);
+    edge_offsets[v_label] =
+        std::make_shared<FixedInt64Builder>(client, tvnums[v_label] + 1);
+    edge_offsets[v_label]->data()[tvnums[v_label]] = label_sizes[v_label];
+  }
+  auto bucket_size = [&](size_t bucket) -> int64_t {
+    int v_label = bucket_labels[bucket];
+    int64_t end = bucket + 1 == label_buckets[v_label + 1]
+                      ? label_sizes[v_label]
+                      : bucket_begins[bucket + 1];
+    return end - bucket_begins[bucket];
+  };
+
+  VLOG(100) << "Start building the CSR with radix sort, buckets: "
+            << num_buckets << ", " << get_rss_pretty()
+            << ", peak = " << get_peak_rss_pretty();
+
+  // 3. scatter each edge once, the local offsets of the sources are staged
+  // at the same global position of the edge
+  std::vector<int64_t> label_bases(vertex_label_num + 1, 0);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    label_bases[v_label + 1] = label_bases[v_label] + label_sizes[v_label];
+  }
+  std::vector<uint32_t> locals(label_bases[vertex_label_num]);
+  parallel_for(
+      static_cast<size_t>(0), num_tasks,
+      [&](size_t task) {
+        auto& task_cursors = cursors[task];
+        source.ForEach(task, [&](VID_T src, VID_T dst, EID_T eid) {
+          size_t bucket = bucket_of(src);
+          int v_label = bucket_labels[bucket];
+          int64_t position = task_cursors[bucket]++;
+          nbr_unit_t* ptr = edges[v_label]->MutablePointer(position);
+          ptr->vid = dst;
+          ptr->eid = eid;
+          locals[label_bases[v_label] + position] = static_cast<uint32_t>(
+              parser.GetOffset(src) & (bucket_width - 1));
+        });
+      },
+      concurrency, 1);
+  std::vector<std::vector<int64_t>>().swap(cursors);
+  source.Release();
+
+  // 4. sort each bucket by the source vertex, and then by the neighbor
+  std::mutex mutex;
+  std::vector<std::pair<nbr_unit_t*, nbr_unit_t*>> large_lists;
+  parallel_for(
+      static_cast<size_t>(0), num_buckets,
+      [&](size_t bucket) {
+        int v_label = bucket_labels[bucket];
+        int64_t size = bucket_size(bucket);
+        nbr_unit_t* nbrs =
+            edges[v_label]->MutablePointer(bucket_begins[bucket]);
+        uint32_t* keys =
+            locals.data() + label_bases[v_label] + bucket_begins[bucket];
+        int64_t vertex_begin =
+            static_cast<int64_t>(bucket - label_buckets[v_label]) << shift;
+        int64_t width =
+            std::min(bucket_width,
+                     static_cast<int64_t>(tvnums[v_label]) - vertex_begin);
+
+        // counting sort by the source vertex, in place
+        std::vector<int64_t> heads(width + 1, 0);
+        for (int64_t i = 0; i < size; ++i) {
+          heads[keys[i] + 1] += 1;
+        }
+        for (int64_t k = 0; k < width; ++k) {
+          heads[k + 1] += heads[k];
+        }
+        int64_t* offsets = edge_offsets[v_label]->data() + vertex_begin;
+        for (int64_t k = 0; k < width; ++k) {
+          offsets[k] = bucket_begins[bucket] + heads[k];
+        }
+        std::vector<int64_t> tails(heads.begin() + 1, heads.end());
+        for (int64_t k = 0; k < width; ++k) {
+          while (heads[k] < tails[k]) {
+            nbr_unit_t value = nbrs[heads[k]];
+            uint32_t key = keys[heads[k]];
+            while (key != static_cast<uint32_t>(k)) {
+              int64_t target = heads[key]++;
+              std::swap(value, nbrs[target]);
+              std::swap(key, keys[target]);
+            }
+            nbrs[heads[k]] = value;
+            keys[heads[k]] = key;
+            heads[k] += 1;
+          }
+        }
+
+        // sort each adjacency list by the neighbor
+        for (int64_t k = 0; k < width; ++k) {
+          nbr_unit_t* begin = nbrs + (offsets[k] - bucket_begins[bucket]);
+          nbr_unit_t* end = nbrs + tails[k];
+          if (static_cast<size_t>(end - begin) >= kRadixCSRParallelThreshold) {
+            std::lock_guard<std::mutex> lock(mutex);
+            large_lists.emplace_back(begin, end);
+          } else {
+            sort_nbrs(begin, end, 1);
+          }
+        }
+      },
+      concurrency, 1);
+  std::vector<uint32_t>().swap(locals);
+
+  // the adjacency lists of high-degree vertices are sorted by all threads
+  for (auto const& list : large_lists) {
+    sort_nbrs(list.first, list.second, concurrency);
+  }
+
+  VLOG(100) << "Finish building the CSR with radix sort ..." << get_rss_pretty()
+            << ", peak = " << get_peak_rss_pretty();
+  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    if (!is_multigraph) {
+      check_is_multigraph(*edges[v_label], edge_offsets[v_label]->data(),
+                          tvnums[v_label], concurrency, is_multigraph);
+    }
+  }
+}
+
+}  // namespace detail
+
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_directed_csr_radix(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph) {
+  detail::COOEdgeSource<VID_T, EID_T> source(
+      std::move(src_chunks), std::move(dst_chunks), false,
+      std::max(concurrency, 1));
+  detail::radix_generate_csr<VID_T, EID_T>(client, parser, tvnums,
+                                           vertex_label_num, concurrency,
+                                           source, edges, edge_offsets,
+                                           is_multigraph);
+  return {};
+}
+
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_directed_csc_radix(
+    Client& client, IdParser<VID_T>& parser, std::vector<VID_T> tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph) {
+  detail::ReversedCSREdgeSource<VID_T, EID_T> source(
+      parser, tvnums, vertex_label_num, oedges, oedge_offsets,
+      std::max(concurrency, 1));
+  detail::radix_generate_csr<VID_T, EID_T>(client, parser, tvnums,
+                                           vertex_label_num, concurrency,
+                                           source, iedges, iedge_offsets,
+                                           is_multigraph);
+  return {};
+}
+
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_undirected_csr_radix(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph) {
+  detail::COOEdgeSource<VID_T, EID_T> source(
+      std::move(src_chunks), std::move(dst_chunks), true,
+      std::max(concurrency, 1));
+  detail::radix_generate_csr<VID_T, EID_T>(client, parser, tvnums,
+                                           vertex_label_num, concurrency,
+                                           source, edges, edge_offsets,
+                                           is_multigraph);
+  return {};
+}
+
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_csr_by_strategy(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    bool directed,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph, CSRBuildStrategy strategy) {
+  if (strategy == CSRBuildStrategy::kRadixSort) {
+    if (directed) {
+      BOOST_LEAF_CHECK(generate_directed_csr_radix<VID_T, EID_T>(
+          client, parser, std::move(src_chunks), std::move(dst_chunks),
+          tvnums, vertex_label_num, concurrency, oedges, oedge_offsets,
+          is_multigraph));
+      BOOST_LEAF_CHECK(generate_directed_csc_radix<VID_T, EID_T>(
+          client, parser, tvnums, vertex_label_num, concurrency, oedges,
+          oedge_offsets, iedges, iedge_offsets, is_multigraph));
+    } else {
+      BOOST_LEAF_CHECK(generate_undirected_csr_radix<VID_T, EID_T>(
+          client, parser, std::move(src_chunks), std::move(dst_chunks),
+          tvnums, vertex_label_num, concurrency, oedges, oedge_offsets,
+          is_multigraph));
+    }
+  } else {
+    if (directed) {
+      BOOST_LEAF_CHECK(generate_directed_csr<VID_T, EID_T>(
+          client, parser, std::move(src_chunks), std::move(dst_chunks),
+          tvnums, vertex_label_num, concurrency, oedges, oedge_offsets,
+          is_multigraph));
+      BOOST_LEAF_CHECK(generate_directed_csc<VID_T, EID_T>(
+          client, parser, tvnums, vertex_label_num, concurrency, oedges,
+          oedge_offsets, iedges, iedge_offsets, is_multigraph));
+    } else {
+      BOOST_LEAF_CHECK(generate_undirected_csr_memopt<VID_T, EID_T>(
+          client, parser, std::move(src_chunks), std::move(dst_chunks),
+          tvnums, vertex_label_num, concurrency, oedges, oedge_offsets,
+          is_multigraph));
+    }
+  }
+  return {};
+}
+
 }  // namespace vineyard
 
 #endif  // MODULES_GRAPH_FRAGMENT_PROPERTY_GRAPH_UTILS_IMPL_H_
@@ -27,7 +27,8 @@ template boost::leaf::result<void> generate_outer_vertices_map<uint32_t>(
     std::vector<ska::flat_hash_map<
         uint32_t, uint32_t, typename Hashmap<uint32_t, uint32_t>::KeyHash>>&
         ovg2l_maps,
-    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>>& ovgid_lists);
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>>& ovgid_lists,
+    const std::vector<Hashmap<uint32_t, uint32_t>*>& base_ovg2l_maps);
 
 template boost::leaf::result<void> generate_local_id_list<uint32_t>(
     IdParser<uint32_t>& parser, std::shared_ptr<arrow::ChunkedArray>&& gid_list,
@@ -37,7 +38,8 @@ template boost::leaf::result<void> generate_local_id_list<uint32_t>(
         ovg2l_maps,
     int concurrency,
     std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>>& lid_list,
-    arrow::MemoryPool* pool);
+    arrow::MemoryPool* pool,
+    const std::vector<Hashmap<uint32_t, uint32_t>*>& base_ovg2l_maps);
 
 template void sort_edges_with_respect_to_vertex<uint32_t, uint64_t>(
     vineyard::PodArrayBuilder<
@@ -97,4 +99,59 @@ generate_undirected_csr_memopt<uint32_t, uint64_t>(
     std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
     bool& is_multigraph);
 
+template boost::leaf::result<void>
+generate_directed_csr_radix<uint32_t, uint64_t>(
+    Client& client, IdParser<uint32_t>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> dst_chunks,
+    std::vector<uint32_t> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
+template boost::leaf::result<void>
+generate_directed_csc_radix<uint32_t, uint64_t>(
+    Client& client, IdParser<uint32_t>& parser, std::vector<uint32_t> tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph);
+
+template boost::leaf::result<void>
+generate_undirected_csr_radix<uint32_t, uint64_t>(
+    Client& client, IdParser<uint32_t>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> dst_chunks,
+    std::vector<uint32_t> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
+template boost::leaf::result<void>
+generate_csr_by_strategy<uint32_t, uint64_t>(
+    Client& client, IdParser<uint32_t>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<uint32_t>>> dst_chunks,
+    std::vector<uint32_t> tvnums, int vertex_label_num, int concurrency,
+    bool directed,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        oedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& oedge_offsets,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint32_t, uint64_t>>>>&
+        iedges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& iedge_offsets,
+    bool& is_multigraph, CSRBuildStrategy strategy);
+
 }  // namespace vineyard
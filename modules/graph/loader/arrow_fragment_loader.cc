@@ -30,6 +30,7 @@ limitations under the License.
 
 #include "grape/worker/comm_spec.h"
 
+#include "basic/ds/arrow_utils.h"
 #include "basic/ds/dataframe.h"
 #include "basic/ds/tensor.h"
 #include "basic/stream/dataframe_stream.h"
@@ -39,6 +40,32 @@ limitations under the License.
 
 namespace vineyard {
 
+// the number of chunks fetched ahead from each local stream
+static constexpr size_t kStreamPrefetch = 4;
+
+/**
+ * @brief Reads all batches of a local stream, which are copied out of the
+ * chunks as they outlive the reading client.
+ */
+template <typename LocalStreamT>
+static Status ReadBatchesFromLocalStream(
+    Client& client, std::shared_ptr<LocalStreamT> const& stream,
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& batches) {
+  std::shared_ptr<RecordBatchStreamReader> reader;
+  RETURN_ON_ERROR(
+      RecordBatchStreamReader::Make(client, stream, reader, kStreamPrefetch));
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    RETURN_ON_ARROW_ERROR(reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    RETURN_ON_ERROR(detail::Copy(batch, batch, false));
+    batches.emplace_back(batch);
+  }
+  return Status::OK();
+}
+
 template <typename LocalStreamT>
 static Status ReadRecordBatchesFromVineyardStreamImpl(
     Client& client, Tuple<std::shared_ptr<LocalStreamT>>& local_streams,
@@ -65,10 +92,9 @@ static Status ReadRecordBatchesFromVineyardStreamImpl(
     Client local_client;
     RETURN_ON_ERROR(local_client.Connect(client.IPCSocket()));
 
-    auto& stream = local_streams[idx];
-    RETURN_ON_ERROR(stream->OpenReader(&local_client));
     std::vector<std::shared_ptr<arrow::RecordBatch>> read_batches;
-    RETURN_ON_ERROR(stream->ReadRecordBatches(read_batches));
+    RETURN_ON_ERROR(ReadBatchesFromLocalStream(local_client, local_streams[idx],
+                                               read_batches));
     {
       std::lock_guard<std::mutex> scoped_lock(mutex_for_results);
       batches.insert(batches.end(), read_batches.begin(), read_batches.end());
@@ -189,10 +215,14 @@ static Status ReadTableFromVineyardStreamImpl(
     Client local_client;
     RETURN_ON_ERROR(local_client.Connect(client.IPCSocket()));
 
-    auto const& stream = local_streams[idx];
-    RETURN_ON_ERROR(local_streams[idx]->OpenReader(&local_client));
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    RETURN_ON_ERROR(
+        ReadBatchesFromLocalStream(local_client, local_streams[idx], batches));
     std::shared_ptr<arrow::Table> table;
-    RETURN_ON_ERROR(stream->ReadTable(table));
+    if (!batches.empty()) {
+      RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          table, arrow::Table::FromRecordBatches(batches));
+    }
     if (table == nullptr) {
       VLOG(10) << "table from stream is null.";
     } else {
@@ -40,6 +40,149 @@ limitations under the License.
 
 namespace vineyard {
 
+namespace detail {
+
+inline std::shared_ptr<arrow::DataType> dictionary_value_type(
+    const std::shared_ptr<arrow::DataType>& type) {
+  if (type->id() == arrow::Type::DICTIONARY) {
+    return std::static_pointer_cast<arrow::DictionaryType>(type)->value_type();
+  }
+  return type;
+}
+
+template <typename INDEX_T, typename FUNC_T>
+inline Status visit_dictionary_indices_impl(const arrow::Array& indices,
+                                            int64_t dictionary_length,
+                                            FUNC_T&& fn) {
+  auto const& array = static_cast<const arrow::NumericArray<INDEX_T>&>(indices);
+  for (int64_t k = 0; k < array.length(); ++k) {
+    if (array.IsNull(k)) {
+      return Status::Invalid("The id column contains a null at " +
+                             std::to_string(k));
+    }
+    int64_t code = static_cast<int64_t>(array.Value(k));
+    if (code < 0 || code >= dictionary_length) {
+      return Status::Invalid("The dictionary index " + std::to_string(code) +
+                             " is out of range at " + std::to_string(k));
+    }
+    fn(k, code);
+  }
+  return Status::OK();
+}
+
+/**
+ * @brief Invokes `fn(position, code)` for each of the dictionary indices,
+ * rejecting nulls and codes out of the dictionary.
+ */
+template <typename FUNC_T>
+inline Status visit_dictionary_indices(const arrow::Array& indices,
+                                       int64_t dictionary_length, FUNC_T&& fn) {
+  switch (indices.type_id()) {
+  case arrow::Type::INT8:
+    return visit_dictionary_indices_impl<arrow::Int8Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::UINT8:
+    return visit_dictionary_indices_impl<arrow::UInt8Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::INT16:
+    return visit_dictionary_indices_impl<arrow::Int16Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::UINT16:
+    return visit_dictionary_indices_impl<arrow::UInt16Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::INT32:
+    return visit_dictionary_indices_impl<arrow::Int32Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::UINT32:
+    return visit_dictionary_indices_impl<arrow::UInt32Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::INT64:
+    return visit_dictionary_indices_impl<arrow::Int64Type>(
+        indices, dictionary_length, fn);
+  case arrow::Type::UINT64:
+    return visit_dictionary_indices_impl<arrow::UInt64Type>(
+        indices, dictionary_length, fn);
+  default:
+    return Status::Invalid("Unsupported dictionary index type: " +
+                           indices.type()->ToString());
+  }
+}
+
+/**
+ * @brief Marks the dictionary entries referenced by the indices, as the
+ * dictionary may be shared by many chunks (e.g., the whole column) and
+ * only the referenced ids are required to be valid vertices.
+ */
+template <typename OID_T>
+inline Status referenced_dictionary_codes(
+    const arrow::DictionaryArray& array,
+    const std::shared_ptr<ArrowArrayType<OID_T>>& dictionary,
+    std::vector<bool>& referenced) {
+  if (dictionary == nullptr) {
+    return Status::Invalid("OID_T '" + type_name<OID_T>() +
+                           "' is not consistent with the id dictionary: '" +
+                           array.dictionary()->type()->ToString() + "'");
+  }
+  referenced.assign(dictionary->length(), false);
+  RETURN_ON_ERROR(visit_dictionary_indices(
+      *array.indices(), dictionary->length(),
+      [&referenced](int64_t, int64_t code) { referenced[code] = true; }));
+  for (int64_t code = 0; code < dictionary->length(); ++code) {
+    if (referenced[code] && dictionary->IsNull(code)) {
+      return Status::Invalid("The id dictionary contains a null at " +
+                             std::to_string(code));
+    }
+  }
+  return Status::OK();
+}
+
+/**
+ * @brief Decodes the dictionary-encoded id columns, for the local vertex map,
+ * which shuffles the edges by the ids.
+ */
+template <typename OID_T>
+inline Status decode_dictionary_ids(std::shared_ptr<arrow::Table>& table,
+                                    const std::vector<int>& columns) {
+  for (int column : columns) {
+    auto ids = table->column(column);
+    if (ids->type()->id() != arrow::Type::DICTIONARY) {
+      continue;
+    }
+    std::vector<std::shared_ptr<arrow::Array>> chunks;
+    for (auto const& chunk : ids->chunks()) {
+      auto const& array = static_cast<const arrow::DictionaryArray&>(*chunk);
+      auto dictionary =
+          std::dynamic_pointer_cast<ArrowArrayType<OID_T>>(array.dictionary());
+      std::vector<bool> referenced;
+      RETURN_ON_ERROR(
+          referenced_dictionary_codes<OID_T>(array, dictionary, referenced));
+      ArrowBuilderType<OID_T> builder;
+      RETURN_ON_ARROW_ERROR(builder.Reserve(array.length()));
+      arrow::Status status;
+      RETURN_ON_ERROR(visit_dictionary_indices(
+          *array.indices(), dictionary->length(), [&](int64_t, int64_t code) {
+            if (status.ok()) {
+              status = builder.Append(dictionary->GetView(code));
+            }
+          }));
+      RETURN_ON_ARROW_ERROR(status);
+      std::shared_ptr<arrow::Array> decoded;
+      RETURN_ON_ARROW_ERROR(builder.Finish(&decoded));
+      chunks.push_back(decoded);
+    }
+    auto field = table->schema()->field(column)->WithType(
+        ConvertToArrowType<OID_T>::TypeValue());
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        table,
+        table->SetColumn(column, field,
+                         std::make_shared<arrow::ChunkedArray>(
+                             chunks, ConvertToArrowType<OID_T>::TypeValue())));
+  }
+  return Status::OK();
+}
+
+}  // namespace detail
+
 template <typename OID_T, typename VID_T, typename PARTITIONER_T,
           template <typename, typename> class VERTEX_MAP_T>
 BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T, VERTEX_MAP_T>::
@@ -151,8 +294,24 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T, VERTEX_MAP_T>::AddEdgeTable(
   }
   dst_label_id = iter->second;
 
-  auto src_column_type = edge_table->column(src_column)->type();
-  auto dst_column_type = edge_table->column(dst_column)->type();
+  if (edge_table->column(src_column)->null_count() != 0 ||
+      edge_table->column(dst_column)->null_count() != 0) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                    "The src/dst ids of edge table for label '" + edge_label +
+                        "' contain nulls");
+  }
+
+  // dictionary-encoded ids are mapped per distinct value with the global
+  // vertex map, see also `parseOidChunkedArrayChunk()`, and decoded for the
+  // local vertex map, as it shuffles the edges by the ids
+  if (is_local_vertex_map<vertex_map_t>::value) {
+    VY_OK_OR_RAISE(detail::decode_dictionary_ids<oid_t>(
+        edge_table, {src_column, dst_column}));
+  }
+  auto src_column_type =
+      detail::dictionary_value_type(edge_table->column(src_column)->type());
+  auto dst_column_type =
+      detail::dictionary_value_type(edge_table->column(dst_column)->type());
 
   if (!src_column_type->Equals(
           vineyard::ConvertToArrowType<oid_t>::TypeValue())) {
@@ -454,8 +613,53 @@ Status BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T, VERTEX_MAP_T>::
     parseOidChunkedArrayChunk(label_id_t label_id,
                               const std::shared_ptr<arrow::Array> oid_arrays_in,
                               std::shared_ptr<arrow::Array>& out) {
+  if (oid_arrays_in->type_id() == arrow::Type::DICTIONARY) {
+    // the distinct oids referenced by the chunk are mapped only once, then
+    // gathered by the indices
+    auto const& dictionary_array =
+        static_cast<const arrow::DictionaryArray&>(*oid_arrays_in);
+    auto dictionary =
+        std::dynamic_pointer_cast<oid_array_t>(dictionary_array.dictionary());
+    std::vector<bool> referenced;
+    RETURN_ON_ERROR(detail::referenced_dictionary_codes<oid_t>(
+        dictionary_array, dictionary, referenced));
+
+    vertex_map_t* vm = vm_ptr_.get();
+    std::vector<vid_t> dictionary_gids(dictionary->length());
+    for (int64_t code = 0; code < dictionary->length(); ++code) {
+      if (!referenced[code]) {
+        continue;
+      }
+      internal_oid_t oid = dictionary->GetView(code);
+      fid_t fid = partitioner_.GetPartitionId(oid);
+      if (!vm->GetGid(fid, label_id, oid, dictionary_gids[code])) {
+        LOG(ERROR) << "Mapping vertex " << oid << " failed.";
+      }
+    }
+
+    std::unique_ptr<arrow::Buffer> buffer;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        buffer,
+        arrow::AllocateBuffer(dictionary_array.length() * sizeof(vid_t)));
+    vid_t* gids = reinterpret_cast<vid_t*>(buffer->mutable_data());
+    RETURN_ON_ERROR(detail::visit_dictionary_indices(
+        *dictionary_array.indices(), dictionary->length(),
+        [gids, &dictionary_gids](int64_t k, int64_t code) {
+          gids[k] = dictionary_gids[code];
+        }));
+    out = std::make_shared<ArrowArrayType<VID_T>>(
+        dictionary_array.length(),
+        std::shared_ptr<arrow::Buffer>(std::move(buffer)), nullptr, 0);
+    return Status::OK();
+  }
+
   std::shared_ptr<oid_array_t> oid_array =
       std::dynamic_pointer_cast<oid_array_t>(oid_arrays_in);
+  if (oid_array == nullptr) {
+    return Status::Invalid("OID_T '" + type_name<OID_T>() +
+                           "' is not consistent with the id array: '" +
+                           oid_arrays_in->type()->ToString() + "'");
+  }
   vertex_map_t* vm = vm_ptr_.get();
 
   // prepare buffer
@@ -466,8 +670,16 @@ Status BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T, VERTEX_MAP_T>::
   }
 
   vid_t* builder = reinterpret_cast<vid_t*>(buffer->mutable_data());
+  internal_oid_t last_oid{};
   for (int64_t k = 0; k != oid_array->length(); ++k) {
     internal_oid_t oid = oid_array->GetView(k);
+    // edges are usually grouped by the source, the repeated oids reuse the
+    // previous gid rather than being hashed again
+    if (k > 0 && oid == last_oid) {
+      builder[k] = builder[k - 1];
+      continue;
+    }
+    last_oid = oid;
     fid_t fid = partitioner_.GetPartitionId(oid);
     if (!vm->GetGid(fid, label_id, oid, builder[k])) {
       LOG(ERROR) << "Mapping vertex " << oid << " failed.";
@@ -604,8 +816,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T,
 
     auto shuffle_procedure =
         [&]() -> boost::leaf::result<std::shared_ptr<arrow::Table>> {
-      BOOST_LEAF_AUTO(table, ShufflePropertyVertexTable<partitioner_t>(
-                                 comm_spec_, partitioner_, vertex_table));
+      BOOST_LEAF_AUTO(table,
+                      ShufflePropertyVertexTable<partitioner_t>(
+                          comm_spec_, partitioner_, vertex_table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled vertex table size for label " << v_label << ": "
                 << table->num_rows();
@@ -701,8 +914,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T,
     auto vertex_table = ordered_vertex_tables_[v_label];
     auto shuffle_procedure =
         [&]() -> boost::leaf::result<std::shared_ptr<arrow::Table>> {
-      BOOST_LEAF_AUTO(table, ShufflePropertyVertexTable<partitioner_t>(
-                                 comm_spec_, partitioner_, vertex_table));
+      BOOST_LEAF_AUTO(table,
+                      ShufflePropertyVertexTable<partitioner_t>(
+                          comm_spec_, partitioner_, vertex_table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled vertex table size for label " << v_label << ": "
                 << table->num_rows();
@@ -766,9 +980,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T,
       std::shared_ptr<ITablePipeline> table =
           std::make_shared<ConcatTablePipeline>(processed_table_list);
       // Shuffle the edge table with gid
-      BOOST_LEAF_AUTO(
-          table_out, ShufflePropertyEdgeTable<vid_t>(
-                         comm_spec_, id_parser, src_column, dst_column, table));
+      BOOST_LEAF_AUTO(table_out, ShufflePropertyEdgeTable<vid_t>(
+                                     comm_spec_, id_parser, src_column,
+                                     dst_column, table, &client_));
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled edge table size for label " << e_label << ": "
                 << table_out->num_rows();
@@ -813,7 +1027,8 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T,
         BOOST_LEAF_AUTO(
             table_out,
             ShufflePropertyEdgeTableByPartition<partitioner_t>(
-                comm_spec_, partitioner_, src_column, dst_column, item.second));
+                comm_spec_, partitioner_, src_column, dst_column, item.second,
+                &client_));
         VLOG(100) << "[worker-" << comm_spec_.worker_id()
                   << "] shuffled edge table size for label " << e_label << ": "
                   << table_out->num_rows();
@@ -15,14 +15,22 @@ limitations under the License.
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <fstream>
+#include <map>
+#include <random>
+#include <set>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "client/client.h"
 #include "common/util/logging.h"
 
 #include "graph/fragment/arrow_fragment.h"
 #include "graph/fragment/graph_schema.h"
+#include "graph/fragment/property_graph_utils.h"
 #include "graph/loader/arrow_fragment_loader.h"
 
 using namespace vineyard;  // NOLINT(build/namespaces)
@@ -31,6 +39,213 @@ using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
                                 property_graph_types::VID_TYPE>;
 using LabelType = typename GraphType::label_id_t;
 
+// Adds a new edge label whose edges point from the inner vertices to the
+// given (outer) vertices of label 0.
+ObjectID AddOuterEdges(vineyard::Client& client,
+                       std::shared_ptr<GraphType> const& frag,
+                       std::string const& label,
+                       std::vector<GraphType::vid_t> const& outer_gids) {
+  using vid_t = GraphType::vid_t;
+  auto inner_vertices = frag->InnerVertices(0);
+  ArrowBuilderType<vid_t> src_builder, dst_builder;
+  arrow::Int64Builder weight_builder;
+  for (size_t i = 0; i < outer_gids.size(); ++i) {
+    GraphType::vertex_t v =
+        inner_vertices.begin() + i % inner_vertices.size();
+    CHECK_ARROW_ERROR(src_builder.Append(frag->GetInnerVertexGid(v)));
+    CHECK_ARROW_ERROR(dst_builder.Append(outer_gids[i]));
+    CHECK_ARROW_ERROR(weight_builder.Append(i));
+  }
+  std::shared_ptr<arrow::Array> src, dst, weight;
+  CHECK_ARROW_ERROR(src_builder.Finish(&src));
+  CHECK_ARROW_ERROR(dst_builder.Finish(&dst));
+  CHECK_ARROW_ERROR(weight_builder.Finish(&weight));
+  auto schema = arrow::schema({arrow::field("src", src->type()),
+                               arrow::field("dst", dst->type()),
+                               arrow::field("weight", weight->type())})
+                    ->WithMetadata(arrow::KeyValueMetadata::Make(
+                        {"label"}, {label}));
+  std::vector<std::shared_ptr<arrow::Table>> edge_tables{
+      arrow::Table::Make(schema, {src, dst, weight})};
+  std::string vertex_label = frag->schema().GetVertexLabelName(0);
+  std::vector<std::set<std::pair<std::string, std::string>>> edge_relations{
+      {{vertex_label, vertex_label}}};
+  return frag->AddNewEdgeLabels(client, std::move(edge_tables), edge_relations,
+                                1)
+      .value();
+}
+
+// The outer vertices pulled in by new edge labels are resolvable, whether
+// they live in the base or in the delta outer vertex map.
+void CheckDeltaOuterVertices(vineyard::Client& client,
+                             std::shared_ptr<GraphType> const& frag) {
+  using vid_t = GraphType::vid_t;
+  const std::string delta_key = "ovg2l_delta_map_0";
+  CHECK(!frag->meta().HasKey(delta_key));
+  // outer vertices only come from other fragments
+  if (frag->fnum() < 2) {
+    LOG(INFO) << "Skipped delta outer vertex maps check: single fragment";
+    return;
+  }
+
+  IdParser<vid_t> parser;
+  parser.Init(frag->fnum(), frag->vertex_label_num());
+  fid_t other = (frag->fid() + 1) % frag->fnum();
+  std::vector<vid_t> gids;
+  for (int64_t offset = 0; offset < 10; ++offset) {
+    gids.push_back(parser.GenerateId(other, 0, offset));
+  }
+  auto check_gids = [&](std::shared_ptr<GraphType> const& f) {
+    for (vid_t gid : gids) {
+      GraphType::vertex_t v;
+      CHECK(f->OuterVertexGid2Vertex(gid, v));
+      CHECK(f->IsOuterVertex(v));
+      CHECK_EQ(f->GetOuterVertexGid(v), gid);
+    }
+  };
+
+  auto frag1 = std::dynamic_pointer_cast<GraphType>(
+      client.GetObject(AddOuterEdges(client, frag, "delta_knows_1", gids)));
+  check_gids(frag1);
+
+  // a single new outer vertex stays within the compaction ratio of the base
+  gids.push_back(parser.GenerateId(other, 0, 1000));
+  auto frag2 = std::dynamic_pointer_cast<GraphType>(
+      client.GetObject(AddOuterEdges(client, frag1, "delta_knows_2", gids)));
+  CHECK(frag2->meta().HasKey(delta_key));
+  check_gids(frag2);
+
+  auto frag3 = std::dynamic_pointer_cast<GraphType>(
+      client.GetObject(frag2->CompactOuterVertexMaps(client).value()));
+  CHECK_NE(frag3->id(), frag2->id());
+  CHECK(!frag3->meta().HasKey(delta_key));
+  check_gids(frag3);
+  CHECK_EQ(frag3->CompactOuterVertexMaps(client).value(), frag3->id());
+  LOG(INFO) << "Passed delta outer vertex maps check";
+}
+
+// The compressed adjacency lists decode to the same neighbors and edges as
+// the plain CSR, and survive the fragments derived by adding properties.
+void CheckCompressedAdjLists(vineyard::Client& client,
+                             std::shared_ptr<GraphType> const& frag) {
+  using vid_t = GraphType::vid_t;
+  using eid_t = GraphType::eid_t;
+  using vertex_t = GraphType::vertex_t;
+  const int concurrency =
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  auto cfrag = std::dynamic_pointer_cast<GraphType>(client.GetObject(
+      frag->CompressAdjLists(client, concurrency).value()));
+  CHECK(!frag->compressed());
+  CHECK(cfrag->compressed());
+  CHECK_EQ(cfrag->CompressAdjLists(client).value(), cfrag->id());
+  CHECK_EQ(cfrag->GetOutEdgeNum(), frag->GetOutEdgeNum());
+  CHECK_EQ(cfrag->GetInEdgeNum(), frag->GetInEdgeNum());
+
+  auto as_pairs = [](GraphType::adj_list_t const& list) {
+    std::vector<std::pair<vid_t, eid_t>> pairs;
+    for (auto& e : list) {
+      pairs.emplace_back(e.neighbor().GetValue(), e.edge_id());
+    }
+    return pairs;
+  };
+  auto check = [&](std::shared_ptr<GraphType> const& f) {
+    for (LabelType v_label = 0; v_label < frag->vertex_label_num();
+         ++v_label) {
+      for (LabelType e_label = 0; e_label < frag->edge_label_num();
+           ++e_label) {
+        for (auto v : frag->Vertices(v_label)) {
+          auto oe = f->GetOutgoingAdjList(v, e_label);
+          auto ie = f->GetIncomingAdjList(v, e_label);
+          CHECK(oe.compressed() && ie.compressed());
+          CHECK_EQ(oe.Size(), frag->GetOutgoingAdjList(v, e_label).Size());
+          CHECK_EQ(ie.Size(), frag->GetIncomingAdjList(v, e_label).Size());
+          CHECK(as_pairs(oe) == as_pairs(frag->GetOutgoingAdjList(v, e_label)));
+          CHECK(as_pairs(ie) == as_pairs(frag->GetIncomingAdjList(v, e_label)));
+        }
+      }
+    }
+  };
+  check(cfrag);
+
+  // the skip entries find the same neighbors as a scan over the sorted lists
+  auto csr = std::dynamic_pointer_cast<CompressedCSR<vid_t, eid_t>>(
+      cfrag->meta().GetMember("compressed_oe_list_0_0"));
+  CHECK(csr != nullptr);
+  CHECK_LE(csr->encoded_size(),
+           csr->edge_num() * sizeof(GraphType::nbr_unit_t));
+  for (auto v : frag->Vertices(0)) {
+    auto pairs = as_pairs(frag->GetOutgoingAdjList(v, 0));
+    if (!std::is_sorted(pairs.begin(), pairs.end())) {
+      continue;
+    }
+    for (auto const& pair : pairs) {
+      for (vid_t u : {pair.first - 1, pair.first, pair.first + 1}) {
+        auto iter = std::lower_bound(pairs.begin(), pairs.end(),
+                                     std::make_pair(u, eid_t(0)));
+        vertex_t nbr;
+        CHECK_EQ(csr->lower_bound(v, vertex_t(u), nbr), iter != pairs.end());
+        if (iter != pairs.end()) {
+          CHECK_EQ(nbr.GetValue(), iter->first);
+        }
+      }
+    }
+  }
+
+  // properties can still be added, while the topology is frozen
+  std::map<LabelType,
+           std::vector<std::pair<std::string, std::shared_ptr<arrow::Array>>>>
+      columns;
+  auto column = frag->vertex_data_table(0)->column(0)->chunk(0);
+  columns[0].emplace_back("compressed_copy", column);
+  auto dfrag = std::dynamic_pointer_cast<GraphType>(client.GetObject(
+      cfrag->AddVertexColumns(client, columns).value()));
+  CHECK(dfrag->compressed());
+  check(dfrag);
+  CHECK(!cfrag->TransformDirection(client, 1));
+  LOG(INFO) << "Passed compressed adjacency lists check";
+}
+
+// The dictionary-encoded src/dst ids load into the same graph as the plain
+// ids, and null ids are rejected.
+template <template <typename, typename> class VERTEX_MAP_T>
+void CheckDictionaryEncodedEdges(
+    vineyard::Client& client, const grape::CommSpec& comm_spec,
+    std::vector<std::shared_ptr<arrow::Table>> const& vtables,
+    std::vector<std::vector<std::shared_ptr<arrow::Table>>> const& etables,
+    std::vector<std::vector<std::shared_ptr<arrow::Table>>> const&
+        dictionary_etables,
+    std::vector<std::vector<std::shared_ptr<arrow::Table>>> const&
+        null_dictionary_etables,
+    bool directed) {
+  using oid_t = property_graph_types::OID_TYPE;
+  using vid_t = property_graph_types::VID_TYPE;
+  using fragment_t =
+      ArrowFragment<oid_t, vid_t,
+                    VERTEX_MAP_T<typename InternalType<oid_t>::type, vid_t>>;
+  using loader_t = ArrowFragmentLoader<oid_t, vid_t, VERTEX_MAP_T>;
+
+  auto load = [&](std::vector<std::vector<std::shared_ptr<arrow::Table>>> const&
+                      tables) {
+    loader_t loader(client, comm_spec, vtables, tables, directed);
+    return loader.LoadFragment();
+  };
+
+  auto frag = std::dynamic_pointer_cast<fragment_t>(
+      client.GetObject(load(etables).value()));
+  auto dictionary_frag = std::dynamic_pointer_cast<fragment_t>(
+      client.GetObject(load(dictionary_etables).value()));
+  CHECK_EQ(frag->GetEdgeNum(), dictionary_frag->GetEdgeNum());
+  for (auto v : frag->InnerVertices(0)) {
+    typename fragment_t::vertex_t u;
+    CHECK(dictionary_frag->GetVertex(0, frag->GetId(v), u));
+    CHECK_EQ(frag->GetLocalOutDegree(v, 0),
+             dictionary_frag->GetLocalOutDegree(u, 0));
+  }
+
+  CHECK(!load(null_dictionary_etables));
+  LOG(INFO) << "Passed dictionary-encoded edges check";
+}
+
 void WriteOut(vineyard::Client& client, const grape::CommSpec& comm_spec,
               vineyard::ObjectID fragment_group_id) {
   LOG(INFO) << "Loaded graph to vineyard: " << fragment_group_id;
@@ -59,6 +274,14 @@ void WriteOut(vineyard::Client& client, const grape::CommSpec& comm_spec,
     LOG(INFO) << "fragment in edge number: " << frag->GetInEdgeNum();
     LOG(INFO) << "fragment out edge number: " << frag->GetOutEdgeNum();
 
+    // the persisted statistics agree with the edge numbers
+    auto const& statistics = frag->GetEdgeStatistics();
+    CHECK(!statistics.empty());
+    CHECK_EQ(static_cast<size_t>(statistics.out_edge_num()),
+             frag->GetOutEdgeNum());
+    CHECK_EQ(static_cast<size_t>(statistics.in_edge_num()),
+             frag->GetInEdgeNum());
+
     LOG(INFO) << "[worker-" << comm_spec.worker_id()
               << "] loaded graph to vineyard: " << ObjectIDToString(frag_id)
               << " ...";
@@ -72,6 +295,11 @@ void WriteOut(vineyard::Client& client, const grape::CommSpec& comm_spec,
                 << frag->edge_data_table(elabel)->schema()->ToString();
     }
 
+    // a freshly loaded fragment has no delta outer vertices to merge
+    CHECK_EQ(frag->CompactOuterVertexMaps(client).value(), frag_id);
+    CheckDeltaOuterVertices(client, frag);
+    CheckCompressedAdjLists(client, frag);
+
     LOG(INFO) << "--------------- consolidate vertex/edge table columns ...";
 
     if (frag->vertex_data_table(0)->columns().size() >= 4) {
@@ -102,6 +330,104 @@ void WriteOut(vineyard::Client& client, const grape::CommSpec& comm_spec,
   }
 }
 
+// The radix sort based CSR/CSC construction yields the same adjacency lists
+// as the default one.
+void CompareCSRBuildStrategies(vineyard::Client& client, bool directed) {
+  using vid_t = property_graph_types::VID_TYPE;
+  using eid_t = property_graph_types::EID_TYPE;
+  using nbr_unit_t = property_graph_utils::NbrUnit<vid_t, eid_t>;
+  using edges_t = std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>>;
+  using offsets_t = std::vector<std::shared_ptr<FixedInt64Builder>>;
+
+  const int vertex_label_num = 2;
+  const std::vector<vid_t> tvnums = {3000, 50000};
+  IdParser<vid_t> parser;
+  parser.Init(1, vertex_label_num);
+
+  // random edges, with a few high-degree vertices and multi-edges
+  std::mt19937_64 rng(20230101);
+  auto random_vid = [&]() -> vid_t {
+    int label = static_cast<int>(rng() % vertex_label_num);
+    int64_t offset = (rng() % 8 == 0) ? rng() % 4 : rng() % tvnums[label];
+    return parser.GenerateId(label, offset);
+  };
+  std::vector<std::shared_ptr<ArrowArrayType<vid_t>>> src_chunks, dst_chunks;
+  for (int chunk = 0; chunk < 3; ++chunk) {
+    ArrowBuilderType<vid_t> src_builder, dst_builder;
+    for (int i = 0; i < 100000; ++i) {
+      CHECK_ARROW_ERROR(src_builder.Append(random_vid()));
+      CHECK_ARROW_ERROR(dst_builder.Append(random_vid()));
+    }
+    std::shared_ptr<ArrowArrayType<vid_t>> src, dst;
+    CHECK_ARROW_ERROR(src_builder.Finish(&src));
+    CHECK_ARROW_ERROR(dst_builder.Finish(&dst));
+    src_chunks.push_back(src);
+    dst_chunks.push_back(dst);
+  }
+
+  const int concurrency =
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  auto build = [&](CSRBuildStrategy strategy, edges_t& oe,
+                   offsets_t& oe_offsets, edges_t& ie, offsets_t& ie_offsets,
+                   bool& is_multigraph) {
+    oe.resize(vertex_label_num), oe_offsets.resize(vertex_label_num);
+    ie.resize(vertex_label_num), ie_offsets.resize(vertex_label_num);
+    is_multigraph = false;
+    CHECK(generate_csr_by_strategy<vid_t, eid_t>(
+        client, parser, src_chunks, dst_chunks, tvnums, vertex_label_num,
+        concurrency, directed, oe, oe_offsets, ie, ie_offsets, is_multigraph,
+        strategy));
+  };
+  auto compare = [&](const edges_t& expected, const offsets_t& expected_offsets,
+                     const edges_t& actual, const offsets_t& actual_offsets) {
+    auto by_vid = [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+      return lhs.vid < rhs.vid;
+    };
+    auto as_pairs = [](const nbr_unit_t* begin, const nbr_unit_t* end) {
+      std::vector<std::pair<vid_t, eid_t>> pairs;
+      for (const nbr_unit_t* iter = begin; iter != end; ++iter) {
+        pairs.emplace_back(iter->vid, iter->eid);
+      }
+      std::sort(pairs.begin(), pairs.end());
+      return pairs;
+    };
+    for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+      const int64_t* lhs_offsets = expected_offsets[v_label]->data();
+      const int64_t* rhs_offsets = actual_offsets[v_label]->data();
+      CHECK_EQ(expected[v_label]->size(), actual[v_label]->size());
+      for (vid_t v = 0; v <= tvnums[v_label]; ++v) {
+        CHECK_EQ(lhs_offsets[v], rhs_offsets[v]);
+      }
+      for (vid_t v = 0; v < tvnums[v_label]; ++v) {
+        const nbr_unit_t* lhs = expected[v_label]->data();
+        const nbr_unit_t* rhs = actual[v_label]->data();
+        CHECK(std::is_sorted(rhs + rhs_offsets[v], rhs + rhs_offsets[v + 1],
+                             by_vid));
+        // the order of multi-edges between the same pair of vertices is
+        // unspecified
+        CHECK(as_pairs(lhs + lhs_offsets[v], lhs + lhs_offsets[v + 1]) ==
+              as_pairs(rhs + rhs_offsets[v], rhs + rhs_offsets[v + 1]));
+      }
+    }
+  };
+
+  edges_t oe, ie, radix_oe, radix_ie;
+  offsets_t oe_offsets, ie_offsets, radix_oe_offsets, radix_ie_offsets;
+  bool is_multigraph = false, radix_is_multigraph = false;
+  build(CSRBuildStrategy::kScatter, oe, oe_offsets, ie, ie_offsets,
+        is_multigraph);
+  build(CSRBuildStrategy::kRadixSort, radix_oe, radix_oe_offsets, radix_ie,
+        radix_ie_offsets, radix_is_multigraph);
+
+  CHECK_EQ(is_multigraph, radix_is_multigraph);
+  compare(oe, oe_offsets, radix_oe, radix_oe_offsets);
+  if (directed) {
+    compare(ie, ie_offsets, radix_ie, radix_ie_offsets);
+  }
+  LOG(INFO) << "Passed CSR build strategies comparison, directed = "
+            << directed;
+}
+
 namespace detail {
 
 std::shared_ptr<arrow::ChunkedArray> makeInt64Array() {
@@ -160,6 +486,47 @@ std::vector<std::vector<std::shared_ptr<arrow::Table>>> makeETables() {
                makeInt64Array(), makeInt64Array(), makeInt64Array()});
   return {{table}};
 }
+// Encodes the ids with a dictionary that has extra (unreferenced) entries,
+// the index at `null_at` (if any) is null.
+std::shared_ptr<arrow::Array> makeDictionaryIds(int64_t length,
+                                                int64_t null_at = -1) {
+  arrow::Int64Builder values_builder;
+  for (int64_t value = 0; value < 10; ++value) {
+    CHECK_ARROW_ERROR(values_builder.Append(value));
+  }
+  CHECK_ARROW_ERROR(values_builder.Append(100));
+  CHECK_ARROW_ERROR(values_builder.Append(101));
+  std::shared_ptr<arrow::Array> values;
+  CHECK_ARROW_ERROR(values_builder.Finish(&values));
+
+  arrow::Int32Builder indices_builder;
+  for (int64_t k = 0; k < length; ++k) {
+    if (k == null_at) {
+      CHECK_ARROW_ERROR(indices_builder.AppendNull());
+    } else {
+      CHECK_ARROW_ERROR(indices_builder.Append(static_cast<int32_t>(k % 10)));
+    }
+  }
+  std::shared_ptr<arrow::Array> indices;
+  CHECK_ARROW_ERROR(indices_builder.Finish(&indices));
+  return arrow::DictionaryArray::FromArrays(
+             arrow::dictionary(arrow::int32(), arrow::int64()), indices,
+             values)
+      .ValueOrDie();
+}
+
+std::vector<std::vector<std::shared_ptr<arrow::Table>>> makeDictionaryETables(
+    int64_t null_at = -1) {
+  auto etable = makeETables()[0][0];
+  auto ids = makeDictionaryIds(etable->num_rows(), null_at);
+  auto schema = etable->schema();
+  auto src_field = schema->field(0)->WithType(ids->type());
+  auto dst_field = schema->field(1)->WithType(ids->type());
+  auto chunked_ids = std::make_shared<arrow::ChunkedArray>(ids);
+  auto table = etable->SetColumn(0, src_field, chunked_ids).ValueOrDie();
+  table = table->SetColumn(1, dst_field, chunked_ids).ValueOrDie();
+  return {{table}};
+}
 }  // namespace detail
 
 int main(int argc, char** argv) {
@@ -185,10 +552,23 @@ int main(int argc, char** argv) {
 
   grape::InitMPIComm();
 
+  CompareCSRBuildStrategies(client, directed != 0);
+
   {
     grape::CommSpec comm_spec;
     comm_spec.Init(MPI_COMM_WORLD);
 
+    {
+      auto dictionary_etables = ::detail::makeDictionaryETables();
+      auto null_dictionary_etables = ::detail::makeDictionaryETables(3);
+      CheckDictionaryEncodedEdges<ArrowVertexMap>(
+          client, comm_spec, vtables, etables, dictionary_etables,
+          null_dictionary_etables, directed != 0);
+      CheckDictionaryEncodedEdges<ArrowLocalVertexMap>(
+          client, comm_spec, vtables, etables, dictionary_etables,
+          null_dictionary_etables, directed != 0);
+    }
+
     {
       auto loader =
           std::make_unique<ArrowFragmentLoader<property_graph_types::OID_TYPE,
@@ -0,0 +1,324 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+#include "grape/worker/comm_spec.h"
+
+#include "client/client.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/arrow_local_vertex_map.h"
+#include "graph/vertex_map/arrow_vertex_map.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using vid_t = property_graph_types::VID_TYPE;
+using label_id_t = property_graph_types::LABEL_ID_TYPE;
+
+constexpr fid_t kFnum = 3;
+// the keys of the fragment `fid` are `[fid * kStride, (fid + 1) * kStride)`
+constexpr int64_t kStride = 1 << 24;
+// see also `VINEYARD_VERTEX_MAP_COMPACTION_RATIO` in main()
+constexpr double kCompactionRatio = 0.5;
+
+template <typename OID_T>
+struct TestOid {};
+
+template <>
+struct TestOid<int64_t> {
+  using key_t = int64_t;
+  static key_t Key(int64_t i) { return i; }
+};
+
+template <>
+struct TestOid<arrow_string_view> {
+  using key_t = std::string;
+  static key_t Key(int64_t i) { return "vertex-" + std::to_string(i); }
+};
+
+template <typename OID_T>
+std::shared_ptr<ArrowArrayType<OID_T>> MakeOids(
+    const std::vector<int64_t>& keys) {
+  ArrowBuilderType<OID_T> builder;
+  for (int64_t i : keys) {
+    CHECK_ARROW_ERROR(builder.Append(TestOid<OID_T>::Key(i)));
+  }
+  std::shared_ptr<arrow::Array> array;
+  CHECK_ARROW_ERROR(builder.Finish(&array));
+  return std::dynamic_pointer_cast<ArrowArrayType<OID_T>>(array);
+}
+
+std::vector<int64_t> Range(fid_t fid, int64_t begin, int64_t end) {
+  std::vector<int64_t> keys;
+  for (int64_t i = begin; i < end; ++i) {
+    keys.push_back(fid * kStride + i);
+  }
+  return keys;
+}
+
+template <typename OID_T>
+std::shared_ptr<ArrowVertexMap<OID_T, vid_t>> BuildVertexMap(
+    Client& client, int64_t num, int concurrency) {
+  std::vector<std::vector<std::shared_ptr<ArrowArrayType<OID_T>>>> oid_arrays(
+      1);
+  for (fid_t fid = 0; fid < kFnum; ++fid) {
+    oid_arrays[0].push_back(MakeOids<OID_T>(Range(fid, 0, num)));
+  }
+  BasicArrowVertexMapBuilder<OID_T, vid_t> builder(client, kFnum, 1,
+                                                   std::move(oid_arrays));
+  builder.set_concurrency(concurrency);
+  std::shared_ptr<Object> object;
+  VINEYARD_CHECK_OK(builder.Seal(client, object));
+  return std::dynamic_pointer_cast<ArrowVertexMap<OID_T, vid_t>>(object);
+}
+
+// The indices are built in the default layout.
+template <typename OID_T>
+void CheckIndexType(const std::shared_ptr<ArrowVertexMap<OID_T, vid_t>>& vm) {
+  auto index_type = vm->meta().GetMemberMeta("o2g_0_0").GetTypeName();
+  if (DefaultVertexMapIndexType() == VertexMapIndexType::kSwissTable) {
+    CHECK_EQ(index_type, type_name<SwissHashmap<OID_T, vid_t>>());
+  } else {
+    CHECK_EQ(index_type, type_name<Hashmap<OID_T, vid_t>>());
+  }
+}
+
+template <typename OID_T>
+std::shared_ptr<ArrowVertexMap<OID_T, vid_t>> GetVertexMap(Client& client,
+                                                           ObjectID id) {
+  CHECK_NE(id, InvalidObjectID());
+  return std::dynamic_pointer_cast<ArrowVertexMap<OID_T, vid_t>>(
+      client.GetObject(id));
+}
+
+// Every key is found with the expected gid, if any, and maps back to itself.
+template <typename OID_T>
+void CheckKeys(const std::shared_ptr<ArrowVertexMap<OID_T, vid_t>>& vm,
+               label_id_t label, fid_t fid, const std::vector<int64_t>& keys,
+               std::map<int64_t, vid_t>& gids) {
+  for (int64_t i : keys) {
+    auto key = TestOid<OID_T>::Key(i);
+    vid_t gid;
+    CHECK(vm->GetGid(fid, label, OID_T(key), gid));
+    auto iter = gids.find(i);
+    if (iter != gids.end()) {
+      CHECK_EQ(iter->second, gid);
+    } else {
+      gids.emplace(i, gid);
+    }
+    OID_T oid;
+    CHECK(vm->GetOid(gid, oid));
+    CHECK(oid == OID_T(key));
+  }
+}
+
+bool HasOverflow(const ObjectMeta& meta, fid_t fid, label_id_t label) {
+  return meta.HasKey("overflow_oid_arrays_" + std::to_string(fid) + "_" +
+                     std::to_string(label));
+}
+
+template <typename OID_T>
+ObjectID AddVertices(
+    Client& client, const std::shared_ptr<ArrowVertexMap<OID_T, vid_t>>& vm,
+    label_id_t label, int64_t begin, int64_t end) {
+  std::map<label_id_t, std::vector<std::shared_ptr<ArrowArrayType<OID_T>>>>
+      arrays;
+  for (fid_t fid = 0; fid < kFnum; ++fid) {
+    arrays[label].push_back(MakeOids<OID_T>(Range(fid, begin, end)));
+  }
+  return vm->AddVertices(client, std::move(arrays));
+}
+
+// Vertices are added to the overflow, the gids are kept across compactions,
+// and the duplicated vertices are rejected.
+template <typename OID_T>
+void IncrementalTest(Client& client, const std::string& name) {
+  constexpr int64_t kBase = 1000;
+  auto vm = BuildVertexMap<OID_T>(client, kBase, 1);
+  CheckIndexType(vm);
+  std::vector<std::map<int64_t, vid_t>> gids(kFnum);
+  for (fid_t fid = 0; fid < kFnum; ++fid) {
+    CheckKeys(vm, 0, fid, Range(fid, 0, kBase), gids[fid]);
+  }
+
+  // [kBase, 1.1 * kBase) and [1.1 * kBase, 1.3 * kBase) stay in the
+  // overflow, [1.3 * kBase, 1.6 * kBase) exceeds the compaction ratio
+  std::vector<int64_t> steps = {kBase, kBase * 11 / 10, kBase * 13 / 10,
+                                kBase * 16 / 10};
+  for (size_t step = 1; step < steps.size(); ++step) {
+    vm = GetVertexMap<OID_T>(
+        client, AddVertices(client, vm, 0, steps[step - 1], steps[step]));
+    bool compacted = steps[step] - kBase > kCompactionRatio * kBase;
+    for (fid_t fid = 0; fid < kFnum; ++fid) {
+      CHECK_EQ(vm->GetInnerVertexSize(fid, 0),
+               static_cast<vid_t>(steps[step]));
+      CHECK_EQ(HasOverflow(vm->meta(), fid, 0), !compacted);
+      // both the base and the overflow are looked up
+      CheckKeys(vm, 0, fid, Range(fid, 0, steps[step]), gids[fid]);
+      CHECK_EQ(vm->GetOidArray(fid, 0)->length(), steps[step]);
+    }
+    CHECK_EQ(vm->GetTotalNodesNum(),
+             static_cast<size_t>(kFnum * steps[step]));
+  }
+
+  // the existing vertices, either in the base or the overflow, and the
+  // vertices added twice are rejected
+  auto overflowed = GetVertexMap<OID_T>(
+      client, AddVertices(client, vm, 0, steps.back(), steps.back() + 10));
+  CHECK(HasOverflow(overflowed->meta(), 0, 0));
+  CHECK_EQ(AddVertices(client, overflowed, 0, 0, 1), InvalidObjectID());
+  CHECK_EQ(AddVertices(client, overflowed, 0, steps.back() + 9,
+                       steps.back() + 20),
+           InvalidObjectID());
+  {
+    std::map<label_id_t, std::vector<std::shared_ptr<ArrowArrayType<OID_T>>>>
+        arrays;
+    for (fid_t fid = 0; fid < kFnum; ++fid) {
+      std::vector<int64_t> keys = Range(fid, kStride - 2, kStride - 1);
+      keys.push_back(keys.back());
+      arrays[0].push_back(MakeOids<OID_T>(keys));
+    }
+    CHECK_EQ(overflowed->AddVertices(client, std::move(arrays)),
+             InvalidObjectID());
+  }
+
+  // the existing labels are extended and new labels are added at once
+  {
+    std::map<label_id_t, std::vector<std::shared_ptr<ArrowArrayType<OID_T>>>>
+        arrays;
+    for (fid_t fid = 0; fid < kFnum; ++fid) {
+      arrays[0].push_back(MakeOids<OID_T>(
+          Range(fid, steps.back() + 10, steps.back() + 20)));
+      arrays[1].push_back(MakeOids<OID_T>(Range(fid, 0, 100)));
+    }
+    auto extended =
+        GetVertexMap<OID_T>(client, overflowed->AddVertices(client, arrays));
+    CHECK_EQ(extended->label_num(), 2);
+    for (fid_t fid = 0; fid < kFnum; ++fid) {
+      CheckKeys(extended, 0, fid, Range(fid, 0, steps.back() + 20),
+                gids[fid]);
+      std::map<int64_t, vid_t> label_gids;
+      CheckKeys(extended, 1, fid, Range(fid, 0, 100), label_gids);
+      CHECK_EQ(extended->GetInnerVertexSize(fid),
+               static_cast<vid_t>(steps.back() + 20 + 100));
+    }
+  }
+  LOG(INFO) << "Passed incremental vertex map test: " << name;
+}
+
+// The vertex map built with threads is the same as the sequential one.
+template <typename OID_T>
+void ParallelBuildTest(Client& client, const std::string& name) {
+  constexpr int64_t kNum = 100000;
+  auto sequential = BuildVertexMap<OID_T>(client, kNum, 1);
+  auto parallel = BuildVertexMap<OID_T>(
+      client, kNum,
+      std::max(2, static_cast<int>(std::thread::hardware_concurrency())));
+  for (fid_t fid = 0; fid < kFnum; ++fid) {
+    std::map<int64_t, vid_t> gids;
+    CheckKeys(sequential, 0, fid, Range(fid, 0, kNum), gids);
+    CheckKeys(parallel, 0, fid, Range(fid, 0, kNum), gids);
+    vid_t gid;
+    auto missing = TestOid<OID_T>::Key(fid * kStride + kNum);
+    CHECK(!parallel->GetGid(fid, 0, OID_T(missing), gid));
+  }
+  CHECK_EQ(parallel->GetTotalNodesNum(), sequential->GetTotalNodesNum());
+  LOG(INFO) << "Passed parallel vertex map build test: " << name;
+}
+
+// The indices of the oids are looked up in the local vertex map, and the
+// oids that are not in the fragment get the sentinel.
+template <typename OID_T>
+void LocalIndexTest(Client& client, grape::CommSpec& comm_spec,
+                    const std::string& name) {
+  using builder_t = ArrowLocalVertexMapBuilder<OID_T, vid_t>;
+  // spans several chunks of the bulk lookups
+  constexpr int64_t kNum = 200000;
+  const vid_t missing = builder_t::kMissingIndex;
+  const fid_t fid = comm_spec.fid();
+
+  builder_t builder(client, comm_spec.fnum(), fid, 1);
+  std::vector<std::shared_ptr<ArrowArrayType<OID_T>>> oid_arrays{
+      MakeOids<OID_T>(Range(fid, 0, kNum))};
+  VINEYARD_CHECK_OK(builder.AddLocalVertices(comm_spec, oid_arrays));
+
+  // the latter half is not in the fragment
+  std::vector<int64_t> keys = Range(fid, kNum / 2, kNum + kNum / 2);
+  std::vector<std::vector<vid_t>> index_list;
+  VINEYARD_CHECK_OK(
+      builder.GetIndexOfOids({MakeOids<OID_T>(keys)}, index_list));
+  CHECK_EQ(index_list.size(), 1u);
+  CHECK_EQ(index_list[0].size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    int64_t offset = keys[i] - fid * kStride;
+    if (offset < kNum) {
+      CHECK_EQ(index_list[0][i], static_cast<vid_t>(offset));
+    } else {
+      CHECK_EQ(index_list[0][i], missing);
+    }
+  }
+  LOG(INFO) << "Passed local vertex map index test: " << name;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage: ./arrow_vertex_map_test <ipc_socket> [index_type]\n");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  // read once by the vertex map
+  setenv("VINEYARD_VERTEX_MAP_COMPACTION_RATIO",
+         std::to_string(kCompactionRatio).c_str(), 1);
+  if (argc > 2) {
+    // the layout of the indices, e.g., "swiss"
+    setenv("VINEYARD_VERTEX_MAP_INDEX", argv[2], 1);
+  }
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  IncrementalTest<int64_t>(client, "int64 oids");
+  IncrementalTest<arrow_string_view>(client, "string oids");
+  ParallelBuildTest<int64_t>(client, "int64 oids");
+  ParallelBuildTest<arrow_string_view>(client, "string oids");
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+    LocalIndexTest<int64_t>(client, comm_spec, "int64 oids");
+    LocalIndexTest<arrow_string_view>(client, comm_spec, "string oids");
+  }
+  grape::FinalizeMPIComm();
+
+  client.Disconnect();
+
+  LOG(INFO) << "Passed arrow vertex map tests...";
+
+  return 0;
+}
@@ -0,0 +1,222 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "arrow/api.h"
+#include "grape/worker/comm_spec.h"
+
+#include "client/client.h"
+#include "common/util/logging.h"
+
+#include "graph/utils/table_pipeline.h"
+#include "graph/utils/table_shuffler.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using row_t = std::tuple<int64_t, double, std::string>;
+
+constexpr int kBatches = 4;
+constexpr int kRows = 1000;
+
+// The rows of the worker, whose ids are unique among all workers. The sizes
+// of strings vary to make messages of different sizes.
+std::shared_ptr<arrow::Table> MakeTable(const grape::CommSpec& comm_spec) {
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("value", arrow::float64()),
+                               arrow::field("name", arrow::large_utf8())});
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int b = 0; b < kBatches; ++b) {
+    arrow::Int64Builder id_builder;
+    arrow::DoubleBuilder value_builder;
+    arrow::LargeStringBuilder name_builder;
+    for (int r = 0; r < kRows; ++r) {
+      int64_t id =
+          (static_cast<int64_t>(comm_spec.worker_id()) * kBatches + b) * kRows +
+          r;
+      CHECK_ARROW_ERROR(id_builder.Append(id));
+      CHECK_ARROW_ERROR(value_builder.Append(id * 0.5));
+      CHECK_ARROW_ERROR(
+          name_builder.Append(std::string(id % 97, 'a' + id % 26)));
+    }
+    std::shared_ptr<arrow::Array> ids, values, names;
+    CHECK_ARROW_ERROR(id_builder.Finish(&ids));
+    CHECK_ARROW_ERROR(value_builder.Finish(&values));
+    CHECK_ARROW_ERROR(name_builder.Finish(&names));
+    batches.emplace_back(
+        arrow::RecordBatch::Make(schema, kRows, {ids, values, names}));
+  }
+  return arrow::Table::FromRecordBatches(schema, batches).ValueOrDie();
+}
+
+// partitions the rows by the id
+void GenOffset(const grape::CommSpec& comm_spec,
+               const std::shared_ptr<arrow::RecordBatch>& batch,
+               std::vector<std::vector<int64_t>>& offset_lists) {
+  offset_lists.resize(comm_spec.fnum());
+  for (auto& offsets : offset_lists) {
+    offsets.clear();
+  }
+  auto ids = std::dynamic_pointer_cast<arrow::Int64Array>(batch->column(0));
+  for (int64_t i = 0; i < ids->length(); ++i) {
+    offset_lists[ids->Value(i) % comm_spec.fnum()].push_back(i);
+  }
+}
+
+std::vector<row_t> CollectRows(
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches) {
+  std::vector<row_t> rows;
+  for (auto const& batch : batches) {
+    auto ids = std::dynamic_pointer_cast<arrow::Int64Array>(batch->column(0));
+    auto values =
+        std::dynamic_pointer_cast<arrow::DoubleArray>(batch->column(1));
+    auto names =
+        std::dynamic_pointer_cast<arrow::LargeStringArray>(batch->column(2));
+    for (int64_t i = 0; i < batch->num_rows(); ++i) {
+      rows.emplace_back(ids->Value(i), values->Value(i), names->GetString(i));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+// The memory usage of the vineyard instance once all workers get here.
+size_t MemoryUsage(const grape::CommSpec& comm_spec, Client& client) {
+  MPI_Barrier(comm_spec.comm());
+  std::shared_ptr<InstanceStatus> status;
+  VINEYARD_CHECK_OK(client.InstanceStatus(status));
+  MPI_Barrier(comm_spec.comm());
+  return status->memory_usage;
+}
+
+// The pipeline yields the same rows as the shuffle of the whole table.
+void CompareShuffles(const grape::CommSpec& comm_spec, Client* client,
+                     const std::string& name) {
+  size_t usage_before = client ? MemoryUsage(comm_spec, *client) : 0;
+  auto table = MakeTable(comm_spec);
+  auto genoffset = [&comm_spec](
+                       const std::shared_ptr<arrow::RecordBatch> batch,
+                       std::vector<std::vector<int64_t>>& offset_lists) {
+    GenOffset(comm_spec, batch, offset_lists);
+  };
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches, expected;
+  VINEYARD_CHECK_OK(TableToRecordBatches(table, &batches));
+  std::vector<std::vector<std::vector<int64_t>>> offset_lists(batches.size());
+  for (size_t i = 0; i < batches.size(); ++i) {
+    GenOffset(comm_spec, batches[i], offset_lists[i]);
+  }
+  ShuffleTableByOffsetLists(comm_spec, table->schema(), batches, offset_lists,
+                            expected);
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> actual;
+  VINEYARD_CHECK_OK(ShuffleTableByOffsetLists(
+      comm_spec, table->schema(), std::make_shared<TablePipeline>(table),
+      genoffset, actual, client));
+
+  auto expected_rows = CollectRows(expected);
+  auto actual_rows = CollectRows(actual);
+  CHECK_EQ(expected_rows.size(), actual_rows.size());
+  CHECK(expected_rows == actual_rows);
+  for (auto const& row : actual_rows) {
+    CHECK_EQ(std::get<0>(row) % comm_spec.fnum(), comm_spec.fid());
+  }
+
+  int64_t local_rows = actual_rows.size(), total_rows = 0;
+  MPI_Allreduce(&local_rows, &total_rows, 1, MPI_INT64_T, MPI_SUM,
+                comm_spec.comm());
+  CHECK_EQ(total_rows, static_cast<int64_t>(comm_spec.worker_num()) *
+                           kBatches * kRows);
+
+  if (client != nullptr) {
+    // the batches from the co-located workers are mapped from vineyard, and
+    // deleted once released
+    size_t usage = MemoryUsage(comm_spec, *client);
+    if (comm_spec.worker_num() > 1) {
+      CHECK_GT(usage, usage_before);
+    }
+    expected.clear();
+    actual.clear();
+    CHECK_EQ(MemoryUsage(comm_spec, *client), usage_before);
+  }
+  LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] Passed " << name
+            << ": rows = " << local_rows;
+}
+
+// Destructing the pipeline before it is drained discards the shuffled
+// batches, and the sealed ones are deleted from vineyard.
+void CancelShuffle(const grape::CommSpec& comm_spec, Client& client) {
+  size_t usage_before = MemoryUsage(comm_spec, client);
+  auto table = MakeTable(comm_spec);
+  auto genoffset = [&comm_spec](
+                       const std::shared_ptr<arrow::RecordBatch> batch,
+                       std::vector<std::vector<int64_t>>& offset_lists) {
+    GenOffset(comm_spec, batch, offset_lists);
+  };
+  {
+    ShuffleTablePipeline pipeline(comm_spec,
+                                  std::make_shared<TablePipeline>(table),
+                                  genoffset, table->schema(), &client, 1);
+    std::shared_ptr<arrow::RecordBatch> batch;
+    VINEYARD_CHECK_OK(pipeline.Next(batch));
+    CHECK_GT(batch->num_rows(), 0);
+  }
+  CHECK_EQ(MemoryUsage(comm_spec, client), usage_before);
+  LOG(INFO) << "[worker-" << comm_spec.worker_id()
+            << "] Passed cancelled shuffle";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage: ./table_shuffler_test <ipc_socket>\n");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    CompareShuffles(comm_spec, nullptr, "serialized shuffle");
+
+    // the messages are sent in many small pieces
+    setenv("VINEYARD_SHUFFLE_MAX_MESSAGE_SIZE", "1000", 1);
+    CompareShuffles(comm_spec, nullptr, "serialized shuffle in pieces");
+    unsetenv("VINEYARD_SHUFFLE_MAX_MESSAGE_SIZE");
+
+    // the workers share the vineyard instance
+    CompareShuffles(comm_spec, &client, "co-located shuffle");
+    CancelShuffle(comm_spec, client);
+  }
+  grape::FinalizeMPIComm();
+
+  client.Disconnect();
+
+  LOG(INFO) << "Passed table shuffler test...";
+
+  return 0;
+}
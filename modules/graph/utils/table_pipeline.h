@@ -283,8 +283,6 @@ class TablePipelineSink {
   bool combine_chunks_;
 };
 
-class ShuffleTablePipeline {};
-
 }  // namespace vineyard
 
 #endif  // MODULES_GRAPH_UTILS_TABLE_PIPELINE_H_
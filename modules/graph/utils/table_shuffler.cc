@@ -18,7 +18,12 @@ limitations under the License.
 #include <mpi.h>
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <future>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,9 +37,14 @@ limitations under the License.
 #include "grape/utils/concurrent_queue.h"
 #include "grape/worker/comm_spec.h"
 
+#include "basic/ds/arrow.h"
+#include "basic/ds/arrow_shim/memory_pool.h"
 #include "basic/ds/arrow_utils.h"
+#include "client/client.h"
+#include "common/util/env.h"
 #include "common/util/functions.h"
 #include "common/util/status.h"
+#include "common/util/uuid.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/error.h"
 #include "graph/utils/thread_group.h"
@@ -299,6 +309,68 @@ static inline void select_list_items(std::shared_ptr<arrow::Array> array,
   }
 }
 
+/**
+ * @brief Deletes the shuffled object from vineyard when the last buffer of
+ * the mapped batch has been released. The deletion is not forced, thus the
+ * blobs that have been adopted by other objects (e.g., the fragment) are
+ * kept.
+ *
+ * The guard shares the ownership of the client, which the batch is mapped
+ * from, thus the mapped buffers stay valid as long as the guard is alive.
+ */
+class SharedObjectGuard {
+ public:
+  SharedObjectGuard(const std::shared_ptr<Client>& client, const ObjectID id)
+      : client_(client), id_(id) {}
+
+  ~SharedObjectGuard() {
+    VINEYARD_DISCARD(client_->DelData(id_, false, true));
+  }
+
+ private:
+  std::shared_ptr<Client> client_;
+  ObjectID id_;
+};
+
+class GuardedBuffer : public arrow::Buffer {
+ public:
+  GuardedBuffer(const std::shared_ptr<arrow::Buffer>& buffer,
+                const std::shared_ptr<SharedObjectGuard>& guard)
+      : arrow::Buffer(buffer->data(), buffer->size()),
+        buffer_(buffer),
+        guard_(guard) {}
+
+ private:
+  std::shared_ptr<arrow::Buffer> buffer_;
+  std::shared_ptr<SharedObjectGuard> guard_;
+};
+
+static std::shared_ptr<arrow::ArrayData> guard_array_data(
+    const std::shared_ptr<arrow::ArrayData>& data,
+    const std::shared_ptr<SharedObjectGuard>& guard) {
+  auto guarded = data->Copy();
+  for (auto& buffer : guarded->buffers) {
+    if (buffer != nullptr) {
+      buffer = std::make_shared<GuardedBuffer>(buffer, guard);
+    }
+  }
+  for (auto& child : guarded->child_data) {
+    child = guard_array_data(child, guard);
+  }
+  if (guarded->dictionary != nullptr) {
+    guarded->dictionary = guard_array_data(guarded->dictionary, guard);
+  }
+  return guarded;
+}
+
+static Status mpi_error(int code, const char* what) {
+  char message[MPI_MAX_ERROR_STRING];
+  int length = 0;
+  MPI_Error_string(code, message, &length);
+  return Status::IOError(std::string(what) +
+                         " failed: " + std::string(message, length));
+}
+
 }  // namespace detail
 
 TableAppender::TableAppender(std::shared_ptr<arrow::Schema> schema) {
@@ -677,12 +749,12 @@ void SelectItems(std::shared_ptr<arrow::Array> array,
 
 void SelectRows(std::shared_ptr<arrow::RecordBatch> record_batch_in,
                 const std::vector<int64_t>& offset,
-                std::shared_ptr<arrow::RecordBatch>& record_batch_out) {
+                std::shared_ptr<arrow::RecordBatch>& record_batch_out,
+                arrow::MemoryPool* pool) {
   int64_t row_num = offset.size();
   std::unique_ptr<arrow::RecordBatchBuilder> builder;
   ARROW_CHECK_OK(arrow::RecordBatchBuilder::Make(record_batch_in->schema(),
-                                                 arrow::default_memory_pool(),
-                                                 row_num, &builder));
+                                                 pool, row_num, &builder));
   int col_num = builder->num_fields();
   for (int col_id = 0; col_id != col_num; ++col_id) {
     SelectItems(record_batch_in->column(col_id), offset,
@@ -799,132 +871,527 @@ void ShuffleTableByOffsetLists(
   MPI_Barrier(comm_spec.comm());
 }
 
-void ShuffleTableByOffsetLists(
+Status ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
     const std::shared_ptr<arrow::Schema> schema,
     const std::shared_ptr<ITablePipeline>& record_batches_send,
     std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
                        std::vector<std::vector<int64_t>>& offset_list)>
         genoffset,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
-  int worker_id = comm_spec.worker_id();
-  int worker_num = comm_spec.worker_num();
-  size_t record_batches_out_num = record_batches_send->num_batches();
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client) {
+  Status status;
+  record_batches_recv.clear();
+  {
+    auto pipeline = std::make_shared<ShuffleTablePipeline>(
+        comm_spec, record_batches_send, genoffset, schema, client);
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      status = pipeline->Next(batch);
+      if (!status.ok()) {
+        break;
+      }
+      record_batches_recv.emplace_back(std::move(batch));
+    }
+    // the pipeline is cancelled and drained when being destructed, thus the
+    // peers won't be blocked if failed
+  }
+  if (status.IsStreamDrained()) {
+    status = Status::OK();
+  }
+  VLOG(100) << "[worker-" << comm_spec.worker_id()
+            << "] ShuffleTableByOffsetLists: batches received = "
+            << record_batches_recv.size();
+  MPI_Barrier(comm_spec.comm());
+  return status;
+}
+
+ShuffleTablePipeline::ShuffleTablePipeline(
+    const grape::CommSpec& comm_spec,
+    const std::shared_ptr<ITablePipeline>& from, offset_fn_t genoffset,
+    const std::shared_ptr<arrow::Schema> schema, Client* client,
+    size_t window)
+    : from_(from),
+      genoffset_(genoffset),
+      fid_(comm_spec.fid()),
+      fnum_(comm_spec.fnum()),
+      worker_id_(comm_spec.worker_id()),
+      worker_num_(comm_spec.worker_num()),
+      failed_(false),
+      cancelled_(false) {
+  if (schema == nullptr) {
+    schema_ = from->schema();
+  } else {
+    schema_ = schema;
+  }
+  // the number of rows and batches is unknown until the shuffle finishes
+  length_ = -1;
+  num_batches_ = -1;
+
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    frag_to_worker_.push_back(comm_spec.FragToWorker(fid));
+  }
+  // isolates the messages of the shuffle from other traffic, and reports
+  // the errors of communication as the status of the pipeline
+  MPI_Comm_dup(comm_spec.comm(), &comm_);
+  MPI_Comm_set_errhandler(comm_, MPI_ERRORS_RETURN);
+
+  // the messages are sent in pieces of at most INT_MAX bytes, as the count
+  // of MPI is an int
+  max_message_size_ = static_cast<size_t>(INT_MAX);
+  std::string max_message_size =
+      read_env("VINEYARD_SHUFFLE_MAX_MESSAGE_SIZE");
+  if (!max_message_size.empty()) {
+    max_message_size_ = std::min(
+        std::max<size_t>(std::strtoull(max_message_size.c_str(), nullptr, 10),
+                         1),
+        static_cast<size_t>(INT_MAX));
+  }
+
+  // find the workers that share the vineyard instance with the current one
+  if (client != nullptr && client->Connected()) {
+    client_ = std::make_shared<Client>();
+    auto status = client->Fork(*client_);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to connect to vineyard, fallback to the "
+                      "serialization: "
+                   << status.ToString();
+      client_ = nullptr;
+    }
+  }
+  InstanceID instance_id = client_ == nullptr ? UnspecifiedInstanceID()
+                                              : client_->instance_id();
+  std::vector<InstanceID> instance_ids(worker_num_);
+  MPI_Allgather(&instance_id, 1, MPI_UINT64_T, instance_ids.data(), 1,
+                MPI_UINT64_T, comm_);
+  colocated_.resize(worker_num_, false);
+  for (int i = 0; i < worker_num_; ++i) {
+    colocated_[i] = i != worker_id_ && instance_id != UnspecifiedInstanceID() &&
+                    instance_ids[i] == instance_id;
+  }
 
   int thread_num =
       (std::thread::hardware_concurrency() + comm_spec.local_num() - 1) /
       comm_spec.local_num();
-  // after pipelining, the serialize thread would be responsible for trigger
-  // the execution of whole pipeline, including things like generate eid,
-  // resolve oid -> gid mapping, etc., and become more computation intensive.
-  int deserialize_thread_num = std::max(1, (thread_num - 2) / 6);
-  int serialize_thread_num =
-      std::max(1, thread_num - 2 - deserialize_thread_num);
-  std::vector<std::thread> serialize_threads(serialize_thread_num);
-  std::vector<std::thread> deserialize_threads(deserialize_thread_num);
+  // the partition threads drive the upstream pipeline, which is usually more
+  // computation intensive than the deserialization.
+  deserialize_thread_num_ = std::max(1, (thread_num - 2) / 6);
+  partition_thread_num_ = std::max(1, thread_num - 2 - deserialize_thread_num_);
+  active_partitioners_ = partition_thread_num_;
+
+  window = std::max(window, static_cast<size_t>(1));
+  size_t peers = static_cast<size_t>(std::max(worker_num_ - 1, 1));
+  send_limit_ = window * peers;
+  recv_limit_ = window * peers;
+  received_.SetProducerNum(1);
+  received_.SetLimit(recv_limit_);
+  output_.SetProducerNum(partition_thread_num_ + deserialize_thread_num_);
+  output_.SetLimit(window *
+                   (partition_thread_num_ + deserialize_thread_num_));
+}
 
-  grape::BlockingQueue<std::pair<grape::fid_t, grape::InArchive>> msg_out;
-  grape::BlockingQueue<grape::OutArchive> msg_in;
+ShuffleTablePipeline::~ShuffleTablePipeline() {
+  // stop pulling from the upstream pipeline and discard the batches that
+  // haven't been consumed. The end of stream is still exchanged with the
+  // peers (the threads are started if not yet), so they won't be blocked.
+  cancelled_.store(true);
+  send_cv_.notify_all();
+  std::call_once(started_, &ShuffleTablePipeline::start, this);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (output_.Get(batch)) {
+    batch = nullptr;
+  }
+  for (auto& thrd : threads_) {
+    if (thrd.joinable()) {
+      thrd.join();
+    }
+  }
+  MPI_Comm_free(&comm_);
+}
 
-  msg_out.SetProducerNum(serialize_thread_num);
-  msg_in.SetProducerNum(1);
+Status ShuffleTablePipeline::Next(std::shared_ptr<arrow::RecordBatch>& batch) {
+  std::call_once(started_, &ShuffleTablePipeline::start, this);
+  if (output_.Get(batch)) {
+    return Status::OK();
+  }
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  RETURN_ON_ERROR(status_);
+  return Status::StreamDrained();
+}
 
-  int64_t record_batches_to_send = static_cast<int64_t>(record_batches_out_num);
-  int64_t total_record_batches;
-  MPI_Allreduce(&record_batches_to_send, &total_record_batches, 1, MPI_INT64_T,
-                MPI_SUM, comm_spec.comm());
-  int64_t record_batches_to_recv =
-      total_record_batches - record_batches_to_send;
+void ShuffleTablePipeline::start() {
+  VLOG(100) << "[worker-" << worker_id_
+            << "] ShuffleTablePipeline: partition thread: "
+            << partition_thread_num_
+            << ", deserialization thread: " << deserialize_thread_num_
+            << ", send window: " << send_limit_ << ", co-located workers: "
+            << std::count(colocated_.begin(), colocated_.end(), true);
+  threads_.emplace_back(&ShuffleTablePipeline::communicate, this);
+  for (int i = 0; i < partition_thread_num_; ++i) {
+    threads_.emplace_back(&ShuffleTablePipeline::partition, this);
+  }
+  for (int i = 0; i < deserialize_thread_num_; ++i) {
+    threads_.emplace_back(&ShuffleTablePipeline::deserialize, this);
+  }
+}
 
-  // preserve spaces for recv and self-recv
-  record_batches_recv.resize(total_record_batches);
-  VLOG(100) << "[worker-" << comm_spec.worker_id()
-            << "] ShuffleTableByOffsetLists: batches: total = "
-            << total_record_batches << ", to send = " << record_batches_to_send
-            << ", to recv = " << record_batches_to_recv
-            << ", serialization thread: " << serialize_thread_num
-            << ", deserialization thread: " << deserialize_thread_num;
+void ShuffleTablePipeline::partition() {
+  std::vector<std::vector<int64_t>> offset_lists(fnum_);
+  bool cancelled = false;
+  while (!cancelled && !failed_.load() && !cancelled_.load()) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    auto status = from_->Next(batch);
+    if (status.IsStreamDrained()) {
+      break;
+    }
+    if (!status.ok()) {
+      LOG(ERROR) << "Failed to fetch a batch from the table pipeline: "
+                 << status.ToString();
+      fail(status);
+      break;
+    }
+    // generate offset lists
+    genoffset_(batch, offset_lists);
+
+    // send to other workers, starting from different peers on each worker
+    for (fid_t i = 1; i < fnum_; ++i) {
+      fid_t dst_fid = (fid_ + i) % fnum_;
+      if (offset_lists[dst_fid].empty()) {
+        continue;
+      }
+      std::unique_ptr<message_t> message(new message_t());
+      message->peer = frag_to_worker_[dst_fid];
+      serialize(*message, dst_fid, batch, offset_lists[dst_fid]);
+      {
+        std::unique_lock<std::mutex> lock(send_mutex_);
+        send_cv_.wait(lock, [this]() {
+          return pending_.size() + outstanding_ < send_limit_ ||
+                 cancelled_.load() || failed_.load();
+        });
+        if (cancelled_.load() || failed_.load()) {
+          discard(*message);
+          cancelled = true;
+          break;
+        }
+        pending_.emplace_back(std::move(message));
+      }
+      send_cv_.notify_all();
+    }
+    if (cancelled) {
+      break;
+    }
 
-  std::thread send_thread([&]() {
-    std::pair<grape::fid_t, grape::InArchive> item;
-    while (msg_out.Get(item)) {
-      int dst_worker_id = comm_spec.FragToWorker(item.first);
-      auto& arc = item.second;
-      grape::sync_comm::Send(arc, dst_worker_id, 0, comm_spec.comm());
+    // select to self
+    if (!offset_lists[fid_].empty()) {
+      std::shared_ptr<arrow::RecordBatch> selected;
+      SelectRows(batch, offset_lists[fid_], selected);
+      output_.Put(std::move(selected));
     }
-  });
+  }
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    active_partitioners_ -= 1;
+  }
+  send_cv_.notify_all();
+  output_.DecProducerNum();
+}
 
-  std::thread recv_thread([&]() {
-    int64_t remaining_msg_num = record_batches_to_recv;
-    while (remaining_msg_num != 0) {
-      MPI_Status status;
-      MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_spec.comm(), &status);
-      grape::OutArchive arc;
-      grape::sync_comm::Recv(arc, status.MPI_SOURCE, 0, comm_spec.comm());
-      msg_in.Put(std::move(arc));
-      --remaining_msg_num;
+void ShuffleTablePipeline::communicate() {
+  // An empty message marks the end of the stream. The messages larger than
+  // `max_message_size_` are sent in pieces, where all but the last piece are
+  // tagged as `kPartTag`. Both the end of stream and the pieces arrive in
+  // order as MPI messages between a pair of workers are non-overtaking.
+  static constexpr int kTag = 0;
+  static constexpr int kPartTag = 1;
+  Status status = Status::OK();
+  auto check = [&](int code, const char* what) -> bool {
+    if (code != MPI_SUCCESS && status.ok()) {
+      status = detail::mpi_error(code, what);
     }
-    msg_in.DecProducerNum();
-  });
+    return code == MPI_SUCCESS;
+  };
 
-  // self: starts from `record_batches_to_recv`.
-  std::atomic<int64_t> cur_self_batch_in(record_batches_to_recv);
-  for (int i = 0; i != serialize_thread_num; ++i) {
-    serialize_threads[i] = std::thread([&]() {
-      std::vector<std::vector<int64_t>> offset_lists(comm_spec.fnum());
-      while (true) {
-        std::shared_ptr<arrow::RecordBatch> batch;
-        auto status = record_batches_send->Next(batch);
-        if (status.IsStreamDrained()) {
-          break;
-        }
-        if (!status.ok()) {
-          LOG(ERROR) << "Failed to fetch a batch from the table pipeline: "
-                     << status.ToString();
-          break;
-        }
-        // generate offset lists
-        genoffset(batch, offset_lists);
+  // the requests of the inflight sends, and the messages they belong to
+  std::vector<MPI_Request> requests;
+  std::vector<message_t*> owners;
+  std::vector<std::unique_ptr<message_t>> inflight;
+  std::vector<int> indices;
+  std::map<int, std::vector<char>> partials;
+  int eos_to_recv = worker_num_ - 1;
+  bool eos_sent = false;
+
+  auto post = [&](std::unique_ptr<message_t> message) {
+    const char* buffer = message->arc.GetBuffer();
+    size_t size = message->arc.GetSize();
+    do {
+      size_t piece = std::min(size, max_message_size_);
+      int tag = piece < size ? kPartTag : kTag;
+      MPI_Request request;
+      if (!check(MPI_Isend(buffer, static_cast<int>(piece), MPI_CHAR,
+                           message->peer, tag, comm_, &request),
+                 "MPI_Isend")) {
+        break;
+      }
+      requests.push_back(request);
+      owners.push_back(message.get());
+      message->remaining += 1;
+      buffer += piece;
+      size -= piece;
+    } while (size > 0);
+    inflight.emplace_back(std::move(message));
+  };
 
-        // send to other workers
-        for (int i = 1; i != worker_num; ++i) {
-          int dst_worker_id = (worker_id + i) % worker_num;
-          grape::fid_t dst_fid = comm_spec.WorkerToFrag(dst_worker_id);
-          std::pair<grape::fid_t, grape::InArchive> item;
-          item.first = dst_fid;
-          SerializeSelectedRows(item.second, batch, offset_lists[dst_fid]);
-          msg_out.Put(std::move(item));
-        }
+  // reaps the completed sends to release the window
+  auto reap = [&](bool blocking) -> bool {
+    if (requests.empty()) {
+      return false;
+    }
+    int count = 0;
+    indices.resize(requests.size());
+    int code = blocking
+                   ? MPI_Waitsome(static_cast<int>(requests.size()),
+                                  requests.data(), &count, indices.data(),
+                                  MPI_STATUSES_IGNORE)
+                   : MPI_Testsome(static_cast<int>(requests.size()),
+                                  requests.data(), &count, indices.data(),
+                                  MPI_STATUSES_IGNORE);
+    if (!check(code, blocking ? "MPI_Waitsome" : "MPI_Testsome") ||
+        count <= 0) {
+      return false;
+    }
+    size_t completed = 0;
+    for (int i = 0; i < count; ++i) {
+      message_t* owner = owners[indices[i]];
+      owners[indices[i]] = nullptr;
+      owner->remaining -= 1;
+      if (owner->remaining == 0 && owner->arc.GetSize() != 0) {
+        completed += 1;
+      }
+    }
+    size_t k = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+      if (owners[i] != nullptr) {
+        requests[k] = requests[i];
+        owners[k] = owners[i];
+        k += 1;
+      }
+    }
+    requests.resize(k);
+    owners.resize(k);
+    inflight.erase(std::remove_if(inflight.begin(), inflight.end(),
+                                  [](const std::unique_ptr<message_t>& m) {
+                                    return m->remaining == 0;
+                                  }),
+                   inflight.end());
+    if (completed != 0) {
+      {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        outstanding_ -= completed;
+      }
+      send_cv_.notify_all();
+    }
+    return true;
+  };
 
-        // select to self and put to recv
-        int64_t got_batch = cur_self_batch_in.fetch_add(1);
-        SelectRows(batch, offset_lists[comm_spec.fid()],
-                   record_batches_recv[got_batch]);
+  // receives the probed message, or a piece of it
+  auto receive = [&](const MPI_Status& probed) {
+    int source = probed.MPI_SOURCE, count = 0;
+    MPI_Get_count(&probed, MPI_CHAR, &count);
+    auto& partial = partials[source];
+    if (probed.MPI_TAG == kPartTag) {
+      size_t offset = partial.size();
+      partial.resize(offset + count);
+      check(MPI_Recv(partial.data() + offset, count, MPI_CHAR, source,
+                     kPartTag, comm_, MPI_STATUS_IGNORE),
+            "MPI_Recv");
+      return;
+    }
+    if (count == 0 && partial.empty()) {
+      check(MPI_Recv(nullptr, 0, MPI_CHAR, source, kTag, comm_,
+                     MPI_STATUS_IGNORE),
+            "MPI_Recv");
+      eos_to_recv -= 1;
+      return;
+    }
+    grape::OutArchive arc;
+    arc.Allocate(partial.size() + count);
+    if (!partial.empty()) {
+      memcpy(arc.GetBuffer(), partial.data(), partial.size());
+    }
+    if (check(MPI_Recv(arc.GetBuffer() + partial.size(), count, MPI_CHAR,
+                       source, kTag, comm_, MPI_STATUS_IGNORE),
+              "MPI_Recv")) {
+      received_.Put(std::move(arc));
+    }
+    std::vector<char>().swap(partial);
+  };
+
+  while (status.ok()) {
+    bool progress = false;
+
+    // post the pending sends
+    std::deque<std::unique_ptr<message_t>> posting;
+    bool drained = false;
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      posting.swap(pending_);
+      outstanding_ += posting.size();
+      drained = active_partitioners_ == 0;
+    }
+    for (auto& message : posting) {
+      post(std::move(message));
+      progress = true;
+    }
+    if (drained && !eos_sent) {
+      for (int i = 1; i < worker_num_; ++i) {
+        std::unique_ptr<message_t> message(new message_t());
+        message->peer = (worker_id_ + i) % worker_num_;
+        post(std::move(message));
       }
-      msg_out.DecProducerNum();
-    });
-  }
+      eos_sent = true;
+      progress = true;
+    }
 
-  std::atomic<int64_t> cur_batch_in(0);
-  for (int i = 0; i != deserialize_thread_num; ++i) {
-    deserialize_threads[i] = std::thread([&]() {
-      grape::OutArchive arc;
-      while (msg_in.Get(arc)) {
-        int64_t got_batch = cur_batch_in.fetch_add(1);
-        DeserializeSelectedRows(arc, schema, record_batches_recv[got_batch]);
+    progress = reap(false) || progress;
+
+    // receive as long as the deserializers keep up
+    bool receiving = eos_to_recv > 0 && received_.Size() < recv_limit_;
+    while (status.ok() && eos_to_recv > 0 &&
+           received_.Size() < recv_limit_) {
+      int flag = 0;
+      MPI_Status probed;
+      if (!check(MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &flag,
+                            &probed),
+                 "MPI_Iprobe") ||
+          !flag) {
+        break;
       }
-    });
+      receive(probed);
+      progress = true;
+    }
+
+    if (eos_sent && inflight.empty() && eos_to_recv == 0) {
+      break;
+    }
+    if (progress || !status.ok()) {
+      continue;
+    }
+    // block until something can make progress: when only one direction is
+    // left, wait for it in MPI, otherwise wait for new messages to send for
+    // a while before testing the requests and probing again
+    if (eos_sent && eos_to_recv == 0) {
+      // nothing is left to receive, and the peers keep receiving until the
+      // end of stream of the current worker arrives, thus the sends complete
+      reap(true);
+    } else if (eos_sent && receiving && requests.empty()) {
+      MPI_Status probed;
+      if (check(MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &probed),
+                "MPI_Probe")) {
+        receive(probed);
+      }
+    } else {
+      // blocking on either direction may deadlock with the peers
+      std::unique_lock<std::mutex> lock(send_mutex_);
+      send_cv_.wait_for(lock, std::chrono::microseconds(100), [&]() {
+        return !pending_.empty() || (!eos_sent && active_partitioners_ == 0);
+      });
+    }
+  }
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to shuffle the table: " << status.ToString();
+    fail(status);
+    // the partitioners won't enqueue anymore once failed, and the messages
+    // that haven't been sent completely are abandoned
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      for (auto& message : pending_) {
+        discard(*message);
+      }
+      pending_.clear();
+    }
+    for (auto& message : inflight) {
+      discard(*message);
+    }
+    send_cv_.notify_all();
   }
+  received_.DecProducerNum();
+}
 
-  send_thread.join();
-  recv_thread.join();
-  for (auto& thrd : serialize_threads) {
-    thrd.join();
+void ShuffleTablePipeline::serialize(
+    message_t& message, fid_t dst_fid,
+    const std::shared_ptr<arrow::RecordBatch>& batch,
+    const std::vector<int64_t>& offsets) {
+  grape::InArchive& arc = message.arc;
+  if (colocated_[frag_to_worker_[dst_fid]]) {
+    // the rows are selected into unsealed blobs, which are then sealed in
+    // place as the record batch, rather than copied again
+    memory::VineyardMemoryPool pool(*client_);
+    std::shared_ptr<arrow::RecordBatch> selected;
+    SelectRows(batch, offsets, selected, &pool);
+    std::shared_ptr<Object> object;
+    RecordBatchBuilder builder(*client_, selected);
+    auto status = builder.Seal(*client_, object);
+    if (status.ok()) {
+      // the receiver holds the reference from now on
+      VINEYARD_DISCARD(client_->Release(object->id()));
+      message.object = object->id();
+      arc << static_cast<uint8_t>(kSharedMemory) << object->id();
+      return;
+    }
+    LOG(WARNING) << "Failed to seal the shuffled batch to vineyard, fallback "
+                    "to the serialization: "
+                 << status.ToString();
   }
-  for (auto& thrd : deserialize_threads) {
-    thrd.join();
+  arc << static_cast<uint8_t>(kSerialized);
+  SerializeSelectedRows(arc, batch, offsets);
+}
+
+void ShuffleTablePipeline::deserialize() {
+  grape::OutArchive arc;
+  while (received_.Get(arc)) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    uint8_t kind = kSerialized;
+    arc >> kind;
+    if (kind == kSharedMemory) {
+      ObjectID id = InvalidObjectID();
+      arc >> id;
+      std::shared_ptr<RecordBatch> object;
+      auto status = client_->GetObject(id, object);
+      if (!status.ok() || object == nullptr) {
+        LOG(ERROR) << "Failed to map the shuffled batch "
+                   << ObjectIDToString(id) << ": " << status.ToString();
+        fail(status.ok() ? Status::ObjectNotExists(ObjectIDToString(id))
+                         : status);
+        continue;
+      }
+      auto guard = std::make_shared<detail::SharedObjectGuard>(client_, id);
+      auto mapped = object->GetRecordBatch();
+      std::vector<std::shared_ptr<arrow::ArrayData>> columns;
+      for (auto const& column : mapped->columns()) {
+        columns.emplace_back(detail::guard_array_data(column->data(), guard));
+      }
+      batch = arrow::RecordBatch::Make(schema_, mapped->num_rows(), columns);
+    } else {
+      DeserializeSelectedRows(arc, schema_, batch);
+    }
+    if (batch != nullptr && batch->num_rows() > 0) {
+      output_.Put(std::move(batch));
+    }
   }
-  MPI_Barrier(comm_spec.comm());
+  output_.DecProducerNum();
+}
+
+void ShuffleTablePipeline::discard(message_t& message) {
+  if (message.object != InvalidObjectID()) {
+    VINEYARD_DISCARD(client_->DelData(message.object, false, true));
+    message.object = InvalidObjectID();
+  }
+}
+
+void ShuffleTablePipeline::fail(const Status& status) {
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  status_ += status;
+  failed_.store(true);
 }
 
 }  // namespace vineyard
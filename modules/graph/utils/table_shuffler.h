@@ -18,9 +18,16 @@ limitations under the License.
 
 #include <mpi.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -28,7 +35,12 @@ limitations under the License.
 #include "arrow/io/api.h"
 #include "boost/leaf.hpp"
 
+#include "grape/serialization/in_archive.h"
+#include "grape/serialization/out_archive.h"
+#include "grape/utils/concurrent_queue.h"
+
 #include "common/util/status.h"
+#include "common/util/uuid.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/table_pipeline.h"
 
@@ -38,6 +50,8 @@ class CommSpec;
 
 namespace vineyard {
 
+class Client;
+
 template <typename T>
 struct AppendHelper {
   static Status append(arrow::ArrayBuilder* builder,
@@ -247,7 +261,8 @@ void SelectItems(const std::shared_ptr<arrow::Array> array,
 
 void SelectRows(const std::shared_ptr<arrow::RecordBatch> record_batch_in,
                 const std::vector<int64_t>& offset,
-                std::shared_ptr<arrow::RecordBatch>& record_batch_out);
+                std::shared_ptr<arrow::RecordBatch>& record_batch_out,
+                arrow::MemoryPool* pool = arrow::default_memory_pool());
 
 void ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
@@ -256,14 +271,139 @@ void ShuffleTableByOffsetLists(
     const std::vector<std::vector<std::vector<int64_t>>>& offset_lists,
     std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv);
 
-void ShuffleTableByOffsetLists(
+Status ShuffleTableByOffsetLists(
     const grape::CommSpec& comm_spec,
     const std::shared_ptr<arrow::Schema> schema,
     const std::shared_ptr<ITablePipeline>& record_batches_send,
     std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
                        std::vector<std::vector<int64_t>>& offset_list)>
         genoffset,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv);
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv,
+    Client* client = nullptr);
+
+/**
+ * @brief A table pipeline that shuffles the batches pulled from the upstream
+ * pipeline among workers, and yields the batches that belong to the current
+ * worker as soon as they are partitioned locally or received from others.
+ *
+ * Reading the upstream pipeline (e.g., the I/O), partitioning and the
+ * (de)serialization are done by a group of worker threads, and a single
+ * communication thread drives the non-blocking MPI sends and receives, thus
+ * the three stages overlap with each other. The messages being sent and the
+ * received messages waiting for deserialization are bounded by
+ * `window * (worker_num - 1)` in total respectively, and the yielded batches
+ * by `window` per worker thread, thus the memory footprint doesn't grow with
+ * the size of the table as long as the pipeline is consumed.
+ *
+ * The end of the stream is marked by an empty message to each peer, so the
+ * number of batches of the upstream pipeline needn't to be known in advance.
+ *
+ * When a connected `client` is given, the partitions for workers on the same
+ * vineyard instance are selected into vineyard blobs and sealed in place as
+ * `RecordBatch` objects, and only their object ids are sent, the receivers
+ * map the batches without copying. The received objects are deleted (except
+ * the blobs that have been adopted by other objects) once the yielded
+ * batches are released. The pipeline forks its own connection from the
+ * `client` for that, which is kept alive by the yielded batches, thus the
+ * `client` needn't outlive them. The objects that won't be received, e.g.,
+ * when the pipeline is cancelled or fails, are deleted by the sender.
+ * Workers on other instances keep the serialized path.
+ *
+ * N.B.: the constructor is collective as it duplicates the communicator.
+ * Destructing the pipeline before it is drained (i.e., before `Next()`
+ * returns `StreamDrained` or an error) cancels it: the upstream pipeline is
+ * not pulled anymore and the remaining batches are discarded, while the
+ * end of stream is still exchanged with the peers.
+ */
+class ShuffleTablePipeline : public ITablePipeline {
+ public:
+  using offset_fn_t =
+      std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
+                         std::vector<std::vector<int64_t>>& offset_list)>;
+
+  ShuffleTablePipeline(const grape::CommSpec& comm_spec,
+                       const std::shared_ptr<ITablePipeline>& from,
+                       offset_fn_t genoffset,
+                       const std::shared_ptr<arrow::Schema> schema = nullptr,
+                       Client* client = nullptr, size_t window = 8);
+
+  ~ShuffleTablePipeline();
+
+  Status Next(std::shared_ptr<arrow::RecordBatch>& batch) override;
+
+ private:
+  // the first byte of each non-empty message
+  enum message_kind_t : uint8_t {
+    kSerialized = 0,
+    kSharedMemory = 1,
+  };
+
+  struct message_t {
+    int peer;
+    grape::InArchive arc;
+    // the number of pieces that haven't been sent
+    size_t remaining = 0;
+    // the sealed batch referred by the message, see also `serialize()`
+    ObjectID object = InvalidObjectID();
+  };
+
+  void start();
+
+  void partition();
+
+  void communicate();
+
+  void deserialize();
+
+  void fail(const Status& status);
+
+  // seals the selected rows to the shared memory, or falls back to the
+  // serialization if failed
+  void serialize(message_t& message, fid_t dst_fid,
+                 const std::shared_ptr<arrow::RecordBatch>& batch,
+                 const std::vector<int64_t>& offsets);
+
+  // deletes the sealed batch of the message that won't be sent
+  void discard(message_t& message);
+
+  std::shared_ptr<ITablePipeline> from_;
+  offset_fn_t genoffset_;
+  // forked from the given client, shared with the mapped batches
+  std::shared_ptr<Client> client_;
+
+  fid_t fid_;
+  fid_t fnum_;
+  int worker_id_;
+  int worker_num_;
+  std::vector<int> frag_to_worker_;
+  // whether the worker is connected to the same vineyard instance
+  std::vector<bool> colocated_;
+  MPI_Comm comm_;
+  // the size limit of a single MPI message, see also communicate()
+  size_t max_message_size_;
+
+  int partition_thread_num_;
+  int deserialize_thread_num_;
+  std::vector<std::thread> threads_;
+  std::once_flag started_;
+
+  // the serialized messages to send, bounded by `send_limit_`
+  std::mutex send_mutex_;
+  std::condition_variable send_cv_;
+  std::deque<std::unique_ptr<message_t>> pending_;
+  size_t outstanding_ = 0;
+  size_t send_limit_;
+  int active_partitioners_;
+
+  grape::BlockingQueue<grape::OutArchive> received_;
+  size_t recv_limit_;
+  grape::BlockingQueue<std::shared_ptr<arrow::RecordBatch>> output_;
+
+  std::mutex status_mutex_;
+  Status status_;
+  std::atomic<bool> failed_;
+  std::atomic<bool> cancelled_;
+};
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>>
@@ -277,7 +417,8 @@ boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
@@ -289,7 +430,8 @@ template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
@@ -299,7 +441,8 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<ITablePipeline>& table_send);
+    const std::shared_ptr<ITablePipeline>& table_send,
+    Client* client = nullptr);
 
 }  // namespace vineyard
 
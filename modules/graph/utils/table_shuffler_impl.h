@@ -137,7 +137,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -176,8 +176,9 @@ ShufflePropertyEdgeTableByPartition(
   };
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
-  ShuffleTableByOffsetLists(comm_spec, table_send->schema(), table_send,
-                            offsetfn, batches_recv);
+  VY_OK_OR_RAISE(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
+                                           table_send, offsetfn, batches_recv,
+                                           client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -266,7 +267,7 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   using oid_t = typename PARTITIONER_T::oid_t;
   using internal_oid_t = typename InternalType<oid_t>::type;
   using oid_array_type = ArrowArrayType<oid_t>;
@@ -295,8 +296,9 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
   };
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
-  ShuffleTableByOffsetLists(comm_spec, table_send->schema(), table_send,
-                            offsetfn, batches_recv);
+  VY_OK_OR_RAISE(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
+                                           table_send, offsetfn, batches_recv,
+                                           client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -395,7 +397,7 @@ template <typename VID_TYPE>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
-    const std::shared_ptr<ITablePipeline>& table_send) {
+    const std::shared_ptr<ITablePipeline>& table_send, Client* client) {
   VY_OK_OR_RAISE(CheckSchemaConsistency(*table_send->schema(), comm_spec));
 
   using vid_array_t = ArrowArrayType<VID_TYPE>;
@@ -433,8 +435,9 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
   };
 
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
-  ShuffleTableByOffsetLists(comm_spec, table_send->schema(), table_send,
-                            offsetfn, batches_recv);
+  VY_OK_OR_RAISE(ShuffleTableByOffsetLists(comm_spec, table_send->schema(),
+                                           table_send, offsetfn, batches_recv,
+                                           client));
 
   batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
                                     [](std::shared_ptr<arrow::RecordBatch>& e) {
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -34,6 +35,7 @@ limitations under the License.
 #include "common/util/typename.h"
 
 #include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/vertex_map_index.h"
 
 namespace grape {
 class CommSpec;
@@ -122,7 +124,7 @@ class ArrowLocalVertexMap
   std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays_;
 
   // frag->label->oid
-  std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2i_;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> o2i_;
 
   // for non-string_view oid type
   std::vector<std::vector<vineyard::Hashmap<vid_t, oid_t>>> i2o_;
@@ -146,6 +148,9 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
                 "Expect arrow_string_view in local vertex map's OID_T");
 
  public:
+  // the index of the oids that are not found by `GetIndexOfOids()`
+  static constexpr vid_t kMissingIndex = std::numeric_limits<vid_t>::max();
+
   explicit ArrowLocalVertexMapBuilder(vineyard::Client& client)
       : client(client) {}
 
@@ -165,6 +170,20 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
       grape::CommSpec& comm_spec,
       std::vector<std::shared_ptr<arrow::ChunkedArray>> oid_arrays);
 
+  /**
+   * @brief Set the layout of the o2i indices that are built by this builder,
+   * defaults to `DefaultVertexMapIndexType()`.
+   */
+  void set_index_type(VertexMapIndexType index_type) {
+    index_type_ = index_type;
+  }
+
+  VertexMapIndexType index_type() const { return index_type_; }
+
+  /**
+   * @brief Looks up the indices of the oids of each label in this fragment,
+   * the oids that don't belong to this fragment get `kMissingIndex`.
+   */
   vineyard::Status GetIndexOfOids(
       const std::vector<std::shared_ptr<oid_array_t>>& oids,
       std::vector<std::vector<vid_t>>& index_list);
@@ -194,13 +213,15 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
 
   vineyard::IdParser<vid_t> id_parser_;
 
+  VertexMapIndexType index_type_ = DefaultVertexMapIndexType();
+
   std::vector<typename InternalType<oid_t>::vineyard_array_type>
       local_oid_arrays_;
   // when oid_t is not string_view, only current fragment's is non-empty
   std::vector<std::vector<typename InternalType<oid_t>::vineyard_array_type>>
       oid_arrays_;
 
-  std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2i_;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> o2i_;
 
   // for non-string_view oid type
   std::vector<std::vector<vineyard::Hashmap<vid_t, oid_t>>> i2o_;
@@ -32,12 +32,14 @@ limitations under the License.
 #include "basic/ds/hashmap.h"
 #include "client/client.h"
 #include "common/util/functions.h"
+#include "common/util/parallel.h"
 #include "common/util/typename.h"
 
 #include "graph/fragment/property_graph_types.h"
 #include "graph/fragment/property_graph_utils.h"
 #include "graph/utils/thread_group.h"
 #include "graph/vertex_map/arrow_local_vertex_map.h"
+#include "graph/vertex_map/vertex_map_index.h"
 
 namespace vineyard {
 
@@ -150,9 +152,9 @@ bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
 template <typename OID_T, typename VID_T>
 bool ArrowLocalVertexMap<OID_T, VID_T>::GetGid(fid_t fid, label_id_t label_id,
                                                oid_t oid, vid_t& gid) const {
-  auto iter = o2i_[fid][label_id].find(oid);
-  if (iter != o2i_[fid][label_id].end()) {
-    gid = id_parser_.GenerateId(fid, label_id, iter->second);
+  vid_t index;
+  if (o2i_[fid][label_id].find(oid, index)) {
+    gid = id_parser_.GenerateId(fid, label_id, index);
     return true;
   }
   return false;
@@ -266,6 +268,9 @@ ObjectID ArrowLocalVertexMap<OID_T, VID_T>::AddNewVertexLabels(
   return InvalidObjectID();
 }
 
+template <typename OID_T, typename VID_T>
+constexpr VID_T ArrowLocalVertexMapBuilder<OID_T, VID_T>::kMissingIndex;
+
 template <typename OID_T, typename VID_T>
 ArrowLocalVertexMapBuilder<OID_T, VID_T>::ArrowLocalVertexMapBuilder(
     vineyard::Client& client, fid_t fnum, fid_t fid, label_id_t label_num)
@@ -408,15 +413,14 @@ vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::addLocalVertices(
 
     // now use the array in vineyard memory
     auto array = oid_arrays_[fid_][label].GetArray();
-    vineyard::HashmapBuilder<oid_t, vid_t> builder(client);
     int64_t vnum = array->length();
-    builder.reserve(static_cast<size_t>(vnum));
-    for (int64_t i = 0; i < vnum; ++i) {
-      builder.emplace(array->GetView(i), i);
-    }
-    RETURN_ON_ERROR(builder.Seal(client, object));
-    o2i_[fid_][label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
+    RETURN_ON_ERROR(BuildVertexMapIndex(
+        client, index_type_, vnum, nullptr,
+        [&array](int64_t i, oid_t& oid, vid_t& index) {
+          oid = array->GetView(i);
+          index = static_cast<vid_t>(i);
+        },
+        o2i_[fid_][label]));
 
     vertices_num_[fid_][label] = vnum;
     return Status::OK();
@@ -451,19 +455,25 @@ vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::GetIndexOfOids(
     std::vector<std::vector<vid_t>>& index_list) {
   index_list.resize(label_num_);
 
+  const int64_t chunk = 64 * 1024;
   for (label_id_t label_id = 0; label_id < label_num_; ++label_id) {
     auto& o2i_map = o2i_[fid_][label_id];
     auto& current_oids = oids[label_id];
     auto& current_index_list = index_list[label_id];
-    current_index_list.resize(current_oids->length());
-
-    parallel_for(
-        static_cast<int64_t>(0), current_oids->length(),
-        [&](const size_t& i) {
-          current_index_list[i] =
-              o2i_map.find(current_oids->GetView(i))->second;
-        },
-        std::thread::hardware_concurrency());
+    const int64_t length = current_oids->length();
+    current_index_list.resize(length);
+
+    RETURN_ON_ERROR(parallel_for_status(
+        static_cast<size_t>((length + chunk - 1) / chunk),
+        std::thread::hardware_concurrency(), [&](size_t i) -> Status {
+          int64_t begin = static_cast<int64_t>(i) * chunk;
+          int64_t end = std::min(begin + chunk, length);
+          o2i_map.find_all(
+              begin, end,
+              [&current_oids](int64_t k) { return current_oids->GetView(k); },
+              current_index_list.data(), kMissingIndex);
+          return Status::OK();
+        }));
   }
   return vineyard::Status::OK();
 }
@@ -489,16 +499,22 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
 
     std::shared_ptr<oid_array_t>& current_oid_array = oids[cur_fid][cur_label];
 
-    vineyard::HashmapBuilder<oid_t, vid_t> o2i_builder(client);
+    auto& current_index_list = index_list[cur_fid][cur_label];
+    RETURN_ON_ERROR(BuildVertexMapIndex(
+        client, index_type_, current_oid_array->length(), nullptr,
+        [&current_oid_array, &current_index_list](int64_t i, oid_t& oid,
+                                                  vid_t& index) {
+          oid = current_oid_array->GetView(i);
+          index = current_index_list[i];
+        },
+        o2i_[cur_fid][cur_label]));
+
     vineyard::HashmapBuilder<vid_t, oid_t> i2o_builder(client);
     vineyard::HashmapBuilder<vid_t, vid_t> i2o_index_builder(client);
-    o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
     i2o_builder.reserve(static_cast<size_t>(current_oid_array->length()));
     for (int64_t i = 0; i < current_oid_array->length(); i++) {
-      auto oid = current_oid_array->GetView(i);
-      auto& index = index_list[cur_fid][cur_label][i];
-      o2i_builder.emplace(oid, index);
-      i2o_builder.emplace(index, oid);
+      i2o_builder.emplace(current_index_list[i],
+                          current_oid_array->GetView(i));
     }
 
     // release the reference
@@ -506,9 +522,6 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
     index_list[cur_fid][cur_label].clear();
     index_list[cur_fid][cur_label].shrink_to_fit();
 
-    RETURN_ON_ERROR(o2i_builder.Seal(client, object));
-    o2i_[cur_fid][cur_label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
     RETURN_ON_ERROR(i2o_builder.Seal(client, object));
     i2o_[cur_fid][cur_label] =
         *std::dynamic_pointer_cast<vineyard::Hashmap<vid_t, oid_t>>(object);
@@ -555,28 +568,29 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
     std::shared_ptr<oid_array_t> current_oid_array =
         oid_arrays_[cur_fid][cur_label].GetArray();
 
-    vineyard::HashmapBuilder<oid_t, vid_t> o2i_builder(client);
+    auto& current_index_list = index_list[cur_fid][cur_label];
+    // n.b.: the string keys point into the oid array in vineyard
+    RETURN_ON_ERROR(BuildVertexMapIndex(
+        client, index_type_, current_oid_array->length(),
+        oid_arrays_[cur_fid][cur_label].GetBuffer(),
+        [&current_oid_array, &current_index_list](int64_t i, oid_t& oid,
+                                                  vid_t& index) {
+          oid = current_oid_array->GetView(i);
+          index = current_index_list[i];
+        },
+        o2i_[cur_fid][cur_label]));
+
     vineyard::HashmapBuilder<vid_t, oid_t> i2o_builder(client);
     vineyard::HashmapBuilder<vid_t, vid_t> i2o_index_builder(client);
-    o2i_builder.reserve(static_cast<size_t>(current_oid_array->length()));
-    // n.b.
-    o2i_builder.AssociateDataBuffer(
-        oid_arrays_[cur_fid][cur_label].GetBuffer());
     i2o_index_builder.reserve(static_cast<size_t>(current_oid_array->length()));
     for (int64_t i = 0; i < current_oid_array->length(); i++) {
-      auto oid = current_oid_array->GetView(i);
-      auto& index = index_list[cur_fid][cur_label][i];
-      o2i_builder.emplace(oid, index);
-      i2o_index_builder.emplace(index, static_cast<size_t>(i));
+      i2o_index_builder.emplace(current_index_list[i], static_cast<size_t>(i));
     }
 
     // release the reference
     index_list[cur_fid][cur_label].clear();
     index_list[cur_fid][cur_label].shrink_to_fit();
 
-    RETURN_ON_ERROR(o2i_builder.Seal(client, object));
-    o2i_[cur_fid][cur_label] =
-        *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
     RETURN_ON_ERROR(i2o_builder.Seal(client, object));
     i2o_[cur_fid][cur_label] =
         *std::dynamic_pointer_cast<vineyard::Hashmap<vid_t, oid_t>>(object);
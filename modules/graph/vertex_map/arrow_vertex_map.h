@@ -19,7 +19,9 @@ limitations under the License.
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "basic/ds/arrow.h"
@@ -28,6 +30,7 @@ limitations under the License.
 #include "common/util/typename.h"
 
 #include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/vertex_map_index.h"
 
 namespace vineyard {
 
@@ -37,6 +40,16 @@ class ArrowVertexMapBuilder;
 template <typename OID_T, typename VID_T>
 class BasicArrowVertexMapBuilder;
 
+/**
+ * @brief The global vertex map of a property graph, shared by all of its
+ * fragments.
+ *
+ * For string oids it serves as the interned dictionary of the graph: each
+ * oid is stored once, in the oid array of its (fragment, label), and its
+ * gid is the 64-bit code of it. Loaders convert edges to gids before they
+ * are shuffled, the fragments only store gids, and the strings are only
+ * materialized by `GetOid()`.
+ */
 template <typename OID_T, typename VID_T>
 class ArrowVertexMap
     : public vineyard::Registered<ArrowVertexMap<OID_T, VID_T>> {
@@ -82,6 +95,20 @@ class ArrowVertexMap
 
   VID_T GetInnerVertexSize(fid_t fid, label_id_t label_id) const;
 
+  /**
+   * @brief Add vertices to both existing labels and new labels, the new
+   * labels are expected to be `label_num(), label_num() + 1, ...`.
+   *
+   * Vertices of existing labels are appended after the current ones, thus
+   * existing gids are kept. They are indexed by an overflow index per
+   * fragment and label, which is merged into the base index once it grows
+   * beyond `DefaultVertexMapCompactionRatio()` of the base.
+   *
+   * The vertices that already exist in the label (in either the base or the
+   * overflow), or are added more than once, are rejected, as the existing
+   * vertices cannot be assigned another gid. `InvalidObjectID()` is returned
+   * in that case, and nothing is sealed.
+   */
   ObjectID AddVertices(
       Client& client,
       std::map<label_id_t, std::vector<std::shared_ptr<oid_array_t>>>
@@ -102,19 +129,63 @@ class ArrowVertexMap
           oid_arrays);
 
  private:
-  ObjectID addNewVertexLabels(
+  ObjectID addVertices(
       Client& client,
+      std::map<label_id_t,
+               std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+          oid_arrays_map);
+
+  ObjectID addVertices(
+      Client& client,
+      std::map<label_id_t,
+               std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+          extended_arrays,
       std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
-          oid_arrays);
+          new_arrays);
+
+  // the vertices added to existing labels must be new to both the base and
+  // the overflow, and added only once
+  Status checkExtendedVertices(
+      const std::map<label_id_t,
+                     std::vector<std::vector<std::shared_ptr<oid_array_t>>>>&
+          oid_arrays) const;
+
+  Status addNewVertexLabels(
+      Client& client,
+      std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+          oid_arrays,
+      ObjectMeta& new_meta, size_t& nbytes);
+
+  Status extendVertexLabels(
+      Client& client,
+      std::map<label_id_t,
+               std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+          oid_arrays,
+      const ObjectMeta& old_meta, ObjectMeta& new_meta, size_t& nbytes);
+
+  size_t vertexNum(fid_t fid, label_id_t label_id) const;
 
   fid_t fnum_;
   label_id_t label_num_;
 
   vineyard::IdParser<vid_t> id_parser_;
 
+  // the layout of o2g indices for newly added labels
+  VertexMapIndexType index_type_ = VertexMapIndexType::kHashmap;
+
   // frag->label->oid
   std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays_;
-  std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2g_;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> o2g_;
+
+  // frag->label->oid, vertices added to existing labels, nullptr if none
+  std::vector<std::vector<std::shared_ptr<oid_array_t>>> overflow_oid_arrays_;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> overflow_o2g_;
+
+  // frag->label->oid, the base and the overflow concatenated on the first
+  // `GetOidArray()`
+  std::mutex concatenated_oid_arrays_mutex_;
+  std::map<std::pair<fid_t, label_id_t>, std::shared_ptr<oid_array_t>>
+      concatenated_oid_arrays_;
 
   friend class ArrowVertexMapBuilder<OID_T, VID_T>;
   friend class BasicArrowVertexMapBuilder<OID_T, VID_T>;
@@ -149,6 +220,33 @@ class ArrowVertexMapBuilder : public vineyard::ObjectBuilder {
   void set_o2g(fid_t fid, label_id_t label,
                const std::shared_ptr<vineyard::Hashmap<oid_t, vid_t>>& rm);
 
+  void set_o2g(fid_t fid, label_id_t label,
+               const vineyard::SwissHashmap<oid_t, vid_t>& rm);
+
+  void set_o2g(fid_t fid, label_id_t label,
+               const std::shared_ptr<vineyard::SwissHashmap<oid_t, vid_t>>& rm);
+
+  void set_o2g(fid_t fid, label_id_t label,
+               const VertexMapIndex<oid_t, vid_t>& rm);
+
+  /**
+   * @brief Set the layout of the o2g indices that are built by this builder,
+   * defaults to `DefaultVertexMapIndexType()`.
+   */
+  void set_index_type(VertexMapIndexType index_type) {
+    index_type_ = index_type;
+  }
+
+  VertexMapIndexType index_type() const { return index_type_; }
+
+  /**
+   * @brief Set the number of threads used to build the o2g indices, defaults
+   * to the hardware concurrency shared by the `fnum` fragments.
+   */
+  void set_concurrency(int concurrency) { concurrency_ = concurrency; }
+
+  int concurrency() const;
+
   Status _Seal(vineyard::Client& client,
                std::shared_ptr<vineyard::Object>& object) override;
 
@@ -156,9 +254,12 @@ class ArrowVertexMapBuilder : public vineyard::ObjectBuilder {
   fid_t fnum_;
   label_id_t label_num_;
 
+  VertexMapIndexType index_type_ = DefaultVertexMapIndexType();
+  int concurrency_ = 0;
+
   std::vector<std::vector<typename InternalType<oid_t>::vineyard_array_type>>
       oid_arrays_;
-  std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2g_;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> o2g_;
 };
 
 template <typename OID_T, typename VID_T>
@@ -24,6 +24,7 @@ limitations under the License.
 #include <vector>
 
 #include "basic/ds/arrow.h"
+#include "basic/ds/arrow_shim/concatenate.h"
 #include "basic/ds/hashmap.h"
 #include "client/client.h"
 #include "common/util/typename.h"
@@ -31,9 +32,32 @@ limitations under the License.
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/thread_group.h"
 #include "graph/vertex_map/arrow_vertex_map.h"
+#include "graph/vertex_map/vertex_map_index.h"
 
 namespace vineyard {
 
+namespace detail {
+
+/**
+ * @brief The (fid, label) pairs are built by a thread group of `concurrency`
+ * threads, the remaining threads are shared by each pair to build its index.
+ */
+inline int vertex_map_task_concurrency(const int concurrency,
+                                       const size_t task_num) {
+  if (task_num == 0) {
+    return 1;
+  }
+  return std::max(1, static_cast<int>((concurrency + task_num - 1) / task_num));
+}
+
+inline int vertex_map_default_concurrency(const fid_t fnum) {
+  return std::max(1, static_cast<int>((std::thread::hardware_concurrency() +
+                                       (fnum - 1)) /
+                                      fnum));
+}
+
+}  // namespace detail
+
 template <typename OID_T, typename VID_T>
 void ArrowVertexMap<OID_T, VID_T>::Construct(const vineyard::ObjectMeta& meta) {
   this->meta_ = meta;
@@ -47,9 +71,13 @@ void ArrowVertexMap<OID_T, VID_T>::Construct(const vineyard::ObjectMeta& meta) {
   size_t o2g_total_bytes = 0, o2g_size = 0, o2g_bucket_count = 0;
   o2g_.resize(fnum_);
   oid_arrays_.resize(fnum_);
+  overflow_o2g_.resize(fnum_);
+  overflow_oid_arrays_.resize(fnum_);
   for (fid_t i = 0; i < fnum_; ++i) {
     o2g_[i].resize(label_num_);
     oid_arrays_[i].resize(label_num_);
+    overflow_o2g_[i].resize(label_num_);
+    overflow_oid_arrays_[i].resize(label_num_);
     for (label_id_t j = 0; j < label_num_; ++j) {
       o2g_[i][j].Construct(meta.GetMemberMeta("o2g_" + std::to_string(i) + "_" +
                                               std::to_string(j)));
@@ -63,8 +91,30 @@ void ArrowVertexMap<OID_T, VID_T>::Construct(const vineyard::ObjectMeta& meta) {
       o2g_size += o2g_[i][j].size();
       o2g_total_bytes += o2g_[i][j].nbytes();
       o2g_bucket_count += o2g_[i][j].bucket_count();
+
+      // the overflow members are absent unless vertices have been added to
+      // the label
+      std::string overflow_name =
+          "overflow_oid_arrays_" + std::to_string(i) + "_" + std::to_string(j);
+      if (meta.HasKey(overflow_name)) {
+        overflow_o2g_[i][j].Construct(meta.GetMemberMeta(
+            "overflow_o2g_" + std::to_string(i) + "_" + std::to_string(j)));
+        typename InternalType<oid_t>::vineyard_array_type overflow_array;
+        overflow_array.Construct(meta.GetMemberMeta(overflow_name));
+        overflow_oid_arrays_[i][j] = overflow_array.GetArray();
+
+        local_oid_total += overflow_array.nbytes();
+        o2g_size += overflow_o2g_[i][j].size();
+        o2g_total_bytes += overflow_o2g_[i][j].nbytes();
+        o2g_bucket_count += overflow_o2g_[i][j].bucket_count();
+      }
     }
   }
+  if (fnum_ > 0 && label_num_ > 0) {
+    index_type_ = o2g_[0][0].type();
+  } else {
+    index_type_ = DefaultVertexMapIndexType();
+  }
 
   nbytes = local_oid_total + o2g_total_bytes;
   double o2g_load_factor =
@@ -88,6 +138,11 @@ bool ArrowVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
       oid = array->GetView(offset);
       return true;
     }
+    auto overflow = overflow_oid_arrays_[fid][label];
+    if (overflow != nullptr && offset - array->length() < overflow->length()) {
+      oid = overflow->GetView(offset - array->length());
+      return true;
+    }
   }
   return false;
 }
@@ -95,12 +150,11 @@ bool ArrowVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
 template <typename OID_T, typename VID_T>
 bool ArrowVertexMap<OID_T, VID_T>::GetGid(fid_t fid, label_id_t label_id,
                                           oid_t oid, vid_t& gid) const {
-  auto iter = o2g_[fid][label_id].find(oid);
-  if (iter != o2g_[fid][label_id].end()) {
-    gid = iter->second;
+  if (o2g_[fid][label_id].find(oid, gid)) {
     return true;
   }
-  return false;
+  return overflow_oid_arrays_[fid][label_id] != nullptr &&
+         overflow_o2g_[fid][label_id].find(oid, gid);
 }
 
 template <typename OID_T, typename VID_T>
@@ -118,12 +172,18 @@ template <typename OID_T, typename VID_T>
 std::vector<OID_T> ArrowVertexMap<OID_T, VID_T>::GetOids(
     fid_t fid, label_id_t label_id) const {
   auto array = oid_arrays_[fid][label_id];
+  auto overflow = overflow_oid_arrays_[fid][label_id];
   std::vector<oid_t> oids;
 
-  oids.resize(array->length());
+  oids.resize(vertexNum(fid, label_id));
   for (auto i = 0; i < array->length(); i++) {
     oids[i] = array->GetView(i);
   }
+  if (overflow != nullptr) {
+    for (auto i = 0; i < overflow->length(); i++) {
+      oids[array->length() + i] = overflow->GetView(i);
+    }
+  }
 
   return oids;
 }
@@ -131,15 +191,29 @@ std::vector<OID_T> ArrowVertexMap<OID_T, VID_T>::GetOids(
 template <typename OID_T, typename VID_T>
 std::shared_ptr<ArrowArrayType<OID_T>>
 ArrowVertexMap<OID_T, VID_T>::GetOidArray(fid_t fid, label_id_t label_id) {
-  return oid_arrays_[fid][label_id];
+  auto overflow = overflow_oid_arrays_[fid][label_id];
+  if (overflow == nullptr) {
+    return oid_arrays_[fid][label_id];
+  }
+  // the vertices added to the label live in a separate array, concatenate
+  // them once
+  std::lock_guard<std::mutex> lock(concatenated_oid_arrays_mutex_);
+  auto& concatenated = concatenated_oid_arrays_[std::make_pair(fid, label_id)];
+  if (concatenated == nullptr) {
+    std::shared_ptr<arrow::Array> array;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        array, arrow_shim::Concatenate({oid_arrays_[fid][label_id], overflow}));
+    concatenated = std::dynamic_pointer_cast<oid_array_t>(array);
+  }
+  return concatenated;
 }
 
 template <typename OID_T, typename VID_T>
 size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum() const {
   size_t num = 0;
-  for (auto& vec : oid_arrays_) {
-    for (auto& v : vec) {
-      num += v->length();
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    for (label_id_t label = 0; label < label_num_; ++label) {
+      num += vertexNum(fid, label);
     }
   }
   return num;
@@ -148,8 +222,8 @@ size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum() const {
 template <typename OID_T, typename VID_T>
 size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum(label_id_t label) const {
   size_t num = 0;
-  for (auto& vec : oid_arrays_) {
-    num += vec[label]->length();
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    num += vertexNum(fid, label);
   }
   return num;
 }
@@ -157,8 +231,8 @@ size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum(label_id_t label) const {
 template <typename OID_T, typename VID_T>
 VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(fid_t fid) const {
   size_t num = 0;
-  for (auto& v : oid_arrays_[fid]) {
-    num += v->length();
+  for (label_id_t label = 0; label < label_num_; ++label) {
+    num += vertexNum(fid, label);
   }
   return static_cast<vid_t>(num);
 }
@@ -166,7 +240,17 @@ VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(fid_t fid) const {
 template <typename OID_T, typename VID_T>
 VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(
     fid_t fid, label_id_t label_id) const {
-  return static_cast<vid_t>(oid_arrays_[fid][label_id]->length());
+  return static_cast<vid_t>(vertexNum(fid, label_id));
+}
+
+template <typename OID_T, typename VID_T>
+size_t ArrowVertexMap<OID_T, VID_T>::vertexNum(fid_t fid,
+                                               label_id_t label_id) const {
+  size_t num = oid_arrays_[fid][label_id]->length();
+  if (overflow_oid_arrays_[fid][label_id] != nullptr) {
+    num += overflow_oid_arrays_[fid][label_id]->length();
+  }
+  return num;
 }
 
 template <typename OID_T, typename VID_T>
@@ -174,13 +258,16 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::AddVertices(
     Client& client,
     std::map<label_id_t, std::vector<std::shared_ptr<oid_array_t>>>
         oid_arrays_map) {
-  int extra_label_num = oid_arrays_map.size();
-  std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays;
-  oid_arrays.resize(extra_label_num);
+  std::map<label_id_t, std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+      arrays;
   for (auto& pair : oid_arrays_map) {
-    oid_arrays[pair.first - label_num_] = pair.second;
+    auto& label_arrays = arrays[pair.first];
+    label_arrays.resize(fnum_);
+    for (fid_t fid = 0; fid < fnum_; ++fid) {
+      label_arrays[fid] = {pair.second[fid]};
+    }
   }
-  return AddNewVertexLabels(client, std::move(oid_arrays));
+  return addVertices(client, std::move(arrays));
 }
 
 template <typename OID_T, typename VID_T>
@@ -188,13 +275,85 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::AddVertices(
     Client& client,
     std::map<label_id_t, std::vector<std::shared_ptr<arrow::ChunkedArray>>>
         oid_arrays_map) {
-  int extra_label_num = oid_arrays_map.size();
-  std::vector<std::vector<std::shared_ptr<arrow::ChunkedArray>>> oid_arrays;
-  oid_arrays.resize(extra_label_num);
+  std::map<label_id_t, std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+      arrays;
+  for (auto& pair : oid_arrays_map) {
+    auto& label_arrays = arrays[pair.first];
+    label_arrays.resize(fnum_);
+    for (fid_t fid = 0; fid < fnum_; ++fid) {
+      for (auto const& chunk : pair.second[fid]->chunks()) {
+        label_arrays[fid].emplace_back(
+            std::dynamic_pointer_cast<oid_array_t>(chunk));
+      }
+    }
+  }
+  return addVertices(client, std::move(arrays));
+}
+
+template <typename OID_T, typename VID_T>
+ObjectID ArrowVertexMap<OID_T, VID_T>::addVertices(
+    Client& client,
+    std::map<label_id_t,
+             std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+        oid_arrays_map) {
+  std::map<label_id_t, std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+      extended_arrays;
+  std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+      new_arrays;
   for (auto& pair : oid_arrays_map) {
-    oid_arrays[pair.first - label_num_] = pair.second;
+    if (pair.first < label_num_) {
+      extended_arrays.emplace(pair.first, std::move(pair.second));
+    } else {
+      size_t index = static_cast<size_t>(pair.first - label_num_);
+      if (new_arrays.size() <= index) {
+        new_arrays.resize(index + 1);
+      }
+      new_arrays[index] = std::move(pair.second);
+    }
+  }
+  return addVertices(client, std::move(extended_arrays),
+                     std::move(new_arrays));
+}
+
+template <typename OID_T, typename VID_T>
+ObjectID ArrowVertexMap<OID_T, VID_T>::addVertices(
+    Client& client,
+    std::map<label_id_t,
+             std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+        extended_arrays,
+    std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+        new_arrays) {
+  // reject the duplicated vertices before anything is sealed
+  auto status = checkExtendedVertices(extended_arrays);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to add vertices to the vertex map: "
+               << status.ToString();
+    return InvalidObjectID();
   }
-  return AddNewVertexLabels(client, std::move(oid_arrays));
+
+  vineyard::ObjectMeta old_meta, new_meta;
+  VINEYARD_CHECK_OK(client.GetMetaData(this->id(), old_meta));
+
+  new_meta.SetTypeName(type_name<ArrowVertexMap<oid_t, vid_t>>());
+
+  new_meta.AddKeyValue("fnum", fnum_);
+  new_meta.AddKeyValue("label_num",
+                       label_num_ + static_cast<int>(new_arrays.size()));
+
+  // both the existing and the new labels are added to the same resulting
+  // vertex map
+  size_t nbytes = 0;
+  VINEYARD_CHECK_OK(extendVertexLabels(client, std::move(extended_arrays),
+                                       old_meta, new_meta, nbytes));
+  VINEYARD_CHECK_OK(
+      addNewVertexLabels(client, std::move(new_arrays), new_meta, nbytes));
+
+  new_meta.SetNBytes(nbytes);
+  ObjectID ret;
+  VINEYARD_CHECK_OK(client.CreateMetaData(new_meta, ret));
+  VLOG(100) << "vertex map memory usage: "
+            << prettyprint_memory_size(new_meta.MemoryUsage());
+  return ret;
 }
 
 template <typename OID_T, typename VID_T>
@@ -209,7 +368,7 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::AddNewVertexLabels(
       arrays[i][j] = {oid_arrays[i][j]};
     }
   }
-  return addNewVertexLabels(client, std::move(arrays));
+  return addVertices(client, {}, std::move(arrays));
 }
 
 template <typename OID_T, typename VID_T>
@@ -227,22 +386,67 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::AddNewVertexLabels(
       }
     }
   }
-  return addNewVertexLabels(client, std::move(arrays));
+  return addVertices(client, {}, std::move(arrays));
 }
 
 template <typename OID_T, typename VID_T>
-ObjectID ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
+Status ArrowVertexMap<OID_T, VID_T>::checkExtendedVertices(
+    const std::map<label_id_t,
+                   std::vector<std::vector<std::shared_ptr<oid_array_t>>>>&
+        oid_arrays) const {
+  auto fn = [this, &oid_arrays](const label_id_t label,
+                                const fid_t fid) -> Status {
+    ska::flat_hash_set<oid_t, prime_number_hash_wy<oid_t>> added;
+    vid_t gid;
+    for (auto const& chunk : oid_arrays.at(label)[fid]) {
+      for (int64_t k = 0; k < chunk->length(); ++k) {
+        oid_t oid = chunk->GetView(k);
+        // the vertex exists in either the base or the overflow, or is added
+        // twice
+        if (GetGid(fid, label, oid, gid) || !added.insert(oid).second) {
+          return Status::Invalid(
+              "Duplicated vertex found when adding vertices to label " +
+              std::to_string(label) + " of fragment " + std::to_string(fid));
+        }
+      }
+    }
+    return Status::OK();
+  };
+
+  ThreadGroup tg(detail::vertex_map_default_concurrency(fnum_));
+  for (auto const& pair : oid_arrays) {
+    if (pair.first < 0 || pair.first >= label_num_) {
+      return Status::Invalid("Invalid vertex label id: " +
+                             std::to_string(pair.first));
+    }
+    for (fid_t fid = 0; fid < fnum_; ++fid) {
+      tg.AddTask(fn, pair.first, fid);
+    }
+  }
+
+  Status status;
+  for (auto const& s : tg.TakeResults()) {
+    status += s;
+  }
+  return status;
+}
+
+template <typename OID_T, typename VID_T>
+Status ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
     Client& client,
     std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
-        oid_arrays) {
+        oid_arrays,
+    ObjectMeta& new_meta, size_t& nbytes) {
   using vineyard_oid_array_t =
       typename InternalType<oid_t>::vineyard_array_type;
 
   label_id_t extra_label_num = oid_arrays.size();
+  if (extra_label_num == 0) {
+    return Status::OK();
+  }
 
   std::vector<std::vector<vineyard_oid_array_t>> vy_oid_arrays;
-  std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> vy_o2g;
-  int total_label_num = label_num_ + extra_label_num;
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> vy_o2g;
   vy_oid_arrays.resize(fnum_);
   vy_o2g.resize(fnum_);
   for (fid_t i = 0; i < fnum_; ++i) {
@@ -250,8 +454,13 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
     vy_o2g[i].resize(extra_label_num);
   }
 
-  auto fn = [this, &client, &oid_arrays, &vy_oid_arrays, &vy_o2g](
-                const label_id_t label, const fid_t fid) -> Status {
+  const int concurrency = detail::vertex_map_default_concurrency(fnum_);
+  const int task_concurrency = detail::vertex_map_task_concurrency(
+      concurrency, static_cast<size_t>(extra_label_num) * fnum_);
+
+  auto fn = [this, &client, &oid_arrays, &vy_oid_arrays, &vy_o2g,
+             task_concurrency](const label_id_t label,
+                               const fid_t fid) -> Status {
     std::shared_ptr<Object> object;
     std::shared_ptr<vineyard_oid_array_t> varray;
     {
@@ -266,27 +475,20 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
     }
 
     {
-      vineyard::HashmapBuilder<oid_t, vid_t> builder(client);
-      builder.AssociateDataBuffer(varray->GetBuffer());
-
       auto array = varray->GetArray();
-      vid_t cur_gid = id_parser_.GenerateId(fid, label, 0);
-      int64_t vnum = array->length();
-      builder.reserve(static_cast<size_t>(vnum));
-      for (int64_t k = 0; k < vnum; ++k) {
-        builder.emplace(array->GetView(k), cur_gid);
-        ++cur_gid;
-      }
-      RETURN_ON_ERROR(builder.Seal(client, object));
-      vy_o2g[fid][label - label_num_] =
-          *std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object);
+      vid_t gid_begin = id_parser_.GenerateId(fid, label, 0);
+      RETURN_ON_ERROR(BuildVertexMapIndex(
+          client, index_type_, array->length(), varray->GetBuffer(),
+          [&array, gid_begin](int64_t k, oid_t& oid, vid_t& gid) {
+            oid = array->GetView(k);
+            gid = gid_begin + static_cast<vid_t>(k);
+          },
+          vy_o2g[fid][label - label_num_], task_concurrency));
     }
     return Status::OK();
   };
 
-  ThreadGroup tg(
-      (static_cast<fid_t>(std::thread::hardware_concurrency()) + (fnum_ - 1)) /
-      fnum_);
+  ThreadGroup tg(concurrency);
   for (label_id_t label = label_num_; label < label_num_ + extra_label_num;
        ++label) {
     for (fid_t fid = 0; fid < fnum_; ++fid) {
@@ -298,48 +500,156 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
   for (auto const& s : tg.TakeResults()) {
     status += s;
   }
-  VINEYARD_CHECK_OK(status);
+  RETURN_ON_ERROR(status);
 
-  vineyard::ObjectMeta old_meta, new_meta;
-  VINEYARD_CHECK_OK(client.GetMetaData(this->id(), old_meta));
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    for (label_id_t label = label_num_; label < label_num_ + extra_label_num;
+         ++label) {
+      std::string array_name =
+          "oid_arrays_" + std::to_string(fid) + "_" + std::to_string(label);
+      std::string map_name =
+          "o2g_" + std::to_string(fid) + "_" + std::to_string(label);
+      new_meta.AddMember(array_name,
+                         vy_oid_arrays[fid][label - label_num_].meta());
+      nbytes += vy_oid_arrays[fid][label - label_num_].nbytes();
 
-  new_meta.SetTypeName(type_name<ArrowVertexMap<oid_t, vid_t>>());
+      new_meta.AddMember(map_name, vy_o2g[fid][label - label_num_].meta());
+      nbytes += vy_o2g[fid][label - label_num_].nbytes();
+    }
+  }
+  return Status::OK();
+}
 
-  new_meta.AddKeyValue("fnum", fnum_);
-  new_meta.AddKeyValue("label_num", total_label_num);
+template <typename OID_T, typename VID_T>
+Status ArrowVertexMap<OID_T, VID_T>::extendVertexLabels(
+    Client& client,
+    std::map<label_id_t,
+             std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
+        oid_arrays,
+    const ObjectMeta& old_meta, ObjectMeta& new_meta, size_t& nbytes) {
+  using vineyard_oid_array_t =
+      typename InternalType<oid_t>::vineyard_array_type;
 
-  size_t nbytes = 0;
+  // what happens to the (fid, label) pair
+  enum ExtendKind { kUnchanged = 0, kOverflowed = 1, kCompacted = 2 };
+
+  const double compaction_ratio = DefaultVertexMapCompactionRatio();
+
+  std::vector<std::vector<ExtendKind>> kinds(
+      fnum_, std::vector<ExtendKind>(label_num_, kUnchanged));
+  std::vector<std::vector<vineyard_oid_array_t>> vy_oid_arrays(
+      fnum_, std::vector<vineyard_oid_array_t>(label_num_));
+  std::vector<std::vector<VertexMapIndex<oid_t, vid_t>>> vy_o2g(
+      fnum_, std::vector<VertexMapIndex<oid_t, vid_t>>(label_num_));
+
+  const int concurrency = detail::vertex_map_default_concurrency(fnum_);
+  const int task_concurrency = detail::vertex_map_task_concurrency(
+      concurrency, oid_arrays.size() * fnum_);
+
+  auto fn = [this, &client, &oid_arrays, &kinds, &vy_oid_arrays, &vy_o2g,
+             compaction_ratio,
+             task_concurrency](const label_id_t label,
+                               const fid_t fid) -> Status {
+    auto& chunks = oid_arrays.at(label)[fid];
+    int64_t added_num = 0;
+    for (auto const& chunk : chunks) {
+      added_num += chunk->length();
+    }
+    if (added_num == 0) {
+      return Status::OK();
+    }
+
+    // the overflow array is merged into the base array once it grows too
+    // large, otherwise it is rebuilt with the newly added vertices
+    auto const& base = oid_arrays_[fid][label];
+    auto const& overflow = overflow_oid_arrays_[fid][label];
+    int64_t overflow_num =
+        added_num + (overflow == nullptr ? 0 : overflow->length());
+    bool compact = overflow_num > compaction_ratio * base->length();
+    std::vector<std::shared_ptr<oid_array_t>> arrays;
+    if (compact) {
+      arrays.emplace_back(base);
+    }
+    if (overflow != nullptr) {
+      arrays.emplace_back(overflow);
+    }
+    for (auto& chunk : chunks) {
+      arrays.emplace_back(std::move(chunk));
+    }
+    // release the reference
+    chunks.clear();
+
+    std::shared_ptr<Object> object;
+    typename InternalType<oid_t>::vineyard_builder_type array_builder(
+        client, std::move(arrays));
+    RETURN_ON_ERROR(array_builder.Seal(client, object));
+    auto varray = std::dynamic_pointer_cast<vineyard_oid_array_t>(object);
+    vy_oid_arrays[fid][label] = *varray;
+
+    auto array = varray->GetArray();
+    vid_t gid_begin =
+        id_parser_.GenerateId(fid, label, compact ? 0 : base->length());
+    RETURN_ON_ERROR(BuildVertexMapIndex(
+        client, index_type_, array->length(), varray->GetBuffer(),
+        [&array, gid_begin](int64_t k, oid_t& oid, vid_t& gid) {
+          oid = array->GetView(k);
+          gid = gid_begin + static_cast<vid_t>(k);
+        },
+        vy_o2g[fid][label], task_concurrency));
+    kinds[fid][label] = compact ? kCompacted : kOverflowed;
+    return Status::OK();
+  };
+
+  ThreadGroup tg(concurrency);
+  for (auto const& pair : oid_arrays) {
+    for (fid_t fid = 0; fid < fnum_; ++fid) {
+      tg.AddTask(fn, pair.first, fid);
+    }
+  }
+
+  Status status;
+  for (auto const& s : tg.TakeResults()) {
+    status += s;
+  }
+  RETURN_ON_ERROR(status);
+
+  auto add_member = [&](const std::string& name, const ObjectMeta& meta) {
+    new_meta.AddMember(name, meta);
+    nbytes += meta.GetNBytes();
+  };
   for (fid_t fid = 0; fid < fnum_; ++fid) {
-    for (label_id_t label = 0; label < total_label_num; ++label) {
+    for (label_id_t label = 0; label < label_num_; ++label) {
       std::string array_name =
           "oid_arrays_" + std::to_string(fid) + "_" + std::to_string(label);
       std::string map_name =
           "o2g_" + std::to_string(fid) + "_" + std::to_string(label);
-      if (label < label_num_) {
-        auto array_meta = old_meta.GetMemberMeta(array_name);
-        new_meta.AddMember(array_name, array_meta);
-        nbytes += array_meta.GetNBytes();
-
-        auto map_meta = old_meta.GetMemberMeta(map_name);
-        new_meta.AddMember(map_name, map_meta);
-        nbytes += map_meta.GetNBytes();
-      } else {
-        new_meta.AddMember(array_name,
-                           vy_oid_arrays[fid][label - label_num_].meta());
-        nbytes += vy_oid_arrays[fid][label - label_num_].nbytes();
-
-        new_meta.AddMember(map_name, vy_o2g[fid][label - label_num_].meta());
-        nbytes += vy_o2g[fid][label - label_num_].nbytes();
+      switch (kinds[fid][label]) {
+      case kCompacted: {
+        add_member(array_name, vy_oid_arrays[fid][label].meta());
+        add_member(map_name, vy_o2g[fid][label].meta());
+        break;
+      }
+      case kOverflowed: {
+        add_member(array_name, old_meta.GetMemberMeta(array_name));
+        add_member(map_name, old_meta.GetMemberMeta(map_name));
+        add_member("overflow_" + array_name, vy_oid_arrays[fid][label].meta());
+        add_member("overflow_" + map_name, vy_o2g[fid][label].meta());
+        break;
+      }
+      default: {
+        add_member(array_name, old_meta.GetMemberMeta(array_name));
+        add_member(map_name, old_meta.GetMemberMeta(map_name));
+        if (old_meta.HasKey("overflow_" + array_name)) {
+          add_member("overflow_" + array_name,
+                     old_meta.GetMemberMeta("overflow_" + array_name));
+          add_member("overflow_" + map_name,
+                     old_meta.GetMemberMeta("overflow_" + map_name));
+        }
+      }
       }
     }
   }
-
-  new_meta.SetNBytes(nbytes);
-  ObjectID ret;
-  VINEYARD_CHECK_OK(client.CreateMetaData(new_meta, ret));
-  VLOG(100) << "vertex map memory usage: "
-            << prettyprint_memory_size(new_meta.MemoryUsage());
-  return ret;
+  return Status::OK();
 }
 
 template <typename OID_T, typename VID_T>
@@ -373,14 +683,42 @@ void ArrowVertexMapBuilder<OID_T, VID_T>::set_oid_array(
 template <typename OID_T, typename VID_T>
 void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g(
     fid_t fid, label_id_t label, const vineyard::Hashmap<oid_t, vid_t>& rm) {
-  o2g_[fid][label] = rm;
+  o2g_[fid][label] = VertexMapIndex<oid_t, vid_t>(rm);
 }
 
 template <typename OID_T, typename VID_T>
 void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g(
     fid_t fid, label_id_t label,
     const std::shared_ptr<vineyard::Hashmap<oid_t, vid_t>>& rm) {
-  o2g_[fid][label] = *rm;
+  o2g_[fid][label] = VertexMapIndex<oid_t, vid_t>(*rm);
+}
+
+template <typename OID_T, typename VID_T>
+void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g(
+    fid_t fid, label_id_t label,
+    const vineyard::SwissHashmap<oid_t, vid_t>& rm) {
+  o2g_[fid][label] = VertexMapIndex<oid_t, vid_t>(rm);
+}
+
+template <typename OID_T, typename VID_T>
+void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g(
+    fid_t fid, label_id_t label,
+    const std::shared_ptr<vineyard::SwissHashmap<oid_t, vid_t>>& rm) {
+  o2g_[fid][label] = VertexMapIndex<oid_t, vid_t>(*rm);
+}
+
+template <typename OID_T, typename VID_T>
+void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g(
+    fid_t fid, label_id_t label, const VertexMapIndex<oid_t, vid_t>& rm) {
+  o2g_[fid][label] = rm;
+}
+
+template <typename OID_T, typename VID_T>
+int ArrowVertexMapBuilder<OID_T, VID_T>::concurrency() const {
+  if (concurrency_ > 0) {
+    return concurrency_;
+  }
+  return detail::vertex_map_default_concurrency(fnum_);
 }
 
 template <typename OID_T, typename VID_T>
@@ -408,6 +746,14 @@ Status ArrowVertexMapBuilder<OID_T, VID_T>::_Seal(
   }
 
   vertex_map->o2g_ = o2g_;
+  vertex_map->index_type_ = index_type_;
+
+  vertex_map->overflow_oid_arrays_.resize(fnum_);
+  vertex_map->overflow_o2g_.resize(fnum_);
+  for (fid_t i = 0; i < fnum_; ++i) {
+    vertex_map->overflow_oid_arrays_[i].resize(label_num_);
+    vertex_map->overflow_o2g_[i].resize(label_num_);
+  }
 
   vertex_map->meta_.SetTypeName(type_name<ArrowVertexMap<oid_t, vid_t>>());
 
@@ -488,6 +834,10 @@ vineyard::Status BasicArrowVertexMapBuilder<OID_T, VID_T>::Build(
 
   this->set_fnum_label_num(fnum_, label_num_);
 
+  const int concurrency = this->concurrency();
+  const int task_concurrency = detail::vertex_map_task_concurrency(
+      concurrency, static_cast<size_t>(label_num_) * fnum_);
+
   auto fn = [&](const label_id_t label, const fid_t fid) -> Status {
     std::shared_ptr<Object> object;
     std::shared_ptr<vineyard_oid_array_t> varray;
@@ -502,28 +852,22 @@ vineyard::Status BasicArrowVertexMapBuilder<OID_T, VID_T>::Build(
       oid_arrays_[label][fid].clear();
     }
     {
-      vineyard::HashmapBuilder<oid_t, vid_t> builder(client);
-      builder.AssociateDataBuffer(varray->GetBuffer());
-
       auto array = varray->GetArray();
-      vid_t cur_gid = id_parser_.GenerateId(fid, label, 0);
-      int64_t vnum = array->length();
-      builder.reserve(static_cast<size_t>(vnum));
-      for (int64_t k = 0; k < vnum; ++k) {
-        builder.emplace(array->GetView(k), cur_gid);
-        ++cur_gid;
-      }
-      RETURN_ON_ERROR(builder.Seal(client, object));
-      this->set_o2g(
-          fid, label,
-          std::dynamic_pointer_cast<vineyard::Hashmap<oid_t, vid_t>>(object));
+      vid_t gid_begin = id_parser_.GenerateId(fid, label, 0);
+      VertexMapIndex<oid_t, vid_t> o2g;
+      RETURN_ON_ERROR(BuildVertexMapIndex(
+          client, this->index_type(), array->length(), varray->GetBuffer(),
+          [&array, gid_begin](int64_t k, oid_t& oid, vid_t& gid) {
+            oid = array->GetView(k);
+            gid = gid_begin + static_cast<vid_t>(k);
+          },
+          o2g, task_concurrency));
+      this->set_o2g(fid, label, o2g);
     }
     return Status::OK();
   };
 
-  ThreadGroup tg(
-      (static_cast<fid_t>(std::thread::hardware_concurrency()) + (fnum_ - 1)) /
-      fnum_);
+  ThreadGroup tg(concurrency);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     for (label_id_t label = 0; label < label_num_; ++label) {
       tg.AddTask(fn, label, fid);
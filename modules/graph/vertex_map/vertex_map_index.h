@@ -0,0 +1,311 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_VERTEX_MAP_VERTEX_MAP_INDEX_H_
+#define MODULES_GRAPH_VERTEX_MAP_VERTEX_MAP_INDEX_H_
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <string>
+
+#include "basic/ds/hashmap.h"
+#include "basic/ds/swiss_hashmap.h"
+#include "client/client.h"
+#include "common/util/env.h"
+#include "common/util/logging.h"
+#include "common/util/parallel.h"
+#include "common/util/status.h"
+#include "common/util/typename.h"
+
+namespace vineyard {
+
+/**
+ * @brief The layout of the sealed oid-to-vid index in vertex maps.
+ *
+ * - kHashmap: the robin-hood `Hashmap`, the default.
+ * - kSwissTable: the `SwissHashmap`, which probes 16 slots at once by
+ *   comparing 7-bit hash tags with SIMD instructions.
+ *
+ * The default can be overridden by the environment variable
+ * `VINEYARD_VERTEX_MAP_INDEX` ("hashmap" or "swiss"), or per builder by
+ * `set_index_type()`. Vertex maps built with either layout can be loaded
+ * by any reader, as the layout is recorded in the type of the index member.
+ */
+enum class VertexMapIndexType {
+  kHashmap = 0,
+  kSwissTable = 1,
+};
+
+inline Status ParseVertexMapIndexType(std::string name,
+                                      VertexMapIndexType& type) {
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  if (name.empty() || name == "hashmap" || name == "robinhood") {
+    type = VertexMapIndexType::kHashmap;
+  } else if (name == "swiss" || name == "swisstable" ||
+             name == "swiss_table") {
+    type = VertexMapIndexType::kSwissTable;
+  } else {
+    return Status::Invalid("Unknown vertex map index type: '" + name + "'");
+  }
+  return Status::OK();
+}
+
+inline VertexMapIndexType DefaultVertexMapIndexType() {
+  static const VertexMapIndexType type = []() {
+    VertexMapIndexType type = VertexMapIndexType::kHashmap;
+    auto status =
+        ParseVertexMapIndexType(read_env("VINEYARD_VERTEX_MAP_INDEX"), type);
+    if (!status.ok()) {
+      LOG(WARNING) << status.ToString() << ", fallback to 'hashmap'";
+    }
+    return type;
+  }();
+  return type;
+}
+
+/**
+ * @brief The vertices added to existing labels of a sealed vertex map are
+ * indexed by an overflow index, which is merged into the base index once
+ * it grows beyond this ratio of the base.
+ *
+ * The default (0.1) can be overridden by the environment variable
+ * `VINEYARD_VERTEX_MAP_COMPACTION_RATIO`.
+ */
+inline double DefaultVertexMapCompactionRatio() {
+  static const double ratio =
+      read_env_ratio("VINEYARD_VERTEX_MAP_COMPACTION_RATIO", 0.1);
+  return ratio;
+}
+
+namespace detail {
+
+template <typename K, typename V>
+inline bool find_in_index(const Hashmap<K, V>& hashmap, const K& key,
+                          V& value) {
+  auto iter = hashmap.find(key);
+  if (iter != hashmap.end()) {
+    value = iter->second;
+    return true;
+  }
+  return false;
+}
+
+template <typename K, typename V>
+inline bool find_in_index(const SwissHashmap<K, V>& hashmap, const K& key,
+                          V& value) {
+  return hashmap.find(key, value);
+}
+
+template <typename MAP_T, typename K, typename V, typename KEY_FUNC_T>
+inline size_t find_all_in_index(const MAP_T& hashmap, const int64_t begin,
+                                const int64_t end, const KEY_FUNC_T& key_at,
+                                V* values, const V missing) {
+  size_t missed = 0;
+  for (int64_t i = begin; i < end; ++i) {
+    const K key = key_at(i);
+    if (!find_in_index(hashmap, key, values[i])) {
+      values[i] = missing;
+      missed += 1;
+    }
+  }
+  return missed;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The sealed index from oids (or other keys) to vids in vertex maps,
+ * which is either a `Hashmap` or a `SwissHashmap`.
+ *
+ * The layout is checked by every `find()`, bulk lookups should use
+ * `find_all()` to check it once for all the keys.
+ */
+template <typename K, typename V>
+class VertexMapIndex {
+ public:
+  using hashmap_t = Hashmap<K, V>;
+  using swiss_hashmap_t = SwissHashmap<K, V>;
+
+  VertexMapIndex() {}
+
+  explicit VertexMapIndex(const hashmap_t& hashmap)
+      : type_(VertexMapIndexType::kHashmap), hashmap_(hashmap) {}
+
+  explicit VertexMapIndex(const swiss_hashmap_t& hashmap)
+      : type_(VertexMapIndexType::kSwissTable), swiss_hashmap_(hashmap) {}
+
+  void Construct(const ObjectMeta& meta) {
+    if (meta.GetTypeName() == type_name<swiss_hashmap_t>()) {
+      type_ = VertexMapIndexType::kSwissTable;
+      swiss_hashmap_.Construct(meta);
+    } else {
+      type_ = VertexMapIndexType::kHashmap;
+      hashmap_.Construct(meta);
+    }
+  }
+
+  inline bool find(const K& key, V& value) const {
+    if (type_ == VertexMapIndexType::kSwissTable) {
+      return detail::find_in_index(swiss_hashmap_, key, value);
+    }
+    return detail::find_in_index(hashmap_, key, value);
+  }
+
+  /**
+   * @brief Looks up the keys `key_at(i)` for i in `[begin, end)`, the value
+   * of the i-th key is written to `values[i]`, or `missing` if the key is
+   * not found.
+   *
+   * @return The number of keys that are not found.
+   */
+  template <typename KEY_FUNC_T>
+  size_t find_all(const int64_t begin, const int64_t end,
+                  const KEY_FUNC_T& key_at, V* values, const V missing) const {
+    if (type_ == VertexMapIndexType::kSwissTable) {
+      return detail::find_all_in_index<swiss_hashmap_t, K>(
+          swiss_hashmap_, begin, end, key_at, values, missing);
+    }
+    return detail::find_all_in_index<hashmap_t, K>(hashmap_, begin, end,
+                                                   key_at, values, missing);
+  }
+
+  VertexMapIndexType type() const { return type_; }
+
+  const ObjectMeta& meta() const {
+    return type_ == VertexMapIndexType::kSwissTable ? swiss_hashmap_.meta()
+                                                    : hashmap_.meta();
+  }
+
+  size_t nbytes() const {
+    return type_ == VertexMapIndexType::kSwissTable ? swiss_hashmap_.nbytes()
+                                                    : hashmap_.nbytes();
+  }
+
+  size_t size() const {
+    return type_ == VertexMapIndexType::kSwissTable ? swiss_hashmap_.size()
+                                                    : hashmap_.size();
+  }
+
+  size_t bucket_count() const {
+    return type_ == VertexMapIndexType::kSwissTable
+               ? swiss_hashmap_.bucket_count()
+               : hashmap_.bucket_count();
+  }
+
+ private:
+  VertexMapIndexType type_ = VertexMapIndexType::kHashmap;
+  hashmap_t hashmap_;
+  swiss_hashmap_t swiss_hashmap_;
+};
+
+namespace detail {
+
+template <typename OBJECT_T, typename BUILDER_T, typename K, typename V,
+          typename FUNC_T>
+inline Status build_vertex_map_index(Client& client, BUILDER_T& builder,
+                                     const int64_t size,
+                                     const std::shared_ptr<Blob>& data_buffer,
+                                     const FUNC_T& func,
+                                     VertexMapIndex<K, V>& index) {
+  if (data_buffer != nullptr) {
+    builder.AssociateDataBuffer(data_buffer);
+  }
+  builder.reserve(static_cast<size_t>(size));
+  K key;
+  V value;
+  for (int64_t i = 0; i < size; ++i) {
+    func(i, key, value);
+    builder.emplace(key, value);
+  }
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  index = VertexMapIndex<K, V>(*std::dynamic_pointer_cast<OBJECT_T>(object));
+  return Status::OK();
+}
+
+template <typename K, typename V, typename FUNC_T>
+inline Status build_vertex_map_index_concurrently(
+    Client& client, const int64_t size,
+    const std::shared_ptr<Blob>& data_buffer, const FUNC_T& func,
+    const int concurrency, VertexMapIndex<K, V>& index) {
+  ConcurrentHashmapBuilder<K, V> builder(client, static_cast<size_t>(size),
+                                         static_cast<size_t>(concurrency));
+  if (data_buffer != nullptr) {
+    builder.AssociateDataBuffer(data_buffer);
+  }
+  const int64_t chunk = 64 * 1024;
+  RETURN_ON_ERROR(parallel_for_status(
+      static_cast<size_t>((size + chunk - 1) / chunk),
+      static_cast<size_t>(concurrency), [&](size_t i) -> Status {
+        int64_t begin = static_cast<int64_t>(i) * chunk;
+        int64_t end = std::min(begin + chunk, size);
+        K key;
+        V value;
+        for (int64_t k = begin; k < end; ++k) {
+          func(k, key, value);
+          if (!builder.emplace(key, value).ok()) {
+            return Status::Invalid(
+                "The capacity of vertex map index is exhausted");
+          }
+        }
+        return Status::OK();
+      }));
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  index =
+      VertexMapIndex<K, V>(*std::dynamic_pointer_cast<Hashmap<K, V>>(object));
+  return Status::OK();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Builds the sealed index of `size` entries in the given layout, the
+ * i-th entry is generated by `func(i, key, value)`.
+ *
+ * Large `Hashmap` indices are filled by `concurrency` threads with the
+ * `ConcurrentHashmapBuilder`, thus `func` must be thread-safe in that case.
+ *
+ * @param data_buffer The blob that string keys point into, can be nullptr.
+ */
+template <typename K, typename V, typename FUNC_T>
+inline Status BuildVertexMapIndex(Client& client, const VertexMapIndexType type,
+                                  const int64_t size,
+                                  const std::shared_ptr<Blob>& data_buffer,
+                                  const FUNC_T& func,
+                                  VertexMapIndex<K, V>& index,
+                                  const int concurrency = 1) {
+  // below which the threads are not worth spawning
+  static constexpr int64_t kConcurrentThreshold = 1024 * 1024;
+  if (type == VertexMapIndexType::kHashmap && concurrency > 1 &&
+      size >= kConcurrentThreshold) {
+    return detail::build_vertex_map_index_concurrently(
+        client, size, data_buffer, func, concurrency, index);
+  }
+  if (type == VertexMapIndexType::kSwissTable) {
+    SwissHashmapBuilder<K, V> builder(client);
+    return detail::build_vertex_map_index<SwissHashmap<K, V>>(
+        client, builder, size, data_buffer, func, index);
+  } else {
+    HashmapBuilder<K, V> builder(client);
+    return detail::build_vertex_map_index<Hashmap<K, V>>(
+        client, builder, size, data_buffer, func, index);
+  }
+}
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_VERTEX_MAP_VERTEX_MAP_INDEX_H_
@@ -0,0 +1,801 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "io/io/columnar_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+#include "arrow/io/api.h"
+#include "boost/algorithm/string.hpp"
+
+#if defined(WITH_PARQUET)
+#include "parquet/api/reader.h"
+#include "parquet/arrow/reader.h"
+#endif
+
+#if defined(WITH_ORC)
+#include "arrow/adapters/orc/adapter.h"
+#endif
+
+#include "basic/ds/arrow_utils.h"
+#include "common/util/arrow.h"
+#include "common/util/logging.h"
+#include "common/util/parallel.h"
+
+namespace vineyard {
+
+namespace detail {
+
+static const char* comparison_function(const std::string& op) {
+  if (op == "==") {
+    return "equal";
+  } else if (op == "!=") {
+    return "not_equal";
+  } else if (op == "<") {
+    return "less";
+  } else if (op == "<=") {
+    return "less_equal";
+  } else if (op == ">") {
+    return "greater";
+  } else if (op == ">=") {
+    return "greater_equal";
+  }
+  return nullptr;
+}
+
+/**
+ * Filter the rows of a table or a record batch.
+ */
+template <typename T>
+static Status filter_rows(const std::shared_ptr<T>& input,
+                          const std::vector<ColumnPredicate>& predicates,
+                          arrow::Datum& out) {
+#if defined(ARROW_VERSION) && ARROW_VERSION < 1000000
+  return Status::NotImplemented(
+      "Filtering rows requires arrow compute functions (arrow >= 1.0)");
+#else
+  arrow::Datum mask;
+  for (auto const& predicate : predicates) {
+    int index = input->schema()->GetFieldIndex(predicate.column);
+    if (index == -1) {
+      return Status::Invalid("Column '" + predicate.column +
+                             "' in the filter doesn't exist");
+    }
+    auto column = input->column(index);
+    std::shared_ptr<arrow::Scalar> scalar;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        scalar, arrow::Scalar::Parse(column->type(), predicate.value));
+    arrow::Datum matched;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        matched, arrow::compute::CallFunction(
+                     comparison_function(predicate.op), {column, scalar}));
+    if (mask.kind() == arrow::Datum::NONE) {
+      mask = matched;
+    } else {
+      RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          mask, arrow::compute::CallFunction("and", {mask, matched}));
+    }
+  }
+  if (mask.kind() == arrow::Datum::NONE) {
+    out = arrow::Datum(input);
+    return Status::OK();
+  }
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      out, arrow::compute::Filter(arrow::Datum(input), mask));
+  return Status::OK();
+#endif
+}
+
+static Status project_schema(const std::shared_ptr<arrow::Schema>& schema,
+                             const std::vector<std::string>& projection,
+                             std::vector<int>& indices) {
+  indices.clear();
+  if (projection.empty()) {
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      indices.push_back(i);
+    }
+    return Status::OK();
+  }
+  for (auto const& name : projection) {
+    int index = schema->GetFieldIndex(name);
+    if (index == -1) {
+      return Status::Invalid("Column '" + name + "' doesn't exist");
+    }
+    indices.push_back(index);
+  }
+  return Status::OK();
+}
+
+static Status project_table(const std::shared_ptr<arrow::Table>& table,
+                            const std::vector<std::string>& projection,
+                            std::shared_ptr<arrow::Table>& out) {
+  std::vector<int> indices;
+  RETURN_ON_ERROR(project_schema(table->schema(), projection, indices));
+  if (static_cast<int>(indices.size()) == table->num_columns()) {
+    out = table;
+    return Status::OK();
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+  for (int index : indices) {
+    fields.push_back(table->schema()->field(index));
+    columns.push_back(table->column(index));
+  }
+  out = arrow::Table::Make(
+      arrow::schema(fields, table->schema()->metadata()), columns,
+      table->num_rows());
+  return Status::OK();
+}
+
+static Status project_batch(const std::shared_ptr<arrow::RecordBatch>& batch,
+                            const std::vector<std::string>& projection,
+                            std::shared_ptr<arrow::RecordBatch>& out) {
+  std::vector<int> indices;
+  RETURN_ON_ERROR(project_schema(batch->schema(), projection, indices));
+  if (static_cast<int>(indices.size()) == batch->num_columns()) {
+    out = batch;
+    return Status::OK();
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (int index : indices) {
+    fields.push_back(batch->schema()->field(index));
+    columns.push_back(batch->column(index));
+  }
+  out = arrow::RecordBatch::Make(
+      arrow::schema(fields, batch->schema()->metadata()), batch->num_rows(),
+      columns);
+  return Status::OK();
+}
+
+/**
+ * The columns to decode: the projection, plus the columns referenced by the
+ * predicates.
+ */
+static std::vector<std::string> columns_to_read(
+    const ColumnarReadOptions& options) {
+  if (options.columns.empty()) {
+    return options.columns;
+  }
+  std::vector<std::string> columns = options.columns;
+  for (auto const& predicate : options.predicates) {
+    if (std::find(columns.begin(), columns.end(), predicate.column) ==
+        columns.end()) {
+      columns.push_back(predicate.column);
+    }
+  }
+  return columns;
+}
+
+/**
+ * Filter the rows and then drop the columns that only the predicates need.
+ */
+static Status finalize_table(const std::shared_ptr<arrow::Table>& table,
+                             const ColumnarReadOptions& options,
+                             std::shared_ptr<arrow::Table>& out) {
+  std::shared_ptr<arrow::Table> filtered;
+  RETURN_ON_ERROR(FilterTable(table, options.predicates, filtered));
+  return project_table(filtered, options.columns, out);
+}
+
+static Status concatenate_parts(
+    const std::vector<std::shared_ptr<arrow::Table>>& parts,
+    std::shared_ptr<arrow::Table>& table) {
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  for (auto const& part : parts) {
+    if (part != nullptr) {
+      tables.push_back(part);
+    }
+  }
+  if (tables.empty()) {
+    table = nullptr;
+    return Status::OK();
+  }
+  if (tables.size() == 1) {
+    table = tables[0];
+    return Status::OK();
+  }
+  return ConcatenateTables(tables, table);
+}
+
+/**
+ * Split [0, n) into contiguous ranges, and returns the `index`-th range.
+ */
+static std::pair<int64_t, int64_t> partition_range(const int64_t n,
+                                                   const int index,
+                                                   const int total_parts) {
+  return std::make_pair(n * index / total_parts,
+                        n * (index + 1) / total_parts);
+}
+
+class FilteringRecordBatchReader : public arrow::RecordBatchReader {
+ public:
+  FilteringRecordBatchReader(
+      const std::shared_ptr<arrow::RecordBatchReader>& reader,
+      const std::vector<ColumnPredicate>& predicates,
+      const std::vector<std::string>& projection,
+      const std::shared_ptr<arrow::Schema>& schema,
+      const std::shared_ptr<void>& keep_alive)
+      : reader_(reader),
+        predicates_(predicates),
+        projection_(projection),
+        schema_(schema),
+        keep_alive_(keep_alive) {}
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> next;
+      ARROW_RETURN_NOT_OK(reader_->ReadNext(&next));
+      if (next == nullptr) {
+        *batch = nullptr;
+        return arrow::Status::OK();
+      }
+      auto status = apply(next, *batch);
+      if (!status.ok()) {
+        return arrow::Status::Invalid(status.ToString());
+      }
+      if ((*batch)->num_rows() > 0) {
+        return arrow::Status::OK();
+      }
+      // skip batches that are filtered out entirely
+    }
+  }
+
+ private:
+  Status apply(const std::shared_ptr<arrow::RecordBatch>& batch,
+               std::shared_ptr<arrow::RecordBatch>& out) {
+    std::shared_ptr<arrow::RecordBatch> filtered = batch;
+    if (!predicates_.empty()) {
+      arrow::Datum datum;
+      RETURN_ON_ERROR(filter_rows(batch, predicates_, datum));
+      filtered = datum.record_batch();
+    }
+    return project_batch(filtered, projection_, out);
+  }
+
+  std::shared_ptr<arrow::RecordBatchReader> reader_;
+  std::vector<ColumnPredicate> predicates_;
+  std::vector<std::string> projection_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<void> keep_alive_;
+};
+
+}  // namespace detail
+
+Status ParseColumnPredicates(const std::string& filter,
+                             std::vector<ColumnPredicate>& predicates) {
+  std::vector<std::string> items;
+  ::boost::split(items, filter, ::boost::is_any_of(";"));
+  for (auto const& item : items) {
+    if (::boost::algorithm::trim_copy(item).empty()) {
+      continue;
+    }
+    // the operator starts at the first operator character, and the longest
+    // operator there wins, e.g., "a<=1" is "<=" rather than "<"
+    size_t pos = item.find_first_of("=!<>"), oplen = 0;
+    if (pos != std::string::npos) {
+      for (const char* op : {"==", "!=", "<=", ">=", "<", ">"}) {
+        if (item.compare(pos, strlen(op), op) == 0) {
+          oplen = strlen(op);
+          break;
+        }
+      }
+    }
+    if (pos == std::string::npos || pos == 0 || oplen == 0) {
+      return Status::Invalid("Invalid filter predicate: '" + item + "'");
+    }
+    ColumnPredicate predicate;
+    predicate.column = ::boost::algorithm::trim_copy(item.substr(0, pos));
+    predicate.op = item.substr(pos, oplen);
+    predicate.value = ::boost::algorithm::trim_copy(item.substr(pos + oplen));
+    predicates.emplace_back(std::move(predicate));
+  }
+  return Status::OK();
+}
+
+Status FilterTable(const std::shared_ptr<arrow::Table>& table,
+                   const std::vector<ColumnPredicate>& predicates,
+                   std::shared_ptr<arrow::Table>& out) {
+  if (table == nullptr || predicates.empty()) {
+    out = table;
+    return Status::OK();
+  }
+  arrow::Datum datum;
+  RETURN_ON_ERROR(detail::filter_rows(table, predicates, datum));
+  out = datum.table();
+  return Status::OK();
+}
+
+Status MakeFilteringRecordBatchReader(
+    const std::shared_ptr<arrow::RecordBatchReader>& reader,
+    const std::vector<ColumnPredicate>& predicates,
+    const std::vector<std::string>& projection,
+    const std::shared_ptr<void>& keep_alive,
+    std::shared_ptr<arrow::RecordBatchReader>& out) {
+  std::vector<int> indices;
+  RETURN_ON_ERROR(
+      detail::project_schema(reader->schema(), projection, indices));
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  for (int index : indices) {
+    fields.push_back(reader->schema()->field(index));
+  }
+  auto schema = arrow::schema(fields, reader->schema()->metadata());
+  out = std::make_shared<detail::FilteringRecordBatchReader>(
+      reader, predicates, projection, schema, keep_alive);
+  return Status::OK();
+}
+
+#if defined(WITH_PARQUET)
+
+namespace detail {
+
+static Status open_parquet_reader(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const bool use_threads, std::unique_ptr<parquet::arrow::FileReader>& out) {
+  parquet::arrow::FileReaderBuilder builder;
+  RETURN_ON_ARROW_ERROR(builder.Open(file));
+  parquet::ArrowReaderProperties properties;
+  properties.set_use_threads(use_threads);
+  RETURN_ON_ARROW_ERROR(builder.memory_pool(arrow::default_memory_pool())
+                            ->properties(properties)
+                            ->Build(&out));
+  return Status::OK();
+}
+
+/**
+ * Parse the literal of the predicate in the physical type of the column,
+ * returns false if the literal cannot be represented in that type.
+ */
+static bool parse_predicate_value(const std::string& literal, int64_t& value) {
+  size_t consumed = 0;
+  try {
+    value = std::stoll(literal, &consumed);
+  } catch (std::exception const&) {
+    return false;
+  }
+  return consumed == literal.size();
+}
+
+static bool parse_predicate_value(const std::string& literal, int32_t& value) {
+  int64_t parsed = 0;
+  if (!parse_predicate_value(literal, parsed) ||
+      parsed < std::numeric_limits<int32_t>::min() ||
+      parsed > std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  value = static_cast<int32_t>(parsed);
+  return true;
+}
+
+static bool parse_predicate_value(const std::string& literal, double& value) {
+  size_t consumed = 0;
+  try {
+    value = std::stod(literal, &consumed);
+  } catch (std::exception const&) {
+    return false;
+  }
+  return consumed == literal.size();
+}
+
+static bool parse_predicate_value(const std::string& literal, float& value) {
+  double parsed = 0;
+  if (!parse_predicate_value(literal, parsed)) {
+    return false;
+  }
+  value = static_cast<float>(parsed);
+  return true;
+}
+
+/**
+ * Compare the predicate against the min/max statistics in the physical type
+ * of the column.
+ */
+template <typename StatisticsType>
+static bool statistics_may_match(
+    const std::shared_ptr<parquet::Statistics>& stats,
+    const ColumnPredicate& predicate) {
+  using T = typename StatisticsType::T;
+  auto typed = std::static_pointer_cast<StatisticsType>(stats);
+  const T min = typed->min(), max = typed->max();
+  T value;
+  if (!parse_predicate_value(predicate.value, value)) {
+    return true;
+  }
+  if (predicate.op == "==") {
+    return min <= value && value <= max;
+  } else if (predicate.op == "!=") {
+    return !(min == value && max == value);
+  } else if (predicate.op == "<") {
+    return min < value;
+  } else if (predicate.op == "<=") {
+    return min <= value;
+  } else if (predicate.op == ">") {
+    return max > value;
+  } else if (predicate.op == ">=") {
+    return max >= value;
+  }
+  return true;
+}
+
+/**
+ * Whether the row group may contain rows that satisfy the predicate, based
+ * on the min/max statistics of signed integral and floating point columns.
+ */
+static bool row_group_may_match(const parquet::RowGroupMetaData& row_group,
+                                const int column, const arrow::DataType& type,
+                                const ColumnPredicate& predicate) {
+  switch (type.id()) {
+  case arrow::Type::INT8:
+  case arrow::Type::INT16:
+  case arrow::Type::INT32:
+  case arrow::Type::INT64:
+  case arrow::Type::FLOAT:
+  case arrow::Type::DOUBLE:
+    break;
+  default:
+    return true;
+  }
+  auto chunk = row_group.ColumnChunk(column);
+  if (!chunk->is_stats_set()) {
+    return true;
+  }
+  auto stats = chunk->statistics();
+  if (stats == nullptr || !stats->HasMinMax()) {
+    return true;
+  }
+  switch (stats->physical_type()) {
+  case parquet::Type::INT32:
+    return statistics_may_match<parquet::Int32Statistics>(stats, predicate);
+  case parquet::Type::INT64:
+    return statistics_may_match<parquet::Int64Statistics>(stats, predicate);
+  case parquet::Type::FLOAT:
+    return statistics_may_match<parquet::FloatStatistics>(stats, predicate);
+  case parquet::Type::DOUBLE:
+    return statistics_may_match<parquet::DoubleStatistics>(stats, predicate);
+  default:
+    return true;
+  }
+}
+
+/**
+ * Resolve the leaf column indices to decode, and the row groups of the
+ * current part that survive the statistics-based pruning.
+ */
+static Status plan_parquet_read(parquet::arrow::FileReader* reader,
+                                const ColumnarReadOptions& options,
+                                std::vector<int>& column_indices,
+                                std::vector<int>& row_groups) {
+  auto metadata = reader->parquet_reader()->metadata();
+  std::shared_ptr<arrow::Schema> schema;
+  RETURN_ON_ARROW_ERROR(reader->GetSchema(&schema));
+
+  for (auto const& name : columns_to_read(options)) {
+    int index = metadata->schema()->ColumnIndex(name);
+    if (index == -1) {
+      return Status::Invalid("Column '" + name +
+                             "' doesn't exist in the parquet file");
+    }
+    column_indices.push_back(index);
+  }
+
+  auto range =
+      partition_range(metadata->num_row_groups(), options.index,
+                      options.total_parts);
+  for (int64_t rg = range.first; rg < range.second; ++rg) {
+    auto row_group = metadata->RowGroup(static_cast<int>(rg));
+    bool matched = true;
+    for (auto const& predicate : options.predicates) {
+      int column = metadata->schema()->ColumnIndex(predicate.column);
+      int field = schema->GetFieldIndex(predicate.column);
+      if (column == -1 || field == -1) {
+        return Status::Invalid("Column '" + predicate.column +
+                               "' in the filter doesn't exist");
+      }
+      if (!row_group_may_match(*row_group, column,
+                               *schema->field(field)->type(), predicate)) {
+        matched = false;
+        break;
+      }
+    }
+    if (matched) {
+      row_groups.push_back(static_cast<int>(rg));
+    } else {
+      VLOG(2) << "Skip row group " << rg << " by the statistics";
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace detail
+
+Status ReadParquetTable(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options, std::shared_ptr<arrow::Table>& table) {
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  RETURN_ON_ERROR(detail::open_parquet_reader(file, true, reader));
+  std::vector<int> column_indices, row_groups;
+  RETURN_ON_ERROR(
+      detail::plan_parquet_read(reader.get(), options, column_indices,
+                                row_groups));
+  if (row_groups.empty()) {
+    table = nullptr;
+    return Status::OK();
+  }
+
+  // row groups are decoded in parallel by independent readers (positional
+  // reads on the file are thread-safe); a single task decodes its columns
+  // in parallel instead.
+  size_t concurrency = options.concurrency;
+  if (concurrency == 0) {
+    concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  size_t ntasks = std::min(row_groups.size(), concurrency);
+  std::vector<std::shared_ptr<arrow::Table>> parts(ntasks);
+  RETURN_ON_ERROR(parallel_for_status(
+      ntasks, ntasks, [&](size_t task) -> Status {
+        auto range = detail::partition_range(row_groups.size(), task, ntasks);
+        std::vector<int> task_row_groups(row_groups.begin() + range.first,
+                                         row_groups.begin() + range.second);
+        std::unique_ptr<parquet::arrow::FileReader> task_reader;
+        RETURN_ON_ERROR(
+            detail::open_parquet_reader(file, ntasks == 1, task_reader));
+        std::shared_ptr<arrow::Table> part;
+        if (column_indices.empty()) {
+          RETURN_ON_ARROW_ERROR(task_reader->ReadRowGroups(task_row_groups,
+                                                           &part));
+        } else {
+          RETURN_ON_ARROW_ERROR(task_reader->ReadRowGroups(
+              task_row_groups, column_indices, &part));
+        }
+        return detail::finalize_table(part, options, parts[task]);
+      }));
+  return detail::concatenate_parts(parts, table);
+}
+
+Status ReadParquetRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader) {
+  std::unique_ptr<parquet::arrow::FileReader> file_reader;
+  RETURN_ON_ERROR(detail::open_parquet_reader(file, true, file_reader));
+  std::vector<int> column_indices, row_groups;
+  RETURN_ON_ERROR(detail::plan_parquet_read(file_reader.get(), options,
+                                            column_indices, row_groups));
+  std::unique_ptr<arrow::RecordBatchReader> batch_reader;
+  if (column_indices.empty()) {
+    RETURN_ON_ARROW_ERROR(
+        file_reader->GetRecordBatchReader(row_groups, &batch_reader));
+  } else {
+    RETURN_ON_ARROW_ERROR(file_reader->GetRecordBatchReader(
+        row_groups, column_indices, &batch_reader));
+  }
+  // the batch reader refers to the file reader
+  std::shared_ptr<parquet::arrow::FileReader> keep_alive =
+      std::move(file_reader);
+  return MakeFilteringRecordBatchReader(std::move(batch_reader),
+                                        options.predicates, options.columns,
+                                        keep_alive, reader);
+}
+
+#else
+
+Status ReadParquetTable(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options, std::shared_ptr<arrow::Table>& table) {
+  return Status::NotImplemented(
+      "Reading parquet files requires building with "
+      "-DBUILD_VINEYARD_IO_PARQUET=ON");
+}
+
+Status ReadParquetRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader) {
+  return Status::NotImplemented(
+      "Reading parquet files requires building with "
+      "-DBUILD_VINEYARD_IO_PARQUET=ON");
+}
+
+#endif  // WITH_PARQUET
+
+#if defined(WITH_ORC)
+
+namespace detail {
+
+static Status open_orc_reader(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    std::unique_ptr<arrow::adapters::orc::ORCFileReader>& reader,
+    std::shared_ptr<arrow::Schema>& schema) {
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 6000000
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      reader, arrow::adapters::orc::ORCFileReader::Open(
+                  file, arrow::default_memory_pool()));
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(schema, reader->ReadSchema());
+#else
+  RETURN_ON_ARROW_ERROR(arrow::adapters::orc::ORCFileReader::Open(
+      file, arrow::default_memory_pool(), &reader));
+  RETURN_ON_ARROW_ERROR(reader->ReadSchema(&schema));
+#endif
+  return Status::OK();
+}
+
+static Status read_orc_stripe(arrow::adapters::orc::ORCFileReader* reader,
+                              const int64_t stripe,
+                              const std::vector<int>& include_indices,
+                              std::shared_ptr<arrow::RecordBatch>& batch) {
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 6000000
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(batch,
+                                   reader->ReadStripe(stripe, include_indices));
+#else
+  RETURN_ON_ARROW_ERROR(reader->ReadStripe(stripe, include_indices, &batch));
+#endif
+  return Status::OK();
+}
+
+/**
+ * Reads the stripes of a range one by one.
+ */
+class ORCStripeReader : public arrow::RecordBatchReader {
+ public:
+  ORCStripeReader(std::unique_ptr<arrow::adapters::orc::ORCFileReader> reader,
+                  const std::shared_ptr<arrow::Schema>& schema,
+                  const std::vector<int>& include_indices, const int64_t begin,
+                  const int64_t end)
+      : reader_(std::move(reader)),
+        schema_(schema),
+        include_indices_(include_indices),
+        next_(begin),
+        end_(end) {}
+
+  std::shared_ptr<arrow::Schema> schema() const override { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+    if (next_ >= end_) {
+      *batch = nullptr;
+      return arrow::Status::OK();
+    }
+    auto status =
+        read_orc_stripe(reader_.get(), next_++, include_indices_, *batch);
+    if (!status.ok()) {
+      return arrow::Status::IOError(status.ToString());
+    }
+    return arrow::Status::OK();
+  }
+
+ private:
+  std::unique_ptr<arrow::adapters::orc::ORCFileReader> reader_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<int> include_indices_;
+  int64_t next_, end_;
+};
+
+static Status orc_include_indices(const std::shared_ptr<arrow::Schema>& schema,
+                                  const ColumnarReadOptions& options,
+                                  std::vector<int>& include_indices,
+                                  std::shared_ptr<arrow::Schema>& projected) {
+  auto columns = columns_to_read(options);
+  if (columns.empty()) {
+    for (int i = 0; i < schema->num_fields(); ++i) {
+      include_indices.push_back(i);
+    }
+    projected = schema;
+    return Status::OK();
+  }
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  for (auto const& name : columns) {
+    int index = schema->GetFieldIndex(name);
+    if (index == -1) {
+      return Status::Invalid("Column '" + name +
+                             "' doesn't exist in the orc file");
+    }
+    include_indices.push_back(index);
+  }
+  // the stripes are returned with columns in the order of the file schema
+  std::sort(include_indices.begin(), include_indices.end());
+  for (int index : include_indices) {
+    fields.push_back(schema->field(index));
+  }
+  projected = arrow::schema(fields, schema->metadata());
+  return Status::OK();
+}
+
+}  // namespace detail
+
+Status ReadORCTable(const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                    const ColumnarReadOptions& options,
+                    std::shared_ptr<arrow::Table>& table) {
+  std::unique_ptr<arrow::adapters::orc::ORCFileReader> reader;
+  std::shared_ptr<arrow::Schema> schema, projected;
+  RETURN_ON_ERROR(detail::open_orc_reader(file, reader, schema));
+  std::vector<int> include_indices;
+  RETURN_ON_ERROR(
+      detail::orc_include_indices(schema, options, include_indices, projected));
+  auto range = detail::partition_range(reader->NumberOfStripes(),
+                                       options.index, options.total_parts);
+  if (range.first >= range.second) {
+    table = nullptr;
+    return Status::OK();
+  }
+
+  // stripes are decoded in parallel, by independent readers
+  size_t nstripes = static_cast<size_t>(range.second - range.first);
+  std::vector<std::shared_ptr<arrow::Table>> parts(nstripes);
+  RETURN_ON_ERROR(parallel_for_status(
+      nstripes, options.concurrency, [&](size_t index) -> Status {
+        std::unique_ptr<arrow::adapters::orc::ORCFileReader> stripe_reader;
+        std::shared_ptr<arrow::Schema> stripe_schema;
+        RETURN_ON_ERROR(
+            detail::open_orc_reader(file, stripe_reader, stripe_schema));
+        std::shared_ptr<arrow::RecordBatch> batch;
+        RETURN_ON_ERROR(detail::read_orc_stripe(
+            stripe_reader.get(), range.first + index, include_indices, batch));
+        std::shared_ptr<arrow::Table> part;
+        RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+            part, arrow::Table::FromRecordBatches({batch}));
+        return detail::finalize_table(part, options, parts[index]);
+      }));
+  return detail::concatenate_parts(parts, table);
+}
+
+Status ReadORCRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader) {
+  std::unique_ptr<arrow::adapters::orc::ORCFileReader> orc_reader;
+  std::shared_ptr<arrow::Schema> schema, projected;
+  RETURN_ON_ERROR(detail::open_orc_reader(file, orc_reader, schema));
+  std::vector<int> include_indices;
+  RETURN_ON_ERROR(
+      detail::orc_include_indices(schema, options, include_indices, projected));
+  auto range = detail::partition_range(orc_reader->NumberOfStripes(),
+                                       options.index, options.total_parts);
+  auto stripe_reader = std::make_shared<detail::ORCStripeReader>(
+      std::move(orc_reader), projected, include_indices, range.first,
+      range.second);
+  return MakeFilteringRecordBatchReader(stripe_reader, options.predicates,
+                                        options.columns, nullptr, reader);
+}
+
+#else
+
+Status ReadORCTable(const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                    const ColumnarReadOptions& options,
+                    std::shared_ptr<arrow::Table>& table) {
+  return Status::NotImplemented(
+      "Reading orc files requires an arrow installation with ORC enabled");
+}
+
+Status ReadORCRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader) {
+  return Status::NotImplemented(
+      "Reading orc files requires an arrow installation with ORC enabled");
+}
+
+#endif  // WITH_ORC
+
+}  // namespace vineyard
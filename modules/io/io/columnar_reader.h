@@ -0,0 +1,104 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_IO_IO_COLUMNAR_READER_H_
+#define MODULES_IO_IO_COLUMNAR_READER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * @brief A simple comparison between a column and a literal, e.g.,
+ * "weight>=0.5", used for predicate pushdown.
+ */
+struct ColumnPredicate {
+  std::string column;
+  std::string op;  // one of "==", "!=", "<", "<=", ">", ">="
+  std::string value;
+};
+
+/**
+ * @brief Parse the conjunction of predicates separated by ';', e.g.,
+ * "weight>=0.5;label==person".
+ */
+Status ParseColumnPredicates(const std::string& filter,
+                             std::vector<ColumnPredicate>& predicates);
+
+/**
+ * @brief Keeps the rows that satisfy all predicates.
+ */
+Status FilterTable(const std::shared_ptr<arrow::Table>& table,
+                   const std::vector<ColumnPredicate>& predicates,
+                   std::shared_ptr<arrow::Table>& out);
+
+/**
+ * @brief Wraps a record batch reader to filter rows with the given predicates
+ * and then drop the columns that are not in the projection.
+ *
+ * @param keep_alive Objects that the underlying reader depends on, e.g., the
+ *                   file reader.
+ */
+Status MakeFilteringRecordBatchReader(
+    const std::shared_ptr<arrow::RecordBatchReader>& reader,
+    const std::vector<ColumnPredicate>& predicates,
+    const std::vector<std::string>& projection,
+    const std::shared_ptr<void>& keep_alive,
+    std::shared_ptr<arrow::RecordBatchReader>& out);
+
+/**
+ * @brief Options of reading columnar files (Parquet and ORC).
+ *
+ * Row groups (Parquet) or stripes (ORC) are assigned to the `index`-th of
+ * `total_parts` parts as contiguous ranges, and only the `columns` are
+ * decoded (all columns when empty). Row groups whose statistics show that
+ * no rows could satisfy the predicates are skipped without being read.
+ */
+struct ColumnarReadOptions {
+  std::vector<std::string> columns;
+  std::vector<ColumnPredicate> predicates;
+  int index = 0;
+  int total_parts = 1;
+  size_t concurrency = 0;  // 0 means the number of hardware threads
+};
+
+Status ReadParquetTable(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options, std::shared_ptr<arrow::Table>& table);
+
+Status ReadParquetRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader);
+
+Status ReadORCTable(const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+                    const ColumnarReadOptions& options,
+                    std::shared_ptr<arrow::Table>& table);
+
+Status ReadORCRecordBatches(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file,
+    const ColumnarReadOptions& options,
+    std::shared_ptr<arrow::RecordBatchReader>& reader);
+
+}  // namespace vineyard
+
+#endif  // MODULES_IO_IO_COLUMNAR_READER_H_
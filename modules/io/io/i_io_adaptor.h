@@ -80,6 +80,15 @@ class IIOAdaptor {
     return Status::OK();
   }
 
+  /**
+   * Read the (partial) content as a stream of record batches, rather than
+   * materializing the whole table in memory.
+   */
+  virtual Status ReadRecordBatches(
+      std::shared_ptr<arrow::RecordBatchReader>* reader) {
+    return Status::NotImplemented("Reading as record batches is not supported");
+  }
+
   virtual Status WriteTable(std::shared_ptr<arrow::Table> table) {
     return Status::OK();
   }
@@ -20,9 +20,13 @@ limitations under the License.
 #include <sys/types.h>
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "arrow/api.h"
@@ -34,8 +38,147 @@ limitations under the License.
 
 #include "basic/ds/arrow_utils.h"
 #include "common/util/logging.h"
+#include "common/util/parallel.h"
+#include "io/io/columnar_reader.h"
 
 namespace vineyard {
+
+namespace detail {
+
+// read-ahead window size of `ReadLine()`
+static constexpr int64_t kReadAheadSize = 1024 * 1024;
+
+// block size when scanning for the nearest line break
+static constexpr int64_t kLineBreakScanSize = 64 * 1024;
+
+// granularity of concurrent positional reads, aligned to page size
+static constexpr int64_t kParallelReadChunkSize = 8 * 1024 * 1024;
+
+/**
+ * @brief An input stream over a byte range of a file that keeps a bounded
+ * window of chunks being read concurrently ahead of the consumer, e.g., the
+ * csv reader, using positional reads.
+ *
+ * The boundaries of chunks are aligned to the chunk size in the file, and at
+ * most `window` chunks are in flight or buffered at any time.
+ */
+class ReadAheadInputStream : public arrow::io::InputStream {
+ public:
+  ReadAheadInputStream(std::shared_ptr<arrow::io::RandomAccessFile> file,
+                       const int64_t offset, const int64_t nbytes,
+                       const int64_t chunk_size, const size_t window)
+      : file_(file),
+        position_(offset),
+        issued_(offset),
+        end_(offset + nbytes),
+        chunk_size_(chunk_size),
+        window_(std::max(window, static_cast<size_t>(1))) {
+    fill();
+  }
+
+  ~ReadAheadInputStream() override { VINEYARD_DISCARD(Close()); }
+
+  arrow::Status Close() override {
+    // wait for the in-flight reads, as they reference the file
+    for (auto& chunk : inflight_) {
+      chunk.wait();
+    }
+    inflight_.clear();
+    current_ = nullptr;
+    closed_ = true;
+    return arrow::Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  arrow::Result<int64_t> Tell() const override { return position_; }
+
+  arrow::Result<int64_t> Read(int64_t nbytes, void* out) override {
+    uint8_t* target = static_cast<uint8_t*>(out);
+    int64_t nread = 0;
+    while (nread < nbytes) {
+      ARROW_RETURN_NOT_OK(advance());
+      if (current_ == nullptr) {
+        break;  // end of range
+      }
+      int64_t size = std::min(nbytes - nread, current_->size() - current_pos_);
+      memcpy(target + nread, current_->data() + current_pos_, size);
+      current_pos_ += size;
+      position_ += size;
+      nread += size;
+    }
+    return nread;
+  }
+
+  arrow::Result<std::shared_ptr<arrow::Buffer>> Read(int64_t nbytes) override {
+    ARROW_RETURN_NOT_OK(advance());
+    if (current_ != nullptr && current_->size() - current_pos_ >= nbytes) {
+      // served by the current chunk without copying
+      auto buffer = arrow::SliceBuffer(current_, current_pos_, nbytes);
+      current_pos_ += nbytes;
+      position_ += nbytes;
+      return buffer;
+    }
+    nbytes = std::min(nbytes, end_ - position_);
+    std::shared_ptr<arrow::ResizableBuffer> buffer;
+    ARROW_ASSIGN_OR_RAISE(buffer, arrow::AllocateResizableBuffer(nbytes));
+    int64_t nread = 0;
+    ARROW_ASSIGN_OR_RAISE(nread, Read(nbytes, buffer->mutable_data()));
+    if (nread < nbytes) {
+      ARROW_RETURN_NOT_OK(buffer->Resize(nread));
+    }
+    return std::static_pointer_cast<arrow::Buffer>(buffer);
+  }
+
+ private:
+  // issue the reads of the next chunks until the window is full
+  void fill() {
+    while (issued_ < end_ && inflight_.size() < window_) {
+      int64_t begin = issued_;
+      int64_t end = std::min(end_, (begin / chunk_size_ + 1) * chunk_size_);
+      auto file = file_;
+      inflight_.emplace_back(
+          std::async(std::launch::async, [file, begin, end]() {
+            return file->ReadAt(begin, end - begin);
+          }));
+      issued_ = end;
+    }
+  }
+
+  // make sure the current chunk has unread bytes, unless reaching the end
+  arrow::Status advance() {
+    while (current_ == nullptr || current_pos_ >= current_->size()) {
+      current_ = nullptr;
+      current_pos_ = 0;
+      if (inflight_.empty()) {
+        return arrow::Status::OK();
+      }
+      auto chunk = inflight_.front().get();
+      inflight_.pop_front();
+      fill();
+      ARROW_RETURN_NOT_OK(chunk.status());
+      current_ = chunk.ValueOrDie();
+      if (current_->size() == 0) {
+        return arrow::Status::IOError("Unexpected end of file");
+      }
+    }
+    return arrow::Status::OK();
+  }
+
+  std::shared_ptr<arrow::io::RandomAccessFile> file_;
+  int64_t position_, issued_, end_;
+  const int64_t chunk_size_;
+  const size_t window_;
+  bool closed_ = false;
+
+  std::deque<std::future<arrow::Result<std::shared_ptr<arrow::Buffer>>>>
+      inflight_;
+  std::shared_ptr<arrow::Buffer> current_;
+  int64_t current_pos_ = 0;
+};
+
+}  // namespace detail
+
 LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
     : location_(location),
       header_row_(false),
@@ -88,6 +231,22 @@ LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
         meta_.emplace("block_size", kv_pair[1]);
       } else if (kv_pair[0] == "consolidate") {
         meta_.emplace("consolidate", kv_pair[1]);
+      } else if (kv_pair[0] == "format" && kv_pair.size() > 1) {
+        format_ = boost::algorithm::to_lower_copy(kv_pair[1]);
+        meta_.emplace("format", format_);
+      } else if (kv_pair[0] == "filter" && kv_pair.size() > 1) {
+        // the predicates contain '=' as well
+        std::string filter = iter.substr(iter.find('=') + 1);
+        auto status = ParseColumnPredicates(filter, predicates_);
+        if (!status.ok()) {
+          LOG(ERROR) << "Invalid filter in location: " << status.ToString();
+        }
+        meta_.emplace("filter", filter);
+      } else if (kv_pair[0] == "io_concurrency" ||
+                 kv_pair[0] == "parallel_read") {
+        if (kv_pair.size() > 1) {
+          VINEYARD_DISCARD(Configure(kv_pair[0], kv_pair[1]));
+        }
       } else if (kv_pair.size() > 1) {
         meta_.emplace(kv_pair[0], kv_pair[1]);
       }
@@ -96,6 +255,14 @@ LocalIOAdaptor::LocalIOAdaptor(const std::string& location)
 
   // process locations
   location_ = location_.substr(0, arg_pos);
+  if (meta_.find("format") == meta_.end()) {
+    auto lowered = boost::algorithm::to_lower_copy(location_);
+    if (boost::algorithm::ends_with(lowered, ".parquet")) {
+      format_ = "parquet";
+    } else if (boost::algorithm::ends_with(lowered, ".orc")) {
+      format_ = "orc";
+    }
+  }
   size_t i = 0;
   for (i = 0; i < location_.size(); ++i) {
     if (location_[i] < 0 || location_[i] > 127) {
@@ -163,6 +330,13 @@ Status LocalIOAdaptor::Open(const char* mode) {
   } else {
     RETURN_ON_ARROW_ERROR_AND_ASSIGN(ifp_, fs_->OpenInputFile(location_));
 
+    if (format_ == "parquet" || format_ == "orc") {
+      // row groups (stripes) are partitioned when reading
+      return Status::OK();
+    } else if (format_ != "csv") {
+      return Status::NotImplemented("Unsupported file format: " + format_);
+    }
+
     // check the partial read flag
     if (enable_partial_read_) {
       RETURN_ON_ERROR(setPartialReadImpl());
@@ -179,6 +353,15 @@ Status LocalIOAdaptor::Open(const char* mode) {
 
 Status LocalIOAdaptor::Configure(const std::string& key,
                                  const std::string& value) {
+  if (key == "io_concurrency") {
+    try {
+      io_concurrency_ = static_cast<size_t>(std::max(0, std::stoi(value)));
+    } catch (std::exception const&) {
+      return Status::Invalid("Invalid value for 'io_concurrency': " + value);
+    }
+  } else if (key == "parallel_read") {
+    parallel_read_ = (boost::algorithm::to_lower_copy(value) != "false");
+  }
   return Status::OK();
 }
 
@@ -207,6 +390,11 @@ Status LocalIOAdaptor::GetPartialReadDetail(int64_t& offset, int64_t& nbytes) {
                   "set partial read first.";
     return Status::IOError();
   }
+  if (format_ != "csv") {
+    return Status::NotImplemented(
+        "Partial read of " + format_ +
+        " files is based on row groups rather than byte ranges");
+  }
   offset = partial_read_offset_[index_];
   nbytes = partial_read_offset_[index_ + 1] - partial_read_offset_[index_];
 
@@ -256,19 +444,23 @@ Status LocalIOAdaptor::setPartialReadImpl() {
   partial_read_offset_[0] = start_pos;
   partial_read_offset_[total_parts_] = total_file_size;
 
-  // move breakpoint to the next of nearest character '\n'
+  // move breakpoint to the next of nearest character '\n', the line breaks
+  // are located concurrently using positional reads
+  std::vector<int64_t> breakpoints(total_parts_ + 1, total_file_size);
+  RETURN_ON_ERROR(parallel_for_status(
+      total_parts_ - 1, io_concurrency_, [&](size_t part) -> Status {
+        int64_t offset = (part + 1) * part_size + start_pos;
+        breakpoints[part + 1] = std::min(
+            offset + getDistanceToLineBreak(offset) + 1, total_file_size);
+        return Status::OK();
+      }));
   for (int i = 1; i < total_parts_; ++i) {
-    partial_read_offset_[i] = i * part_size + start_pos;
-
-    if (partial_read_offset_[i] < partial_read_offset_[i - 1]) {
+    int64_t offset = i * part_size + start_pos;
+    if (offset < partial_read_offset_[i - 1]) {
+      // the previous line spans over this breakpoint
       partial_read_offset_[i] = partial_read_offset_[i - 1];
     } else {
-      // traversing backwards to find the nearest character '\n',
-      int64_t dis = getDistanceToLineBreak(i);
-      partial_read_offset_[i] += (dis + 1);
-      if (partial_read_offset_[i] > total_file_size) {
-        partial_read_offset_[i] = total_file_size;
-      }
+      partial_read_offset_[i] = breakpoints[i];
     }
   }
 
@@ -309,24 +501,150 @@ Status LocalIOAdaptor::ReadPartialTable(std::shared_ptr<arrow::Table>* table,
     return Status::IOError("The file hasn't been opened in read mode: " +
                            location_);
   }
+  if (format_ != "csv") {
+    std::shared_ptr<arrow::Table> result;
+    if (format_ == "parquet") {
+      RETURN_ON_ERROR(
+          ReadParquetTable(ifp_, columnarReadOptions(index), result));
+    } else {
+      RETURN_ON_ERROR(ReadORCTable(ifp_, columnarReadOptions(index), result));
+    }
+    *table = result;
+    return Status::OK();
+  }
+
+  std::shared_ptr<arrow::io::InputStream> input;
+  RETURN_ON_ERROR(openPartialInput(index, input));
+
+  arrow::MemoryPool* pool = arrow::default_memory_pool();
+
+  auto read_options = arrow::csv::ReadOptions::Defaults();
+  auto parse_options = arrow::csv::ParseOptions::Defaults();
+  auto convert_options = arrow::csv::ConvertOptions::Defaults();
+  RETURN_ON_ERROR(
+      makeCSVOptions(read_options, parse_options, convert_options));
+
+  std::shared_ptr<arrow::csv::TableReader> reader;
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      reader, arrow::csv::TableReader::Make(arrow::io::IOContext(pool), input,
+                                            read_options, parse_options,
+                                            convert_options));
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      reader, arrow::csv::TableReader::Make(pool, input, read_options,
+                                            parse_options, convert_options));
+#endif
+
+  auto result = reader->Read();
+  if (!result.status().ok()) {
+    if (result.status().message() == "Empty CSV file") {
+      *table = nullptr;
+      return Status::OK();
+    } else {
+      return Status::ArrowError(result.status());
+    }
+  }
+  *table = result.ValueOrDie();
+
+  RETURN_ON_ARROW_ERROR((*table)->Validate());
+  RETURN_ON_ERROR(FilterTable(*table, predicates_, *table));
+
+  VLOG(2) << "[file-" << location_ << "] contains: " << (*table)->num_rows()
+          << " rows, " << (*table)->num_columns() << " columns";
+  VLOG(2) << (*table)->schema()->ToString();
+  return Status::OK();
+}
+
+Status LocalIOAdaptor::ReadRecordBatches(
+    std::shared_ptr<arrow::RecordBatchReader>* reader) {
+  if (ifp_ == nullptr) {
+    return Status::IOError("The file hasn't been opened in read mode: " +
+                           location_);
+  }
+  std::shared_ptr<arrow::RecordBatchReader> result;
+  if (format_ == "parquet") {
+    RETURN_ON_ERROR(
+        ReadParquetRecordBatches(ifp_, columnarReadOptions(index_), result));
+  } else if (format_ == "orc") {
+    RETURN_ON_ERROR(
+        ReadORCRecordBatches(ifp_, columnarReadOptions(index_), result));
+  } else {
+    std::shared_ptr<arrow::io::InputStream> input;
+    RETURN_ON_ERROR(openPartialInput(index_, input));
+
+    auto read_options = arrow::csv::ReadOptions::Defaults();
+    auto parse_options = arrow::csv::ParseOptions::Defaults();
+    auto convert_options = arrow::csv::ConvertOptions::Defaults();
+    RETURN_ON_ERROR(
+        makeCSVOptions(read_options, parse_options, convert_options));
+
+    std::shared_ptr<arrow::csv::StreamingReader> csv_reader;
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        csv_reader, arrow::csv::StreamingReader::Make(
+                        arrow::io::IOContext(arrow::default_memory_pool()),
+                        input, read_options, parse_options, convert_options));
+#else
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        csv_reader, arrow::csv::StreamingReader::Make(
+                        arrow::default_memory_pool(), input, read_options,
+                        parse_options, convert_options));
+#endif
+    result = csv_reader;
+    if (!predicates_.empty()) {
+      RETURN_ON_ERROR(MakeFilteringRecordBatchReader(
+          csv_reader, predicates_, {}, nullptr, result));
+    }
+  }
+  *reader = result;
+  return Status::OK();
+}
+
+Status LocalIOAdaptor::openPartialInput(
+    const int index, std::shared_ptr<arrow::io::InputStream>& input) {
   int64_t offset = partial_read_offset_[index];
   int64_t nbytes =
       partial_read_offset_[index + 1] - partial_read_offset_[index];
+  if (parallel_read_ && nbytes > detail::kParallelReadChunkSize) {
+    // keep a bounded window of chunks being read concurrently ahead of the
+    // csv reader, rather than the blocking sequential reads it issues block
+    // by block
+    size_t window = io_concurrency_;
+    if (window == 0) {
+      window = std::thread::hardware_concurrency();
+    }
+    input = std::make_shared<detail::ReadAheadInputStream>(
+        ifp_, offset, nbytes, detail::kParallelReadChunkSize, window);
+    return Status::OK();
+  }
 #if defined(ARROW_VERSION) && ARROW_VERSION <= 9000000
-  std::shared_ptr<arrow::io::InputStream> input =
-      arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes);
+  input = arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes);
 #else
-  std::shared_ptr<arrow::io::InputStream> input;
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
       input, arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes));
 #endif
+  return Status::OK();
+}
 
-  arrow::MemoryPool* pool = arrow::default_memory_pool();
-
-  auto read_options = arrow::csv::ReadOptions::Defaults();
-  auto parse_options = arrow::csv::ParseOptions::Defaults();
-  auto convert_options = arrow::csv::ConvertOptions::Defaults();
+ColumnarReadOptions LocalIOAdaptor::columnarReadOptions(const int index) const {
+  ColumnarReadOptions options;
+  if (!include_all_columns_) {
+    options.columns = columns_;
+  }
+  options.predicates = predicates_;
+  if (enable_partial_read_) {
+    options.index = index;
+    options.total_parts = total_parts_;
+  }
+  options.concurrency = io_concurrency_;
+  return options;
+}
 
+Status LocalIOAdaptor::makeCSVOptions(
+    arrow::csv::ReadOptions& read_options,
+    arrow::csv::ParseOptions& parse_options,
+    arrow::csv::ConvertOptions& convert_options) {
   // enable parallelism
   read_options.use_threads = true;
 
@@ -390,55 +708,25 @@ Status LocalIOAdaptor::ReadPartialTable(std::shared_ptr<arrow::Table>* table,
   convert_options.column_types = column_types;
 
   parse_options.delimiter = delimiter_;
-
-  std::shared_ptr<arrow::csv::TableReader> reader;
-#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      reader, arrow::csv::TableReader::Make(arrow::io::IOContext(pool), input,
-                                            read_options, parse_options,
-                                            convert_options));
-#else
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      reader, arrow::csv::TableReader::Make(pool, input, read_options,
-                                            parse_options, convert_options));
-#endif
-
-  auto result = reader->Read();
-  if (!result.status().ok()) {
-    if (result.status().message() == "Empty CSV file") {
-      *table = nullptr;
-      return Status::OK();
-    } else {
-      return Status::ArrowError(result.status());
-    }
-  }
-  *table = result.ValueOrDie();
-
-  RETURN_ON_ARROW_ERROR((*table)->Validate());
-
-  VLOG(2) << "[file-" << location_ << "] contains: " << (*table)->num_rows()
-          << " rows, " << (*table)->num_columns() << " columns";
-  VLOG(2) << (*table)->schema()->ToString();
   return Status::OK();
 }
 
-// TODO: sub-optimal, requires further optimization
-int64_t LocalIOAdaptor::getDistanceToLineBreak(const int index) {
-  VINEYARD_CHECK_OK(seek(partial_read_offset_[index], kFileLocationBegin));
-
-  constexpr int64_t nbytes_for_block = 255;
-  char buffer[256];
+// Positional reads don't touch the file cursor, so it is safe to detect the
+// partition boundaries concurrently.
+int64_t LocalIOAdaptor::getDistanceToLineBreak(const int64_t offset) {
+  std::vector<char> buffer(detail::kLineBreakScanSize);
 
   int64_t dis = 0;
   while (true) {
-    auto sz = ifp_->Read(nbytes_for_block, buffer);
+    auto sz = ifp_->ReadAt(offset + dis, detail::kLineBreakScanSize,
+                           buffer.data());
     if (sz.ok() && sz.ValueUnsafe() > 0) {
       int64_t read_size = sz.ValueUnsafe();
-
-      buffer[read_size] = '\0';
-      char* endofline = strchr(buffer, '\n');
+      const char* endofline = static_cast<const char*>(
+          memchr(buffer.data(), '\n', static_cast<size_t>(read_size)));
       if (endofline != nullptr) {
-        dis += endofline - buffer;  // points to previous char before the `\n`.
+        dis += endofline - buffer.data();  // points to previous char before
+                                           // the `\n`.
         return dis;
       } else {
         dis += read_size;
@@ -449,51 +737,49 @@ int64_t LocalIOAdaptor::getDistanceToLineBreak(const int index) {
   }
 }
 
-// TODO: sub-optimal, requires further optimization
 Status LocalIOAdaptor::ReadLine(std::string& line) {
   if (ifp_ == nullptr) {
     return Status::IOError("The file hasn't been opened in read mode: " +
                            location_);
   }
-  if (enable_partial_read_ && tell() >= partial_read_offset_[index_ + 1]) {
+  int64_t position = tell();
+  if (enable_partial_read_ && position >= partial_read_offset_[index_ + 1]) {
     return Status::EndOfFile();
   }
 
-  constexpr int64_t nbytes_for_block = 256;
-  size_t offset = 0, skip_endofline = 0;
-  int64_t start_position = ifp_->Tell().ValueOrDie();
-
-  // find delimiter
+  // serve lines from the read-ahead window, which is refilled with a large
+  // positional read when the cursor moves out of it.
+  line.clear();
+  int64_t cursor = position;
   while (true) {
-    auto sz = ifp_->Read(nbytes_for_block, buff + offset);
-    if (sz.ok() && sz.ValueUnsafe() > 0) {
-      int64_t read_size = sz.ValueUnsafe();
-
-      // find '\n'
-      VINEYARD_ASSERT(offset + read_size < LINESIZE - 1,
-                      "The line is too long that is not supported");
-      buff[offset + read_size] = '\0';
-      char* endofline = strchr(buff + offset, '\n');
-      if (endofline != nullptr) {
-        offset = endofline - buff;
-        skip_endofline = 1;
+    if (read_ahead_ == nullptr || cursor < read_ahead_offset_ ||
+        cursor >= read_ahead_offset_ + read_ahead_->size()) {
+      RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+          read_ahead_, ifp_->ReadAt(cursor, detail::kReadAheadSize));
+      read_ahead_offset_ = cursor;
+      if (read_ahead_->size() == 0) {
+        if (cursor == position) {
+          return Status::EndOfFile();
+        }
         break;
-      } else {
-        offset += read_size;
-      }
-    } else {
-      if (offset == 0) {
-        return Status::EndOfFile();
       }
+    }
+    const char* begin =
+        reinterpret_cast<const char*>(read_ahead_->data()) +
+        (cursor - read_ahead_offset_);
+    size_t available =
+        static_cast<size_t>(read_ahead_offset_ + read_ahead_->size() - cursor);
+    const char* endofline =
+        static_cast<const char*>(memchr(begin, '\n', available));
+    if (endofline != nullptr) {
+      line.append(begin, endofline - begin);
+      cursor += (endofline - begin) + 1;  // skip the `\n`
       break;
     }
+    line.append(begin, available);
+    cursor += available;
   }
-
-  VINEYARD_DISCARD(
-      Status::ArrowError(ifp_->Seek(start_position + offset + skip_endofline)));
-  std::string linebuffer = std::string(buff, offset);
-  line.swap(linebuffer);
-  return Status::OK();
+  return seek(cursor, kFileLocationBegin);
 }
 
 Status LocalIOAdaptor::WriteTable(std::shared_ptr<arrow::Table> table) {
@@ -608,6 +894,7 @@ Status LocalIOAdaptor::Flush() {
 
 Status LocalIOAdaptor::Close() {
   Status s1, s2;
+  read_ahead_.reset();
   if (ifp_) {
     s1 = Status::ArrowError(ifp_->Close());
   }
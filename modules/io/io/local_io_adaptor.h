@@ -23,18 +23,17 @@ limitations under the License.
 #include <vector>
 
 #include "arrow/api.h"
+#include "arrow/csv/api.h"
 #include "arrow/filesystem/api.h"
 #include "arrow/io/api.h"
 
 #include "common/util/functions.h"
 #include "common/util/status.h"
+#include "io/io/columnar_reader.h"
 #include "io/io/i_io_adaptor.h"
 #include "io/io/io_factory.h"
 
 namespace vineyard {
-// FIXME: do not use fixed value, expend to double space when read to a
-// threshold.
-#define LINESIZE 65536
 
 enum FileLocation {
   kFileLocationBegin = 0,
@@ -77,6 +76,26 @@ class LocalIOAdaptor : public IIOAdaptor {
    * */
   Status SetPartialRead(const int index, const int total_parts) override;
 
+  /** Configure the reading behaviors, supported keys:
+   *
+   *  - "io_concurrency": the number of concurrent positional reads used when
+   *    reading a partition and detecting the partition boundaries, defaults
+   *    to the number of hardware threads. It also bounds the number of 8MB
+   *    chunks read ahead of the csv reader.
+   *  - "parallel_read": whether read the partition ahead of the csv reader
+   *    with concurrent positional reads, defaults to true.
+   *
+   * Besides, the location accepts the following arguments:
+   *
+   *  - "format": "csv", "parquet" or "orc", inferred from the file extension
+   *    by default. For parquet and orc files only the columns in "schema" are
+   *    decoded, and the row groups (stripes) are read in parallel.
+   *  - "filter": predicates on columns, e.g., "weight>0.5;label==person",
+   *    rows that don't satisfy all predicates are dropped. Row groups of
+   *    parquet files are skipped based on the statistics if possible.
+   *
+   * The same keys can be passed as arguments in the location as well.
+   * */
   Status Configure(const std::string& key, const std::string& value) override;
 
   Status WriteLine(const std::string& line) override;
@@ -108,6 +127,9 @@ class LocalIOAdaptor : public IIOAdaptor {
 
   Status ReadPartialTable(std::shared_ptr<arrow::Table>* table, int index);
 
+  Status ReadRecordBatches(
+      std::shared_ptr<arrow::RecordBatchReader>* reader) override;
+
   Status Seek(const int64_t offset);
 
   int64_t GetFullSize();
@@ -120,17 +142,26 @@ class LocalIOAdaptor : public IIOAdaptor {
   int64_t tell();
   Status seek(const int64_t offset, const FileLocation seek_from);
   Status setPartialReadImpl();
-  int64_t getDistanceToLineBreak(const int index);
+  int64_t getDistanceToLineBreak(const int64_t offset);
+  Status openPartialInput(const int index,
+                          std::shared_ptr<arrow::io::InputStream>& input);
+  Status makeCSVOptions(arrow::csv::ReadOptions& read_options,
+                        arrow::csv::ParseOptions& parse_options,
+                        arrow::csv::ConvertOptions& convert_options);
+  // the row groups (stripes) of the `index`-th part, when partial read is
+  // enabled
+  ColumnarReadOptions columnarReadOptions(const int index) const;
 
   std::string trimBOM(const std::string& line);
 
   std::string location_;
-  char buff[LINESIZE];
   std::shared_ptr<arrow::fs::FileSystem> fs_;
   std::shared_ptr<arrow::io::RandomAccessFile> ifp_;  // for input
   std::shared_ptr<arrow::io::OutputStream> ofp_;      // for output
 
   // for arrow
+  std::string format_ = "csv";
+  std::vector<ColumnPredicate> predicates_;
   std::vector<std::string> columns_;
   std::vector<std::string> column_types_;
   char delimiter_ = ',';
@@ -144,6 +175,15 @@ class LocalIOAdaptor : public IIOAdaptor {
   std::vector<int64_t> partial_read_offset_;
   int total_parts_;
   int index_;
+
+  // positional reads
+  bool parallel_read_ = true;
+  size_t io_concurrency_ = 0;
+
+  // read-ahead window for `ReadLine()`
+  std::shared_ptr<arrow::Buffer> read_ahead_;
+  int64_t read_ahead_offset_ = 0;
+
   std::unordered_multimap<std::string, std::string> meta_;
 
   // register
@@ -29,6 +29,16 @@ limitations under the License.
 
 namespace vineyard {
 
+/**
+ * @brief PackedObject serializes an object as
+ *
+ *    [u64 length of metadata][metadata (json)]
+ *    [u64 number of blobs][(u64 blob id, u64 blob size)...]
+ *    [blob payloads...]
+ *
+ * The header is small and copied, while the blob payloads are referenced
+ * in the scatter-gather `buffer()` without being copied.
+ */
 class PackedObject {
  public:
   explicit PackedObject(Object const& object) : PackedObject(object.meta()) {}
@@ -42,23 +52,35 @@ class PackedObject {
       : PackedObject(object->meta()) {}
 
   explicit PackedObject(ObjectMeta const& meta) : meta_(meta) {
-    buffer.Append(Buffer(meta.MetaData().dump()));
-    std::vector<uint64_t> elements;
+    BufferBuilder header;
+    std::string const metadata = meta.MetaData().dump();
+    header.PutUInt64(metadata.size());
+    header.PutChars(metadata.data(), metadata.size());
+
+    // the blobs that are not available locally are packed as empty ones
     auto const& buffers = meta.GetBufferSet()->AllBuffers();
-    elements.emplace_back(buffers.size());
+    header.PutUInt64(buffers.size());
     for (auto const& item : buffers) {
-      elements.emplace_back(item.first);
-      elements.emplace_back(item.second->size());
+      header.PutUInt64(item.first);
+      header.PutUInt64(item.second ? item.second->size() : 0);
     }
-    buffer.Append(Buffer(elements));
+    buffer_.Append(header.Finish());
     for (auto const& item : buffers) {
-      buffer.Append(Buffer(item.second->data(), item.second->size()));
+      if (item.second && item.second->size() > 0) {
+        buffer_.Append(item.second);
+      }
     }
   }
 
+  VBuffer const& buffer() const { return buffer_; }
+
+  size_t size() const { return buffer_.size(); }
+
+  Status WriteTo(int fd) const { return buffer_.WriteTo(fd); }
+
  private:
   const ObjectMeta meta_;
-  VBuffer buffer;
+  VBuffer buffer_;
 };
 
 }  // namespace vineyard
@@ -16,7 +16,6 @@ limitations under the License.
 #ifndef MODULES_MSGPACK_PICKLE_H_
 #define MODULES_MSGPACK_PICKLE_H_
 
-#include <iostream>
 #include <memory>
 #include <string>
 #include <utility>
@@ -30,6 +29,17 @@ limitations under the License.
 
 namespace vineyard {
 
+/**
+ * @brief Pickler serializes an object as a pickle (protocol 5) of
+ *
+ *    vineyard._C._object_from_pickled_buffers(
+ *        metadata, (blob id, PickleBuffer, blob id, PickleBuffer, ...))
+ *
+ * where the blobs are out-of-band buffers (NEXT_BUFFER), thus the pickle
+ * stream is small and the blob payloads are never copied. The first segment
+ * of `buffer()` is the pickle stream, followed by the out-of-band buffers in
+ * order, which are expected to be passed as `pickle.loads(data, buffers=...)`.
+ */
 class Pickler {
  public:
   explicit Pickler(Object const& object) : Pickler(object.meta()) {}
@@ -46,16 +56,31 @@ class Pickler {
     this->buildPickleBuffers();
   }
 
+  VBuffer const& buffer() const { return buffer_; }
+
+  Buffer const& pickled() const { return buffer_.buffers()[0]; }
+
+  size_t size() const { return buffer_.size(); }
+
+  Status WriteTo(int fd) const { return buffer_.WriteTo(fd); }
+
  private:
   void buildPickleBuffers() {
     BufferBuilder builder;
-    // Framer framer;
 
     // header
-    builder.PutByte('\x80');
+    builder.PutByte(PROTO);
     builder.PutByte(5);
 
-    auto const& buffers = meta_.GetBufferSet()->AllBuffers();
+    // the blobs that are not available locally are skipped
+    std::vector<std::shared_ptr<arrow::Buffer>> buffers;
+    std::vector<ObjectID> buffer_ids;
+    for (auto const& item : meta_.GetBufferSet()->AllBuffers()) {
+      if (item.second != nullptr) {
+        buffer_ids.emplace_back(item.first);
+        buffers.emplace_back(item.second);
+      }
+    }
 
     // start frame
     {
@@ -63,41 +88,46 @@ class Pickler {
       inner.PutChars(
           "\x8c\x0bvineyard._C\x94\x8c\x1c_object_from_pickled_"
           "buffers\x94");
-      inner.PutChars("\x93\x94");  // start the tuple
-      for (auto const& item : buffers) {
-        // put object id
-        inner.PutByte('\x8a');  // LONG1
-        inner.PutByte(8);
-        inner.PutUInt64(item.first);
+      inner.PutChars("\x93\x94");  // STACK_GLOBAL
+
+      // put metadata, as BINUNICODE8
+      std::string const metadata = meta_.MetaData().dump();
+      inner.PutByte('\x8d');
+      inner.PutUInt64(metadata.size());
+      inner.PutChars(metadata.data(), metadata.size());
+      inner.PutByte('\x94');
+
+      inner.PutByte('(');  // MARK, start the tuple
+      for (auto const& id : buffer_ids) {
+        // put object id, as LONG1 (signed, little endian)
+        inner.PutByte('\x8a');
+        inner.PutByte(id >> 63 ? 9 : 8);
+        inner.PutUInt64(id);
+        if (id >> 63) {
+          inner.PutByte(0);
+        }
         // put PickleBuffer
         inner.PutChars("\x97\x98");  // NEXT_BUFFER + READONLY_BUFFER
       }
-      inner.PutByte('.');
+      inner.PutByte('t');     // TUPLE
+      inner.PutByte('\x86');  // TUPLE2, (metadata, buffers)
+      inner.PutByte('R');     // REDUCE
+      inner.PutByte(STOP);
 
       auto buffer = inner.Finish();
-      builder.PutByte('\x95');
+      builder.PutByte('\x95');  // FRAME
       builder.PutUInt64(buffer.size());
       builder.Append(buffer);
     }
 
-    auto buffer = builder.Finish();
-    std::cout << "buffer: " << buffer.ToString() << std::endl;
-
-    // buffer.Append(Buffer(meta.MetaData().dump()));
-    // std::vector<uint64_t> elements;
-    // for (auto const& item : buffers) {
-    //   elements.emplace_back(item.first);
-    //   elements.emplace_back(item.second->size());
-    // }
-    // buffer.Append(Buffer(elements));
-    // for (auto const& item : buffers) {
-    //   buffer.Append(Buffer(item.second->data(), item.second->size()));
-    // }
-    // builder.Append();
+    buffer_.Append(builder.Finish());
+    for (auto const& buffer : buffers) {
+      buffer_.Append(buffer);
+    }
   }
 
   const ObjectMeta meta_;
-  VBuffer buffer;
+  VBuffer buffer_;
 
   static constexpr const uint8_t PROTO = '\x80';
   static constexpr const uint8_t STOP = '.';
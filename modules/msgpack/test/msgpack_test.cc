@@ -13,6 +13,8 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <unistd.h>
+
 #include <memory>
 #include <string>
 #include <thread>
@@ -50,6 +52,28 @@ int main(int argc, char** argv) {
 
   PackedObject packed(sealed_double_array);
 
+  // the payload of blobs are referenced, rather than copied
+  auto const& blobs = sealed_double_array->meta().GetBufferSet()->AllBuffers();
+  auto const& segments = packed.buffer().buffers();
+  CHECK_EQ(segments.size(), 1 + blobs.size());
+  size_t index = 1;
+  for (auto const& item : blobs) {
+    CHECK_EQ(segments[index].ptr(), item.second->data());
+    CHECK_EQ(segments[index].size(), item.second->size());
+    index += 1;
+  }
+
+  // written by writev
+  {
+    char path[] = "/tmp/msgpack_test.XXXXXX";
+    int fd = mkstemp(path);
+    CHECK_GE(fd, 0);
+    VINEYARD_CHECK_OK(packed.WriteTo(fd));
+    CHECK_EQ(static_cast<size_t>(lseek(fd, 0, SEEK_END)), packed.size());
+    close(fd);
+    unlink(path);
+  }
+
   LOG(INFO) << "Passed msgpack array tests...";
 
   client.Disconnect();
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <fstream>
 #include <memory>
 #include <string>
 #include <thread>
@@ -30,9 +31,25 @@ limitations under the License.
 using namespace vineyard;  // NOLINT(build/namespaces)
 using vineyard::Pickler;
 
+// dumps the pickle stream and the out-of-band buffers, to be loaded by
+// python/vineyard/core/tests/test_pickle.py
+void DumpPickle(Pickler const& pickled, std::string const& directory) {
+  auto const& segments = pickled.buffer().buffers();
+  for (size_t index = 0; index < segments.size(); ++index) {
+    std::string path =
+        directory + "/" +
+        (index == 0 ? "pickle.bin"
+                    : "buffer-" + std::to_string(index - 1) + ".bin");
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(segments[index].ptr()),
+               segments[index].size());
+    CHECK(file.good());
+  }
+}
+
 int main(int argc, char** argv) {
   if (argc < 2) {
-    printf("usage ./pickle_test <ipc_socket>");
+    printf("usage ./pickle_test <ipc_socket> [<dump directory>]");
     return 1;
   }
   std::string ipc_socket = std::string(argv[1]);
@@ -41,19 +58,38 @@ int main(int argc, char** argv) {
   VINEYARD_CHECK_OK(client.Connect(ipc_socket));
   LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
 
-  // std::vector<double> double_array = {1.0, 7.0, 3.0, 4.0, 2.0};
-  // ArrayBuilder<double> builder(client, double_array);
-  // auto sealed_double_array =
-  //     std::dynamic_pointer_cast<Array<double>>(builder.Seal(client));
+  std::vector<double> double_array = {1.0, 7.0, 3.0, 4.0, 2.0};
+  ArrayBuilder<double> builder(client, double_array);
+  auto sealed_double_array =
+      std::dynamic_pointer_cast<Array<double>>(builder.Seal(client));
 
-  // LOG(INFO) << "successfully sealed...";
-  // LOG(INFO) << "sealed object id: " << sealed_double_array->id() << ", "
-  //           << ObjectIDToString(sealed_double_array->id());
+  LOG(INFO) << "successfully sealed...";
+  LOG(INFO) << "sealed object id: " << sealed_double_array->id() << ", "
+            << ObjectIDToString(sealed_double_array->id());
 
-  auto sealed_double_array =
-      client.GetObject(ObjectIDFromString("o00003e2dcb86e08e"));
   Pickler pickled(sealed_double_array);
 
+  // protocol 5, and ends with STOP
+  auto const& stream = pickled.pickled();
+  CHECK_EQ(stream.ptr()[0], 0x80);
+  CHECK_EQ(stream.ptr()[1], 5);
+  CHECK_EQ(stream.ptr()[stream.size() - 1], '.');
+
+  // the blobs are out-of-band buffers, which are referenced rather than
+  // copied
+  auto const& blobs = sealed_double_array->meta().GetBufferSet()->AllBuffers();
+  auto const& segments = pickled.buffer().buffers();
+  CHECK_EQ(segments.size(), 1 + blobs.size());
+  size_t index = 1;
+  for (auto const& item : blobs) {
+    CHECK_EQ(segments[index].ptr(), item.second->data());
+    index += 1;
+  }
+
+  if (argc >= 3) {
+    DumpPickle(pickled, argv[2]);
+  }
+
   LOG(INFO) << "Passed pickle array tests...";
 
   client.Disconnect();
@@ -16,6 +16,13 @@ limitations under the License.
 #ifndef MODULES_MSGPACK_VBUFFER_H_
 #define MODULES_MSGPACK_VBUFFER_H_
 
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -62,30 +69,38 @@ class Buffer {
     owned_ = false;
   }
 
-  Buffer(Buffer&& other) {
+  Buffer(Buffer&& other) noexcept {
     buffer_ = other.buffer_;
     size_ = other.size_;
-    if (other.owned_) {
-      owned_ = true;
-    }
+    owned_ = other.owned_;
     other.buffer_ = nullptr;
     other.size_ = 0;
     other.owned_ = false;
   }
 
   Buffer& operator=(const Buffer& other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (owned_ && buffer_ != nullptr) {
+      free(buffer_);
+    }
     buffer_ = other.buffer_;
     size_ = other.size_;
     owned_ = false;
     return *this;
   }
 
-  Buffer& operator=(Buffer&& other) {
+  Buffer& operator=(Buffer&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    if (owned_ && buffer_ != nullptr) {
+      free(buffer_);
+    }
     buffer_ = other.buffer_;
     size_ = other.size_;
-    if (other.owned_) {
-      owned_ = true;
-    }
+    owned_ = other.owned_;
     other.buffer_ = nullptr;
     other.size_ = 0;
     other.owned_ = false;
@@ -116,8 +131,8 @@ class Buffer {
 
  private:
   uint8_t* buffer_ = nullptr;
-  size_t size_;
-  bool owned_;
+  size_t size_ = 0;
+  bool owned_ = false;
 };
 
 // little endian
@@ -209,19 +224,89 @@ class BufferBuilder {
   }
 };
 
+/**
+ * @brief A scatter-gather list of segments, where the headers are owned and
+ * the payloads of blobs are referenced (and kept alive) rather than copied.
+ *
+ * The segments can be written by `writev`/`sendmsg` (see `AsIOVecs` and
+ * `WriteTo`), or handed to Python as the out-of-band buffers of pickle
+ * protocol 5, without a contiguous copy of the whole object.
+ */
 class VBuffer {
  public:
   VBuffer() { offsets_.emplace_back(0); }
 
+  // references the buffer, which must outlive the VBuffer
   void Append(Buffer const& buffer) {
     buffers_.emplace_back(buffer);
     size_ += buffer.size();
     offsets_.emplace_back(size_);
   }
 
+  // takes the ownership of the buffer, if it is owned
+  void Append(Buffer&& buffer) {
+    size_ += buffer.size();
+    buffers_.emplace_back(std::move(buffer));
+    offsets_.emplace_back(size_);
+  }
+
+  // references the blob payload without copying, and keeps it alive
+  void Append(std::shared_ptr<arrow::Buffer> const& buffer) {
+    holds_.emplace_back(buffer);
+    Append(Buffer(buffer->data(), buffer->size()));
+  }
+
+  size_t size() const { return size_; }
+
+  std::vector<Buffer> const& buffers() const { return buffers_; }
+
+  // the offset of each segment in the serialized bytes
+  std::vector<size_t> const& offsets() const { return offsets_; }
+
+  void AsIOVecs(std::vector<struct iovec>& iovecs) const {
+    iovecs.reserve(iovecs.size() + buffers_.size());
+    for (auto const& buffer : buffers_) {
+      if (buffer.size() != 0) {
+        iovecs.push_back({buffer.ptr(), buffer.size()});
+      }
+    }
+  }
+
+  // writes all segments by `writev`, at most IOV_MAX segments per call
+  Status WriteTo(int fd) const {
+    std::vector<struct iovec> iovecs;
+    AsIOVecs(iovecs);
+    size_t index = 0;
+    while (index < iovecs.size()) {
+      int count = static_cast<int>(
+          std::min<size_t>(iovecs.size() - index, IOV_MAX));
+      ssize_t written = writev(fd, iovecs.data() + index, count);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return Status::IOError("Failed to write the buffers: " +
+                               std::string(strerror(errno)));
+      }
+      // skips the segments that have been written, for partial writes
+      size_t remaining = static_cast<size_t>(written);
+      while (index < iovecs.size() && remaining >= iovecs[index].iov_len) {
+        remaining -= iovecs[index].iov_len;
+        index += 1;
+      }
+      if (remaining > 0) {
+        iovecs[index].iov_base =
+            static_cast<uint8_t*>(iovecs[index].iov_base) + remaining;
+        iovecs[index].iov_len -= remaining;
+      }
+    }
+    return Status::OK();
+  }
+
  private:
   std::vector<size_t> offsets_;
   std::vector<Buffer> buffers_;
+  std::vector<std::shared_ptr<arrow::Buffer>> holds_;
   size_t size_ = 0;
 };
 
@@ -15,10 +15,13 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "client/client.h"
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
+#include "client/ds/object_factory.h"
 #include "client/ds/object_meta.h"
 #include "client/ds/remote_blob.h"
 #include "client/rpc_client.h"
@@ -46,6 +49,31 @@ struct metadata_iterator_state {
   bool first_or_done;
   Arg arg;
 };
+
+/// The object of unregistered types, the same as what `Client::GetObject`
+/// returns for them.
+class GenericObject : public Object {
+ public:
+  GenericObject() = default;
+};
+
+/// Wraps a python buffer (e.g., the out-of-band `PickleBuffer`) as an arrow
+/// buffer without copying, the python object is kept alive until the arrow
+/// buffer is released.
+static std::shared_ptr<arrow::Buffer> wrap_python_buffer(
+    py::buffer const& buffer) {
+  auto view = new py::buffer_info(buffer.request());
+  auto owner = new py::object(buffer);
+  return std::shared_ptr<arrow::Buffer>(
+      new arrow::Buffer(reinterpret_cast<const uint8_t*>(view->ptr),
+                        view->size * view->itemsize),
+      [view, owner](arrow::Buffer* wrapper) {
+        delete wrapper;
+        py::gil_scoped_acquire acquire;
+        delete view;
+        delete owner;
+      });
+}
 }  // namespace detail
 
 void bind_core(py::module& mod) {
@@ -451,6 +479,39 @@ void bind_core(py::module& mod) {
           },
           "client"_a)
       .def_property_readonly("issealed", &ObjectBuilder::sealed);
+
+  // see also `Pickler` in modules/msgpack/pickle.h
+  mod.def(
+      "_object_from_pickled_buffers",
+      [](std::string const& metadata,
+         py::tuple const& buffers) -> std::shared_ptr<Object> {
+        ObjectMeta meta;
+        meta.SetMetaData(nullptr, json::parse(metadata));
+        // the payloads of blobs are carried by the pickle itself
+        meta.ForceLocal();
+        if (buffers.size() % 2 != 0) {
+          throw std::invalid_argument(
+              "Expect pairs of (blob id, buffer), but got " +
+              std::to_string(buffers.size()) + " items");
+        }
+        for (size_t index = 0; index < buffers.size(); index += 2) {
+          ObjectID id = buffers[index].cast<ObjectID>();
+          if (!meta.GetBufferSet()->Contains(id)) {
+            throw std::invalid_argument("The blob " + ObjectIDToString(id) +
+                                        " is not a member of the object");
+          }
+          auto buffer = buffers[index + 1].cast<py::buffer>();
+          meta.SetBuffer(id, detail::wrap_python_buffer(buffer));
+        }
+        std::shared_ptr<Object> object =
+            ObjectFactory::Create(meta.GetTypeName());
+        if (object == nullptr) {
+          object = std::make_shared<detail::GenericObject>();
+        }
+        object->Construct(meta);
+        return object;
+      },
+      "metadata"_a, "buffers"_a);
 }
 
 void bind_blobs(py::module& mod) {
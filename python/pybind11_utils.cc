@@ -201,8 +201,8 @@ Status copy_memoryview(PyObject* src, void* dst, size_t const size,
   {
     py::gil_scoped_release release;
     // memcpy
-    memory::inline_memcpy(reinterpret_cast<uint8_t*>(dst) + offset,
-                          src_buffer.data(), src_buffer.size());
+    memory::concurrent_memcpy(reinterpret_cast<uint8_t*>(dst) + offset,
+                              src_buffer.data(), src_buffer.size());
   }
 
   return Status::OK();
@@ -256,8 +256,8 @@ Status copy_memoryview_to_memoryview(PyObject* src, PyObject* dst,
   {
     py::gil_scoped_release release;
     // memcpy
-    memory::inline_memcpy(dst_buffer.data() + offset, src_buffer.data(),
-                          src_buffer.size());
+    memory::concurrent_memcpy(dst_buffer.data() + offset, src_buffer.data(),
+                              src_buffer.size());
   }
 
   return Status::OK();
@@ -337,6 +337,9 @@ class RPCClient(ClientBase):
     def __enter__(self) -> "RPCClient": ...
     def __exit__(self, exc_type: Any, exc_value: Any, traceback: Any) -> None: ...
 
+def _object_from_pickled_buffers(
+    metadata: str, buffers: Tuple[Union[int, Any], ...]
+) -> Object: ...
 @overload
 def connect(
     *, username: str = "", password: str = ""
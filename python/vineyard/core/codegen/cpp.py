@@ -269,6 +269,13 @@ class {class_name}BaseBuilder{type_params}: public ObjectBuilder {{
     }}
 
     Status _Seal(Client& client, std::shared_ptr<Object>& object) override {{
+        RETURN_ON_ERROR(this->_Assemble(client, object));
+        auto __value = std::dynamic_pointer_cast<{class_name_elaborated}>(object);
+        RETURN_ON_ERROR(client.CreateMetaData(__value->meta_, __value->id_));
+        return this->_PostSeal(client, object);
+    }}
+
+    Status _Assemble(Client& client, std::shared_ptr<Object>& object) override {{
         // ensure the builder hasn't been sealed yet.
         ENSURE_NOT_SEALED(this);
 
@@ -283,8 +290,11 @@ class {class_name}BaseBuilder{type_params}: public ObjectBuilder {{
         {assignments}
 
         __value->meta_.SetNBytes(__value_nbytes);
+        return Status::OK();
+    }}
 
-        RETURN_ON_ERROR(client.CreateMetaData(__value->meta_, __value->id_));
+    Status _PostSeal(Client& client, std::shared_ptr<Object>& object) override {{
+        auto __value = std::dynamic_pointer_cast<{class_name_elaborated}>(object);
 
         // mark the builder as sealed
         this->set_sealed(true);
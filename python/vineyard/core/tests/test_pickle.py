@@ -0,0 +1,103 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020-2023 Alibaba Group Holding Limited.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import os
+import pickle
+
+import numpy as np
+
+import pytest
+
+import vineyard
+from vineyard.core.resolver import get_current_resolvers
+
+
+class PickledObject:
+    '''Pickles the object the same as :code:`vineyard::Pickler`, i.e.,
+    as a call of :code:`vineyard._C._object_from_pickled_buffers` with
+    the blobs as out-of-band buffers.'''
+
+    def __init__(self, obj, blobs):
+        self.metadata = repr(obj.meta)
+        self.blobs = blobs
+
+    def __reduce_ex__(self, protocol):
+        buffers = []
+        for blob in self.blobs:
+            buffers.append(int(blob.id))
+            buffers.append(pickle.PickleBuffer(memoryview(blob)))
+        return (
+            vineyard._C._object_from_pickled_buffers,
+            (self.metadata, tuple(buffers)),
+        )
+
+
+def test_object_from_pickled_buffers(vineyard_client):
+    data = np.arange(1024, dtype=np.double)
+    obj = vineyard_client.get_object(vineyard_client.put(data))
+
+    buffers = []
+    pickled = pickle.dumps(
+        PickledObject(obj, [obj.member('buffer_')]),
+        protocol=5,
+        buffer_callback=buffers.append,
+    )
+    # the blobs are not copied into the pickle stream
+    assert len(pickled) < data.nbytes
+    assert len(buffers) == 1
+
+    loaded = pickle.loads(pickled, buffers=buffers)
+    assert loaded.id == obj.id
+    assert loaded.typename == obj.typename
+    np.testing.assert_array_equal(get_current_resolvers().run(loaded), data)
+
+
+def test_object_from_pickled_buffers_mismatch(vineyard_client):
+    data = np.arange(16, dtype=np.double)
+    obj = vineyard_client.get_object(vineyard_client.put(data))
+    other = vineyard_client.get_object(vineyard_client.put(data))
+
+    buffers = []
+    pickled = pickle.dumps(
+        PickledObject(obj, [other.member('buffer_')]),
+        protocol=5,
+        buffer_callback=buffers.append,
+    )
+    with pytest.raises(ValueError):
+        pickle.loads(pickled, buffers=buffers)
+
+
+@pytest.mark.skipif(
+    not os.environ.get('VINEYARD_PICKLE_TEST_DIR'),
+    reason='requires the pickle dumped by the C++ pickle_test',
+)
+def test_load_pickle_from_cpp():
+    directory = os.environ['VINEYARD_PICKLE_TEST_DIR']
+    with open(os.path.join(directory, 'pickle.bin'), 'rb') as f:
+        pickled = f.read()
+    buffers, index = [], 0
+    while os.path.exists(os.path.join(directory, 'buffer-%d.bin' % index)):
+        with open(os.path.join(directory, 'buffer-%d.bin' % index), 'rb') as f:
+            buffers.append(f.read())
+        index += 1
+
+    loaded = pickle.loads(pickled, buffers=buffers)
+    assert loaded.typename == 'vineyard::Array<double>'
+    np.testing.assert_array_equal(
+        get_current_resolvers().run(loaded), [1.0, 7.0, 3.0, 4.0, 2.0]
+    )
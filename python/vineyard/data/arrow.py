@@ -154,6 +154,23 @@ def list_array_builder(client: IPCClient, array: pa.ListArray, builder: BuilderC
     return client.create_metadata(meta)
 
 
+def chunked_array_builder(
+    client: IPCClient, array: pa.ChunkedArray, builder: BuilderContext
+):
+    meta = ObjectMeta()
+    meta['typename'] = 'vineyard::ChunkedArray'
+    meta['length_'] = len(array)
+    chunks = array.chunks
+    if not chunks:
+        # keeps an empty chunk to retain the data type
+        chunks = [pa.array([], type=array.type)]
+    meta['__chunks_-size'] = len(chunks)
+    for idx, chunk in enumerate(chunks):
+        meta.add_member('__chunks_-%d' % idx, builder.run(client, chunk))
+    meta['nbytes'] = array.nbytes
+    return client.create_metadata(meta)
+
+
 def null_array_builder(client: IPCClient, array: pa.NullArray):
     meta = ObjectMeta()
     meta['typename'] = 'vineyard::NullArray'
@@ -224,20 +241,60 @@ def record_batch_builder(
     return client.create_metadata(meta)
 
 
-def table_builder(client: IPCClient, table: pa.Table, builder: BuilderContext):
+def _is_chunk_aligned(table: pa.Table):
+    chunk_lengths = [[len(chunk) for chunk in column.chunks] for column in table]
+    return all(lengths == chunk_lengths[0] for lengths in chunk_lengths)
+
+
+def _chunked_record_batch_builder(
+    client: IPCClient, table: pa.Table, builder: BuilderContext
+):
+    meta = ObjectMeta()
+    meta['typename'] = 'vineyard::RecordBatch'
+    meta['row_num_'] = table.num_rows
+    meta['column_num_'] = table.num_columns
+    meta['__columns_-size'] = table.num_columns
+
+    meta.add_member('schema_', schema_proxy_builder(client, table.schema, builder))
+    for idx in range(table.num_columns):
+        meta.add_member(
+            '__columns_-%d' % idx,
+            chunked_array_builder(client, table.column(idx), builder),
+        )
+    meta['nbytes'] = table.nbytes
+    return client.create_metadata(meta)
+
+
+def table_builder(
+    client: IPCClient,
+    table: pa.Table,
+    builder: BuilderContext,
+    preserve_chunks: bool = False,
+):
+    '''Puts the table as record batches. If :code:`preserve_chunks` is set,
+    a table whose columns are not chunked in the same way is kept as a single
+    record batch of :code:`vineyard::ChunkedArray` columns, rather than being
+    sliced into multiple record batches.'''
     meta = ObjectMeta()
     meta['typename'] = 'vineyard::Table'
     meta['num_rows_'] = table.num_rows
     meta['num_columns_'] = table.num_columns
-    batches = table.to_batches()
-    meta['batch_num_'] = len(batches)
-    meta['partitions_-size'] = len(batches)
 
     meta.add_member('schema_', schema_proxy_builder(client, table.schema, builder))
-    for idx, batch in enumerate(batches):
+    if preserve_chunks and not _is_chunk_aligned(table):
+        meta['batch_num_'] = 1
+        meta['partitions_-size'] = 1
         meta.add_member(
-            'partitions_-%d' % idx, record_batch_builder(client, batch, builder)
+            'partitions_-0', _chunked_record_batch_builder(client, table, builder)
         )
+    else:
+        batches = table.to_batches()
+        meta['batch_num_'] = len(batches)
+        meta['partitions_-size'] = len(batches)
+        for idx, batch in enumerate(batches):
+            meta.add_member(
+                'partitions_-%d' % idx, record_batch_builder(client, batch, builder)
+            )
     meta['nbytes'] = table.nbytes
     return client.create_metadata(meta)
 
@@ -365,12 +422,29 @@ def schema_proxy_resolver(obj: Union[Object, ObjectMeta]):
     return pa.ipc.read_schema(buffer)
 
 
+def chunked_array_resolver(obj: Union[Object, ObjectMeta], resolver: ResolverContext):
+    meta = obj.meta
+    chunks = []
+    for idx in range(int(meta['__chunks_-size'])):
+        chunks.append(resolver.run(obj.member('__chunks_-%d' % idx)))
+    # the builders guarantee there is at least one chunk
+    return pa.chunked_array(chunks, type=chunks[0].type)
+
+
 def record_batch_resolver(obj: Union[Object, ObjectMeta], resolver: ResolverContext):
+    '''Resolves the record batch, or a table if there are
+    :code:`vineyard::ChunkedArray` columns that have multiple chunks, as the
+    chunks are never concatenated implicitly.'''
     meta = obj.meta
     schema = resolver.run(obj.member('schema_'))
     columns = []
     for idx in range(int(meta['__columns_-size'])):
-        columns.append(resolver.run(obj.member('__columns_-%d' % idx)))
+        column = resolver.run(obj.member('__columns_-%d' % idx))
+        if isinstance(column, pa.ChunkedArray) and column.num_chunks == 1:
+            column = column.chunk(0)
+        columns.append(column)
+    if any(isinstance(column, pa.ChunkedArray) for column in columns):
+        return pa.Table.from_arrays(columns, schema=schema)
     return pa.RecordBatch.from_arrays(columns, schema=schema)
 
 
@@ -380,6 +454,13 @@ def table_resolver(obj: Union[Object, ObjectMeta], resolver: ResolverContext):
     batches = []
     for idx in range(batch_num):
         batches.append(resolver.run(obj.member('partitions_-%d' % idx)))
+    if any(isinstance(batch, pa.Table) for batch in batches):
+        return pa.concat_tables(
+            [
+                batch if isinstance(batch, pa.Table) else pa.Table.from_batches([batch])
+                for batch in batches
+            ]
+        )
     return pa.Table.from_batches(batches)
 
 
@@ -397,6 +478,7 @@ def register_arrow_types(
         builder_ctx.register(pa.Schema, schema_proxy_builder)
         builder_ctx.register(pa.RecordBatch, record_batch_builder)
         builder_ctx.register(pa.Table, table_builder)
+        builder_ctx.register(pa.ChunkedArray, chunked_array_builder)
         builder_ctx.register(pa.ListArray, list_array_builder)
 
     if resolver_ctx is not None:
@@ -413,4 +495,5 @@ def register_arrow_types(
         resolver_ctx.register('vineyard::SchemaProxy', schema_proxy_resolver)
         resolver_ctx.register('vineyard::RecordBatch', record_batch_resolver)
         resolver_ctx.register('vineyard::Table', table_resolver)
+        resolver_ctx.register('vineyard::ChunkedArray', chunked_array_resolver)
         resolver_ctx.register('vineyard::LargeListArray', list_array_resolver)
@@ -87,3 +87,37 @@ def test_table(vineyard_client):
     # will be transformed to LargeStringArray
     #
     # assert table.equals(vineyard_client.get(object_id))
+
+
+def test_chunked_array(vineyard_client):
+    arr = pa.chunked_array([[1, 2, None], [3], [4, 5]])
+    object_id = vineyard_client.put(arr)
+    result = vineyard_client.get(object_id)
+    assert isinstance(result, pa.ChunkedArray)
+    assert result.num_chunks == 3
+    assert arr.equals(result)
+
+
+def test_unaligned_table(vineyard_client):
+    table = pa.Table.from_arrays(
+        [
+            pa.chunked_array([[1, 2, 3, 4], [5, 6]]),
+            pa.chunked_array([[0.5, 1.5], [2.5, 3.5, 4.5, 5.5]]),
+        ],
+        ['f0', 'f1'],
+    )
+
+    # sliced into record batches by default
+    object_id = vineyard_client.put(table)
+    meta = vineyard_client.get_meta(object_id)
+    assert int(meta['batch_num_']) == 3
+    assert table.equals(vineyard_client.get(object_id))
+
+    # the chunks of columns are preserved
+    object_id = vineyard_client.put(table, preserve_chunks=True)
+    meta = vineyard_client.get_meta(object_id)
+    assert int(meta['batch_num_']) == 1
+    result = vineyard_client.get(object_id)
+    assert table.equals(result)
+    assert result.column(0).num_chunks == 2
+    assert result.column(1).num_chunks == 2
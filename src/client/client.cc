@@ -536,10 +536,12 @@ bool Client::IsSharedMemory(const void* target, ObjectID& object_id) const {
 }
 
 bool Client::IsSharedMemory(const uintptr_t target, ObjectID& object_id) const {
+  Client* mutable_this = const_cast<Client*>(this);
+  // the segments are updated when other threads create blobs
+  std::lock_guard<std::recursive_mutex> guard(mutable_this->client_mutex_);
   if (shm_->Exists(target, object_id)) {
     // verify that the blob is not deleted on the server side
     json tree;
-    Client* mutable_this = const_cast<Client*>(this);
     return mutable_this->GetData(object_id, tree, false, false).ok();
   }
   return false;
@@ -76,14 +76,28 @@ Status ClientBase::CreateData(const json& tree, ObjectID& id,
   return Status::OK();
 }
 
+Status ClientBase::CreateData(const std::vector<json>& trees,
+                              std::vector<ObjectID>& ids,
+                              std::vector<Signature>& signatures,
+                              std::vector<InstanceID>& instance_ids) {
+  ENSURE_CONNECTED(this);
+  std::string message_out;
+  WriteCreateDatasRequest(trees, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(
+      ReadCreateDatasReply(message_in, ids, signatures, instance_ids));
+  return Status::OK();
+}
+
 Status ClientBase::CreateMetaData(ObjectMeta& meta_data, ObjectID& id) {
   return this->CreateMetaData(meta_data, this->instance_id_, std::ref(id));
 }
 
-Status ClientBase::CreateMetaData(ObjectMeta& meta_data,
-                                  InstanceID const& instance_id, ObjectID& id) {
+static void prepare_metadata(ObjectMeta& meta_data,
+                             InstanceID const& instance_id) {
   const char* labels[3] = {"JOB_NAME", "POD_NAME", "POD_NAMESPACE"};
-  InstanceID computed_instance_id = instance_id;
   meta_data.SetInstanceId(instance_id);
   meta_data.AddKeyValue("transient", true);
   // add the key from env to the metadata for k8s environment.
@@ -97,6 +111,12 @@ Status ClientBase::CreateMetaData(ObjectMeta& meta_data,
   if (!meta_data.HasKey("nbytes")) {
     meta_data.SetNBytes(0);
   }
+}
+
+Status ClientBase::CreateMetaData(ObjectMeta& meta_data,
+                                  InstanceID const& instance_id, ObjectID& id) {
+  InstanceID computed_instance_id = instance_id;
+  prepare_metadata(meta_data, instance_id);
   // if the metadata has incomplete components, trigger an remote meta sync.
   if (meta_data.incomplete()) {
     VINEYARD_SUPPRESS(SyncMetaData());
@@ -120,6 +140,45 @@ Status ClientBase::CreateMetaData(ObjectMeta& meta_data,
   return status;
 }
 
+Status ClientBase::CreateMetaData(std::vector<ObjectMeta>& meta_datas,
+                                  std::vector<ObjectID>& ids) {
+  return this->CreateMetaData(meta_datas, this->instance_id_, ids);
+}
+
+Status ClientBase::CreateMetaData(std::vector<ObjectMeta>& meta_datas,
+                                  InstanceID const& instance_id,
+                                  std::vector<ObjectID>& ids) {
+  std::vector<json> trees;
+  bool incomplete = false;
+  for (auto& meta_data : meta_datas) {
+    prepare_metadata(meta_data, instance_id);
+    incomplete |= meta_data.incomplete();
+    trees.emplace_back(meta_data.MetaData());
+  }
+  // if the metadata has incomplete components, trigger an remote meta sync.
+  if (incomplete) {
+    VINEYARD_SUPPRESS(SyncMetaData());
+  }
+  std::vector<Signature> signatures;
+  std::vector<InstanceID> computed_instance_ids;
+  RETURN_ON_ERROR(CreateData(trees, ids, signatures, computed_instance_ids));
+  RETURN_ON_ASSERT(ids.size() == meta_datas.size(),
+                   "The number of created metadatas doesn't match");
+  for (size_t idx = 0; idx < meta_datas.size(); ++idx) {
+    auto& meta_data = meta_datas[idx];
+    meta_data.SetId(ids[idx]);
+    meta_data.SetSignature(signatures[idx]);
+    meta_data.SetClient(this);
+    meta_data.SetInstanceId(computed_instance_ids[idx]);
+    if (meta_data.incomplete()) {
+      ObjectMeta result_meta;
+      RETURN_ON_ERROR(this->GetMetaData(ids[idx], result_meta));
+      meta_data = result_meta;
+    }
+  }
+  return Status::OK();
+}
+
 Status ClientBase::SyncMetaData() {
   json __dummy;
   return GetData(InvalidObjectID(), __dummy, true, false);
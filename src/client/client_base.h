@@ -104,6 +104,20 @@ class ClientBase {
   Status CreateData(const json& tree, ObjectID& id, Signature& signature,
                     InstanceID& instance_id);
 
+  /**
+   * @brief Create the metadatas in the vineyard server with a single request.
+   *
+   * @param trees The metadatas that will be created in vineyard.
+   * @param ids The returned object IDs of the created data.
+   * @param instance_ids The vineyard instance IDs where these objects are
+   * created at.
+   *
+   * @return Status that indicates whether the create action has succeeded.
+   */
+  Status CreateData(const std::vector<json>& trees, std::vector<ObjectID>& ids,
+                    std::vector<Signature>& signatures,
+                    std::vector<InstanceID>& instance_ids);
+
   /**
    * @brief Create the metadata in the vineyard server, after created, the
    * resulted object id in the `meta_data` will be filled.
@@ -131,6 +145,32 @@ class ClientBase {
   Status CreateMetaData(ObjectMeta& meta_data, InstanceID const& instance_id,
                         ObjectID& id);
 
+  /**
+   * @brief Create the metadatas in the vineyard server with a single request,
+   * after created, the resulted object ids in the `meta_datas` will be filled.
+   *
+   * @param meta_datas The metadatas that will be created in vineyard.
+   * @param ids The returned object IDs of the created metadatas.
+   *
+   * @return Status that indicates whether the create action has succeeded.
+   */
+  Status CreateMetaData(std::vector<ObjectMeta>& meta_datas,
+                        std::vector<ObjectID>& ids);
+
+  /**
+   * @brief Create the metadatas in the vineyard server with specified instance
+   * id and a single request, see also `CreateMetaData(meta_data, instance_id,
+   * id)`.
+   *
+   * @param meta_datas The metadatas that will be created in vineyard.
+   * @param ids The returned object IDs of the created metadatas.
+   *
+   * @return Status that indicates whether the create action has succeeded.
+   */
+  Status CreateMetaData(std::vector<ObjectMeta>& meta_datas,
+                        InstanceID const& instance_id,
+                        std::vector<ObjectID>& ids);
+
   /**
    * @brief Get the meta-data of the requested object
    *
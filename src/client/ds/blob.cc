@@ -188,8 +188,8 @@ std::shared_ptr<Blob> Blob::FromPointer(Client& client, const uintptr_t pointer,
   } else {
     std::unique_ptr<BlobWriter> writer;
     VINEYARD_CHECK_OK(client.CreateBlob(size, writer));
-    memory::inline_memcpy(writer->data(), reinterpret_cast<uint8_t*>(pointer),
-                          size);
+    memory::concurrent_memcpy(writer->data(),
+                              reinterpret_cast<uint8_t*>(pointer), size);
     return std::dynamic_pointer_cast<Blob>(writer->Seal(client));
   }
 }
@@ -15,8 +15,12 @@ limitations under the License.
 
 #include "client/ds/i_object.h"
 
+#include <string>
+#include <vector>
+
 #include "client/client.h"
 #include "client/client_base.h"
+#include "common/util/parallel.h"
 
 namespace vineyard {
 
@@ -79,4 +83,104 @@ Status ObjectBuilder::_Seal(Client& client, std::shared_ptr<Object>& object) {
       "The _Seal(client, object) not implemented, use _Seal(client) instead");
 }
 
+Status ObjectBuilder::_Assemble(Client& client,
+                                std::shared_ptr<Object>& object) {
+  return Status::NotImplemented(
+      "The _Assemble(client, object) not implemented, use _Seal() instead");
+}
+
+Status ObjectBuilder::_PostSeal(Client& client,
+                                std::shared_ptr<Object>& object) {
+  this->set_sealed(true);
+  return Status::OK();
+}
+
+namespace detail {
+
+// the members of an assembled object have been created in vineyard server,
+// although the metadata of the object itself hasn't
+void collect_members(ObjectMeta const& meta, std::vector<ObjectID>& ids) {
+  for (auto const& item : meta.MetaData().items()) {
+    if (item.value().is_object() && item.value().contains("id")) {
+      ids.emplace_back(ObjectIDFromString(
+          item.value()["id"].get_ref<std::string const&>()));
+    }
+  }
+}
+
+}  // namespace detail
+
+Status ObjectBuilder::_SealBatch(
+    Client& client, std::vector<std::shared_ptr<ObjectBuilder>> const& builders,
+    std::vector<std::shared_ptr<Object>>& objects, size_t const concurrency) {
+  size_t n = builders.size();
+  objects.assign(n, nullptr);
+
+  // the builders that are sealed by `_Seal`, as `_Assemble` is not supported
+  std::vector<uint8_t> sealed(n, false);
+  auto status =
+      parallel_for_status(n, concurrency, [&](size_t index) -> Status {
+        std::shared_ptr<Object> object;
+        auto s = builders[index]->_Assemble(client, object);
+        if (s.IsNotImplemented()) {
+          sealed[index] = true;
+          s = builders[index]->_Seal(client, object);
+        }
+        if (s.ok()) {
+          objects[index] = object;
+        }
+        return s;
+      });
+
+  // create the metadata of assembled objects in a single request
+  std::vector<size_t> indices;
+  std::vector<ObjectMeta> metas;
+  if (status.ok()) {
+    for (size_t index = 0; index < n; ++index) {
+      if (!sealed[index]) {
+        indices.emplace_back(index);
+        metas.emplace_back(std::move(objects[index]->meta_));
+      }
+    }
+  }
+  std::vector<ObjectID> ids;
+  if (status.ok() && !metas.empty()) {
+    status = client.CreateMetaData(metas, ids);
+    if (!status.ok()) {
+      for (size_t idx = 0; idx < indices.size(); ++idx) {
+        objects[indices[idx]]->meta_ = std::move(metas[idx]);
+      }
+    }
+  }
+
+  if (!status.ok()) {
+    // release what has been created, the batch is either sealed as a whole
+    // or not at all
+    std::vector<ObjectID> created;
+    for (size_t index = 0; index < n; ++index) {
+      if (objects[index] == nullptr) {
+        continue;
+      }
+      if (sealed[index]) {
+        created.emplace_back(objects[index]->id());
+      } else {
+        detail::collect_members(objects[index]->meta_, created);
+      }
+    }
+    if (!created.empty()) {
+      VINEYARD_DISCARD(client.DelData(created, false, true));
+    }
+    objects.clear();
+    return status;
+  }
+
+  for (size_t idx = 0; idx < indices.size(); ++idx) {
+    auto& object = objects[indices[idx]];
+    object->meta_ = std::move(metas[idx]);
+    object->id_ = ids[idx];
+    RETURN_ON_ERROR(builders[indices[idx]]->_PostSeal(client, object));
+  }
+  return Status::OK();
+}
+
 }  // namespace vineyard
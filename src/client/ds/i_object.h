@@ -19,6 +19,7 @@ limitations under the License.
 #include <iostream>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "client/ds/object_factory.h"
 #include "client/ds/object_meta.h"
@@ -179,6 +180,7 @@ class Object : public ObjectBase, public std::enable_shared_from_this<Object> {
   friend class PlasmaClient;
   friend class RPCClient;
   friend class ObjectMeta;
+  friend class ObjectBuilder;
 };
 
 /**
@@ -204,6 +206,36 @@ class ObjectBuilder : public ObjectBase {
   //  protected: FIXME
   virtual Status _Seal(Client& client, std::shared_ptr<Object>& object);
 
+  /**
+   * @brief Builds the object and assembles its metadata as what `_Seal` does,
+   * but doesn't create the metadata in vineyard server. The builder is sealed
+   * by `_PostSeal` once the metadata has been created.
+   *
+   * Returns `Status::NotImplemented` if the builder doesn't support that, and
+   * `_Seal` should be used instead.
+   */
+  //  protected: FIXME
+  virtual Status _Assemble(Client& client, std::shared_ptr<Object>& object);
+
+  //  protected: FIXME
+  virtual Status _PostSeal(Client& client, std::shared_ptr<Object>& object);
+
+  /**
+   * @brief Seals the builders on at most `concurrency` threads (0 means the
+   * number of hardware threads, see also `parallel_for_status`), where the
+   * metadata of the resulting objects are created in vineyard server with a
+   * single request.
+   *
+   * The layout of the resulting objects is the same as what `_Seal` makes.
+   * On failure, the blobs and objects that have been created by the batch are
+   * deleted and `objects` is left empty.
+   */
+  static Status _SealBatch(
+      Client& client,
+      std::vector<std::shared_ptr<ObjectBuilder>> const& builders,
+      std::vector<std::shared_ptr<Object>>& objects,
+      size_t const concurrency = 1);
+
   bool sealed() const { return sealed_; }
 
  protected:
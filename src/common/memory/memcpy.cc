@@ -0,0 +1,537 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// n.b.: the intrinsics must be included before `memcpy.h`, see the include
+// inside the namespace there.
+#if defined(__x86_64__) && !defined(__VINEYARD_NO_RDTSC) && !defined(__VPP)
+#include <immintrin.h>
+#define VINEYARD_MEMCPY_X86 1
+#endif
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/memory/memcpy.h"
+#include "common/util/env.h"
+
+namespace vineyard {
+
+namespace memory {
+
+namespace detail {
+
+// the granularity of work split across threads, also keeps the boundaries
+// of chunks page aligned in the destination.
+static constexpr size_t kMemcpyChunkAlignment = 4096;
+// copies smaller than this never pay for the calibration.
+static constexpr size_t kMemcpyLargeThreshold = 1024 * 1024;
+
+#if defined(VINEYARD_MEMCPY_X86)
+
+__attribute__((target("avx2"))) static void memcpy_avx2(
+    char* __restrict dst, const char* __restrict src, size_t size) {
+  if (size < 256) {
+    inline_memcpy(dst, src, size);
+    return;
+  }
+  // align the destination to 32 bytes
+  size_t padding = (32 - (reinterpret_cast<size_t>(dst) & 31)) & 31;
+  if (padding > 0) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+    dst += padding;
+    src += padding;
+    size -= padding;
+  }
+  while (size >= 128) {
+    __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 0);
+    __m256i c1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 1);
+    __m256i c2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 2);
+    __m256i c3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + 3);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dst) + 0, c0);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dst) + 1, c1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dst) + 2, c2);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(dst) + 3, c3);
+    src += 128;
+    dst += 128;
+    size -= 128;
+  }
+  inline_memcpy(dst, src, size);
+}
+
+__attribute__((target("avx512f"))) static void memcpy_avx512(
+    char* __restrict dst, const char* __restrict src, size_t size) {
+  if (size < 512) {
+    inline_memcpy(dst, src, size);
+    return;
+  }
+  // align the destination to 64 bytes
+  size_t padding = (64 - (reinterpret_cast<size_t>(dst) & 63)) & 63;
+  if (padding > 0) {
+    _mm512_storeu_si512(dst, _mm512_loadu_si512(src));
+    dst += padding;
+    src += padding;
+    size -= padding;
+  }
+  while (size >= 256) {
+    __m512i c0 = _mm512_loadu_si512(src + 0);
+    __m512i c1 = _mm512_loadu_si512(src + 64);
+    __m512i c2 = _mm512_loadu_si512(src + 128);
+    __m512i c3 = _mm512_loadu_si512(src + 192);
+    _mm512_store_si512(dst + 0, c0);
+    _mm512_store_si512(dst + 64, c1);
+    _mm512_store_si512(dst + 128, c2);
+    _mm512_store_si512(dst + 192, c3);
+    src += 256;
+    dst += 256;
+    size -= 256;
+  }
+  inline_memcpy(dst, src, size);
+}
+
+/**
+ * Non-temporal stores bypass the cache hierarchy, which avoids polluting
+ * the LLC (and the read-for-ownership traffic) when the destination won't
+ * be read back soon, i.e., the copy is much larger than the LLC.
+ */
+static void memcpy_nontemporal(char* __restrict dst,
+                               const char* __restrict src, size_t size) {
+  if (size < 1024) {
+    inline_memcpy(dst, src, size);
+    return;
+  }
+  size_t padding = (16 - (reinterpret_cast<size_t>(dst) & 15)) & 15;
+  if (padding > 0) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    dst += padding;
+    src += padding;
+    size -= padding;
+  }
+  while (size >= 128) {
+    _mm_prefetch(src + 512, _MM_HINT_NTA);
+    __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 0);
+    __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 1);
+    __m128i c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 2);
+    __m128i c3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 3);
+    __m128i c4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 4);
+    __m128i c5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 5);
+    __m128i c6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 6);
+    __m128i c7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 7);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 0, c0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 1, c1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 2, c2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 3, c3);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 4, c4);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 5, c5);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 6, c6);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst) + 7, c7);
+    src += 128;
+    dst += 128;
+    size -= 128;
+  }
+  // make the streaming stores globally visible before returning
+  _mm_sfence();
+  inline_memcpy(dst, src, size);
+}
+
+static bool cpu_supports(MemcpyStrategy strategy) {
+  switch (strategy) {
+  case MemcpyStrategy::kAVX2:
+    return __builtin_cpu_supports("avx2");
+  case MemcpyStrategy::kAVX512:
+    return __builtin_cpu_supports("avx512f");
+  default:
+    return true;
+  }
+}
+
+// 512-bit stores lower the frequency of the cores on Skylake-SP and Cascade
+// Lake, but not on Ice Lake, Zen 4 and later CPUs, which are told apart by
+// AVX512-VBMI2.
+static bool cpu_prefers_avx512() {
+  return __builtin_cpu_supports("avx512f") &&
+         __builtin_cpu_supports("avx512vbmi2");
+}
+
+#else
+
+static bool cpu_supports(MemcpyStrategy strategy) {
+  return strategy == MemcpyStrategy::kSSE2;
+}
+
+static bool cpu_prefers_avx512() { return false; }
+
+#endif
+
+static inline void memcpy_with(MemcpyStrategy strategy, char* __restrict dst,
+                               const char* __restrict src, size_t size) {
+  switch (strategy) {
+#if defined(VINEYARD_MEMCPY_X86)
+  case MemcpyStrategy::kAVX2:
+    memcpy_avx2(dst, src, size);
+    break;
+  case MemcpyStrategy::kAVX512:
+    memcpy_avx512(dst, src, size);
+    break;
+  case MemcpyStrategy::kNonTemporal:
+    memcpy_nontemporal(dst, src, size);
+    break;
+#endif
+  default:
+    inline_memcpy(dst, src, size);
+  }
+}
+
+static size_t read_env_size(const char* name, size_t default_value) {
+  std::string value = read_env(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  return static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+}
+
+static size_t llc_size() {
+  long size = -1;  // NOLINT(runtime/int)
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+  size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+  if (size <= 0) {
+    size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  }
+#endif
+  if (size <= 0) {
+    size = 32L * 1024 * 1024;
+  }
+  return static_cast<size_t>(size);
+}
+
+/**
+ * A small pool of copy workers, shared by all concurrent large copies in
+ * the process. The caller of a copy always takes part in the work, and helps
+ * draining the queue while waiting, thus a busy pool never stalls a copy.
+ */
+class MemcpyWorkers {
+ public:
+  explicit MemcpyWorkers(size_t workers) : pid_(getpid()) {
+    for (size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back([this]() { this->loop(); });
+    }
+  }
+
+  ~MemcpyWorkers() {
+    if (!usable()) {
+      // the threads don't exist in a forked child, and joining (or detaching)
+      // them is undefined, thus leak the handles instead
+      new std::vector<std::thread>(std::move(threads_));
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cv_.notify_all();
+    for (auto& thread : threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+
+  // the worker threads don't survive `fork()`
+  bool usable() const { return pid_ == getpid(); }
+
+  void Submit(std::function<void()>&& task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  bool RunOne() {
+    std::function<void()> task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (tasks_.empty()) {
+        return false;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+    return true;
+  }
+
+ private:
+  void loop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+        if (stopped_ && tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  const pid_t pid_;
+  bool stopped_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> threads_;
+};
+
+static MemcpyWorkers* memcpy_workers(size_t concurrency) {
+  static std::once_flag flag;
+  static std::unique_ptr<MemcpyWorkers> workers;
+  std::call_once(flag, [concurrency]() {
+    workers.reset(new MemcpyWorkers(concurrency > 1 ? concurrency - 1 : 0));
+  });
+  return workers->usable() ? workers.get() : nullptr;
+}
+
+static void memcpy_parallel(MemcpyStrategy strategy, char* __restrict dst,
+                            const char* __restrict src, size_t size,
+                            size_t concurrency, MemcpyWorkers* workers) {
+  size_t chunk = (size + concurrency - 1) / concurrency;
+  chunk = (chunk + kMemcpyChunkAlignment - 1) & ~(kMemcpyChunkAlignment - 1);
+  size_t chunks = (size + chunk - 1) / chunk;
+
+  std::atomic<size_t> remaining(chunks - 1);
+  for (size_t index = 1; index < chunks; ++index) {
+    size_t offset = index * chunk;
+    size_t length = std::min(chunk, size - offset);
+    workers->Submit([strategy, dst, src, offset, length, &remaining]() {
+      memcpy_with(strategy, dst + offset, src + offset, length);
+      remaining.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  memcpy_with(strategy, dst, src, std::min(chunk, size));
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    if (!workers->RunOne()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename F>
+static double measure_seconds(F&& fn, const size_t rounds) {
+  double best = std::numeric_limits<double>::max();
+  for (size_t round = 0; round < rounds; ++round) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - start).count());
+  }
+  return best;
+}
+
+static void calibrate(MemcpyProfile& profile) {
+  const MemcpyStrategy candidates[] = {
+      MemcpyStrategy::kSSE2, MemcpyStrategy::kAVX2, MemcpyStrategy::kAVX512};
+
+  // in-cache copies: the buffers fit into the L2/LLC
+  {
+    const size_t size = std::min<size_t>(256 * 1024, profile.llc_size / 4);
+    std::unique_ptr<char[]> src(new char[size]), dst(new char[size]);
+    memset(src.get(), 0x5a, size);
+    double best = std::numeric_limits<double>::max();
+    for (auto strategy : candidates) {
+      if (!cpu_supports(strategy)) {
+        continue;
+      }
+      double elapsed = measure_seconds(
+          [&]() { memcpy_with(strategy, dst.get(), src.get(), size); }, 16);
+      if (elapsed < best) {
+        best = elapsed;
+        profile.cached = strategy;
+      }
+    }
+  }
+
+  // out-of-cache copies: cached stores vs. non-temporal stores, and a single
+  // thread vs. the copy workers
+  {
+    const size_t size = std::max<size_t>(
+        16 * 1024 * 1024,
+        std::min<size_t>(2 * profile.llc_size, 128 * 1024 * 1024));
+    std::unique_ptr<char[]> src(new char[size]), dst(new char[size]);
+    memset(src.get(), 0x5a, size);
+    memset(dst.get(), 0xa5, size);
+
+    double cached = measure_seconds(
+        [&]() { memcpy_with(profile.cached, dst.get(), src.get(), size); }, 3);
+    double streaming = measure_seconds(
+        [&]() {
+          memcpy_with(MemcpyStrategy::kNonTemporal, dst.get(), src.get(),
+                      size);
+        },
+        3);
+    if (cpu_supports(MemcpyStrategy::kNonTemporal) && streaming < cached) {
+      profile.streaming = MemcpyStrategy::kNonTemporal;
+    } else {
+      profile.streaming = profile.cached;
+      profile.streaming_threshold = std::numeric_limits<size_t>::max();
+    }
+
+    if (profile.max_concurrency > 1) {
+      MemcpyWorkers* workers = memcpy_workers(profile.max_concurrency);
+      double single = std::min(cached, streaming);
+      double parallel = measure_seconds(
+          [&]() {
+            memcpy_parallel(profile.streaming, dst.get(), src.get(), size,
+                            profile.max_concurrency, workers);
+          },
+          3);
+      if (parallel >= single * 0.9) {
+        // memory bandwidth is already saturated by a single thread
+        profile.parallel_threshold = std::numeric_limits<size_t>::max();
+      }
+    }
+  }
+}
+
+static MemcpyProfile detect_profile() {
+  MemcpyProfile profile;
+  profile.llc_size = llc_size();
+  profile.cached = MemcpyStrategy::kSSE2;
+  if (cpu_prefers_avx512()) {
+    profile.cached = MemcpyStrategy::kAVX512;
+  } else if (cpu_supports(MemcpyStrategy::kAVX2)) {
+    profile.cached = MemcpyStrategy::kAVX2;
+  }
+  profile.streaming = cpu_supports(MemcpyStrategy::kNonTemporal)
+                          ? MemcpyStrategy::kNonTemporal
+                          : profile.cached;
+  // "more than a half of L3 cache", see the notes of `inline_memcpy`
+  profile.streaming_threshold = profile.llc_size / 2;
+  profile.parallel_threshold = read_env_size(
+      "VINEYARD_MEMCPY_PARALLEL_THRESHOLD", 8 * 1024 * 1024);
+  profile.max_concurrency = read_env_size(
+      "VINEYARD_MEMCPY_CONCURRENCY",
+      std::min<size_t>(8, std::max<size_t>(
+                              1, std::thread::hardware_concurrency() / 2)));
+  if (profile.max_concurrency == 0) {
+    profile.max_concurrency = 1;
+  }
+
+  return profile;
+}
+
+/**
+ * The calibration allocates and copies up to hundreds of MBs, thus it is
+ * opt-in, and runs on a background thread rather than inside the first large
+ * copy. The heuristic profile is used until the calibration finishes.
+ */
+static const MemcpyProfile* current_profile() {
+  static std::atomic<const MemcpyProfile*> profile(nullptr);
+  static std::once_flag flag;
+  std::call_once(flag, []() {
+    auto detected = new MemcpyProfile(detect_profile());
+    profile.store(detected, std::memory_order_release);
+    if (read_env("VINEYARD_MEMCPY_CALIBRATE", "0") != "0") {
+      std::thread([detected]() {
+        auto calibrated = new MemcpyProfile(*detected);
+        calibrate(*calibrated);
+        // the explicitly specified threshold takes precedence
+        if (!read_env("VINEYARD_MEMCPY_PARALLEL_THRESHOLD").empty()) {
+          calibrated->parallel_threshold = detected->parallel_threshold;
+        }
+        // the previous profile is leaked, as concurrent copies may use it
+        profile.store(calibrated, std::memory_order_release);
+      }).detach();
+    }
+  });
+  return profile.load(std::memory_order_acquire);
+}
+
+}  // namespace detail
+
+const char* MemcpyStrategyName(MemcpyStrategy strategy) {
+  switch (strategy) {
+  case MemcpyStrategy::kSSE2:
+    return "sse2";
+  case MemcpyStrategy::kAVX2:
+    return "avx2";
+  case MemcpyStrategy::kAVX512:
+    return "avx512";
+  case MemcpyStrategy::kNonTemporal:
+    return "non-temporal";
+  default:
+    return "unknown";
+  }
+}
+
+MemcpyProfile GetMemcpyProfile() { return *detail::current_profile(); }
+
+void* concurrent_memcpy(void* __restrict dst_, const void* __restrict src_,
+                        size_t size, size_t concurrency) {
+  if (size < detail::kMemcpyLargeThreshold) {
+    return inline_memcpy(dst_, src_, size);
+  }
+  char* __restrict dst = reinterpret_cast<char* __restrict>(dst_);
+  const char* __restrict src = reinterpret_cast<const char* __restrict>(src_);
+
+  const MemcpyProfile& profile = *detail::current_profile();
+  MemcpyStrategy strategy = size > profile.streaming_threshold
+                                ? profile.streaming
+                                : profile.cached;
+  if (concurrency == 0) {
+    concurrency = profile.max_concurrency;
+  }
+  concurrency = std::min(concurrency, profile.max_concurrency);
+  if (concurrency > 1 && size >= profile.parallel_threshold) {
+    // each thread copies at least half of the threshold
+    concurrency = std::min(
+        concurrency,
+        std::max<size_t>(1, size / std::max<size_t>(
+                                       1, profile.parallel_threshold / 2)));
+    detail::MemcpyWorkers* workers =
+        detail::memcpy_workers(profile.max_concurrency);
+    if (concurrency > 1 && workers != nullptr) {
+      detail::memcpy_parallel(strategy, dst, src, size, concurrency, workers);
+      return dst_;
+    }
+  }
+  detail::memcpy_with(strategy, dst, src, size);
+  return dst_;
+}
+
+}  // namespace memory
+
+}  // namespace vineyard
@@ -20,6 +20,7 @@
 
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 namespace vineyard {
 
@@ -117,8 +118,8 @@ namespace memory {
   * 1. Test on real production workload.
   * 2. For synthetic test, see utils/memcpy-bench, but make sure you will do the best to exhaust the wide range of scenarios.
   *
-  * TODO: Add self-tuning memcpy with bayesian bandits algorithm for large sizes.
-  * See https://habr.com/en/company/yandex/blog/457612/
+  * n.b.: for large copies in vineyard (e.g., blob payloads), use `concurrent_memcpy`,
+  * which selects the kernel by CPU detection and an optional calibration.
   */
 
 static inline void * inline_memcpy(void * __restrict dst_, const void * __restrict src_, size_t size)
@@ -250,6 +251,66 @@ static inline void * inline_memcpy(void * __restrict dst_, const void * __restri
 
 // clang-format on
 
+/**
+ * @brief The copy kernels that can be selected for large copies.
+ */
+enum class MemcpyStrategy {
+  kSSE2 = 0,         // `inline_memcpy`
+  kAVX2 = 1,         // 32-byte unaligned loads and aligned stores
+  kAVX512 = 2,       // 64-byte unaligned loads and aligned stores
+  kNonTemporal = 3,  // cache-bypassing stores
+};
+
+const char* MemcpyStrategyName(MemcpyStrategy strategy);
+
+/**
+ * @brief The tuned parameters of large copies, detected from the CPU features
+ * and optionally calibrated in background after the first large copy.
+ *
+ * Without calibration, AVX-512 is used on the CPUs that don't throttle on
+ * 512-bit stores (those having AVX512-VBMI2), AVX2 otherwise if supported.
+ */
+struct MemcpyProfile {
+  // kernel used for copies that don't exceed `streaming_threshold`
+  MemcpyStrategy cached;
+  // kernel used for copies that exceed `streaming_threshold`
+  MemcpyStrategy streaming;
+  size_t streaming_threshold;
+  // copies larger than this will be split across the copy workers
+  size_t parallel_threshold;
+  size_t max_concurrency;
+  size_t llc_size;
+};
+
+/**
+ * @brief Returns the profile used by `concurrent_memcpy`.
+ *
+ * The profile can be adjusted with the following environment variables:
+ *
+ *  - `VINEYARD_MEMCPY_CALIBRATE=1`: opt in to measure the kernels (including
+ *    AVX-512 on every CPU that supports it) and the thresholds on a
+ *    background thread, otherwise heuristics based on the CPU features and
+ *    the LLC size are used.
+ *  - `VINEYARD_MEMCPY_CONCURRENCY`: the max number of threads for a copy.
+ *  - `VINEYARD_MEMCPY_PARALLEL_THRESHOLD`: the minimal size (in bytes) of a
+ *    copy to be split across threads.
+ */
+MemcpyProfile GetMemcpyProfile();
+
+/**
+ * @brief Copy large buffers, e.g., blob payloads.
+ *
+ * Small copies are forwarded to `inline_memcpy`. Larger copies use the
+ * fastest kernel that the CPU supports, switch to non-temporal stores when
+ * the copy doesn't fit into the last level cache, and are split across a
+ * small pool of copy workers when exceeding the parallel threshold.
+ *
+ * @param concurrency The max number of threads to use, 0 means the value in
+ *        the profile.
+ */
+void* concurrent_memcpy(void* __restrict dst, const void* __restrict src,
+                        size_t size, size_t concurrency = 0);
+
 }  // namespace memory
 
 }  // namespace vineyard
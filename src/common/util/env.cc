@@ -23,6 +23,7 @@ limitations under the License.
 #include <cstring>
 
 #include "common/util/env.h"
+#include "common/util/logging.h"
 
 #if defined(__unix__) || defined(__unix) || defined(unix) || \
     (defined(__APPLE__) && defined(__MACH__))
@@ -78,6 +79,22 @@ static void parse_proc_smaps(int64_t& private_rss, int64_t& shared_rss) {
 
 }  // namespace detail
 
+double read_env_ratio(const char* name, const double default_value) {
+  std::string value = read_env(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  const char* start = value.c_str();
+  char* parsed_end = nullptr;
+  double ratio = std::strtod(start, &parsed_end);
+  if (parsed_end != start && *parsed_end == '\0' && ratio >= 0) {
+    return ratio;
+  }
+  LOG(WARNING) << "Invalid ratio in environment variable " << name << ": '"
+               << value << "', fallback to " << default_value;
+  return default_value;
+}
+
 void create_dirs(const char* path) {
   if (path == nullptr) {
     return;
@@ -53,6 +53,13 @@ inline std::string read_env(std::string const& name) {
   return read_env(name, "");
 }
 
+/**
+ * @brief Reads a non-negative ratio (e.g., a compaction threshold) from the
+ * environment variable, the default value is used (with a warning) if the
+ * variable is absent or invalid.
+ */
+double read_env_ratio(const char* name, const double default_value);
+
 inline std::string get_hostname() {
   auto hname = read_env("MY_HOST_NAME");
   if (!hname.empty()) {
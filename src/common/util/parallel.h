@@ -0,0 +1,77 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_COMMON_UTIL_PARALLEL_H_
+#define SRC_COMMON_UTIL_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * @brief Runs `func(i)` for `i` in [0, n) on at most `concurrency` threads
+ * (0 means the number of hardware threads), where the calling thread is one
+ * of the workers.
+ *
+ * `func` returns a `Status`, the remaining indices are skipped once an error
+ * happens, and the first error is returned.
+ */
+template <typename F>
+inline Status parallel_for_status(const size_t n, size_t concurrency,
+                                  const F& func) {
+  if (concurrency == 0) {
+    concurrency = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  size_t nthreads = std::min(n, concurrency);
+  if (nthreads <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      RETURN_ON_ERROR(func(i));
+    }
+    return Status::OK();
+  }
+  std::atomic<size_t> next(0);
+  std::mutex mutex;
+  Status status;
+  auto worker = [&]() {
+    size_t i;
+    while ((i = next.fetch_add(1, std::memory_order_relaxed)) < n) {
+      auto s = func(i);
+      if (!s.ok()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        status &= s;
+        next.store(n);  // stop others early
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < nthreads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return status;
+}
+
+}  // namespace vineyard
+
+#endif  // SRC_COMMON_UTIL_PARALLEL_H_
@@ -101,6 +101,8 @@ const std::string command_t::PLASMA_DEL_DATA_REPLY = "plasma_delete_data_reply";
 // Metadata APIs
 const std::string command_t::CREATE_DATA_REQUEST = "create_data_request";
 const std::string command_t::CREATE_DATA_REPLY = "create_data_reply";
+const std::string command_t::CREATE_DATAS_REQUEST = "create_datas_request";
+const std::string command_t::CREATE_DATAS_REPLY = "create_datas_reply";
 const std::string command_t::GET_DATA_REQUEST = "get_data_request";
 const std::string command_t::GET_DATA_REPLY = "get_data_reply";
 const std::string command_t::LIST_DATA_REQUEST = "list_data_request";
@@ -983,6 +985,44 @@ Status ReadCreateDataReply(const json& root, ObjectID& id, Signature& signature,
   return Status::OK();
 }
 
+void WriteCreateDatasRequest(const std::vector<json>& contents,
+                             std::string& msg) {
+  json root;
+  root["type"] = command_t::CREATE_DATAS_REQUEST;
+  root["content"] = contents;
+
+  encode_msg(root, msg);
+}
+
+Status ReadCreateDatasRequest(const json& root, std::vector<json>& contents) {
+  RETURN_ON_ASSERT(root["type"] == command_t::CREATE_DATAS_REQUEST);
+  contents = root["content"].get<std::vector<json>>();
+  return Status::OK();
+}
+
+void WriteCreateDatasReply(const std::vector<ObjectID>& ids,
+                           const std::vector<Signature>& signatures,
+                           const std::vector<InstanceID>& instance_ids,
+                           std::string& msg) {
+  json root;
+  root["type"] = command_t::CREATE_DATAS_REPLY;
+  root["ids"] = ids;
+  root["signatures"] = signatures;
+  root["instance_ids"] = instance_ids;
+
+  encode_msg(root, msg);
+}
+
+Status ReadCreateDatasReply(const json& root, std::vector<ObjectID>& ids,
+                            std::vector<Signature>& signatures,
+                            std::vector<InstanceID>& instance_ids) {
+  CHECK_IPC_ERROR(root, command_t::CREATE_DATAS_REPLY);
+  ids = root["ids"].get<std::vector<ObjectID>>();
+  signatures = root["signatures"].get<std::vector<Signature>>();
+  instance_ids = root["instance_ids"].get<std::vector<InstanceID>>();
+  return Status::OK();
+}
+
 void WriteGetDataRequest(const ObjectID id, const bool sync_remote,
                          const bool wait, std::string& msg) {
   json root;
@@ -79,6 +79,8 @@ struct command_t {
   // Metadata APIs
   static const std::string CREATE_DATA_REQUEST;
   static const std::string CREATE_DATA_REPLY;
+  static const std::string CREATE_DATAS_REQUEST;
+  static const std::string CREATE_DATAS_REPLY;
   static const std::string GET_DATA_REQUEST;
   static const std::string GET_DATA_REPLY;
   static const std::string LIST_DATA_REQUEST;
@@ -404,6 +406,20 @@ void WriteCreateDataReply(const ObjectID& id, const Signature& signature,
 Status ReadCreateDataReply(const json& root, ObjectID& id, Signature& signature,
                            InstanceID& instance_id);
 
+void WriteCreateDatasRequest(const std::vector<json>& contents,
+                             std::string& msg);
+
+Status ReadCreateDatasRequest(const json& root, std::vector<json>& contents);
+
+void WriteCreateDatasReply(const std::vector<ObjectID>& ids,
+                           const std::vector<Signature>& signatures,
+                           const std::vector<InstanceID>& instance_ids,
+                           std::string& msg);
+
+Status ReadCreateDatasReply(const json& root, std::vector<ObjectID>& ids,
+                            std::vector<Signature>& signatures,
+                            std::vector<InstanceID>& instance_ids);
+
 void WriteGetDataRequest(const ObjectID id, const bool sync_remote,
                          const bool wait, std::string& msg);
 
@@ -249,6 +249,8 @@ bool SocketConnection::processMessage(const std::string& message_in) {
     return doPlasmaDelData(root);
   } else if (cmd == command_t::CREATE_DATA_REQUEST) {
     return doCreateData(root);
+  } else if (cmd == command_t::CREATE_DATAS_REQUEST) {
+    return doCreateDatas(root);
   } else if (cmd == command_t::GET_DATA_REQUEST) {
     return doGetData(root);
   } else if (cmd == command_t::DELETE_DATA_REQUEST) {
@@ -821,6 +823,33 @@ bool SocketConnection::doCreateData(const json& root) {
   return false;
 }
 
+bool SocketConnection::doCreateDatas(const json& root) {
+  auto self(shared_from_this());
+  std::vector<json> trees;
+  double startTime = GetCurrentTime();
+  TRY_READ_REQUEST(ReadCreateDatasRequest, root, trees);
+  RESPONSE_ON_ERROR(server_ptr_->CreateData(
+      trees, [self, startTime](const Status& status,
+                               const std::vector<ObjectID>& ids,
+                               const std::vector<Signature>& signatures,
+                               const std::vector<InstanceID>& instance_ids) {
+        std::string message_out;
+        if (status.ok()) {
+          WriteCreateDatasReply(ids, signatures, instance_ids, message_out);
+        } else {
+          VLOG(100) << "Error: " << status.ToString();
+          WriteErrorReply(status, message_out);
+        }
+        self->doWrite(message_out);
+        double endTime = GetCurrentTime();
+        LOG_SUMMARY("data_request_duration_microseconds", "create",
+                    (endTime - startTime) * 1000000);
+        LOG_COUNTER("data_requests_total", "create");
+        return Status::OK();
+      }));
+  return false;
+}
+
 bool SocketConnection::doGetData(const json& root) {
   auto self(shared_from_this());
   std::vector<ObjectID> ids;
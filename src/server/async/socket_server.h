@@ -101,6 +101,7 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
   bool doPlasmaDelData(json const& root);
 
   bool doCreateData(json const& root);
+  bool doCreateDatas(json const& root);
   bool doGetData(json const& root);
   bool doListData(json const& root);
   bool doDelData(json const& root);
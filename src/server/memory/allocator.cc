@@ -47,8 +47,8 @@ https://github.com/apache/arrow/blob/master/cpp/src/plasma/plasma_allocator.cc
 namespace vineyard {
 
 bool BulkAllocator::use_mimalloc_ = false;
-int64_t BulkAllocator::footprint_limit_ = 0;
-int64_t BulkAllocator::allocated_ = 0;
+std::atomic<int64_t> BulkAllocator::footprint_limit_{0};
+std::atomic<int64_t> BulkAllocator::allocated_{0};
 
 void* BulkAllocator::Init(const size_t size, std::string const& allocator) {
   if (allocator == "dlmalloc") {
@@ -68,9 +68,18 @@ void* BulkAllocator::Init(const size_t size, std::string const& allocator) {
 }
 
 void* BulkAllocator::Memalign(const size_t bytes, const size_t alignment) {
-  if (allocated_ + static_cast<int64_t>(bytes) > footprint_limit_) {
-    return nullptr;
-  }
+  // the reservation is committed only if it fits in the limit, thus a
+  // concurrent allocation never fails because of one that doesn't fit.
+  const int64_t size = static_cast<int64_t>(bytes);
+  const int64_t limit = footprint_limit_.load(std::memory_order_relaxed);
+  int64_t allocated = allocated_.load(std::memory_order_relaxed);
+  do {
+    if (allocated + size > limit) {
+      return nullptr;
+    }
+  } while (!allocated_.compare_exchange_weak(allocated, allocated + size,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
 
   void* mem = nullptr;
   if (use_mimalloc_) {
@@ -79,8 +88,8 @@ void* BulkAllocator::Memalign(const size_t bytes, const size_t alignment) {
   } else {
     mem = DLmallocAllocator::Allocate(bytes, alignment);
   }
-  if (mem != nullptr) {
-    allocated_ += bytes;
+  if (mem == nullptr) {
+    allocated_.fetch_sub(size, std::memory_order_acq_rel);
   }
   return mem;
 }
@@ -91,15 +100,15 @@ void BulkAllocator::Free(void* mem, size_t bytes) {
   } else {
     DLmallocAllocator::Free(mem, bytes);
   }
-  allocated_ -= bytes;
+  allocated_.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_acq_rel);
 }
 
 void BulkAllocator::SetFootprintLimit(size_t bytes) {
-  footprint_limit_ = static_cast<int64_t>(bytes);
+  footprint_limit_.store(static_cast<int64_t>(bytes));
 }
 
-int64_t BulkAllocator::GetFootprintLimit() { return footprint_limit_; }
+int64_t BulkAllocator::GetFootprintLimit() { return footprint_limit_.load(); }
 
-int64_t BulkAllocator::Allocated() { return allocated_; }
+int64_t BulkAllocator::Allocated() { return allocated_.load(); }
 
 }  // namespace vineyard
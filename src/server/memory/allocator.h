@@ -29,6 +29,7 @@
 #ifndef SRC_SERVER_MEMORY_ALLOCATOR_H_
 #define SRC_SERVER_MEMORY_ALLOCATOR_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -82,6 +83,10 @@ class BulkAllocator {
   static int64_t GetFootprintLimit();
 
   /// Get the number of bytes allocated by Plasma so far.
+  ///
+  /// The counter is updated lock-free, reading it never blocks concurrent
+  /// allocations.
+  ///
   /// \return Number of bytes allocated by Plasma so far.
   static int64_t Allocated();
 
@@ -90,8 +95,8 @@ class BulkAllocator {
 
  private:
   static bool use_mimalloc_;
-  static int64_t allocated_;
-  static int64_t footprint_limit_;
+  static std::atomic<int64_t> allocated_;
+  static std::atomic<int64_t> footprint_limit_;
 };
 
 }  // namespace vineyard
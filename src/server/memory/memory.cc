@@ -136,12 +136,11 @@ template <typename ID, typename P>
 BulkStoreBase<ID, P>::~BulkStoreBase() {
   std::vector<ID> object_ids;
   object_ids.reserve(objects_.size());
-  {
-    auto locked = objects_.lock_table();
-    for (auto iter = locked.begin(); iter != locked.end(); iter++) {
-      object_ids.emplace_back(iter->first);
-    }
-  }
+  objects_.traverse_fn(
+      [&object_ids](ID const& id, std::shared_ptr<P> const&) -> bool {
+        object_ids.emplace_back(id);
+        return true;
+      });
   for (auto const& item : object_ids) {
     VINEYARD_DISCARD(Delete(item));
     VINEYARD_DISCARD(DeleteGPU(item));
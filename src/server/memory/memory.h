@@ -47,6 +47,7 @@
 #include "common/util/macros.h"
 #include "common/util/status.h"
 #include "server/memory/gpu/gpuallocator.h"
+#include "server/memory/sharded.h"
 #include "server/memory/usage.h"
 
 namespace vineyard {
@@ -54,7 +55,7 @@ namespace vineyard {
 template <typename ID, typename P>
 class BulkStoreBase {
  public:
-  using object_map_t = libcuckoo::cuckoohash_map<ID, std::shared_ptr<P>>;
+  using object_map_t = ShardedCuckooMap<ID, std::shared_ptr<P>>;
 
   virtual ~BulkStoreBase();
 
@@ -83,7 +84,15 @@ class BulkStoreBase {
 
   Status DeleteGPU(ID const& object_id);
 
-  object_map_t& List() { return objects_; }
+  /**
+   * Visits the blobs in the store incrementally, only a fraction of the
+   * payload table is locked at a time. The visitor returns `false` to stop
+   * the traversal.
+   */
+  template <typename F>
+  void Traverse(F fn) const {
+    objects_.traverse_fn(fn);
+  }
 
   size_t Footprint() const;
   size_t FootprintLimit() const;
@@ -0,0 +1,142 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_SERVER_MEMORY_SHARDED_H_
+#define SRC_SERVER_MEMORY_SHARDED_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "libcuckoo/cuckoohash_map.hh"
+
+namespace vineyard {
+
+/**
+ * @brief A concurrent hash map that partitions its keys over several
+ * `libcuckoo::cuckoohash_map` shards.
+ *
+ * Point operations keep the semantics of `cuckoohash_map` (fine-grained
+ * bucket locking inside each shard), while whole-table operations (listing,
+ * draining on destruction) visit the shards incrementally and only hold the
+ * locks of one shard at a time, rather than freezing the whole store with
+ * `lock_table()`.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          size_t kShards = 32>
+class ShardedCuckooMap {
+  static_assert((kShards & (kShards - 1)) == 0,
+                "The number of shards must be a power of two");
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using shard_type = libcuckoo::cuckoohash_map<K, V, Hash>;
+
+  ShardedCuckooMap() = default;
+
+  ShardedCuckooMap(const ShardedCuckooMap&) = delete;
+  ShardedCuckooMap& operator=(const ShardedCuckooMap&) = delete;
+
+  template <typename F>
+  bool find_fn(const K& key, F fn) const {
+    return shard(key).find_fn(key, fn);
+  }
+
+  template <typename F>
+  bool update_fn(const K& key, F fn) {
+    return shard(key).update_fn(key, fn);
+  }
+
+  template <typename F>
+  bool erase_fn(const K& key, F fn) {
+    return shard(key).erase_fn(key, fn);
+  }
+
+  template <typename Key, typename... Args>
+  bool insert(Key&& key, Args&&... args) {
+    return shard(key).insert(std::forward<Key>(key),
+                             std::forward<Args>(args)...);
+  }
+
+  template <typename Key, typename Val>
+  bool insert_or_assign(Key&& key, Val&& value) {
+    return shard(key).insert_or_assign(std::forward<Key>(key),
+                                       std::forward<Val>(value));
+  }
+
+  bool erase(const K& key) { return shard(key).erase(key); }
+
+  bool contains(const K& key) const { return shard(key).contains(key); }
+
+  /**
+   * @brief The number of elements, the result is approximate when there are
+   * concurrent modifications.
+   */
+  size_t size() const {
+    size_t total = 0;
+    for (auto const& s : shards_) {
+      total += s.size();
+    }
+    return total;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Visits the elements shard by shard, the visitor returns `false` to
+   * stop the traversal early.
+   *
+   * Only one shard is locked at a time, so concurrent point operations on
+   * the other shards can still make progress. Elements that are inserted or
+   * erased concurrently in shards that haven't been visited yet may or may
+   * not be observed.
+   */
+  template <typename F>
+  void traverse_fn(F fn) const {
+    for (auto const& s : shards_) {
+      // `lock_table()` is not a const method in libcuckoo
+      auto locked = const_cast<shard_type&>(s).lock_table();
+      for (auto const& item : locked) {
+        if (!fn(item.first, item.second)) {
+          return;
+        }
+      }
+    }
+  }
+
+ private:
+  inline size_t shard_index(const K& key) const {
+    // fibonacci hashing: the low bits of object ids are not well distributed
+    uint64_t h = static_cast<uint64_t>(Hash()(key));
+    return static_cast<size_t>((h * 0x9E3779B97F4A7C15ULL) >> 40) &
+           (kShards - 1);
+  }
+
+  inline shard_type& shard(const K& key) { return shards_[shard_index(key)]; }
+
+  inline const shard_type& shard(const K& key) const {
+    return shards_[shard_index(key)];
+  }
+
+  std::array<shard_type, kShards> shards_;
+};
+
+}  // namespace vineyard
+
+#endif  // SRC_SERVER_MEMORY_SHARDED_H_
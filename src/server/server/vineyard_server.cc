@@ -348,37 +348,36 @@ Status VineyardServer::ListData(std::string const& pattern, bool const regex,
           if (current < limit &&
               meta_tree::MatchTypeName(false, pattern, "vineyard::Blob")) {
             // consider returns blob when not reach the limit
-            auto& blobs = self->bulk_store_->List();
-            {
-              auto locked = blobs.lock_table();
-              for (auto const& item : locked) {
-                if (current >= limit) {
-                  break;
-                }
-                if (!item.second->IsSealed()) {
-                  // skip unsealed blobs, otherwise `GetBuffers()` will fail on
-                  // client after `ListData()`.
-                  continue;
-                }
-                if (item.first ==
-                    GenerateBlobID(std::numeric_limits<uintptr_t>::max())) {
-                  // skip the dummy blob with the initialized blob id
-                  continue;
-                }
-                std::string sub_tree_key = ObjectIDToString(item.first);
-                json sub_tree;
-                {
-                  sub_tree["id"] = sub_tree_key;
-                  sub_tree["typename"] = "vineyard::Blob";
-                  sub_tree["length"] = item.second->data_size;
-                  sub_tree["nbytes"] = item.second->data_size;
-                  sub_tree["transient"] = true;
-                  sub_tree["instance_id"] = self->instance_id();
-                }
-                sub_tree_group[sub_tree_key] = sub_tree;
-                current += 1;
-              }
-            }
+            self->bulk_store_->Traverse(
+                [&](ObjectID const& id,
+                    std::shared_ptr<Payload> const& payload) -> bool {
+                  if (current >= limit) {
+                    return false;
+                  }
+                  if (!payload->IsSealed()) {
+                    // skip unsealed blobs, otherwise `GetBuffers()` will fail
+                    // on client after `ListData()`.
+                    return true;
+                  }
+                  if (id ==
+                      GenerateBlobID(std::numeric_limits<uintptr_t>::max())) {
+                    // skip the dummy blob with the initialized blob id
+                    return true;
+                  }
+                  std::string sub_tree_key = ObjectIDToString(id);
+                  json sub_tree;
+                  {
+                    sub_tree["id"] = sub_tree_key;
+                    sub_tree["typename"] = "vineyard::Blob";
+                    sub_tree["length"] = payload->data_size;
+                    sub_tree["nbytes"] = payload->data_size;
+                    sub_tree["transient"] = true;
+                    sub_tree["instance_id"] = self->instance_id();
+                  }
+                  sub_tree_group[sub_tree_key] = sub_tree;
+                  current += 1;
+                  return true;
+                });
           }
           return callback(status, sub_tree_group);
         } else {
@@ -403,13 +402,12 @@ Status VineyardServer::ListAllData(
           if (!s.ok()) {
             return callback(s, objects);
           }
-          auto& blobs = self->bulk_store_->List();
-          {
-            auto locked = blobs.lock_table();
-            for (auto const& item : locked) {
-              objects.emplace_back(item.first);
-            }
-          }
+          self->bulk_store_->Traverse(
+              [&objects](ObjectID const& id,
+                         std::shared_ptr<Payload> const&) -> bool {
+                objects.emplace_back(id);
+                return true;
+              });
           return callback(status, objects);
         } else {
           VLOG(100) << "Error: " << status.ToString();
@@ -549,6 +547,53 @@ Status VineyardServer::CreateData(
   return Status::OK();
 }
 
+Status VineyardServer::CreateData(
+    const std::vector<json>& trees,
+    callback_t<const std::vector<ObjectID>&, const std::vector<Signature>&,
+               const std::vector<InstanceID>&>
+        callback) {
+  ENSURE_VINEYARDD_READY();
+  auto self(shared_from_this());
+  auto ids = std::make_shared<std::vector<ObjectID>>();
+  auto signatures = std::make_shared<std::vector<Signature>>();
+  auto instance_ids = std::make_shared<std::vector<InstanceID>>();
+  // all metadatas are put in a single update to the meta tree
+  meta_service_ptr_->RequestToBulkUpdate(
+      [self, trees, ids, signatures, instance_ids](
+          const Status& status, const json& meta,
+          std::vector<meta_tree::op_t>& ops, ObjectID& id,
+          Signature& signature, InstanceID& computed_instance_id) {
+        if (status.ok()) {
+          for (auto const& tree : trees) {
+            auto decorated_tree = json::object();
+            RETURN_ON_ERROR(
+                detail::validate_metadata(tree, decorated_tree, signature));
+
+            Status s;
+            id = GenerateObjectID();
+            CATCH_JSON_ERROR(
+                s, meta_tree::PutDataOps(meta, self->instance_name(), id,
+                                         decorated_tree, ops,
+                                         computed_instance_id));
+            RETURN_ON_ERROR(s);
+            ids->emplace_back(id);
+            signatures->emplace_back(signature);
+            instance_ids->emplace_back(computed_instance_id);
+          }
+          return Status::OK();
+        } else {
+          VLOG(100) << "Error: " << status.ToString();
+          return status;
+        }
+      },
+      [ids, signatures, instance_ids, callback](
+          const Status& status, const ObjectID, const Signature,
+          const InstanceID) {
+        return callback(status, *ids, *signatures, *instance_ids);
+      });
+  return Status::OK();
+}
+
 Status VineyardServer::Persist(const ObjectID id, callback_t<> callback) {
   ENSURE_VINEYARDD_READY();
   auto self(shared_from_this());
@@ -129,6 +129,12 @@ class VineyardServer : public std::enable_shared_from_this<VineyardServer> {
       const json& tree, bool recursive,
       callback_t<const ObjectID, const Signature, const InstanceID> callback);
 
+  Status CreateData(
+      const std::vector<json>& trees,
+      callback_t<const std::vector<ObjectID>&, const std::vector<Signature>&,
+                 const std::vector<InstanceID>&>
+          callback);
+
   Status Persist(const ObjectID id, callback_t<> callback);
 
   Status IfPersist(const ObjectID id, callback_t<const bool> callback);
@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "server/services/etcd_meta_service.h"
 
+#include <algorithm>
 #include <chrono>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,6 +35,12 @@ limitations under the License.
 
 #define BACKOFF_RETRY_TIME 10
 
+// the max number of ops in a txn, see also the max-txn-ops limitation (128)
+#define MAX_TXN_OPS 127
+
+// the max number of txns of a commit that are in flight
+#define MAX_INFLIGHT_TXNS 8
+
 namespace vineyard {
 
 void EtcdWatchHandler::operator()(pplx::task<etcd::Response> const& resp_task) {
@@ -93,15 +102,49 @@ void EtcdWatchHandler::operator()(etcd::Response const& resp) {
   //      io_context__strand.html#boost_asio.reference.io_context__strand.orde
   //      r_of_handler_invocation
 
+  auto status = Status::EtcdError(resp.error_code(), resp.error_message());
+
+  std::lock_guard<std::mutex> scope_lock(pending_mutex_);
+  if (pending_ops_.empty()) {
+    pending_ops_ = std::move(ops);
+  } else {
+    pending_ops_.insert(pending_ops_.end(), ops.begin(), ops.end());
+  }
+  pending_rev_ = std::max(pending_rev_, head_rev);
+  if (!status.ok()) {
+    pending_status_ = status;
+  }
+  if (!pending_posted_) {
+    pending_posted_ = true;
+    pending_since_ = std::chrono::steady_clock::now();
+    ctx_.post(boost::bind(&EtcdWatchHandler::drain, this));
+  }
+}
+
+void EtcdWatchHandler::drain() {
 #ifndef NDEBUG
   static unsigned processed = 0;
 #endif
 
-  auto status = Status::EtcdError(resp.error_code(), resp.error_message());
+  std::vector<IMetaService::op_t> ops;
+  unsigned head_rev = 0;
+  Status status;
+  {
+    std::lock_guard<std::mutex> scope_lock(pending_mutex_);
+    ops.swap(pending_ops_);
+    head_rev = pending_rev_;
+    std::swap(status, pending_status_);
+    pending_posted_ = false;
+    LOG_SUMMARY("etcd_watch_lag_microseconds", "watch",
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - pending_since_)
+                    .count());
+  }
+  LOG_SUMMARY("etcd_watch_coalesced_events", "watch", ops.size());
 
   // NB: update the `handled_rev_` after we have truly applied the update ops.
-  ctx_.post(boost::bind(
-      callback_, status, ops, head_rev,
+  VINEYARD_DISCARD(callback_(
+      status, ops, head_rev,
       [this, status](Status const&, unsigned rev) -> Status {
         if (this->meta_service_ptr_->stopped()) {
           return Status::AlreadyStopped("etcd metadata service");
@@ -188,40 +231,61 @@ void EtcdMetaService::requestLock(
       });
 }
 
+struct EtcdMetaService::CommitState {
+  std::vector<op_t> changes;
+  callback_t<unsigned, const std::vector<op_t>&> callback_after_updated;
+  std::chrono::steady_clock::time_point start;
+
+  std::mutex mutex;
+  size_t txn_num = 0;
+  size_t issued = 0;
+  size_t finished = 0;
+  std::vector<bool> committed;  // per txn
+  unsigned rev = 0;
+  Status status;
+};
+
 void EtcdMetaService::commitUpdates(
     const std::vector<op_t>& changes,
-    callback_t<unsigned> callback_after_updated) {
+    callback_t<unsigned, const std::vector<op_t>&> callback_after_updated) {
   // Split to many small txns to conform the requirement of max-txn-ops
   // limitation (128) from etcd.
   //
-  // The first n segments will be performed synchronously while the last
-  // txn will still be executed in a asynchronous manner.
-  size_t offset = 0;
-  while (offset + 127 < changes.size()) {
-    etcdv3::Transaction tx;
-    for (size_t idx = offset; idx < offset + 127; ++idx) {
-      auto const& op = changes[idx];
-      if (op.op == op_t::kPut) {
-        tx.setup_put(prefix_ + op.kv.key, op.kv.value);
-      } else if (op.op == op_t::kDel) {
-        tx.setup_delete(prefix_ + op.kv.key);
-      }
-    }
-    auto resp = etcd_->txn(tx).get();
-    if (resp.is_ok()) {
-      offset += 127;
-      LOG_SUMMARY("etcd_request_duration_microseconds", "txn",
-                  resp.duration().count());
-    } else {
-      auto status = Status::EtcdError(resp.error_code(), resp.error_message());
-      server_ptr_->GetMetaContext().post(
-          boost::bind(callback_after_updated, status, resp.index()));
-      return;
+  // The txns are pipelined with at most MAX_INFLIGHT_TXNS of them in flight,
+  // unless a key is changed more than once, where the txns are committed
+  // one by one to keep the order of changes.
+  //
+  // No more txns are issued once one of them fails, and the callback
+  // receives the changes of the txns that have been committed.
+  auto state = std::make_shared<CommitState>();
+  state->changes = changes;
+  state->callback_after_updated = callback_after_updated;
+  state->start = std::chrono::steady_clock::now();
+  state->txn_num =
+      std::max(static_cast<size_t>(1),
+               (changes.size() + MAX_TXN_OPS - 1) / MAX_TXN_OPS);
+  state->committed.resize(state->txn_num, false);
+
+  size_t window = MAX_INFLIGHT_TXNS;
+  std::set<std::string> keys;
+  for (auto const& op : changes) {
+    if (!keys.emplace(op.kv.key).second) {
+      window = 1;
+      break;
     }
   }
+  state->issued = std::min(window, state->txn_num);
+  for (size_t txn = 0; txn < state->issued; ++txn) {
+    commitTxn(state, txn);
+  }
+}
+
+void EtcdMetaService::commitTxn(std::shared_ptr<CommitState> const& state,
+                                size_t txn) {
   etcdv3::Transaction tx;
-  for (size_t idx = offset; idx < changes.size(); ++idx) {
-    auto const& op = changes[idx];
+  size_t end = std::min(state->changes.size(), (txn + 1) * MAX_TXN_OPS);
+  for (size_t idx = txn * MAX_TXN_OPS; idx < end; ++idx) {
+    auto const& op = state->changes[idx];
     if (op.op == op_t::kPut) {
       tx.setup_put(prefix_ + op.kv.key, op.kv.value);
     } else if (op.op == op_t::kDel) {
@@ -229,10 +293,112 @@ void EtcdMetaService::commitUpdates(
     }
   }
   auto self(shared_from_base());
+  etcd_->txn(tx).then([self, state, txn](
+                          pplx::task<etcd::Response> const& resp_task) {
+    auto resp = resp_task.get();
+    VLOG(10) << "etcd txn use " << resp.duration().count() << " microseconds";
+    LOG_SUMMARY("etcd_request_duration_microseconds", "txn",
+                resp.duration().count());
+
+    Status status = Status::EtcdError(resp.error_code(), resp.error_message());
+    size_t next_txn = state->txn_num;
+    bool done = false;
+    {
+      std::lock_guard<std::mutex> scope_lock(state->mutex);
+      state->committed[txn] = status.ok();
+      if (state->status.ok()) {
+        if (self->stopped_.load()) {
+          state->status = Status::AlreadyStopped("etcd metadata service");
+        } else {
+          state->status = status;
+        }
+      }
+      state->rev = std::max(state->rev, static_cast<unsigned>(resp.index()));
+      state->finished += 1;
+      // reserve the next txn while holding the lock, thus the commit won't be
+      // finished before it
+      if (state->status.ok() && state->issued < state->txn_num) {
+        next_txn = state->issued++;
+      }
+      done = state->finished == state->issued &&
+             (state->issued == state->txn_num || !state->status.ok());
+    }
+    if (next_txn < state->txn_num) {
+      self->commitTxn(state, next_txn);
+    }
+    if (done) {
+      LOG_SUMMARY("etcd_request_duration_microseconds", "commit",
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - state->start)
+                      .count());
+      std::vector<op_t> committed;
+      if (state->status.ok()) {
+        committed = std::move(state->changes);
+      } else {
+        for (size_t txn = 0; txn < state->txn_num; ++txn) {
+          if (!state->committed[txn]) {
+            continue;
+          }
+          auto begin = state->changes.begin() + txn * MAX_TXN_OPS;
+          auto end = state->changes.begin() +
+                     std::min(state->changes.size(), (txn + 1) * MAX_TXN_OPS);
+          committed.insert(committed.end(), begin, end);
+        }
+        LOG(WARNING) << "Failed to commit " << state->changes.size()
+                     << " changes, " << committed.size()
+                     << " of them have been committed: "
+                     << state->status.ToString();
+      }
+      self->server_ptr_->GetMetaContext().post(
+          boost::bind(state->callback_after_updated, state->status, state->rev,
+                      std::move(committed)));
+    }
+  });
+}
+
+void EtcdMetaService::commitUpdatesIfUnchanged(
+    const std::vector<op_t>& changes,
+    const std::vector<std::string>& referenced, unsigned base_rev,
+    callback_t<unsigned> callback_after_updated) {
+  // the changes must fit into a single txn to be committed atomically, see
+  // also the max-txn-ops limitation in `commitUpdates()`.
+  if (changes.size() > MAX_TXN_OPS) {
+    server_ptr_->GetMetaContext().post(boost::bind(
+        callback_after_updated,
+        Status::NotImplemented("too many changes for a single etcd txn"),
+        base_rev));
+    return;
+  }
+  etcdv3::Transaction tx;
+  std::set<std::string> keys;
+  for (auto const& op : changes) {
+    std::string key = prefix_ + op.kv.key;
+    if (keys.emplace(key).second) {
+      // the key (if exists) hasn't been modified after `base_rev`
+      tx.add_compare_mod(key, static_cast<int64_t>(base_rev) + 1,
+                         etcdv3::CompareResult::LESS);
+    }
+    if (op.op == op_t::kPut) {
+      tx.setup_put(key, op.kv.value);
+    } else if (op.op == op_t::kDel) {
+      tx.setup_delete(key);
+    }
+  }
+  for (auto const& item : referenced) {
+    std::string key = prefix_ + item;
+    if (keys.emplace(key).second) {
+      // the linked member still exists, and hasn't been modified after
+      // `base_rev`, as a missing key passes the comparison of revisions
+      tx.add_compare_version(key, 0, etcdv3::CompareResult::GREATER);
+      tx.add_compare_mod(key, static_cast<int64_t>(base_rev) + 1,
+                         etcdv3::CompareResult::LESS);
+    }
+  }
+  auto self(shared_from_base());
   etcd_->txn(tx).then([self, callback_after_updated](
                           pplx::task<etcd::Response> const& resp_task) {
     auto resp = resp_task.get();
-    VLOG(10) << "etcd (last) txn use " << resp.duration().count()
+    VLOG(10) << "etcd (conditional) txn use " << resp.duration().count()
              << " microseconds";
     LOG_SUMMARY("etcd_request_duration_microseconds", "txn",
                 resp.duration().count());
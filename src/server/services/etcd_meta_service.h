@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef SRC_SERVER_SERVICES_ETCD_META_SERVICE_H_
 #define SRC_SERVER_SERVICES_ETCD_META_SERVICE_H_
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -83,6 +84,9 @@ class EtcdWatchHandler {
   void operator()(etcd::Response const& task);
 
  private:
+  // apply the pending events in the meta context
+  void drain();
+
   const std::shared_ptr<EtcdMetaService> meta_service_ptr_;
   asio::io_context& ctx_;
   const callback_t<const std::vector<IMetaService::op_t>&, unsigned,
@@ -93,6 +97,15 @@ class EtcdWatchHandler {
   callback_task_queue_t& registered_callbacks_;
   std::atomic<unsigned>& handled_rev_;
   std::mutex& registered_callbacks_mutex_;
+
+  // the events that arrive before the previous ones get applied are
+  // coalesced and applied together
+  std::mutex pending_mutex_;
+  std::vector<IMetaService::op_t> pending_ops_;
+  unsigned pending_rev_ = 0;
+  Status pending_status_;
+  bool pending_posted_ = false;
+  std::chrono::steady_clock::time_point pending_since_;
 };
 
 /**
@@ -148,7 +161,12 @@ class EtcdMetaService : public IMetaService {
       callback_t<const std::vector<op_t>&, unsigned> callback) override;
 
   void commitUpdates(const std::vector<op_t>&,
-                     callback_t<unsigned> callback_after_updated) override;
+                     callback_t<unsigned, const std::vector<op_t>&>
+                         callback_after_updated) override;
+
+  void commitUpdatesIfUnchanged(
+      const std::vector<op_t>&, const std::vector<std::string>& referenced,
+      unsigned base_rev, callback_t<unsigned> callback_after_updated) override;
 
   void startDaemonWatch(
       const std::string& prefix, unsigned since_rev,
@@ -162,6 +180,11 @@ class EtcdMetaService : public IMetaService {
 
   Status probe() override;
 
+  // the txns of a commit that are in flight
+  struct CommitState;
+
+  void commitTxn(std::shared_ptr<CommitState> const& state, size_t txn);
+
   const json etcd_spec_;
   const std::string prefix_;
 
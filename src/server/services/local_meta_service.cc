@@ -37,9 +37,20 @@ void LocalMetaService::requestLock(
 
 void LocalMetaService::commitUpdates(
     const std::vector<op_t>& changes,
-    callback_t<unsigned> callback_after_updated) {
+    callback_t<unsigned, const std::vector<op_t>&> callback_after_updated) {
   server_ptr_->GetMetaContext().post(
-      boost::bind(callback_after_updated, Status::OK(), 0));
+      boost::bind(callback_after_updated, Status::OK(), 0, changes));
+}
+
+void LocalMetaService::commitUpdatesIfUnchanged(
+    const std::vector<op_t>& changes, const std::vector<std::string>&,
+    unsigned, callback_t<unsigned> callback_after_updated) {
+  // there are no other instances to conflict with
+  commitUpdates(changes, [callback_after_updated](const Status& status,
+                                                  unsigned rev,
+                                                  const std::vector<op_t>&) {
+    return callback_after_updated(status, rev);
+  });
 }
 
 void LocalMetaService::requestAll(
@@ -67,7 +67,12 @@ class LocalMetaService : public IMetaService {
       callback_t<const std::vector<op_t>&, unsigned> callback) override;
 
   void commitUpdates(const std::vector<op_t>&,
-                     callback_t<unsigned> callback_after_updated) override;
+                     callback_t<unsigned, const std::vector<op_t>&>
+                         callback_after_updated) override;
+
+  void commitUpdatesIfUnchanged(
+      const std::vector<op_t>&, const std::vector<std::string>& referenced,
+      unsigned base_rev, callback_t<unsigned> callback_after_updated) override;
 
   void startDaemonWatch(
       const std::string& prefix, unsigned since_rev,
@@ -25,6 +25,7 @@ limitations under the License.
 #if defined(BUILD_VINEYARDD_REDIS)
 #include "server/services/redis_meta_service.h"
 #endif  // BUILD_VINEYARDD_REDIS
+#include "server/services/wal_meta_service.h"
 #include "server/util/meta_tree.h"
 
 namespace vineyard {
@@ -33,7 +34,8 @@ std::shared_ptr<IMetaService> IMetaService::Get(
     std::shared_ptr<VineyardServer> server_ptr) {
   std::string meta = server_ptr->GetSpec()["metastore_spec"]["meta"]
                          .get_ref<const std::string&>();
-  VINEYARD_ASSERT(meta == "etcd" || meta == "redis" || meta == "local",
+  VINEYARD_ASSERT(meta == "etcd" || meta == "redis" || meta == "wal" ||
+                      meta == "local",
                   "Invalid metastore: " + meta);
   if (meta == "etcd") {
     return std::shared_ptr<IMetaService>(new EtcdMetaService(server_ptr));
@@ -43,6 +45,9 @@ std::shared_ptr<IMetaService> IMetaService::Get(
     return std::shared_ptr<IMetaService>(new RedisMetaService(server_ptr));
   }
 #endif  // BUILD_VINEYARDD_REDIS
+  if (meta == "wal") {
+    return std::shared_ptr<IMetaService>(new WalMetaService(server_ptr));
+  }
   if (meta == "local") {
     return std::shared_ptr<IMetaService>(new LocalMetaService(server_ptr));
   }
@@ -166,62 +166,57 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
     this->metaUpdate(ops, from_remote);
   }
 
+  /**
+   * @brief Persist the changes to the backend.
+   *
+   * The changes are generated against the local meta tree first, and are
+   * committed only if none of the affected keys, nor the keys of the members
+   * they link to, has been modified (or deleted) after the revision that the
+   * local meta tree has caught up with. On conflicts (or
+   * when the backend doesn't support such conditional commits) it falls back
+   * to re-generate the changes against the latest meta tree with the
+   * `meta_sync_lock_` held.
+   */
   inline void RequestToPersist(
       callback_t<const json&, std::vector<op_t>&> callback_after_ready,
       callback_t<> callback_after_finish) {
-    // NB: when persist local meta to etcd, we needs the meta_sync_lock_ to
-    // avoid contention between other vineyard instances.
     auto self(shared_from_this());
-    this->requestLock(
-        meta_sync_lock_,
-        [self, callback_after_ready, callback_after_finish](
-            const Status& status, std::shared_ptr<ILock> lock) {
-          if (self->stopped_.load()) {
-            return Status::AlreadyStopped("etcd metadata service");
-          }
-          if (status.ok()) {
-            self->requestValues(
-                "", [self, callback_after_ready, callback_after_finish, lock](
-                        const Status& status, const json& meta, unsigned rev) {
-                  if (self->stopped_.load()) {
-                    return Status::AlreadyStopped("etcd metadata service");
-                  }
-                  std::vector<op_t> ops;
-                  auto s = callback_after_ready(status, meta, ops);
-                  if (s.ok()) {
-                    if (ops.empty()) {
-                      unsigned rev_after_unlock = 0;
-                      VINEYARD_DISCARD(lock->Release(rev_after_unlock));
-                      return callback_after_finish(Status::OK());
-                    }
-                    // apply changes locally before committing to etcd
-                    self->metaUpdate(ops, false);
-                    // commit to etcd
-                    self->commitUpdates(ops, [self, callback_after_finish,
-                                              lock](const Status& status,
-                                                    unsigned rev) {
-                      if (self->stopped_.load()) {
-                        return Status::AlreadyStopped("etcd metadata service");
-                      }
-                      // update rev_ to the revision after unlock.
-                      unsigned rev_after_unlock = 0;
-                      VINEYARD_DISCARD(lock->Release(rev_after_unlock));
-                      return callback_after_finish(status);
-                    });
-                    return Status::OK();
-                  } else {
-                    unsigned rev_after_unlock = 0;
-                    VINEYARD_DISCARD(lock->Release(rev_after_unlock));
-                    return callback_after_finish(s);  // propagate the error
-                  }
-                });
+    server_ptr_->GetMetaContext().post([self, callback_after_ready,
+                                        callback_after_finish]() {
+      if (self->stopped_.load()) {
+        VINEYARD_DISCARD(callback_after_finish(
+            Status::AlreadyStopped("etcd metadata service")));
+        return;
+      }
+      std::vector<op_t> ops;
+      auto s = callback_after_ready(Status::OK(), self->meta_, ops);
+      if (!s.ok() || ops.empty()) {
+        // the local meta tree may be stale: an error or an empty change set
+        // is confirmed against the latest meta tree
+        self->requestToPersistWithLock(callback_after_ready,
+                                       callback_after_finish);
+        return;
+      }
+      std::vector<std::string> referenced;
+      meta_tree::ReferencedKeys(ops, referenced);
+      self->commitUpdatesIfUnchanged(
+          ops, referenced, self->rev_,
+          [self, ops, callback_after_ready, callback_after_finish](
+              const Status& status, unsigned rev) {
+            if (self->stopped_.load()) {
+              return Status::AlreadyStopped("etcd metadata service");
+            }
+            if (status.ok()) {
+              self->metaUpdate(ops, false);
+              return callback_after_finish(Status::OK());
+            }
+            VLOG(10) << "Failed to persist without the lock, retry with it: "
+                     << status.ToString();
+            self->requestToPersistWithLock(callback_after_ready,
+                                           callback_after_finish);
             return Status::OK();
-          } else {
-            VLOG(100) << "Error: failed to request metadata lock: "
-                      << status.ToString();
-            return callback_after_finish(status);  // propagate the error
-          }
-        });
+          });
+    });
   }
 
   inline void RequestToGetData(const bool sync_remote,
@@ -304,7 +299,8 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
               // commit to etcd
               self->commitUpdates(
                   ops, [self, processed_delete_set, callback_after_finish,
-                        lock](const Status& status, unsigned rev) {
+                        lock](const Status& status, unsigned rev,
+                              const std::vector<op_t>&) {
                     if (self->stopped_.load()) {
                       return Status::AlreadyStopped("etcd metadata service");
                     }
@@ -374,6 +370,66 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
   bool stopped() const { return this->stopped_.load(); }
 
  private:
+  inline void requestToPersistWithLock(
+      callback_t<const json&, std::vector<op_t>&> callback_after_ready,
+      callback_t<> callback_after_finish) {
+    // NB: when persist local meta to etcd, we needs the meta_sync_lock_ to
+    // avoid contention between other vineyard instances.
+    auto self(shared_from_this());
+    this->requestLock(
+        meta_sync_lock_,
+        [self, callback_after_ready, callback_after_finish](
+            const Status& status, std::shared_ptr<ILock> lock) {
+          if (self->stopped_.load()) {
+            return Status::AlreadyStopped("etcd metadata service");
+          }
+          if (status.ok()) {
+            self->requestValues(
+                "", [self, callback_after_ready, callback_after_finish, lock](
+                        const Status& status, const json& meta, unsigned rev) {
+                  if (self->stopped_.load()) {
+                    return Status::AlreadyStopped("etcd metadata service");
+                  }
+                  std::vector<op_t> ops;
+                  auto s = callback_after_ready(status, meta, ops);
+                  if (s.ok()) {
+                    if (ops.empty()) {
+                      unsigned rev_after_unlock = 0;
+                      VINEYARD_DISCARD(lock->Release(rev_after_unlock));
+                      return callback_after_finish(Status::OK());
+                    }
+                    // commit to etcd, and apply the committed changes
+                    // locally, which are a subset of the changes on failures
+                    self->commitUpdates(
+                        ops, [self, callback_after_finish, lock](
+                                 const Status& status, unsigned rev,
+                                 const std::vector<op_t>& committed) {
+                          if (self->stopped_.load()) {
+                            return Status::AlreadyStopped(
+                                "etcd metadata service");
+                          }
+                          self->metaUpdate(committed, false);
+                          // update rev_ to the revision after unlock.
+                          unsigned rev_after_unlock = 0;
+                          VINEYARD_DISCARD(lock->Release(rev_after_unlock));
+                          return callback_after_finish(status);
+                        });
+                    return Status::OK();
+                  } else {
+                    unsigned rev_after_unlock = 0;
+                    VINEYARD_DISCARD(lock->Release(rev_after_unlock));
+                    return callback_after_finish(s);  // propagate the error
+                  }
+                });
+            return Status::OK();
+          } else {
+            VLOG(100) << "Error: failed to request metadata lock: "
+                      << status.ToString();
+            return callback_after_finish(status);  // propagate the error
+          }
+        });
+  }
+
   inline void registerToEtcd() {
     auto self(shared_from_this());
     RequestToPersist(
@@ -581,8 +637,34 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
     server_ptr_->MetaReady();  // notify server the meta svc is ready
   }
 
-  virtual void commitUpdates(const std::vector<op_t>&,
-                             callback_t<unsigned> callback_after_updated) = 0;
+  /**
+   * @brief Commit the updates, which may be split into several non-atomic
+   * steps by the backend. The callback receives the updates that have been
+   * committed, i.e., all of them on success, and those of the finished steps
+   * on failures.
+   */
+  virtual void commitUpdates(
+      const std::vector<op_t>&,
+      callback_t<unsigned, const std::vector<op_t>&>
+          callback_after_updated) = 0;
+
+  /**
+   * @brief Commit the updates atomically, only if none of the affected keys
+   * has been modified after `base_rev`, and the `referenced` keys still exist
+   * and haven't been modified after `base_rev` either, otherwise fails
+   * without any change.
+   *
+   * Backends that cannot do that fail it always, and the updates are then
+   * committed with the `meta_sync_lock_` held.
+   */
+  virtual void commitUpdatesIfUnchanged(
+      const std::vector<op_t>&, const std::vector<std::string>& referenced,
+      unsigned base_rev, callback_t<unsigned> callback_after_updated) {
+    server_ptr_->GetMetaContext().post(boost::bind(
+        callback_after_updated,
+        Status::NotImplemented("conditional commits in the meta service"),
+        base_rev));
+  }
 
   void requestValues(const std::string& prefix,
                      callback_t<const json&, unsigned> callback) {
@@ -864,22 +946,50 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
     if (ops.empty()) {
       return callback_after_update(Status::OK(), rev);
     }
-    // process events grouped by revision
+    // process events grouped by revision, and coalesce adjacent revisions
+    // into one batch unless they touch the same object (or key), as the
+    // `metaUpdate()` applies puts before deletes.
     size_t idx = 0;
     std::vector<op_t> op_batch;
+    std::set<std::string> batch_keys, revision_keys;
+    unsigned batch_rev = 0;
     while (idx < ops.size()) {
       unsigned head_index = ops[idx].kv.rev;
+      size_t begin = idx;
+      revision_keys.clear();
       while (idx < ops.size() && ops[idx].kv.rev == head_index) {
-        op_batch.emplace_back(ops[idx]);
+        revision_keys.emplace(conflictKey(ops[idx].kv.key));
         idx += 1;
       }
+      for (auto const& key : revision_keys) {
+        if (batch_keys.find(key) != batch_keys.end()) {
+          self->metaUpdate(op_batch, true);
+          op_batch.clear();
+          batch_keys.clear();
+          self->rev_ = batch_rev;
+          break;
+        }
+      }
+      op_batch.insert(op_batch.end(), ops.begin() + begin, ops.begin() + idx);
+      batch_keys.insert(revision_keys.begin(), revision_keys.end());
+      batch_rev = head_index;
+    }
+    if (!op_batch.empty()) {
       self->metaUpdate(op_batch, true);
-      op_batch.clear();
-      self->rev_ = head_index;
+      self->rev_ = batch_rev;
     }
     return callback_after_update(Status::OK(), rev);
   }
 
+  // the keys of an object are all changed in the same way
+  static std::string conflictKey(std::string const& key) {
+    static const std::string data_prefix = "/data/";
+    if (boost::algorithm::starts_with(key, data_prefix)) {
+      return key.substr(0, key.find('/', data_prefix.size()));
+    }
+    return key;
+  }
+
   std::unique_ptr<asio::steady_timer> heartbeat_timer_;
   std::set<InstanceID> instances_list_;
   int64_t target_latest_time_ = 0;
@@ -17,8 +17,12 @@ limitations under the License.
 
 #if defined(BUILD_VINEYARDD_REDIS)
 
+#include <algorithm>
 #include <chrono>
+#include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "pplx/pplxtasks.h"
@@ -31,83 +35,163 @@ limitations under the License.
 
 namespace vineyard {
 
-void RedisWatchHandler::operator()(std::unique_ptr<redis::Redis>& redis,
-                                   std::string rev) {
-  // need to ensure handled_rev_ updates before next publish is handled
-  std::lock_guard<std::mutex> scope_lock(registered_callbacks_mutex_);
-  if (this->meta_service_ptr_->stopped()) {
-    return;
-  }
-
+// KEYS: redis_revision, revisions, opslist, then the keys of puts, deletes,
+// and the referenced keys that must still exist.
+// ARGV: the base revision (negative for unconditional commits), the number of
+// puts, the number of referenced keys, then the values of puts. Returns the
+// operation number, or -1 on conflicts.
+static const char* kRedisCommitScript = R"(
+local base_rev = tonumber(ARGV[1])
+local puts_end = 3 + tonumber(ARGV[2])
+local dels_end = #KEYS - tonumber(ARGV[3])
+if base_rev >= 0 then
+  for i = 4, #KEYS do
+    local rev = redis.call('HGET', KEYS[2], KEYS[i])
+    if rev and tonumber(rev) > base_rev then
+      return -1
+    end
+  end
+  for i = dels_end + 1, #KEYS do
+    if redis.call('EXISTS', KEYS[i]) == 0 then
+      return -1
+    end
+  end
+end
+local irev = redis.call('INCR', KEYS[1]) - 1
+local op = {}
+for i = 4, puts_end do
+  redis.call('SET', KEYS[i], ARGV[i])
+  redis.call('HSET', KEYS[2], KEYS[i], irev + 1)
+  op[#op + 1] = '0'
+  op[#op + 1] = KEYS[i]
+end
+for i = puts_end + 1, dels_end do
+  redis.call('DEL', KEYS[i])
+  redis.call('HDEL', KEYS[2], KEYS[i])
+  op[#op + 1] = '1'
+  op[#op + 1] = KEYS[i]
+end
+redis.call('RPUSH', KEYS[3], cjson.encode(op))
+redis.call('PUBLISH', 'operations', irev)
+return irev
+)";
+
+void RedisWatchHandler::Notify(std::unique_ptr<redis::Redis>& redis,
+                               std::string const& rev) {
   unsigned irev = 0;
   try {
     irev = static_cast<unsigned>(std::stol(rev));
   } catch (...) {
-    stateCode = UNNAMED_ERROR;
-    errMsg = "redis watchHandler error:";
-    errType += " resolve redis_revision error";
+    LOG(WARNING) << "redis watchHandler: invalid redis_revision: " << rev;
+    return;
+  }
+  unsigned pending = pending_rev_.load();
+  while (pending < irev &&
+         !pending_rev_.compare_exchange_weak(pending, irev)) {}
+  pending_events_.fetch_add(1);
+  if (!posted_.exchange(true)) {
+    ctx_.post(boost::bind<void>(std::ref(*this), std::ref(redis)));
+  }
+}
+
+void RedisWatchHandler::operator()(std::unique_ptr<redis::Redis>& redis) {
+  // need to ensure handled_rev_ updates before next publish is handled
+  std::lock_guard<std::mutex> scope_lock(registered_callbacks_mutex_);
+  posted_.store(false);
+  if (this->meta_service_ptr_->stopped()) {
+    return;
   }
 
+  unsigned irev = pending_rev_.load();
+  LOG_SUMMARY("redis_watch_coalesced_events", "watch",
+              pending_events_.exchange(0));
   if (irev < handled_rev_.load()) {
     return;
   }
 
-  std::vector<std::string> operations;
+  // fetch all operations since the last handled revision at once, and then
+  // the values of the puts
+  std::vector<IMetaService::op_t> ops;
+  Status status;
   try {
+    std::vector<std::string> operations;
     redis->lrange("opslist", handled_rev_.load(), irev,
                   std::back_inserter(operations));
-  } catch (...) {
-    stateCode = UNNAMED_ERROR;
-    errMsg = "redis watchHandler error:";
-    errType += " lrange error";
-  }
 
-  std::vector<IMetaService::op_t> ops;
-  try {
-    for (auto const& item : operations) {
-      std::vector<std::string> puts;
-      std::vector<std::string> dels;
-      std::unordered_map<std::string, std::string> kvs;
-      redis->hgetall(item, std::inserter(kvs, kvs.begin()));
-      for (auto const& kv : kvs) {
-        if (kv.second == kPut) {
-          // keys need to Put
-          puts.emplace_back(kv.first);
-        } else if (kv.second == kDel) {
-          // keys need to Del
-          ops.emplace_back(IMetaService::op_t::Del(kv.first, irev + 1));
+    // only the last operation of each key matters
+    std::unordered_map<std::string, size_t> positions;
+    auto record = [&](std::string const& type, std::string const& key) {
+      IMetaService::op_t op;
+      if (type == kPut) {
+        op = IMetaService::op_t::Put(key, "", irev + 1);
+      } else if (type == kDel) {
+        op = IMetaService::op_t::Del(key, irev + 1);
+      } else {
+        return;
+      }
+      auto iter = positions.find(key);
+      if (iter == positions.end()) {
+        positions.emplace(key, ops.size());
+        ops.emplace_back(std::move(op));
+      } else {
+        ops[iter->second] = std::move(op);
+      }
+    };
+    for (auto const& operation : operations) {
+      json fields = json::parse(operation, nullptr, false);
+      if (fields.is_array()) {
+        for (size_t i = 0; i + 1 < fields.size(); i += 2) {
+          record(fields[i].get_ref<std::string const&>(),
+                 fields[i + 1].get_ref<std::string const&>());
+        }
+      } else {
+        // the operations committed by older servers: the element is the
+        // name of a hash from the keys to the operation types
+        std::unordered_map<std::string, std::string> kvs;
+        redis->hgetall(operation, std::inserter(kvs, kvs.begin()));
+        for (auto const& kv : kvs) {
+          record(kv.second, kv.first);
         }
       }
+    }
 
-      if (puts.size() > 0) {
-        std::vector<redis::OptionalString> vals;
-        try {
-          redis->mget(puts.begin(), puts.end(), std::back_inserter(vals));
-          for (size_t i = 0; i < vals.size(); ++i) {
-            if (vals[i]) {
-              ops.emplace_back(IMetaService::op_t::Put(
-                  boost::algorithm::erase_head_copy(puts[i], prefix_.size()),
-                  *vals[i], irev + 1));
-            }
-          }
-        } catch (...) {
-          stateCode = UNNAMED_ERROR;
-          errMsg = "redis watchHandler error:";
-          errType += " mget error";
+    std::vector<std::string> put_keys;
+    for (auto const& op : ops) {
+      if (op.op == IMetaService::op_t::kPut) {
+        put_keys.emplace_back(op.kv.key);
+      }
+    }
+    std::vector<redis::OptionalString> values;
+    if (!put_keys.empty()) {
+      redis->mget(put_keys.begin(), put_keys.end(),
+                  std::back_inserter(values));
+    }
+    // the puts of deleted keys are omitted
+    std::vector<IMetaService::op_t> resolved;
+    resolved.reserve(ops.size());
+    size_t index = 0;
+    for (auto& op : ops) {
+      if (op.op == IMetaService::op_t::kPut) {
+        auto const& value = values[index++];
+        if (!value) {
+          continue;
         }
+        op.kv.value = *value;
       }
+      op.kv.key = boost::algorithm::erase_head_copy(op.kv.key, prefix_.size());
+      resolved.emplace_back(std::move(op));
     }
-  } catch (...) {
-    stateCode = UNNAMED_ERROR;
-    errMsg = "redis watchHandler error:";
-    errType += " hgetall error";
+    ops = std::move(resolved);
+  } catch (std::exception const& e) {
+    ops.clear();
+    status = Status::RedisError(UNNAMED_ERROR,
+                                "redis watchHandler error: ", e.what());
   }
 
 #ifndef NDEBUG
   static unsigned processed = 0;
 #endif
 
-  auto status = Status::RedisError(stateCode, errMsg, errType);
   ctx_.post(boost::bind(
       callback_, status, ops, irev + 1,
       [this, status](Status const&, unsigned rev) -> Status {
@@ -164,7 +248,15 @@ void RedisMetaService::requestLock(
   pplx::create_task([self]() {
     unsigned irev = 0;
     try {
-      while (!self->redlock_->try_lock(std::chrono::seconds(600))) {}
+      // back off rather than spinning on the lock
+      auto backoff = std::chrono::milliseconds(1);
+      while (!self->redlock_->try_lock(std::chrono::seconds(600))) {
+        if (self->stopped_.load()) {
+          break;
+        }
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min(backoff * 2, std::chrono::milliseconds(100));
+      }
       auto val = *(self->redis_->get("redis_revision").get());
       irev = static_cast<unsigned>(std::stol(val));
     } catch (...) {
@@ -310,76 +402,109 @@ void RedisMetaService::requestUpdates(
 
 void RedisMetaService::commitUpdates(
     const std::vector<op_t>& changes,
+    callback_t<unsigned, const std::vector<op_t>&> callback_after_updated) {
+  // the script is executed atomically
+  commitScript(changes, {}, -1,
+               [changes, callback_after_updated](const Status& status,
+                                                 unsigned rev) {
+                 return callback_after_updated(
+                     status, rev, status.ok() ? changes : std::vector<op_t>{});
+               });
+}
+
+void RedisMetaService::commitUpdatesIfUnchanged(
+    const std::vector<op_t>& changes,
+    const std::vector<std::string>& referenced, unsigned base_rev,
     callback_t<unsigned> callback_after_updated) {
-  // Just a reminder: When the number of hash entries exceeds 500, hash tables
-  // are used instead of ZipList, which occupies a large memory.
+  commitScript(changes, referenced, base_rev, callback_after_updated);
+}
 
-  // If rev or op_prefix doesn't initialize, which means errors have already
-  // happened.
-  std::string rev;
-  std::string op_prefix;
-  unsigned irev = 0;
-  try {
-    // the operation number is ready to publish
-    rev = *redis_->get("redis_revision").get();
-    redis_->incr("redis_revision").get();
-    op_prefix = "op" + rev;
-    irev = static_cast<unsigned>(std::stol(rev));
-  } catch (...) {
-    cUStateCode = UNNAMED_ERROR;
-    cUErrMsg = "redis commitUpdates error:";
-    cUErrType += " get redis_revision error";
+void RedisMetaService::commitScript(
+    const std::vector<op_t>& changes,
+    const std::vector<std::string>& referenced, int64_t const base_rev,
+    callback_t<unsigned> callback_after_updated) {
+  size_t puts = 0;
+  for (auto const& op : changes) {
+    puts += op.op == op_t::kPut;
   }
-
-  std::vector<std::string> kvs;
-  kvs.emplace_back("MSET");
-  std::unordered_map<std::string, unsigned> ops;
-  std::vector<std::string> keys;
+  // all the keys the script accesses are passed as KEYS
+  auto command = std::make_shared<std::vector<std::string>>();
+  command->reserve(9 + changes.size() + referenced.size() + puts);
+  command->insert(
+      command->end(),
+      {"EVALSHA", commit_script_sha_,
+       std::to_string(3 + changes.size() + referenced.size()), "redis_revision",
+       "revisions", "opslist"});
   for (auto const& op : changes) {
     if (op.op == op_t::kPut) {
-      kvs.emplace_back(prefix_ + op.kv.key);
-      kvs.emplace_back(op.kv.value);
-      ops.insert({prefix_ + op.kv.key, op_t::kPut});
-    } else if (op.op == op_t::kDel) {
-      keys.emplace_back(prefix_ + op.kv.key);
-      ops.insert({op.kv.key, op_t::kDel});
+      command->emplace_back(prefix_ + op.kv.key);
+    }
+  }
+  for (auto const& op : changes) {
+    if (op.op == op_t::kDel) {
+      command->emplace_back(prefix_ + op.kv.key);
     }
   }
+  for (auto const& key : referenced) {
+    command->emplace_back(prefix_ + key);
+  }
+  command->emplace_back(std::to_string(base_rev));
+  command->emplace_back(std::to_string(puts));
+  command->emplace_back(std::to_string(referenced.size()));
+  for (auto const& op : changes) {
+    if (op.op == op_t::kPut) {
+      command->emplace_back(op.kv.value);
+    }
+  }
+  evalCommitScript(command, callback_after_updated,
+                   std::chrono::steady_clock::now());
+}
 
+void RedisMetaService::evalCommitScript(
+    std::shared_ptr<std::vector<std::string>> command,
+    callback_t<unsigned> callback_after_updated,
+    std::chrono::steady_clock::time_point const start) {
   auto self(shared_from_base());
-  // delete keys
-  if (keys.size() > 0) {
-    redis_->del(
-        keys.begin(), keys.end(),
-        [self](redis::Future<long long>&& resp) {  // NOLINT(runtime/int)
-          try {
-            resp.get();
-          } catch (...) {
-            self->cUStateCode = UNNAMED_ERROR;
-            self->cUErrMsg = "redis commitUpdates error:";
-            self->cUErrType += " del keys error";
+  redis_->command<long long>(  // NOLINT(runtime/int)
+      command->begin(), command->end(),
+      [self, command, callback_after_updated,
+       start](redis::Future<long long>&& resp) {  // NOLINT(runtime/int)
+        Status status;
+        unsigned rev = 0;
+        try {
+          auto irev = resp.get();
+          if (irev < 0) {
+            status = Status::RedisError(
+                "redis commitUpdates conflicts: the keys have been modified");
+          } else {
+            rev = static_cast<unsigned>(irev) + 1;
           }
-        });
-  }
-
-  // mset kvs
-  if (kvs.size() > 2) {
-    redis_->command<void>(kvs.begin(), kvs.end(),
-                          [self, callback_after_updated, ops, op_prefix,
-                           irev](redis::Future<void>&& resp) {
-                            try {
-                              resp.get();
-                            } catch (...) {
-                              self->cUStateCode = UNNAMED_ERROR;
-                              self->cUErrMsg = "redis commitUpdates error:";
-                              self->cUErrType += " mset error";
-                            }
-                            self->operationUpdates(callback_after_updated, ops,
-                                                   op_prefix, irev);
-                          });
-  } else {
-    operationUpdates(callback_after_updated, ops, op_prefix, irev);
-  }
+        } catch (redis::ReplyError const& e) {
+          if ((*command)[0] == "EVALSHA" &&
+              boost::algorithm::starts_with(e.what(), "NOSCRIPT")) {
+            // nothing has been executed, resend with the script itself,
+            // which is cached by redis again
+            (*command)[0] = "EVAL";
+            (*command)[1] = kRedisCommitScript;
+            self->evalCommitScript(command, callback_after_updated, start);
+            return;
+          }
+          status = Status::RedisError(UNNAMED_ERROR,
+                                      "redis commitUpdates error: ", e.what());
+        } catch (std::exception const& e) {
+          status = Status::RedisError(UNNAMED_ERROR,
+                                      "redis commitUpdates error: ", e.what());
+        }
+        LOG_SUMMARY("redis_request_duration_microseconds", "commit",
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count());
+        if (self->stopped_.load()) {
+          status = Status::AlreadyStopped("redis metadata service");
+        }
+        self->server_ptr_->GetMetaContext().post(
+            boost::bind(callback_after_updated, status, rev));
+      });
 }
 
 void RedisMetaService::startDaemonWatch(
@@ -398,8 +523,7 @@ void RedisMetaService::startDaemonWatch(
     auto self(shared_from_base());
     this->watcher_.reset(new redis::AsyncSubscriber(redis_->subscriber()));
     this->watcher_->on_message([self](std::string channel, std::string msg) {
-      self->server_ptr_->GetMetaContext().post(boost::bind<void>(
-          std::ref(*(self->handler_)), std::ref(self->watch_client_), msg));
+      self->handler_->Notify(self->watch_client_, msg);
     });
     this->watcher_->subscribe("operations");
   } catch (std::runtime_error& e) {
@@ -444,8 +568,15 @@ Status RedisMetaService::probe() {
 Status RedisMetaService::preStart() {
   redis_launcher_ =
       std::unique_ptr<RedisLauncher>(new RedisLauncher(redis_spec_));
-  return redis_launcher_->LaunchRedisServer(redis_, syncredis_, watch_client_,
-                                            mtx_, redlock_);
+  RETURN_ON_ERROR(redis_launcher_->LaunchRedisServer(
+      redis_, syncredis_, watch_client_, mtx_, redlock_));
+  try {
+    commit_script_sha_ = syncredis_->script_load(kRedisCommitScript);
+  } catch (std::exception const& e) {
+    return Status::RedisError(UNNAMED_ERROR,
+                              "Failed to load the commit script: ", e.what());
+  }
+  return Status::OK();
 }
 
 }  // namespace vineyard
@@ -24,52 +24,52 @@ limitations under the License.
  * a key role to make redis as backend come true.
  *
  * - redis_revision: the key represented the latest revision of commitUpdates
- * - op + redis_revision: the key for hash data structure, which is about the
- * every operation to commitUpdate
- * - opslist: the key for list data structure, we can get any operation from the
- * list
+ * - opslist: the key for list data structure, the i-th element is the
+ * operation of the commit at revision i + 1, i.e., the (operation type, key)
+ * pairs encoded as a json array. The elements pushed by older servers are
+ * the names ("op<revision>") of hashes from the keys to the operation types,
+ * which are still accepted by the watcher.
  *
- *                    hashlist for saving operations
- *                   -------------------------------
- *                   | ops | key  | operation type |
- *                   -------------------------------
- *                   |     | key1 |       PUT      |
- *                   | op0 | key2 |       PUT      |
- *                   |     | key3 |       DEL      |
- *                   -------------------------------
- *                   |     | key1 |       PUT      |
- *                   | op1 | key2 |       DEL      |
- *                   |     | key3 |       PUT      |
- *                   -------------------------------
- *                   | ... | ...  |       ...      |
- *                   -------------------------------
- *                               opslist
- *            ----------------------------------------------
- *            | op0 | op1 | op2 | op3 | op4 | op5 | ...... |
- *            ----------------------------------------------
+ *                              opslist
+ *     ------------------------------------------------------------
+ *     | ["0", key1, "0", key2, "1", key3] | ["1", key2] | ...... |
+ *     ------------------------------------------------------------
  *
  * - operations: the key is used to publish and subscribe, publish to every
  * server who subscribed the key when the operation is updated
  * - resource: the name of distributed lock
  *
+ * - revisions: the key for hash data structure, which records the revision
+ * that every existing key was modified at last
+ *
  * Let's see how they collaborate together to work.
  * First, the redis_revision is set to zero when the first server starts up.
- * Other servers won't change it, because we use 'SETNX' command. The vineyard
- * server who wants to commit it's kvs changes to redis have to get the
- * distributed lock named resource. It gets to know it's operation revision by
- * redis_revision and it increased the redis_revision before it puts down the
- * lock, which prevents the changes disappearing when other server tried to
- * commit it's changes. The reason why we used a lot of callbacks in
- * commitUpdates function is that redis client API now doesn't support txn for
- * async_client and we must ensure operations are already in hashlist when ops
- * appear in opslist. So PUBLISH can notice other servers after all changes are
- * ready in redis.
+ * Other servers won't change it, because we use 'SETNX' command. A commit is
+ * a server-side lua script which increases the redis_revision, applies the
+ * kvs changes, records them in the opslist and publishes the revision,
+ * atomically and in a single round trip. Thus concurrent commits are
+ * pipelined on the connection, and the operations are always ready in redis
+ * when other servers are noticed. The script is loaded once and invoked by
+ * `EVALSHA`, and all keys it accesses are passed in `KEYS`.
+ *
+ * Persisting doesn't need the distributed lock named resource: the script
+ * fails the commit without any change if any affected key has been modified
+ * (see `revisions`) after the revision the local metadata is at, i.e., the
+ * optimistic concurrency as `WATCH`/`MULTI` but without extra round trips.
+ * The lock is still used by the other updates, see also
+ * `IMetaService::RequestToPersist`.
+ *
+ * The watcher coalesces the notifications that arrive while it is busy and
+ * fetches all the operations since the last handled revision at once, then
+ * the values of the put keys by a single `MGET`.
  *
  */
 
 #ifndef SRC_SERVER_SERVICES_REDIS_META_SERVICE_H_
 #define SRC_SERVER_SERVICES_REDIS_META_SERVICE_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -121,7 +121,13 @@ class RedisWatchHandler {
         registered_callbacks_mutex_(registered_callbacks_mutex) {
   }
 
-  void operator()(std::unique_ptr<redis::Redis>&, std::string);
+  /**
+   * @brief Records the revision published by a commit, the handler is posted
+   * once for all notifications that arrive before it runs.
+   */
+  void Notify(std::unique_ptr<redis::Redis>& redis, std::string const& rev);
+
+  void operator()(std::unique_ptr<redis::Redis>&);
 
  private:
   const std::shared_ptr<RedisMetaService> meta_service_ptr_;
@@ -142,11 +148,14 @@ class RedisWatchHandler {
   const std::string kPut = "0";
   const std::string kDel = "1";
 
+  // the latest published revision, and the number of notifications, that
+  // haven't been handled yet
+  std::atomic<unsigned> pending_rev_{0};
+  std::atomic<size_t> pending_events_{0};
+  std::atomic<bool> posted_{false};
+
   // TODO: more error codes
   enum { OK = 0, UNNAMED_ERROR = 1 };
-  std::string errMsg;
-  int stateCode = OK;
-  std::string errType;
 };
 /**
  * @brief RedisLock is designed as the lock for accessing redis
@@ -199,7 +208,12 @@ class RedisMetaService : public IMetaService {
       callback_t<const std::vector<op_t>&, unsigned> callback) override;
 
   void commitUpdates(const std::vector<op_t>&,
-                     callback_t<unsigned> callback_after_updated) override;
+                     callback_t<unsigned, const std::vector<op_t>&>
+                         callback_after_updated) override;
+
+  void commitUpdatesIfUnchanged(
+      const std::vector<op_t>&, const std::vector<std::string>& referenced,
+      unsigned base_rev, callback_t<unsigned> callback_after_updated) override;
 
   void startDaemonWatch(
       const std::string& prefix, unsigned since_rev,
@@ -243,10 +257,6 @@ class RedisMetaService : public IMetaService {
   int rAStateCode = OK;
   std::string rAErrMsg;
   std::string rAErrType;
-  // commitUpdates error
-  int cUStateCode = OK;
-  std::string cUErrMsg;
-  std::string cUErrType;
   // requestLock error
   int rLStateCode = OK;
   std::string rLErrMsg;
@@ -254,59 +264,20 @@ class RedisMetaService : public IMetaService {
 
   friend class IMetaService;
 
-  inline void operationUpdates(
-      callback_t<unsigned> callback_after_updated,
-      const std::unordered_map<std::string, unsigned> ops,
-      std::string op_prefix, unsigned irev) {
-    auto self(shared_from_base());
-    redis_->hset(
-        op_prefix, ops.begin(), ops.end(),
-        [self, callback_after_updated, op_prefix,
-         irev](redis::Future<long long>&& resp) {  // NOLINT(runtime/int)
-          try {
-            resp.get();
-          } catch (...) {
-            self->cUStateCode = UNNAMED_ERROR;
-            self->cUErrMsg = "redis commitUpdates error:";
-            self->cUErrType += " hset error";
-          }
-          self->redis_->command<long long>(  // NOLINT(runtime/int)
-              "RPUSH", "opslist", op_prefix,
-              [self, callback_after_updated,
-               irev](redis::Future<long long>&& resp) {  // NOLINT(runtime/int)
-                try {
-                  resp.get();
-                } catch (...) {
-                  self->cUStateCode = UNNAMED_ERROR;
-                  self->cUErrMsg = "redis commitUpdates error:";
-                  self->cUErrType += " rpush error";
-                }
-                self->redis_->command<long long>(  // NOLINT(runtime/int)
-                    "PUBLISH", "operations", irev,
-                    [self, callback_after_updated,
-                     irev](redis::Future<long long>&&  // NOLINT(runtime/int)
-                               resp) {
-                      try {
-                        resp.get();
-                      } catch (...) {
-                        self->cUStateCode = UNNAMED_ERROR;
-                        self->cUErrMsg = "redis commitUpdates error:";
-                        self->cUErrType += " publish error";
-                      }
-                      Status status;
-                      if (self->stopped_.load()) {
-                        status =
-                            Status::AlreadyStopped("redis metadata service");
-                      } else {
-                        status = Status::RedisError(
-                            self->cUStateCode, self->cUErrMsg, self->cUErrType);
-                      }
-                      self->server_ptr_->GetMetaContext().post(boost::bind(
-                          callback_after_updated, status, irev + 1));
-                    });
-              });
-        });
-  }
+  // commits by the lua script, unconditionally if `base_rev` is negative
+  void commitScript(const std::vector<op_t>& changes,
+                    const std::vector<std::string>& referenced,
+                    int64_t const base_rev,
+                    callback_t<unsigned> callback_after_updated);
+
+  // sends the `EVALSHA` command, or `EVAL` if the script is missing from the
+  // script cache of redis, e.g., after a restart or a `SCRIPT FLUSH`
+  void evalCommitScript(std::shared_ptr<std::vector<std::string>> command,
+                        callback_t<unsigned> callback_after_updated,
+                        std::chrono::steady_clock::time_point const start);
+
+  // the sha1 digest of the commit script, see also `SCRIPT LOAD`
+  std::string commit_script_sha_;
 };
 
 }  // namespace vineyard
@@ -0,0 +1,121 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "server/services/wal_meta_service.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/util/logging.h"
+#include "server/server/vineyard_server.h"
+#include "server/util/metrics.h"
+
+namespace vineyard {
+
+WalMetaService::WalMetaService(std::shared_ptr<VineyardServer>& server_ptr)
+    : IMetaService(server_ptr) {
+  auto const& spec = server_ptr_->GetSpec()["metastore_spec"];
+  wal_ = std::unique_ptr<MetaWal>(
+      new MetaWal(spec["wal_dir"].get<std::string>() + "/" +
+                      SessionIDToString(server_ptr_->session_id()),
+                  spec["wal_compaction_size"].get<size_t>()));
+}
+
+inline void WalMetaService::Stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  IMetaService::Stop();
+  // makes the pending commits durable
+  wal_->Close();
+  // the directory of a child session is never recovered, as the session id
+  // is generated on creation
+  if (server_ptr_->session_id() != RootSessionID()) {
+    auto status = wal_->Remove();
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to remove the metadata log of session '"
+                   << SessionIDToString(server_ptr_->session_id())
+                   << "': " << status.ToString();
+    }
+  }
+}
+
+Status WalMetaService::preStart() { return wal_->Open(); }
+
+void WalMetaService::requestLock(
+    std::string lock_name,
+    callback_t<std::shared_ptr<ILock>> callback_after_locked) {
+  auto lock_ptr = std::make_shared<LocalLock>(
+      [](const Status& status, unsigned& rev) { return Status::OK(); },
+      wal_->Revision());
+  VINEYARD_SUPPRESS(callback_after_locked(Status::OK(), lock_ptr));
+}
+
+void WalMetaService::commitUpdates(
+    const std::vector<op_t>& changes,
+    callback_t<unsigned, const std::vector<op_t>&> callback_after_updated) {
+  auto self(shared_from_base());
+  auto start = std::chrono::steady_clock::now();
+  wal_->Commit(changes, [self, changes, callback_after_updated, start](
+                            const Status& status, unsigned rev) {
+    LOG_SUMMARY("wal_request_duration_microseconds", "commit",
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+    // the records are appended atomically
+    self->server_ptr_->GetMetaContext().post(
+        boost::bind(callback_after_updated, status, rev,
+                    status.ok() ? changes : std::vector<op_t>{}));
+  });
+}
+
+void WalMetaService::commitUpdatesIfUnchanged(
+    const std::vector<op_t>& changes, const std::vector<std::string>&,
+    unsigned, callback_t<unsigned> callback_after_updated) {
+  // there are no other instances to conflict with
+  commitUpdates(changes, [callback_after_updated](const Status& status,
+                                                  unsigned rev,
+                                                  const std::vector<op_t>&) {
+    return callback_after_updated(status, rev);
+  });
+}
+
+void WalMetaService::requestAll(
+    const std::string& prefix, unsigned base_rev,
+    callback_t<const std::vector<op_t>&, unsigned> callback) {
+  std::vector<op_t> ops;
+  unsigned rev = 0;
+  wal_->Values(ops, rev);
+  server_ptr_->GetMetaContext().post(
+      boost::bind(callback, Status::OK(), std::move(ops), rev));
+}
+
+void WalMetaService::requestUpdates(
+    const std::string& prefix, unsigned since_rev,
+    callback_t<const std::vector<op_t>&, unsigned> callback) {
+  // the local meta tree is always ahead of the log
+  server_ptr_->GetMetaContext().post(boost::bind(
+      callback, Status::OK(), std::vector<op_t>{}, wal_->Revision()));
+}
+
+void WalMetaService::startDaemonWatch(
+    const std::string& prefix, unsigned since_rev,
+    callback_t<const std::vector<op_t>&, unsigned, callback_t<unsigned>>
+        callback) {}
+
+}  // namespace vineyard
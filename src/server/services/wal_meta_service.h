@@ -0,0 +1,89 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_SERVER_SERVICES_WAL_META_SERVICE_H_
+#define SRC_SERVER_SERVICES_WAL_META_SERVICE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "server/services/local_meta_service.h"
+#include "server/services/meta_service.h"
+#include "server/util/meta_wal.h"
+
+namespace vineyard {
+
+/**
+ * @brief WalMetaService persists the metadata of a single vineyardd to a local
+ * directory (see also `MetaWal`), thus the metadata survives restarts without
+ * an external etcd.
+ *
+ * The metadata is changed by this instance only, and the changes have been
+ * applied to the local meta tree before being committed. Thus there are no
+ * remote updates to request or watch, and the lock is a dummy one.
+ *
+ * The directory of a child session is removed once the session is released.
+ */
+class WalMetaService : public IMetaService {
+ public:
+  inline void Stop() override;
+
+  ~WalMetaService() override {}
+
+ protected:
+  explicit WalMetaService(std::shared_ptr<VineyardServer>& server_ptr);
+
+  void requestLock(
+      std::string lock_name,
+      callback_t<std::shared_ptr<ILock>> callback_after_locked) override;
+
+  void requestAll(
+      const std::string& prefix, unsigned base_rev,
+      callback_t<const std::vector<op_t>&, unsigned> callback) override;
+
+  void requestUpdates(
+      const std::string& prefix, unsigned since_rev,
+      callback_t<const std::vector<op_t>&, unsigned> callback) override;
+
+  void commitUpdates(const std::vector<op_t>&,
+                     callback_t<unsigned, const std::vector<op_t>&>
+                         callback_after_updated) override;
+
+  void commitUpdatesIfUnchanged(
+      const std::vector<op_t>&, const std::vector<std::string>& referenced,
+      unsigned base_rev, callback_t<unsigned> callback_after_updated) override;
+
+  void startDaemonWatch(
+      const std::string& prefix, unsigned since_rev,
+      callback_t<const std::vector<op_t>&, unsigned, callback_t<unsigned>>
+          callback) override;
+
+  Status probe() override { return wal_->status(); }
+
+  Status preStart() override;
+
+ private:
+  std::shared_ptr<WalMetaService> shared_from_base() {
+    return std::static_pointer_cast<WalMetaService>(shared_from_this());
+  }
+
+  std::unique_ptr<MetaWal> wal_;
+
+  friend class IMetaService;
+};
+}  // namespace vineyard
+
+#endif  // SRC_SERVER_SERVICES_WAL_META_SERVICE_H_
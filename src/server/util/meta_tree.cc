@@ -904,6 +904,49 @@ Status PersistOps(const json& tree, const std::string& instance_name,
   return Status::OK();
 }
 
+void ReferencedKeys(const std::vector<op_t>& ops,
+                    std::vector<std::string>& keys) {
+  const std::string data_prefix = "/data/";
+  std::set<std::string> written, referenced;
+  for (auto const& op : ops) {
+    written.emplace(op.kv.key);
+  }
+  for (auto const& op : ops) {
+    if (op.op != op_t::kPut || op.kv.key.compare(0, data_prefix.size(),
+                                                 data_prefix) != 0) {
+      continue;
+    }
+    json tree = json::parse(op.kv.value, nullptr, false);
+    // the members of global objects are referred by signatures, which are
+    // put together with them
+    if (!tree.is_object() || tree.value("global", false)) {
+      continue;
+    }
+    for (auto const& item : tree.items()) {
+      if (!item.value().is_string()) {
+        continue;
+      }
+      NodeType type;
+      std::string value;
+      decode_value(item.value().get_ref<std::string const&>(), type, value);
+      if (type != NodeType::Link) {
+        continue;
+      }
+      InstanceID instance_id = UnspecifiedInstanceID();
+      std::string sub_type, sub_name;
+      if (!parse_link(value, sub_type, sub_name, instance_id).ok() ||
+          sub_type == "vineyard::Blob" || sub_name[0] != 'o') {
+        continue;
+      }
+      std::string key = data_prefix + sub_name;
+      if (written.find(key) == written.end()) {
+        referenced.emplace(key);
+      }
+    }
+  }
+  keys.assign(referenced.begin(), referenced.end());
+}
+
 Status Exists(const json& tree, const ObjectID id, bool& exists) {
   std::string name = ObjectIDToString(id);
   exists = has_sub_tree(tree, "/data", name);
@@ -106,6 +106,14 @@ Status PutDataOps(const json& tree, const std::string& instance_name,
 Status PersistOps(const json& tree, const std::string& instance_name,
                   const ObjectID id, std::vector<op_t>& ops);
 
+/**
+ * @brief The keys of the objects that are linked as members by the objects
+ * put by `ops`, but are not put by `ops` themselves, e.g., the members that
+ * have been persisted before.
+ */
+void ReferencedKeys(const std::vector<op_t>& ops,
+                    std::vector<std::string>& keys);
+
 Status DelDataOps(const json& tree, const ObjectID id, std::vector<op_t>& ops,
                   bool& sync_remote);
 
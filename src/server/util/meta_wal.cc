@@ -0,0 +1,706 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "server/util/meta_wal.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boost/algorithm/string.hpp"
+#include "boost/crc.hpp"
+
+#include "common/util/logging.h"
+
+namespace vineyard {
+
+namespace detail {
+
+static constexpr const char* kSnapshotPrefix = "snapshot-";
+static constexpr const char* kLogPrefix = "wal-";
+static constexpr const char* kLogSuffix = ".log";
+static constexpr const char* kTemporarySuffix = ".tmp";
+
+static constexpr uint64_t kSnapshotMagic = 0x31504e53544d4456UL;
+static constexpr size_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+static constexpr size_t kSnapshotBufferSize = 4 * 1024 * 1024;
+
+static Status io_error(std::string const& message, std::string const& path) {
+  return Status::IOError(message + " '" + path + "': " + strerror(errno));
+}
+
+// zero-padded, thus the files are listed in the order of revisions
+static std::string wal_file_name(std::string const& prefix, unsigned const rev,
+                                 std::string const& suffix) {
+  std::string digits = std::to_string(rev);
+  return prefix + std::string(10 - digits.size(), '0') + digits + suffix;
+}
+
+static bool parse_wal_file_name(std::string const& name,
+                                std::string const& prefix,
+                                std::string const& suffix, unsigned& rev) {
+  if (name.size() != prefix.size() + 10 + suffix.size() ||
+      !boost::algorithm::starts_with(name, prefix) ||
+      !boost::algorithm::ends_with(name, suffix)) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (size_t i = prefix.size(); i < prefix.size() + 10; ++i) {
+    if (name[i] < '0' || name[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (name[i] - '0');
+  }
+  rev = static_cast<unsigned>(value);
+  return value == rev;
+}
+
+static uint32_t crc32(const char* data, size_t const size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+template <typename T>
+static void put_value(std::string& buffer, T const value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void put_bytes(std::string& buffer, std::string const& value) {
+  put_value<uint32_t>(buffer, static_cast<uint32_t>(value.size()));
+  buffer.append(value);
+}
+
+// Decodes the values written by `put_value` and `put_bytes` (in the native
+// byte order), fails rather than reading beyond the end.
+class wal_reader {
+ public:
+  wal_reader(const char* data, size_t const size)
+      : data_(data), end_(data + size) {}
+
+  template <typename T>
+  bool get_value(T& value) {
+    if (static_cast<size_t>(end_ - data_) < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, data_, sizeof(T));
+    data_ += sizeof(T);
+    return true;
+  }
+
+  bool get_bytes(std::string& value) {
+    uint32_t size = 0;
+    if (!get_value(size) || static_cast<size_t>(end_ - data_) < size) {
+      return false;
+    }
+    value.assign(data_, size);
+    data_ += size;
+    return true;
+  }
+
+  bool done() const { return data_ == end_; }
+
+ private:
+  const char* data_;
+  const char* end_;
+};
+
+static Status write_fully(int fd, std::string const& buffer,
+                          std::string const& path) {
+  const char* data = buffer.data();
+  size_t size = buffer.size();
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return io_error("Failed to write", path);
+    }
+    data += written;
+    size -= written;
+  }
+  return Status::OK();
+}
+
+static Status read_fully(std::string const& path, std::string& buffer) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return io_error("Failed to open", path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    Status status = io_error("Failed to stat", path);
+    close(fd);
+    return status;
+  }
+  buffer.resize(st.st_size);
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    ssize_t nread = read(fd, &buffer[offset], buffer.size() - offset);
+    if (nread == -1 && errno == EINTR) {
+      continue;
+    }
+    if (nread <= 0) {
+      Status status = io_error("Failed to read", path);
+      close(fd);
+      return status;
+    }
+    offset += nread;
+  }
+  close(fd);
+  return Status::OK();
+}
+
+static Status create_directories(std::string const& directory) {
+  for (size_t end = directory.find('/', 1); true;
+       end = directory.find('/', end + 1)) {
+    std::string path = directory.substr(0, end);
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+      return io_error("Failed to create the directory", path);
+    }
+    if (end == std::string::npos) {
+      return Status::OK();
+    }
+  }
+}
+
+static Status list_directory(std::string const& directory,
+                             std::vector<std::string>& names) {
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return io_error("Failed to open the directory", directory);
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    names.emplace_back(entry->d_name);
+  }
+  closedir(dir);
+  return Status::OK();
+}
+
+// makes the creations, renames and removals in the directory durable
+static Status sync_directory(std::string const& directory) {
+  int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd == -1) {
+    return io_error("Failed to open the directory", directory);
+  }
+  Status status;
+  if (fsync(fd) != 0) {
+    status = io_error("Failed to sync the directory", directory);
+  }
+  close(fd);
+  return status;
+}
+
+}  // namespace detail
+
+MetaWal::MetaWal(std::string const& directory, size_t const compaction_size)
+    : directory_(directory), compaction_size_(compaction_size) {}
+
+MetaWal::~MetaWal() { Close(); }
+
+Status MetaWal::Open() {
+  RETURN_ON_ERROR(detail::create_directories(directory_));
+  auto start = std::chrono::steady_clock::now();
+  RETURN_ON_ERROR(recover());
+  // never append to a recovered log, whose tail may have been truncated
+  RETURN_ON_ERROR(openLog(rev_ + 1));
+  LOG(INFO) << "Recovered " << kvs_.size() << " metadata keys at revision "
+            << rev_ << " from '" << directory_ << "' in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " milliseconds";
+  writer_ = std::thread(&MetaWal::writer, this);
+  return Status::OK();
+}
+
+void MetaWal::Close() {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    closing_ = true;
+  }
+  pending_cv_.notify_all();
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+  if (compactor_.joinable()) {
+    compactor_.join();
+  }
+  if (log_fd_ != -1) {
+    close(log_fd_);
+    log_fd_ = -1;
+  }
+}
+
+Status MetaWal::Remove() {
+  Close();
+  std::vector<std::string> names;
+  RETURN_ON_ERROR(detail::list_directory(directory_, names));
+  for (auto const& name : names) {
+    if (name == "." || name == "..") {
+      continue;
+    }
+    std::string path = directory_ + "/" + name;
+    if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+      return detail::io_error("Failed to remove", path);
+    }
+  }
+  if (rmdir(directory_.c_str()) != 0 && errno != ENOENT) {
+    return detail::io_error("Failed to remove the directory", directory_);
+  }
+  return Status::OK();
+}
+
+void MetaWal::Commit(std::vector<op_t> const& changes,
+                     commit_callback_t callback) {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (!closing_ && writer_.joinable()) {
+      pending_.emplace_back(commit_t{changes, callback});
+      pending_cv_.notify_one();
+      return;
+    }
+  }
+  callback(Status::AlreadyStopped("metadata write-ahead log"), Revision());
+}
+
+void MetaWal::Values(std::vector<op_t>& ops, unsigned& rev) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ops.reserve(ops.size() + kvs_.size());
+  for (auto const& kv : kvs_) {
+    ops.emplace_back(op_t::Put(kv.first, kv.second, rev_));
+  }
+  rev = rev_;
+}
+
+unsigned MetaWal::Revision() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rev_;
+}
+
+size_t MetaWal::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return kvs_.size();
+}
+
+Status MetaWal::status() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return status_;
+}
+
+Status MetaWal::recover() {
+  std::vector<std::string> names;
+  RETURN_ON_ERROR(detail::list_directory(directory_, names));
+  std::vector<unsigned> snapshots, logs;
+  for (auto const& name : names) {
+    unsigned rev = 0;
+    if (boost::algorithm::ends_with(name, detail::kTemporarySuffix)) {
+      // leftovers of an interrupted compaction
+      unlink((directory_ + "/" + name).c_str());
+    } else if (detail::parse_wal_file_name(name, detail::kSnapshotPrefix, "",
+                                           rev)) {
+      snapshots.emplace_back(rev);
+    } else if (detail::parse_wal_file_name(name, detail::kLogPrefix,
+                                           detail::kLogSuffix, rev)) {
+      logs.emplace_back(rev);
+    }
+  }
+  std::sort(snapshots.begin(), snapshots.end(), std::greater<unsigned>());
+  std::sort(logs.begin(), logs.end());
+
+  for (auto const rev : snapshots) {
+    auto status = loadSnapshot(
+        directory_ + "/" + detail::wal_file_name(detail::kSnapshotPrefix, rev,
+                                                 ""),
+        rev);
+    if (status.ok()) {
+      break;
+    }
+    // the logs since an older snapshot may be still there
+    LOG(WARNING) << "Skipping the invalid metadata snapshot: "
+                 << status.ToString();
+    kvs_.clear();
+    rev_ = 0;
+  }
+  for (size_t i = 0; i < logs.size(); ++i) {
+    if (i + 1 < logs.size() && logs[i + 1] <= rev_ + 1) {
+      // all covered by the snapshot
+      continue;
+    }
+    if (logs[i] > rev_ + 1) {
+      return Status::IOError("The metadata in '" + directory_ +
+                             "' is incomplete: the revisions from " +
+                             std::to_string(rev_ + 1) + " to " +
+                             std::to_string(logs[i] - 1) + " are missing");
+    }
+    RETURN_ON_ERROR(replayLog(
+        directory_ + "/" +
+            detail::wal_file_name(detail::kLogPrefix, logs[i],
+                                  detail::kLogSuffix),
+        i + 1 == logs.size()));
+  }
+  return Status::OK();
+}
+
+Status MetaWal::loadSnapshot(std::string const& path, unsigned const rev) {
+  std::string content;
+  RETURN_ON_ERROR(detail::read_fully(path, content));
+  if (content.size() < sizeof(uint32_t)) {
+    return Status::IOError("The metadata snapshot '" + path +
+                           "' is truncated");
+  }
+  const size_t size = content.size() - sizeof(uint32_t);
+  uint32_t checksum = 0;
+  memcpy(&checksum, content.data() + size, sizeof(uint32_t));
+  if (detail::crc32(content.data(), size) != checksum) {
+    return Status::IOError("The metadata snapshot '" + path +
+                           "' is corrupted");
+  }
+  detail::wal_reader reader(content.data(), size);
+  uint64_t magic = 0, count = 0;
+  uint32_t snapshot_rev = 0;
+  if (!reader.get_value(magic) || magic != detail::kSnapshotMagic ||
+      !reader.get_value(snapshot_rev) || snapshot_rev != rev ||
+      !reader.get_value(count)) {
+    return Status::IOError("The metadata snapshot '" + path +
+                           "' has an unexpected header");
+  }
+  kvs_.reserve(count);
+  std::string key, value;
+  for (uint64_t i = 0; i < count; ++i) {
+    if (!reader.get_bytes(key) || !reader.get_bytes(value)) {
+      return Status::IOError("The metadata snapshot '" + path +
+                             "' is truncated");
+    }
+    kvs_.emplace(std::move(key), std::move(value));
+  }
+  rev_ = rev;
+  snapshot_size_.store(content.size());
+  return Status::OK();
+}
+
+Status MetaWal::replayLog(std::string const& path, bool const last) {
+  std::string content;
+  RETURN_ON_ERROR(detail::read_fully(path, content));
+  size_t offset = 0;
+  std::vector<op_t> changes;
+  while (content.size() - offset >= detail::kRecordHeaderSize) {
+    uint32_t size = 0, checksum = 0;
+    memcpy(&size, content.data() + offset, sizeof(uint32_t));
+    memcpy(&checksum, content.data() + offset + sizeof(uint32_t),
+           sizeof(uint32_t));
+    const char* payload = content.data() + offset + detail::kRecordHeaderSize;
+    if (content.size() - offset - detail::kRecordHeaderSize < size ||
+        detail::crc32(payload, size) != checksum) {
+      break;
+    }
+    detail::wal_reader reader(payload, size);
+    uint32_t rev = 0, count = 0;
+    bool valid = reader.get_value(rev) && reader.get_value(count);
+    changes.clear();
+    for (uint32_t i = 0; valid && i < count; ++i) {
+      uint8_t op = 0;
+      std::string key, value;
+      valid = reader.get_value(op) && reader.get_bytes(key) &&
+              reader.get_bytes(value) &&
+              (op == op_t::kPut || op == op_t::kDel);
+      if (op == op_t::kPut) {
+        changes.emplace_back(op_t::Put(key, value, rev));
+      } else {
+        changes.emplace_back(op_t::Del(key, rev));
+      }
+    }
+    if (!valid || !reader.done()) {
+      break;
+    }
+    if (rev > rev_ + 1) {
+      return Status::IOError("The metadata log '" + path +
+                             "' is incomplete: the revisions from " +
+                             std::to_string(rev_ + 1) + " to " +
+                             std::to_string(rev - 1) + " are missing");
+    }
+    if (rev == rev_ + 1) {
+      apply(changes);
+      rev_ = rev;
+    }
+    offset += detail::kRecordHeaderSize + size;
+  }
+  if (offset == content.size()) {
+    return Status::OK();
+  }
+  // only the last log can have a torn tail, as the former ones have been
+  // fsync-ed before a new log is created
+  if (!last) {
+    return Status::IOError("The metadata log '" + path +
+                           "' is corrupted at offset " +
+                           std::to_string(offset));
+  }
+  LOG(WARNING) << "Truncating the torn tail of the metadata log '" << path
+               << "' at offset " << offset << ", " << content.size() - offset
+               << " bytes are dropped";
+  int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return detail::io_error("Failed to open", path);
+  }
+  Status status;
+  if (ftruncate(fd, offset) != 0 || fsync(fd) != 0) {
+    status = detail::io_error("Failed to truncate", path);
+  }
+  close(fd);
+  return status;
+}
+
+Status MetaWal::openLog(unsigned const start_rev) {
+  std::string path =
+      directory_ + "/" +
+      detail::wal_file_name(detail::kLogPrefix, start_rev, detail::kLogSuffix);
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd == -1) {
+    return detail::io_error("Failed to create the metadata log", path);
+  }
+  auto status = detail::sync_directory(directory_);
+  if (!status.ok()) {
+    close(fd);
+    return status;
+  }
+  if (log_fd_ != -1) {
+    close(log_fd_);
+  }
+  log_fd_ = fd;
+  log_path_ = path;
+  log_size_ = 0;
+  return Status::OK();
+}
+
+void MetaWal::writer() {
+  while (true) {
+    std::vector<commit_t> group;
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      pending_cv_.wait(lock,
+                       [this]() { return closing_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      group.swap(pending_);
+    }
+
+    Status status = this->status();
+    if (status.ok()) {
+      status = writeGroup(group);
+    }
+    unsigned base_rev = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      base_rev = rev_;
+      if (status.ok()) {
+        for (auto const& commit : group) {
+          apply(commit.changes);
+        }
+        rev_ += group.size();
+      } else if (status_.ok()) {
+        LOG(ERROR) << "Failed to commit to the metadata log, the later "
+                      "commits will be rejected: "
+                   << status.ToString();
+        status_ = status;
+      }
+    }
+    for (size_t i = 0; i < group.size(); ++i) {
+      group[i].callback(status, status.ok() ? base_rev + i + 1 : base_rev);
+    }
+    if (status.ok()) {
+      maybeCompact();
+    }
+  }
+}
+
+Status MetaWal::writeGroup(std::vector<commit_t> const& group) {
+  std::string buffer;
+  unsigned rev = rev_;
+  for (auto const& commit : group) {
+    size_t header = buffer.size();
+    buffer.resize(header + detail::kRecordHeaderSize);
+    detail::put_value<uint32_t>(buffer, ++rev);
+    detail::put_value<uint32_t>(buffer,
+                                static_cast<uint32_t>(commit.changes.size()));
+    for (auto const& op : commit.changes) {
+      detail::put_value<uint8_t>(buffer, op.op);
+      detail::put_bytes(buffer, op.kv.key);
+      detail::put_bytes(buffer,
+                        op.op == op_t::kPut ? op.kv.value : std::string());
+    }
+    const char* payload = buffer.data() + header + detail::kRecordHeaderSize;
+    uint32_t size = buffer.size() - header - detail::kRecordHeaderSize;
+    uint32_t checksum = detail::crc32(payload, size);
+    memcpy(&buffer[header], &size, sizeof(uint32_t));
+    memcpy(&buffer[header + sizeof(uint32_t)], &checksum, sizeof(uint32_t));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto status = detail::write_fully(log_fd_, buffer, log_path_);
+  if (status.ok() && fdatasync(log_fd_) != 0) {
+    status = detail::io_error("Failed to sync", log_path_);
+  }
+  if (!status.ok()) {
+    // the group is not acknowledged, drop the partial writes if possible
+    if (ftruncate(log_fd_, log_size_) != 0) {
+      LOG(WARNING) << "Failed to drop the partial writes to '" << log_path_
+                   << "': " << strerror(errno);
+    }
+    return status;
+  }
+  log_size_ += buffer.size();
+  VLOG(100) << "metadata log: group commit of " << group.size()
+            << " commits, " << buffer.size() << " bytes in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+            << " microseconds";
+  return Status::OK();
+}
+
+void MetaWal::apply(std::vector<op_t> const& changes) {
+  // puts are applied before deletes, the same as `IMetaService::metaUpdate`
+  for (auto const& op : changes) {
+    if (op.op == op_t::kPut) {
+      kvs_[op.kv.key] = op.kv.value;
+    }
+  }
+  for (auto const& op : changes) {
+    if (op.op == op_t::kDel) {
+      kvs_.erase(op.kv.key);
+    }
+  }
+}
+
+void MetaWal::maybeCompact() {
+  // compact when the log outgrows the snapshot, thus the size on disk is
+  // at most about twice of the metadata
+  if (compacting_.load() ||
+      log_size_ <= std::max(compaction_size_, snapshot_size_.load())) {
+    return;
+  }
+  if (compactor_.joinable()) {
+    compactor_.join();
+  }
+  // the former logs are durable and will be superseded by the snapshot
+  auto status = openLog(rev_ + 1);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to roll the metadata log: " << status.ToString();
+    return;
+  }
+  // the writer is the only one that mutates the key-values, the copy is
+  // consistent with `rev_` without holding the mutex
+  auto kvs = std::make_shared<kvs_t>(kvs_);
+  compacting_.store(true);
+  compactor_ = std::thread(&MetaWal::compact, this, kvs, rev_);
+}
+
+void MetaWal::compact(std::shared_ptr<kvs_t> kvs, unsigned const rev) {
+  auto start = std::chrono::steady_clock::now();
+  std::string path = directory_ + "/" +
+                     detail::wal_file_name(detail::kSnapshotPrefix, rev, "");
+  std::string temporary = path + detail::kTemporarySuffix;
+
+  Status status;
+  size_t size = 0;
+  int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0644);
+  if (fd == -1) {
+    status = detail::io_error("Failed to create the metadata snapshot",
+                              temporary);
+  } else {
+    boost::crc_32_type crc;
+    std::string buffer;
+    buffer.reserve(detail::kSnapshotBufferSize * 2);
+    detail::put_value<uint64_t>(buffer, detail::kSnapshotMagic);
+    detail::put_value<uint32_t>(buffer, rev);
+    detail::put_value<uint64_t>(buffer, kvs->size());
+    for (auto const& kv : *kvs) {
+      detail::put_bytes(buffer, kv.first);
+      detail::put_bytes(buffer, kv.second);
+      if (buffer.size() >= detail::kSnapshotBufferSize) {
+        crc.process_bytes(buffer.data(), buffer.size());
+        status = detail::write_fully(fd, buffer, temporary);
+        if (!status.ok()) {
+          break;
+        }
+        size += buffer.size();
+        buffer.clear();
+      }
+    }
+    if (status.ok()) {
+      crc.process_bytes(buffer.data(), buffer.size());
+      detail::put_value<uint32_t>(buffer, crc.checksum());
+      status = detail::write_fully(fd, buffer, temporary);
+      size += buffer.size();
+    }
+    if (status.ok() && fdatasync(fd) != 0) {
+      status = detail::io_error("Failed to sync", temporary);
+    }
+    close(fd);
+  }
+  if (status.ok() && rename(temporary.c_str(), path.c_str()) != 0) {
+    status = detail::io_error("Failed to rename", temporary);
+  }
+  if (status.ok()) {
+    status = detail::sync_directory(directory_);
+  }
+  kvs.reset();
+  if (!status.ok()) {
+    // the logs are left untouched, nothing is lost
+    LOG(ERROR) << "Failed to compact the metadata log: " << status.ToString();
+    unlink(temporary.c_str());
+    compacting_.store(false);
+    return;
+  }
+  snapshot_size_.store(size);
+
+  // the snapshot supersedes the older snapshots and logs
+  std::vector<std::string> names;
+  VINEYARD_DISCARD(detail::list_directory(directory_, names));
+  for (auto const& name : names) {
+    unsigned file_rev = 0;
+    if ((detail::parse_wal_file_name(name, detail::kSnapshotPrefix, "",
+                                     file_rev) &&
+         file_rev < rev) ||
+        (detail::parse_wal_file_name(name, detail::kLogPrefix,
+                                     detail::kLogSuffix, file_rev) &&
+         file_rev <= rev)) {
+      unlink((directory_ + "/" + name).c_str());
+    }
+  }
+  VLOG(10) << "metadata log: compacted to snapshot at revision " << rev
+           << ", " << size << " bytes in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count()
+           << " milliseconds";
+  compacting_.store(false);
+}
+
+}  // namespace vineyard
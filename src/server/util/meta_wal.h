@@ -0,0 +1,158 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_SERVER_UTIL_META_WAL_H_
+#define SRC_SERVER_UTIL_META_WAL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/util/status.h"
+#include "server/util/meta_tree.h"
+
+namespace vineyard {
+
+/**
+ * @brief MetaWal persists the (flattened) metadata key-values in a directory
+ * as an append-only write-ahead log, which is compacted to a snapshot
+ * periodically.
+ *
+ * The directory contains:
+ *
+ *   - snapshot-<rev>: all key-values at revision <rev>
+ *   - wal-<rev>.log: the commits since revision <rev> (inclusive)
+ *
+ * Each commit bumps the revision by one and is logged as a record of
+ * `[size: uint32][crc32: uint32][payload: uint8[size]]`. Commits are written
+ * and fsync-ed by a dedicated writer in groups, i.e., the commits that arrive
+ * during an fsync are made durable together by the next one.
+ *
+ * On recovery the latest snapshot is loaded and the newer commits are
+ * replayed. A torn record at the tail of the last log, i.e., a write that has
+ * been interrupted by a crash and never been acknowledged, is truncated.
+ */
+class MetaWal {
+ public:
+  using op_t = meta_tree::op_t;
+  using commit_callback_t = std::function<void(const Status&, unsigned)>;
+
+  MetaWal(std::string const& directory, size_t const compaction_size);
+
+  MetaWal(const MetaWal&) = delete;
+
+  MetaWal& operator=(const MetaWal&) = delete;
+
+  ~MetaWal();
+
+  /**
+   * @brief Recovers the key-values from the directory and starts the writer.
+   */
+  Status Open();
+
+  /**
+   * @brief Waits for the pending commits to be durable and stops the writer.
+   */
+  void Close();
+
+  /**
+   * @brief Closes the log and removes the directory, i.e., the metadata is
+   * discarded.
+   */
+  Status Remove();
+
+  /**
+   * @brief Commits the changes atomically. The callback is invoked on the
+   * writer thread with the revision of the commit once it is durable.
+   */
+  void Commit(std::vector<op_t> const& changes, commit_callback_t callback);
+
+  /**
+   * @brief Lists all key-values as puts, and the revision they are at.
+   */
+  void Values(std::vector<op_t>& ops, unsigned& rev) const;
+
+  unsigned Revision() const;
+
+  size_t Size() const;
+
+  /**
+   * @brief The first I/O error of the writer: once a write or an fsync
+   * fails what is on disk is unknown, and later commits are rejected.
+   */
+  Status status() const;
+
+ private:
+  struct commit_t {
+    std::vector<op_t> changes;
+    commit_callback_t callback;
+  };
+
+  using kvs_t = std::unordered_map<std::string, std::string>;
+
+  Status recover();
+
+  Status loadSnapshot(std::string const& path, unsigned const rev);
+
+  Status replayLog(std::string const& path, bool const last);
+
+  Status openLog(unsigned const start_rev);
+
+  void writer();
+
+  Status writeGroup(std::vector<commit_t> const& group);
+
+  void apply(std::vector<op_t> const& changes);
+
+  void maybeCompact();
+
+  void compact(std::shared_ptr<kvs_t> kvs, unsigned const rev);
+
+  const std::string directory_;
+  const size_t compaction_size_;
+
+  // guards `kvs_`, `rev_` and `status_`, which are mutated by the writer only
+  mutable std::mutex mutex_;
+  kvs_t kvs_;
+  unsigned rev_ = 0;
+  Status status_;
+
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::vector<commit_t> pending_;
+  bool closing_ = false;
+  std::thread writer_;
+
+  // accessed by the writer only
+  int log_fd_ = -1;
+  std::string log_path_;
+  size_t log_size_ = 0;
+
+  std::thread compactor_;
+  std::atomic<bool> compacting_{false};
+  std::atomic<size_t> snapshot_size_{0};
+};
+
+}  // namespace vineyard
+
+#endif  // SRC_SERVER_UTIL_META_WAL_H_
@@ -34,11 +34,17 @@ DEFINE_string(meta, "etcd",
 #if defined(BUILD_VINEYARDD_REDIS)
               ", 'redis'"
 #endif
-              " and 'local'");
+              ", 'wal' and 'local'");
 DEFINE_string(etcd_endpoint, "http://127.0.0.1:2379", "endpoint of etcd");
 DEFINE_string(etcd_prefix, "vineyard", "metadata path prefix in etcd");
 DEFINE_string(etcd_cmd, "", "path of etcd executable");
 
+DEFINE_string(wal_dir, "/var/lib/vineyard/meta",
+              "directory of the write-ahead log and snapshots of metadata");
+DEFINE_int64(wal_compaction_size, 64 * 1024 * 1024,
+             "compact the write-ahead log of metadata to a snapshot when it "
+             "grows beyond this size (in bytes) and the latest snapshot");
+
 #if defined(BUILD_VINEYARDD_REDIS)
 DEFINE_string(redis_endpoint, "redis://127.0.0.1:6379", "endpoint of redis");
 DEFINE_string(redis_prefix, "vineyard", "metadata path prefix in redis");
@@ -127,6 +133,10 @@ json MetaStoreSpecResolver::resolve() const {
   spec["etcd_endpoint"] = FLAGS_etcd_endpoint;
   spec["etcd_cmd"] = FLAGS_etcd_cmd;
 
+  // resolve for wal
+  spec["wal_dir"] = FLAGS_wal_dir;
+  spec["wal_compaction_size"] = FLAGS_wal_compaction_size;
+
   // resolve for redis
 #if defined(BUILD_VINEYARDD_REDIS)
   spec["redis_prefix"] = FLAGS_redis_prefix;
@@ -22,6 +22,7 @@ limitations under the License.
 #include "arrow/stl.h"
 
 #include "basic/ds/arrow.h"
+#include "basic/ds/arrow_shim/memory_pool.h"
 #include "basic/ds/arrow_utils.h"
 #include "client/client.h"
 #include "client/ds/object_meta.h"
@@ -582,6 +583,136 @@ int main(int argc, char** argv) {
     LOG(INFO) << "Passed large table with multiple chunks tests...";
   }
 
+  {
+    LOG(INFO) << "######### Chunked Array Test ######";
+    std::vector<std::shared_ptr<arrow::Array>> chunks;
+    for (int64_t i = 0; i < 3; ++i) {
+      arrow::Int64Builder b1;
+      CHECK_ARROW_ERROR(b1.AppendValues({i, i + 1, i + 2}));
+      CHECK_ARROW_ERROR(b1.AppendNull());
+      std::shared_ptr<arrow::Array> a1;
+      CHECK_ARROW_ERROR(b1.Finish(&a1));
+      chunks.push_back(a1);
+    }
+    auto chunked_array = std::make_shared<arrow::ChunkedArray>(chunks);
+
+    ChunkedArrayBuilder builder(client, chunked_array);
+    auto r1 = std::dynamic_pointer_cast<ChunkedArray>(builder.Seal(client));
+    CHECK_EQ(r1->num_chunks(), 3);
+    CHECK(r1->GetArray()->Equals(*chunked_array));
+
+    // the chunks are vineyard blobs already, thus are adopted without copying
+    ChunkedArrayBuilder adopt_builder(client, r1->GetArray());
+    auto r2 =
+        std::dynamic_pointer_cast<ChunkedArray>(adopt_builder.Seal(client));
+    CHECK(r2->GetArray()->Equals(*chunked_array));
+    for (size_t i = 0; i < r1->num_chunks(); ++i) {
+      auto lhs = std::dynamic_pointer_cast<Int64Array>(r1->chunks()[i]);
+      auto rhs = std::dynamic_pointer_cast<Int64Array>(r2->chunks()[i]);
+      CHECK_NE(lhs->id(), rhs->id());
+      CHECK_EQ(lhs->GetBuffer()->id(), rhs->GetBuffer()->id());
+    }
+
+    ChunkedArrayBuilder concatenate_builder(client, chunked_array, true);
+    auto r3 = std::dynamic_pointer_cast<ChunkedArray>(
+        concatenate_builder.Seal(client));
+    CHECK_EQ(r3->num_chunks(), 1);
+    CHECK(r3->GetArray()->Equals(*chunked_array));
+
+    LOG(INFO) << "######### Unaligned Chunks Table Test ######";
+    arrow::DoubleBuilder b2;
+    CHECK_ARROW_ERROR(b2.AppendValues(
+        {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5, 10.5, 11.5}));
+    std::shared_ptr<arrow::Array> a2;
+    CHECK_ARROW_ERROR(b2.Finish(&a2));
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("a", arrow::int64()),
+                       arrow::field("b", arrow::float64())}),
+        std::vector<std::shared_ptr<arrow::ChunkedArray>>{
+            chunked_array, std::make_shared<arrow::ChunkedArray>(a2)});
+
+    // sliced into record batches by default
+    TableBuilder table_builder(client, table);
+    auto r4 = std::dynamic_pointer_cast<Table>(table_builder.Seal(client));
+    CHECK_EQ(r4->batch_num(), 3);
+    for (auto const& batch : r4->batches()) {
+      CHECK(batch->GetRecordBatch() != nullptr);
+    }
+    CHECK(r4->GetTable()->Equals(*table));
+
+    TableBuilder preserve_builder(client, table, false, true);
+    auto r6 = std::dynamic_pointer_cast<Table>(preserve_builder.Seal(client));
+    CHECK_EQ(r6->batch_num(), 1);
+    CHECK_EQ(r6->column(0)->num_chunks(), 3);
+    CHECK_EQ(r6->column(1)->num_chunks(), 1);
+    CHECK(r6->GetTable()->Equals(*table));
+    // the chunks are preserved by the table, and concatenated by the legacy
+    // accessors only
+    auto batch = r6->batches()[0];
+    CHECK(batch->GetTable()->Equals(*table));
+    CHECK_EQ(batch->chunked_column(0)->num_chunks(), 3);
+    std::shared_ptr<arrow::Array> concatenated;
+    CHECK_ARROW_ERROR_AND_ASSIGN(concatenated,
+                                 arrow::Concatenate(chunked_array->chunks()));
+    CHECK(batch->arrow_columns()[0]->Equals(concatenated));
+    CHECK(batch->arrow_columns()[1]->Equals(a2));
+    auto record_batch = batch->GetRecordBatch();
+    CHECK(record_batch != nullptr);
+    CHECK_EQ(record_batch->num_rows(), table->num_rows());
+    CHECK(record_batch->column(0)->Equals(concatenated));
+    CHECK(record_batch->column(1)->Equals(a2));
+    CHECK(r1->ToArray()->Equals(concatenated));
+
+    TableBuilder merge_builder(client, table, true);
+    auto r5 = std::dynamic_pointer_cast<Table>(merge_builder.Seal(client));
+    CHECK_EQ(r5->batch_num(), 1);
+    CHECK_EQ(r5->column(0)->num_chunks(), 1);
+    CHECK(r5->GetTable()->Equals(*table));
+
+    LOG(INFO) << "Passed chunked array tests...";
+  }
+
+  {
+    LOG(INFO) << "######### Vineyard Memory Pool Test ######";
+    memory::VineyardMemoryPool pool(client);
+    arrow::Int64Builder b1(&pool);
+    for (int64_t i = 0; i < 1024; ++i) {
+      CHECK_ARROW_ERROR(b1.Append(i));
+    }
+    std::shared_ptr<arrow::Int64Array> a1;
+    CHECK_ARROW_ERROR(b1.Finish(&a1));
+    CHECK_GT(pool.bytes_allocated(), 0);
+
+    // the buffers are sealed in place, rather than being copied
+    NumericArrayBuilder<int64_t> builder(client, a1);
+    auto r1 = std::dynamic_pointer_cast<Int64Array>(builder.Seal(client));
+    CHECK(!memory::VineyardMemoryPool::IsAllocated(client, a1->values()));
+    CHECK_EQ(r1->GetArray()->raw_values(), a1->raw_values());
+    CHECK(r1->GetArray()->Equals(*a1));
+
+    // the slices are copied, as the unsealed blob cannot be referenced
+    arrow::Int64Builder b2(&pool);
+    for (int64_t i = 0; i < 1024; ++i) {
+      CHECK_ARROW_ERROR(b2.Append(i));
+    }
+    std::shared_ptr<arrow::Int64Array> a2;
+    CHECK_ARROW_ERROR(b2.Finish(&a2));
+    int64_t allocated = pool.bytes_allocated();
+    auto sliced = std::dynamic_pointer_cast<arrow::Int64Array>(
+        a2->Slice(0, 512));
+    auto sliced_values = arrow::SliceBuffer(a2->values(), 0, 512 * 8);
+    auto a3 = std::make_shared<arrow::Int64Array>(512, sliced_values);
+    CHECK(!memory::VineyardMemoryPool::IsAllocated(client, sliced_values));
+    NumericArrayBuilder<int64_t> slice_builder(client, a3);
+    auto r3 = std::dynamic_pointer_cast<Int64Array>(slice_builder.Seal(client));
+    CHECK_NE(r3->GetArray()->raw_values(), a3->raw_values());
+    CHECK(r3->GetArray()->Equals(*sliced));
+    CHECK(memory::VineyardMemoryPool::IsAllocated(client, a2->values()));
+    CHECK_EQ(pool.bytes_allocated(), allocated);
+
+    LOG(INFO) << "Passed vineyard memory pool tests...";
+  }
+
   client.Disconnect();
 
   return 0;
@@ -13,15 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
 
 #include "basic/ds/array.h"
 #include "basic/ds/hashmap.h"
+#include "basic/ds/swiss_hashmap.h"
 #include "client/client.h"
 #include "client/ds/object_meta.h"
 #include "common/util/logging.h"
@@ -71,6 +74,101 @@ int main(int argc, char** argv) {
 
   LOG(INFO) << "Passed double hashmap tests...";
 
+  {
+    constexpr int64_t num_keys = 1000000;
+    constexpr int concurrency = 4;
+    ConcurrentHashmapBuilder<int64_t, int64_t> concurrent_builder(
+        client, num_keys + concurrency);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < concurrency; ++t) {
+      threads.emplace_back([&, t]() {
+        for (int64_t key = t; key < num_keys; key += concurrency) {
+          VINEYARD_CHECK_OK(concurrent_builder.emplace(key, key * 2));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    // duplicated keys are dropped
+    for (int t = 0; t < concurrency; ++t) {
+      VINEYARD_CHECK_OK(concurrent_builder.emplace(t, t * 2));
+    }
+    auto concurrent_hashmap =
+        std::dynamic_pointer_cast<Hashmap<int64_t, int64_t>>(
+            concurrent_builder.Seal(client));
+    CHECK_EQ(concurrent_hashmap->size(), num_keys);
+    for (int64_t key = 0; key < num_keys; ++key) {
+      CHECK_EQ(concurrent_hashmap->at(key), key * 2);
+    }
+    CHECK(concurrent_hashmap->find(num_keys) == concurrent_hashmap->end());
+    size_t visited = 0;
+    for (auto const& kv : *concurrent_hashmap) {
+      CHECK_EQ(kv.second, kv.first * 2);
+      visited += 1;
+    }
+    CHECK_EQ(visited, num_keys);
+  }
+
+  LOG(INFO) << "Passed concurrent hashmap builder tests...";
+
+  {
+    constexpr int64_t num_keys = 100000;
+    SwissHashmapBuilder<int64_t, int64_t> swiss_builder(client);
+    for (int64_t key = 0; key < num_keys; ++key) {
+      swiss_builder.emplace(key * 7919, key);
+    }
+    // duplicated keys are dropped
+    swiss_builder.emplace(0, -1);
+    ObjectID swiss_id = swiss_builder.Seal(client)->id();
+    auto swiss_hashmap =
+        client.GetObject<SwissHashmap<int64_t, int64_t>>(swiss_id);
+    CHECK_EQ(swiss_hashmap->size(), num_keys);
+    for (int64_t key = 0; key < num_keys; ++key) {
+      CHECK_EQ(swiss_hashmap->at(key * 7919), key);
+      CHECK(swiss_hashmap->find(key * 7919 + 1) == swiss_hashmap->end());
+    }
+    size_t visited = 0;
+    for (auto const& kv : *swiss_hashmap) {
+      CHECK_EQ(kv.first, kv.second * 7919);
+      visited += 1;
+    }
+    CHECK_EQ(visited, num_keys);
+
+    // string keys that point into a blob
+    std::vector<std::string> values;
+    size_t total_size = 0;
+    for (int64_t key = 0; key < 1000; ++key) {
+      values.emplace_back("key-" + std::to_string(key));
+      total_size += values.back().size();
+    }
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(client.CreateBlob(total_size, writer));
+    SwissHashmapBuilder<arrow_string_view, int64_t> string_builder(client);
+    size_t offset = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+      memcpy(writer->data() + offset, values[i].data(), values[i].size());
+      string_builder.emplace(
+          arrow_string_view(writer->data() + offset, values[i].size()),
+          static_cast<int64_t>(i));
+      offset += values[i].size();
+    }
+    string_builder.AssociateDataBuffer(
+        std::dynamic_pointer_cast<Blob>(writer->Seal(client)));
+    auto string_hashmap =
+        client.GetObject<SwissHashmap<arrow_string_view, int64_t>>(
+            string_builder.Seal(client)->id());
+    CHECK_EQ(string_hashmap->size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      int64_t value = -1;
+      CHECK(string_hashmap->find(values[i], value));
+      CHECK_EQ(value, static_cast<int64_t>(i));
+    }
+    CHECK_EQ(string_hashmap->count("key-not-exists"), 0);
+  }
+
+  LOG(INFO) << "Passed swiss hashmap tests...";
+
   client.Disconnect();
 
   return 0;
@@ -13,12 +13,38 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <unistd.h>
+
 #include <bitset>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+
+#if defined(WITH_PARQUET)
+#include "parquet/arrow/writer.h"
+#endif
 
+#if defined(WITH_ORC)
+#include "arrow/adapters/orc/adapter.h"
+#endif
+
+#include "common/util/arrow.h"
 #include "common/util/logging.h"
 #include "common/util/uuid.h"
+#include "io/io/columnar_reader.h"
 #include "io/io/io_factory.h"
+#include "io/io/local_io_adaptor.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr int64_t kRows = 1000;
+constexpr int kParts = 4;
 
 void ReadLines(std::string const& path_to_read) {
   auto io = vineyard::IOFactory::CreateIOAdaptor(path_to_read, nullptr);
@@ -76,9 +102,352 @@ void ReadTable(std::string const& path_to_read) {
   }
 }
 
+void ReadBatches(std::string const& path_to_read) {
+  constexpr int total_parts = 4;
+  for (int index = 0; index < total_parts; ++index) {
+    auto io = vineyard::IOFactory::CreateIOAdaptor(path_to_read, nullptr);
+    VINEYARD_CHECK_OK(io->SetPartialRead(index, total_parts));
+    VINEYARD_CHECK_OK(io->Open());
+
+    std::shared_ptr<arrow::RecordBatchReader> reader;
+    VINEYARD_CHECK_OK(io->ReadRecordBatches(&reader));
+    LOG(INFO) << "schema of part " << index << ": "
+              << reader->schema()->ToString();
+    int64_t num_rows = 0;
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      CHECK_ARROW_ERROR(reader->ReadNext(&batch));
+      if (batch == nullptr) {
+        break;
+      }
+      num_rows += batch->num_rows();
+    }
+    LOG(INFO) << "read " << num_rows << " rows from part " << index << " of "
+              << total_parts;
+    VINEYARD_CHECK_OK(io->Close());
+  }
+}
+
+// The operator starts at its first character, and the longest operator
+// there is matched.
+void ParsePredicatesTest() {
+  std::vector<ColumnPredicate> predicates;
+  VINEYARD_CHECK_OK(
+      ParseColumnPredicates("id<=99; weight > 0.5;name<a==b", predicates));
+  CHECK_EQ(predicates.size(), 3u);
+  CHECK_EQ(predicates[0].column, "id");
+  CHECK_EQ(predicates[0].op, "<=");
+  CHECK_EQ(predicates[0].value, "99");
+  CHECK_EQ(predicates[1].column, "weight");
+  CHECK_EQ(predicates[1].op, ">");
+  CHECK_EQ(predicates[1].value, "0.5");
+  CHECK_EQ(predicates[2].column, "name");
+  CHECK_EQ(predicates[2].op, "<");
+  CHECK_EQ(predicates[2].value, "a==b");
+
+  for (auto const& invalid : {"id", "==1", "id=1", "id!1"}) {
+    predicates.clear();
+    CHECK(ParseColumnPredicates(invalid, predicates).IsInvalid());
+  }
+  LOG(INFO) << "Passed parse predicates test";
+}
+
+// "id" is 0, 1, ..., kRows - 1, the file is split into kRows / 100 row groups
+// (stripes).
+std::shared_ptr<arrow::Table> MakeTable() {
+  arrow::Int64Builder id_builder;
+  arrow::DoubleBuilder weight_builder;
+  arrow::StringBuilder name_builder;
+  for (int64_t i = 0; i < kRows; ++i) {
+    CHECK_ARROW_ERROR(id_builder.Append(i));
+    CHECK_ARROW_ERROR(weight_builder.Append(i * 0.5));
+    CHECK_ARROW_ERROR(name_builder.Append("name-" + std::to_string(i)));
+  }
+  std::shared_ptr<arrow::Array> ids, weights, names;
+  CHECK_ARROW_ERROR(id_builder.Finish(&ids));
+  CHECK_ARROW_ERROR(weight_builder.Finish(&weights));
+  CHECK_ARROW_ERROR(name_builder.Finish(&names));
+  auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                               arrow::field("weight", arrow::float64()),
+                               arrow::field("name", arrow::utf8())});
+  return arrow::Table::Make(schema, {ids, weights, names});
+}
+
+std::vector<int64_t> CollectIds(const std::shared_ptr<arrow::Table>& table) {
+  std::vector<int64_t> ids;
+  if (table == nullptr) {
+    return ids;
+  }
+  auto column = table->GetColumnByName("id");
+  CHECK(column != nullptr);
+  for (auto const& chunk : column->chunks()) {
+    auto array = std::dynamic_pointer_cast<arrow::Int64Array>(chunk);
+    for (int64_t i = 0; i < array->length(); ++i) {
+      ids.push_back(array->Value(i));
+    }
+  }
+  return ids;
+}
+
+std::vector<int64_t> CollectIds(
+    const std::shared_ptr<arrow::RecordBatchReader>& reader) {
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    CHECK_ARROW_ERROR(reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(batch);
+  }
+  if (batches.empty()) {
+    return {};
+  }
+  std::shared_ptr<arrow::Table> table;
+  CHECK_ARROW_ERROR_AND_ASSIGN(
+      table, arrow::Table::FromRecordBatches(reader->schema(), batches));
+  return CollectIds(table);
+}
+
+// Lines of various lengths, where the long ones span over the read-ahead
+// window of `ReadLine()` (1MB), the scan block of line breaks (64KB) and many
+// partitions. The last line is not terminated by '\n'.
+std::vector<std::string> MakeLines() {
+  std::vector<std::string> lines;
+  for (int64_t i = 0; i < kRows; ++i) {
+    size_t length = (i * 37) % 200;
+    if (i == 10) {
+      length = 100 * 1024;
+    } else if (i == kRows / 2) {
+      length = 3 * 1024 * 1024 / 2;
+    } else if (i == kRows - 10) {
+      length = 70 * 1024;
+    } else if (i % 100 == 0) {
+      length = 0;
+    }
+    lines.push_back(std::to_string(i) + "," +
+                    std::string(length, 'a' + i % 26));
+  }
+  return lines;
+}
+
+void WriteLines(const std::string& path,
+                const std::vector<std::string>& lines) {
+  std::ofstream output(path, std::ios::binary);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    output << lines[i];
+    if (i + 1 < lines.size()) {
+      output << "\n";
+    }
+  }
+  CHECK(output.good());
+}
+
+std::vector<std::string> ReadAllLines(IIOAdaptor* io) {
+  std::vector<std::string> lines;
+  std::string line;
+  while (true) {
+    auto status = io->ReadLine(line);
+    if (status.IsEndOfFile()) {
+      break;
+    }
+    VINEYARD_CHECK_OK(status);
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+// The lines are read as is, from either the whole file or the parts. Every
+// line is read by exactly one part, the one where it starts, and the parts
+// are contiguous byte ranges that start at line beginnings.
+void ReadLinesTest(const std::string& path) {
+  auto lines = MakeLines();
+  WriteLines(path, lines);
+  {
+    auto io = IOFactory::CreateIOAdaptor(path, nullptr);
+    VINEYARD_CHECK_OK(io->Open());
+    CHECK(ReadAllLines(io.get()) == lines);
+    VINEYARD_CHECK_OK(io->Close());
+  }
+
+  std::ifstream input(path, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(input)),
+                      std::istreambuf_iterator<char>());
+  for (int total_parts : {1, 2, 5, 16, 64}) {
+    std::vector<std::string> read;
+    int64_t next_offset = 0;
+    for (int index = 0; index < total_parts; ++index) {
+      auto io = IOFactory::CreateIOAdaptor(path, nullptr);
+      VINEYARD_CHECK_OK(io->SetPartialRead(index, total_parts));
+      VINEYARD_CHECK_OK(io->Open());
+      auto local = dynamic_cast<LocalIOAdaptor*>(io.get());
+      CHECK(local != nullptr);
+      int64_t offset = 0, nbytes = 0;
+      VINEYARD_CHECK_OK(local->GetPartialReadDetail(offset, nbytes));
+      CHECK_EQ(offset, next_offset);
+      CHECK_GE(nbytes, 0);
+      CHECK(offset == 0 || content[offset - 1] == '\n');
+      next_offset = offset + nbytes;
+
+      auto part = ReadAllLines(io.get());
+      read.insert(read.end(), part.begin(), part.end());
+      VINEYARD_CHECK_OK(io->Close());
+    }
+    CHECK_EQ(next_offset, static_cast<int64_t>(content.size()));
+    CHECK_EQ(read.size(), lines.size());
+    for (size_t i = 0; i < lines.size(); ++i) {
+      CHECK(read[i] == lines[i]) << "line " << i << " of " << total_parts
+                                 << " parts mismatches";
+    }
+  }
+  unlink(path.c_str());
+  LOG(INFO) << "Passed read lines test";
+}
+
+// The rows read from the parts cover the file exactly once.
+void PartialReadCSVTest(const std::string& path) {
+  std::vector<std::string> lines = {"id,name"};
+  for (int64_t i = 0; i < kRows; ++i) {
+    lines.push_back(std::to_string(i) + ",name-" + std::to_string(i));
+  }
+  WriteLines(path, lines);
+  for (int total_parts : {1, 3, 7}) {
+    std::vector<int64_t> ids;
+    for (int index = 0; index < total_parts; ++index) {
+      auto io = IOFactory::CreateIOAdaptor(path + "#header_row=true", nullptr);
+      VINEYARD_CHECK_OK(io->SetPartialRead(index, total_parts));
+      VINEYARD_CHECK_OK(io->Open());
+      std::shared_ptr<arrow::Table> table;
+      VINEYARD_CHECK_OK(io->ReadTable(&table));
+      auto part = CollectIds(table);
+      ids.insert(ids.end(), part.begin(), part.end());
+      VINEYARD_CHECK_OK(io->Close());
+    }
+    CHECK_EQ(ids.size(), static_cast<size_t>(kRows));
+    for (int64_t i = 0; i < kRows; ++i) {
+      CHECK_EQ(ids[i], i);
+    }
+  }
+  unlink(path.c_str());
+  LOG(INFO) << "Passed partial read csv test";
+}
+
+// The parts are read by both separated adaptors and a single adaptor with
+// different indices, they are contiguous ranges of ids that cover the file,
+// and the predicates are applied to the rows (and row groups).
+void ReadColumnarFile(const std::string& path) {
+  std::vector<int64_t> ids;
+  for (int index = 0; index < kParts; ++index) {
+    auto io = IOFactory::CreateIOAdaptor(path, nullptr);
+    VINEYARD_CHECK_OK(io->SetPartialRead(index, kParts));
+    VINEYARD_CHECK_OK(io->Open());
+    std::shared_ptr<arrow::Table> table;
+    VINEYARD_CHECK_OK(io->ReadTable(&table));
+    auto part = CollectIds(table);
+    ids.insert(ids.end(), part.begin(), part.end());
+
+    auto local = dynamic_cast<LocalIOAdaptor*>(io.get());
+    CHECK(local != nullptr);
+    for (int other = 0; other < kParts; ++other) {
+      std::shared_ptr<arrow::Table> other_table;
+      VINEYARD_CHECK_OK(local->ReadPartialTable(&other_table, other));
+      CHECK_EQ(CollectIds(other_table) == part, other == index);
+    }
+    VINEYARD_CHECK_OK(io->Close());
+
+    io = IOFactory::CreateIOAdaptor(path, nullptr);
+    VINEYARD_CHECK_OK(io->SetPartialRead(index, kParts));
+    VINEYARD_CHECK_OK(io->Open());
+    std::shared_ptr<arrow::RecordBatchReader> reader;
+    VINEYARD_CHECK_OK(io->ReadRecordBatches(&reader));
+    CHECK(CollectIds(reader) == part);
+    VINEYARD_CHECK_OK(io->Close());
+  }
+  CHECK_EQ(ids.size(), static_cast<size_t>(kRows));
+  for (int64_t i = 0; i < kRows; ++i) {
+    CHECK_EQ(ids[i], i);
+  }
+
+  // the projected columns are kept in order
+  std::string location = path + "#schema=name,id&filter=id>=600;weight<400";
+  auto io = IOFactory::CreateIOAdaptor(location, nullptr);
+  VINEYARD_CHECK_OK(io->Open());
+  std::shared_ptr<arrow::Table> table;
+  VINEYARD_CHECK_OK(io->ReadTable(&table));
+  CHECK_EQ(table->num_columns(), 2);
+  CHECK_EQ(table->schema()->field(0)->name(), "name");
+  CHECK_EQ(table->schema()->field(1)->name(), "id");
+  ids = CollectIds(table);
+  CHECK_EQ(ids.size(), 200u);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    CHECK_EQ(ids[i], static_cast<int64_t>(600 + i));
+  }
+  VINEYARD_CHECK_OK(io->Close());
+
+  io = IOFactory::CreateIOAdaptor(path + "#filter=id>=" + std::to_string(kRows),
+                                  nullptr);
+  VINEYARD_CHECK_OK(io->Open());
+  std::shared_ptr<arrow::RecordBatchReader> reader;
+  VINEYARD_CHECK_OK(io->ReadRecordBatches(&reader));
+  CHECK(CollectIds(reader).empty());
+  VINEYARD_CHECK_OK(io->Close());
+}
+
+void ColumnarTests(const std::string& prefix) {
+  auto table = MakeTable();
+#if defined(WITH_PARQUET)
+  {
+    std::string path = prefix + ".parquet";
+    std::shared_ptr<arrow::io::FileOutputStream> output;
+    CHECK_ARROW_ERROR_AND_ASSIGN(output,
+                                 arrow::io::FileOutputStream::Open(path));
+    CHECK_ARROW_ERROR(parquet::arrow::WriteTable(
+        *table, arrow::default_memory_pool(), output, kRows / 10));
+    CHECK_ARROW_ERROR(output->Close());
+    ReadColumnarFile(path);
+    unlink(path.c_str());
+    LOG(INFO) << "Passed parquet read test";
+  }
+#endif
+#if defined(WITH_ORC) && defined(ARROW_VERSION) && ARROW_VERSION >= 7000000
+  {
+    std::string path = prefix + ".orc";
+    std::shared_ptr<arrow::io::FileOutputStream> output;
+    CHECK_ARROW_ERROR_AND_ASSIGN(output,
+                                 arrow::io::FileOutputStream::Open(path));
+    // a stripe for every batch
+    arrow::adapters::orc::WriteOptions options;
+    options.batch_size = kRows / 10;
+    options.stripe_size = 1;
+    std::unique_ptr<arrow::adapters::orc::ORCFileWriter> writer;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        writer, arrow::adapters::orc::ORCFileWriter::Open(output.get(),
+                                                          options));
+    CHECK_ARROW_ERROR(writer->Write(*table));
+    CHECK_ARROW_ERROR(writer->Close());
+    CHECK_ARROW_ERROR(output->Close());
+    ReadColumnarFile(path);
+    unlink(path.c_str());
+    LOG(INFO) << "Passed orc read test";
+  }
+#endif
+}
+
 int main(int argc, char** argv) {
+  if (argc == 2) {
+    // the ipc socket from the test runner, which is not used
+    std::string prefix = "/tmp/vineyard_io_test_" + std::to_string(getpid());
+    ReadLinesTest(prefix + ".lines");
+    PartialReadCSVTest(prefix + ".csv");
+    ParsePredicatesTest();
+    ColumnarTests(prefix);
+    LOG(INFO) << "Passed io tests...";
+    return 0;
+  }
   if (argc < 3) {
-    printf("usage ./io_test <lines or table> <path to read>");
+    printf(
+        "usage ./io_test <ipc_socket>, or ./io_test <lines, table or batches> "
+        "<path to read>\n");
     return 1;
   }
 
@@ -91,6 +460,9 @@ int main(int argc, char** argv) {
   if (mode == "table") {
     ReadTable(path_to_read);
   }
+  if (mode == "batches") {
+    ReadBatches(path_to_read);
+  }
 
   LOG(INFO) << "Passed double array tests...";
 
@@ -0,0 +1,129 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/util/logging.h"
+#include "common/util/status.h"
+#include "server/util/meta_wal.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using op_t = meta_tree::op_t;
+
+constexpr size_t kCompactionSize = 1024 * 1024 * 1024;
+
+// commits and waits until the changes are durable
+unsigned Commit(MetaWal& wal, std::vector<op_t> const& changes) {
+  std::promise<unsigned> committed;
+  wal.Commit(changes, [&committed](const Status& status, unsigned rev) {
+    VINEYARD_CHECK_OK(status);
+    committed.set_value(rev);
+  });
+  return committed.get_future().get();
+}
+
+std::map<std::string, std::string> Values(MetaWal const& wal) {
+  std::vector<op_t> ops;
+  unsigned rev = 0;
+  wal.Values(ops, rev);
+  std::map<std::string, std::string> values;
+  for (auto const& op : ops) {
+    values.emplace(op.kv.key, op.kv.value);
+  }
+  return values;
+}
+
+void RemoveDirectory(std::string const& directory) {
+  DIR* dir = opendir(directory.c_str());
+  CHECK(dir != nullptr);
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      unlink((directory + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+  rmdir(directory.c_str());
+}
+
+void TornTailTest(std::string const& directory) {
+  std::map<std::string, std::string> expected;
+  {
+    MetaWal wal(directory, kCompactionSize);
+    VINEYARD_CHECK_OK(wal.Open());
+    CHECK_EQ(wal.Revision(), 0u);
+    for (int i = 0; i < 10; ++i) {
+      std::string key = "/data/o" + std::to_string(i) + "/id";
+      std::vector<op_t> changes{op_t::Put(key, std::to_string(i), 0)};
+      if (i == 5) {
+        changes.emplace_back(op_t::Del("/data/o0/id", 0));
+      }
+      CHECK_EQ(Commit(wal, changes), static_cast<unsigned>(i + 1));
+      // the last commit will be torn
+      if (i < 9) {
+        expected[key] = std::to_string(i);
+      }
+    }
+    expected.erase("/data/o0/id");
+    wal.Close();
+  }
+
+  // truncates the log in the middle of the last record, as what a crash
+  // during the write leaves
+  std::string log = directory + "/wal-0000000001.log";
+  struct stat st;
+  CHECK_EQ(stat(log.c_str(), &st), 0);
+  CHECK_EQ(truncate(log.c_str(), st.st_size - 3), 0);
+
+  {
+    MetaWal wal(directory, kCompactionSize);
+    VINEYARD_CHECK_OK(wal.Open());
+    CHECK_EQ(wal.Revision(), 9u);
+    CHECK(Values(wal) == expected);
+
+    // the revisions continue after the torn record
+    CHECK_EQ(Commit(wal, {op_t::Put("/data/o9/id", "9-again", 0)}), 10u);
+    expected["/data/o9/id"] = "9-again";
+    wal.Close();
+  }
+
+  {
+    MetaWal wal(directory, kCompactionSize);
+    VINEYARD_CHECK_OK(wal.Open());
+    CHECK_EQ(wal.Revision(), 10u);
+    CHECK(Values(wal) == expected);
+    wal.Close();
+  }
+}
+
+int main(int argc, char** argv) {
+  char directory[] = "/tmp/vineyard-meta-wal-XXXXXX";
+  CHECK(mkdtemp(directory) != nullptr);
+
+  TornTailTest(directory);
+  RemoveDirectory(directory);
+
+  LOG(INFO) << "Passed meta wal tests...";
+  return 0;
+}
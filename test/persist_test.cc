@@ -13,9 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -27,9 +29,79 @@ limitations under the License.
 
 using namespace vineyard;  // NOLINT(build/namespaces)
 
+ObjectID CreateParent(Client& client, const ObjectMeta& member) {
+  ObjectMeta meta;
+  meta.SetTypeName("vineyard::PersistTestParent");
+  meta.SetNBytes(0);
+  meta.AddMember("member", member);
+  ObjectID id = InvalidObjectID();
+  VINEYARD_CHECK_OK(client.CreateMetaData(meta, id));
+  return id;
+}
+
+bool ExistsAfterSync(Client& client, const ObjectID id) {
+  bool exists = false;
+  VINEYARD_CHECK_OK(client.SyncMetaData());
+  VINEYARD_CHECK_OK(client.Exists(id, exists));
+  return exists;
+}
+
+// Persisting an object whose member has been deleted by another instance
+// must fail, rather than commit a parent that links to a missing member.
+void PersistWithDeletedMember(Client& client, Client& other) {
+  ArrayBuilder<double> builder(client, std::vector<double>{1.0, 2.0});
+  auto member = builder.Seal(client);
+  VINEYARD_CHECK_OK(member->Persist(client));
+  ObjectID parent = CreateParent(client, member->meta());
+
+  CHECK(ExistsAfterSync(other, member->id()));
+  VINEYARD_CHECK_OK(other.DelData(member->id(), true, false));
+
+  Status status = client.Persist(parent);
+  CHECK(!status.ok());
+  LOG(INFO) << "Persist failed as expected: " << status.ToString();
+  CHECK(!ExistsAfterSync(other, parent));
+  CHECK(!ExistsAfterSync(other, member->id()));
+  LOG(INFO) << "Passed persist with deleted member";
+}
+
+// Objects that share a persisted member are persisted concurrently from
+// both instances, and every one of them is visible to the other instance.
+void PersistWithSharedMember(Client& client, Client& other) {
+  constexpr int kParents = 8;
+  ArrayBuilder<double> builder(client, std::vector<double>{1.0, 2.0});
+  auto member = builder.Seal(client);
+  VINEYARD_CHECK_OK(member->Persist(client));
+  CHECK(ExistsAfterSync(other, member->id()));
+  ObjectMeta other_member;
+  VINEYARD_CHECK_OK(other.GetMetaData(member->id(), other_member));
+
+  std::vector<ObjectID> parents, other_parents;
+  for (int i = 0; i < kParents; ++i) {
+    parents.push_back(CreateParent(client, member->meta()));
+    other_parents.push_back(CreateParent(other, other_member));
+  }
+  auto persist_all = [](Client& client, const std::vector<ObjectID>& ids) {
+    for (auto const id : ids) {
+      VINEYARD_CHECK_OK(client.Persist(id));
+    }
+  };
+  std::thread persist_thread(persist_all, std::ref(client), parents);
+  std::thread other_persist_thread(persist_all, std::ref(other),
+                                   other_parents);
+  persist_thread.join();
+  other_persist_thread.join();
+
+  for (int i = 0; i < kParents; ++i) {
+    CHECK(ExistsAfterSync(other, parents[i]));
+    CHECK(ExistsAfterSync(client, other_parents[i]));
+  }
+  LOG(INFO) << "Passed persist with shared member";
+}
+
 int main(int argc, char** argv) {
   if (argc < 2) {
-    printf("usage ./persist_test <ipc_socket>");
+    printf("usage ./persist_test <ipc_socket> [<another_ipc_socket>]");
     return 1;
   }
   std::string ipc_socket = std::string(argv[1]);
@@ -64,6 +136,44 @@ int main(int argc, char** argv) {
     CHECK_EQ((*vy_double_array)[i], double_array[i]);
   }
 
+  // a failed persist (e.g., exceeds the request size limit of etcd) must
+  // leave the metadata unchanged, and won't break the following persists.
+  {
+    ObjectMeta meta;
+    meta.SetTypeName("vineyard::PersistTestLargeObject");
+    meta.SetNBytes(0);
+    meta.AddKeyValue("payload", std::string(4 * 1024 * 1024, 'x'));
+    ObjectID large_id = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.CreateMetaData(meta, large_id));
+
+    bool persist = false;
+    Status status = client.Persist(large_id);
+    VINEYARD_CHECK_OK(client.IfPersist(large_id, persist));
+    if (status.ok()) {
+      CHECK(persist);
+    } else {
+      LOG(INFO) << "Persist failed as expected: " << status.ToString();
+      CHECK(!persist);
+    }
+
+    ArrayBuilder<double> other_builder(client, double_array);
+    auto other = other_builder.Seal(client);
+    VINEYARD_CHECK_OK(other->Persist(client));
+    CHECK(other->IsPersist());
+  }
+
+  // the persists race with the changes from another instance
+  if (argc > 2) {
+    Client other;
+    VINEYARD_CHECK_OK(other.Connect(std::string(argv[2])));
+    LOG(INFO) << "Connected to IPCServer: " << argv[2];
+
+    PersistWithDeletedMember(client, other);
+    PersistWithSharedMember(client, other);
+
+    other.Disconnect();
+  }
+
   LOG(INFO) << "Passed persist tests...";
 
   client.Disconnect();
@@ -6,9 +6,11 @@ import importlib
 import importlib.util
 import os
 import platform
+import shutil
 import socket
 import subprocess
 import sys
+import tempfile
 import time
 from argparse import ArgumentParser
 from typing import Union
@@ -444,10 +446,12 @@ def run_vineyard_cpp_tests(meta, allocator, endpoints, tests):
         run_test(tests, 'hashmap_test')
         # run_test(tests, 'hosseinmoein_dataframe_test')
         run_test(tests, 'id_test')
+        run_test(tests, 'io_test')
         run_test(tests, 'invalid_connect_test', '127.0.0.1:%d' % rpc_socket_port)
         run_test(tests, 'large_meta_test')
         run_test(tests, 'list_object_test')
         run_test(tests, 'lru_test')
+        run_test(tests, 'meta_wal_test')
         run_test(tests, 'mutable_blob_test')
         run_test(tests, 'name_test')
         run_test(tests, 'object_meta_test')
@@ -469,6 +473,7 @@ def run_vineyard_cpp_tests(meta, allocator, endpoints, tests):
         run_test(tests, 'tensor_test')
         run_test(tests, 'typename_test')
         run_test(tests, 'version_test')
+        run_test(tests, 'wide_table_seal_test')
 
 
 def run_vineyard_spill_tests(meta, allocator, endpoints, tests):
@@ -484,6 +489,82 @@ def run_vineyard_spill_tests(meta, allocator, endpoints, tests):
         run_test(tests, 'spill_test')
 
 
+def run_vineyard_persist_tests(meta, allocator, endpoints, tests):
+    meta_prefix = 'vineyard_test_%s' % time.time()
+    metadata_settings = make_metadata_settings(meta, endpoints, meta_prefix)
+    instance_size = 2
+    with start_multiple_vineyardd(
+        metadata_settings,
+        ['--allocator', allocator],
+        default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+        instance_size=instance_size,
+    ) as instances:  # noqa: F841, pylint: disable=unused-variable
+        # the persists race with the deletes from the other instance
+        run_test(
+            tests,
+            'persist_test',
+            '%s.%d' % (VINEYARD_CI_IPC_SOCKET, 1),
+            vineyard_ipc_socket='%s.%d' % (VINEYARD_CI_IPC_SOCKET, 0),
+        )
+
+
+def run_wal_restart_tests(allocator, tests):
+    if not include_test(tests, 'wal_restart_test'):
+        return
+    wal_dir = tempfile.mkdtemp(prefix='vineyard-wal-')
+    metadata_settings = ['--meta', 'wal', '--wal_dir', wal_dir]
+    try:
+        with start_vineyardd(
+            metadata_settings,
+            ['--allocator', allocator],
+            default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+        ):
+            run_test(tests, 'wal_restart_test', wal_dir, 'write')
+        # restarts on the same directory
+        with start_vineyardd(
+            metadata_settings,
+            ['--allocator', allocator],
+            default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+        ):
+            run_test(tests, 'wal_restart_test', wal_dir, 'check')
+    finally:
+        shutil.rmtree(wal_dir, ignore_errors=True)
+
+
+def run_msgpack_tests(meta, allocator, endpoints, tests):
+    meta_prefix = 'vineyard_test_%s' % time.time()
+    metadata_settings = make_metadata_settings(meta, endpoints, meta_prefix)
+    pickle_dir = tempfile.mkdtemp(prefix='vineyard-pickle-')
+    try:
+        with start_vineyardd(
+            metadata_settings,
+            ['--allocator', allocator],
+            default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+        ) as (_, rpc_socket_port):
+            run_test(tests, 'msgpack_test')
+            run_test(tests, 'pickle_test', pickle_dir)
+            # loads the pickle dumped by the C++ pickler in python
+            if include_test(tests, 'pickle_test'):
+                subprocess.check_call(
+                    [
+                        'pytest',
+                        '-s',
+                        '-vvv',
+                        '--exitfirst',
+                        '--durations=0',
+                        'python/vineyard/core/tests/test_pickle.py',
+                        '--vineyard-ipc-socket=%s' % VINEYARD_CI_IPC_SOCKET,
+                        '--vineyard-endpoint=localhost:%s' % rpc_socket_port,
+                    ],
+                    cwd=os.path.join(
+                        os.path.dirname(os.path.abspath(__file__)), '..'
+                    ),
+                    env=dict(os.environ, VINEYARD_PICKLE_TEST_DIR=pickle_dir),
+                )
+    finally:
+        shutil.rmtree(pickle_dir, ignore_errors=True)
+
+
 def run_scale_in_out_tests(meta, allocator, endpoints, instance_size=4):
     meta_prefix = 'vineyard_test_%s' % time.time()
     metadata_settings = make_metadata_settings(meta, endpoints, meta_prefix)
@@ -524,6 +605,10 @@ def run_graph_tests(meta, allocator, endpoints, tests):
         default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
     ) as (_, rpc_socket_port):
         run_test(tests, 'arrow_fragment_test')
+        run_test(tests, 'arrow_vertex_map_test')
+        run_test(tests, 'arrow_vertex_map_test', 'swiss')
+        run_test(tests, 'table_shuffler_test', nproc=1)
+        run_test(tests, 'table_shuffler_test', nproc=3)
         # CSV seems does't work, due to the timestamp data type
         #
         # run_test(
@@ -903,6 +988,12 @@ def parse_sys_args():
         default=False,
         help="whether to run fuse test",
     )
+    arg_parser.add_argument(
+        '--with-msgpack',
+        action='store_true',
+        default=False,
+        help="whether to run msgpack tests",
+    )
     arg_parser.add_argument(
         '-k',
         '--tests',
@@ -920,6 +1011,10 @@ def execute_tests(args):
         with start_metadata_engine(args.meta) as (_, endpoints):
             run_vineyard_cpp_tests(args.meta, args.allocator, endpoints, args.tests)
             run_vineyard_spill_tests(args.meta, args.allocator, endpoints, args.tests)
+            run_vineyard_persist_tests(
+                args.meta, args.allocator, endpoints, args.tests
+            )
+        run_wal_restart_tests(args.allocator, args.tests)
 
         if args.with_deployment:
             with start_metadata_engine(args.meta) as (_, endpoints):
@@ -963,6 +1058,10 @@ def execute_tests(args):
         with start_metadata_engine(args.meta) as (_, endpoints):
             run_fuse_test(args.meta, args.allocator, endpoints, args.tests)
 
+    if args.with_msgpack:
+        with start_metadata_engine(args.meta) as (_, endpoints):
+            run_msgpack_tests(args.meta, args.allocator, endpoints, args.tests)
+
 
 def main():
     parser, args = parse_sys_args()
@@ -973,9 +1072,10 @@ def main():
         or args.with_python
         or args.with_io
         or args.with_fuse
+        or args.with_msgpack
     ):
         print(
-            'Error: \n\tat least one of of --with-{cpp,graph,python,io,fuse} needs '
+            'Error: \n\tat least one of of --with-{cpp,graph,python,io,fuse,msgpack} needs '
             'to be specified\n'
         )
         parser.print_help()
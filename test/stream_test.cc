@@ -17,6 +17,7 @@ limitations under the License.
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -261,6 +262,89 @@ void testRecordBatchStream(Client& client, std::string const& ipc_socket) {
   CHECK_EQ(send_chunks, recv_chunks);
 }
 
+// The batches are read from the shared memory without copying, including the
+// prefetched ones, whose chunks are kept alive until they are read.
+template <typename StreamT>
+void testRecordBatchStreamReader(Client& client,
+                                 std::string const& ipc_socket) {
+  ObjectID stream_id = InvalidObjectID();
+  {
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "test"}, {"test_name", "stream_test"}};
+    stream_id = StreamBuilder<StreamT>::Make(client, params);
+    CHECK(stream_id != InvalidObjectID());
+  }
+
+  const int64_t num_batches = 10, num_rows = 1000;
+  auto schema = arrow::schema(
+      {std::make_shared<arrow::Field>("f1", arrow::int64()),
+       std::make_shared<arrow::Field>("f2", arrow::large_utf8())});
+
+  std::thread send_thrd([&]() {
+    Client writer_client;
+    VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+    auto recordbatch_stream = writer_client.GetObject<StreamT>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+    VINEYARD_CHECK_OK(recordbatch_stream->OpenWriter(&writer_client));
+
+    for (int64_t idx = 0; idx < num_batches; ++idx) {
+      arrow::Int64Builder value_builder;
+      arrow::LargeStringBuilder string_builder;
+      for (int64_t j = 0; j < num_rows; ++j) {
+        CHECK_ARROW_ERROR(value_builder.Append(idx * num_rows + j));
+        CHECK_ARROW_ERROR(string_builder.Append(std::to_string(idx)));
+      }
+      std::shared_ptr<arrow::Array> array1, array2;
+      CHECK_ARROW_ERROR(value_builder.Finish(&array1));
+      CHECK_ARROW_ERROR(string_builder.Finish(&array2));
+      VINEYARD_CHECK_OK(recordbatch_stream->WriteBatch(
+          arrow::RecordBatch::Make(schema, num_rows, {array1, array2})));
+    }
+    VINEYARD_CHECK_OK(recordbatch_stream->Finish());
+  });
+
+  std::thread recv_thrd([&]() {
+    Client reader_client;
+    VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+
+    auto recordbatch_stream = reader_client.GetObject<StreamT>(stream_id);
+    CHECK(recordbatch_stream != nullptr);
+
+    // prefetch several chunks per pull round
+    std::shared_ptr<RecordBatchStreamReader> reader;
+    VINEYARD_CHECK_OK(RecordBatchStreamReader::Make(
+        reader_client, recordbatch_stream, reader, 4));
+    CHECK(reader->schema()->Equals(schema));
+
+    int64_t idx = 0;
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      CHECK_ARROW_ERROR(reader->ReadNext(&batch));
+      if (batch == nullptr) {
+        break;
+      }
+      CHECK_EQ(batch->num_rows(), num_rows);
+      auto values =
+          std::dynamic_pointer_cast<arrow::Int64Array>(batch->column(0));
+      auto strings =
+          std::dynamic_pointer_cast<arrow::LargeStringArray>(batch->column(1));
+      ObjectID blob_id = InvalidObjectID();
+      CHECK(reader_client.IsSharedMemory(values->raw_values(), blob_id));
+      CHECK(reader_client.IsSharedMemory(strings->raw_data(), blob_id));
+      for (int64_t j = 0; j < num_rows; ++j) {
+        CHECK_EQ(values->Value(j), idx * num_rows + j);
+        CHECK_EQ(strings->GetString(j), std::to_string(idx));
+      }
+      idx += 1;
+    }
+    CHECK_EQ(idx, num_batches);
+  });
+
+  send_thrd.join();
+  recv_thrd.join();
+}
+
 int main(int argc, char** argv) {
   if (argc < 2) {
     printf("usage ./stream_test <ipc_socket>");
@@ -304,6 +388,20 @@ int main(int argc, char** argv) {
   CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
   CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
 
+  testRecordBatchStreamReader<RecordBatchStream>(client, ipc_socket);
+  LOG(INFO) << "Passed recordbatch reader test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
+  testRecordBatchStreamReader<DataframeStream>(client, ipc_socket);
+  LOG(INFO) << "Passed dataframe stream reader test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
   LOG(INFO) << "Passed stream tests...";
 
   client.Disconnect();
@@ -0,0 +1,106 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "client/client.h"
+#include "client/ds/object_meta.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr const char* kObjectName = "wal_restart_test_object";
+
+bool DirectoryExists(std::string const& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+// the metadata persisted before the restart
+void Write(std::string const& ipc_socket) {
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  ObjectMeta meta;
+  meta.SetTypeName("vineyard::WalRestartTestObject");
+  meta.SetNBytes(0);
+  meta.AddKeyValue("payload", std::string("persisted before restart"));
+  ObjectID id = InvalidObjectID();
+  VINEYARD_CHECK_OK(client.CreateMetaData(meta, id));
+  VINEYARD_CHECK_OK(client.Persist(id));
+  VINEYARD_CHECK_OK(client.PutName(id, kObjectName));
+
+  client.Disconnect();
+}
+
+// the directory of a child session is removed once the session is released
+void ReleaseSession(std::string const& ipc_socket, std::string const& wal_dir) {
+  Client client;
+  VINEYARD_CHECK_OK(client.Open(ipc_socket));
+  std::string session_socket = client.IPCSocket();
+  std::string session_dir =
+      wal_dir + "/" + session_socket.substr(session_socket.rfind('.') + 1);
+  CHECK(DirectoryExists(session_dir));
+  client.Disconnect();
+
+  for (int retries = 0; retries < 50 && DirectoryExists(session_dir);
+       ++retries) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  CHECK(!DirectoryExists(session_dir));
+}
+
+void Check(std::string const& ipc_socket) {
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  ObjectID id = InvalidObjectID();
+  VINEYARD_CHECK_OK(client.GetName(kObjectName, id));
+  ObjectMeta meta;
+  VINEYARD_CHECK_OK(client.GetMetaData(id, meta));
+  CHECK_EQ(meta.GetTypeName(), "vineyard::WalRestartTestObject");
+  CHECK_EQ(meta.GetKeyValue<std::string>("payload"),
+           "persisted before restart");
+  bool persist = false;
+  VINEYARD_CHECK_OK(client.IfPersist(id, persist));
+  CHECK(persist);
+
+  client.Disconnect();
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf("usage ./wal_restart_test <ipc_socket> <wal_dir> <write|check>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  std::string wal_dir = std::string(argv[2]);
+  std::string phase = std::string(argv[3]);
+
+  if (phase == "write") {
+    Write(ipc_socket);
+    ReleaseSession(ipc_socket, wal_dir);
+  } else {
+    Check(ipc_socket);
+  }
+
+  LOG(INFO) << "Passed wal restart tests (" << phase << ")...";
+  return 0;
+}
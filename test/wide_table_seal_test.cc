@@ -0,0 +1,189 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/api.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/dataframe.h"
+#include "client/client.h"
+#include "client/ds/object_meta.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+constexpr int kColumns = 500;
+constexpr int kRows = 100;
+
+// compares the metadata trees, ignoring the fields that differ between two
+// sealed copies of the same data
+bool LayoutEquals(json const& a, json const& b) {
+  if (a.is_object() != b.is_object()) {
+    return false;
+  }
+  if (!a.is_object()) {
+    return a == b;
+  }
+  auto skip = [](std::string const& key) {
+    return key == "id" || key == "signature" || key == "instance_id" ||
+           key == "transient";
+  };
+  for (auto const& item : a.items()) {
+    if (skip(item.key())) {
+      continue;
+    }
+    if (!b.contains(item.key()) ||
+        !LayoutEquals(item.value(), b[item.key()])) {
+      LOG(ERROR) << "Layout mismatches at key '" << item.key() << "'";
+      return false;
+    }
+  }
+  for (auto const& item : b.items()) {
+    if (!skip(item.key()) && !a.contains(item.key())) {
+      LOG(ERROR) << "Layout mismatches at key '" << item.key() << "'";
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<arrow::Table> MakeWideTable() {
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> columns;
+  for (int c = 0; c < kColumns; ++c) {
+    std::string name = "c" + std::to_string(c);
+    std::shared_ptr<arrow::Array> column;
+    if (c % 3 == 0) {
+      arrow::Int64Builder builder;
+      for (int r = 0; r < kRows; ++r) {
+        CHECK_ARROW_ERROR(builder.Append(c * kRows + r));
+      }
+      CHECK_ARROW_ERROR(builder.Finish(&column));
+    } else if (c % 3 == 1) {
+      arrow::DoubleBuilder builder;
+      for (int r = 0; r < kRows; ++r) {
+        CHECK_ARROW_ERROR(builder.Append(c + r * 0.5));
+      }
+      CHECK_ARROW_ERROR(builder.Finish(&column));
+    } else {
+      arrow::StringBuilder builder;
+      for (int r = 0; r < kRows; ++r) {
+        CHECK_ARROW_ERROR(builder.Append(name + "-" + std::to_string(r)));
+      }
+      CHECK_ARROW_ERROR(builder.Finish(&column));
+    }
+    fields.emplace_back(arrow::field(name, column->type()));
+    columns.emplace_back(column);
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns);
+}
+
+std::shared_ptr<ITensorBuilder> MakeTensor(Client& client, int c) {
+  if (c % 2 == 0) {
+    auto tb = std::make_shared<TensorBuilder<double>>(
+        client, std::vector<int64_t>{kRows});
+    for (int r = 0; r < kRows; ++r) {
+      tb->data()[r] = c + r * 0.5;
+    }
+    return tb;
+  } else {
+    auto tb = std::make_shared<TensorBuilder<int64_t>>(
+        client, std::vector<int64_t>{kRows});
+    for (int r = 0; r < kRows; ++r) {
+      tb->data()[r] = c * kRows + r;
+    }
+    return tb;
+  }
+}
+
+void WideTableTest(Client& client) {
+  auto table = MakeWideTable();
+
+  // the columns are sealed in parallel
+  auto sealed = std::dynamic_pointer_cast<Table>(
+      TableBuilder(client, table).Seal(client));
+  CHECK_EQ(sealed->batches().size(), 1);
+  auto batch = sealed->batches()[0];
+  CHECK_EQ(batch->num_columns(), kColumns);
+  CHECK_EQ(batch->num_rows(), kRows);
+  for (int c = 0; c < kColumns; ++c) {
+    CHECK(batch->arrow_columns()[c]->Equals(table->column(c)->chunk(0)));
+  }
+
+  // the columns are sealed one by one
+  RecordBatchBaseBuilder builder(client);
+  builder.set_schema_(
+      std::make_shared<SchemaProxyBuilder>(client, table->schema()));
+  builder.set_row_num_(table->num_rows());
+  builder.set_column_num_(table->num_columns());
+  for (auto const& column : table->columns()) {
+    builder.add_columns_(detail::BuildArray(client, column));
+  }
+  std::shared_ptr<Object> expected;
+  VINEYARD_CHECK_OK(builder._Seal(client, expected));
+
+  CHECK(LayoutEquals(batch->meta().MetaData(), expected->meta().MetaData()));
+}
+
+void WideDataFrameTest(Client& client) {
+  // the columns are sealed in parallel
+  DataFrameBuilder builder(client);
+  builder.set_row_batch_index(0);
+  for (int c = 0; c < kColumns; ++c) {
+    builder.AddColumn("c" + std::to_string(c), MakeTensor(client, c));
+  }
+  auto df = std::dynamic_pointer_cast<DataFrame>(builder.Seal(client));
+  CHECK_EQ(df->Columns().size(), kColumns);
+
+  // the columns are sealed one by one
+  DataFrameBaseBuilder serial(client);
+  serial.set_row_batch_index_(0);
+  std::vector<json> columns;
+  for (int c = 0; c < kColumns; ++c) {
+    columns.emplace_back("c" + std::to_string(c));
+    serial.set_values_(columns.back(), std::dynamic_pointer_cast<ObjectBuilder>(
+                                           MakeTensor(client, c)));
+  }
+  serial.set_columns_(columns);
+  std::shared_ptr<Object> expected;
+  VINEYARD_CHECK_OK(serial._Seal(client, expected));
+
+  CHECK(LayoutEquals(df->meta().MetaData(), expected->meta().MetaData()));
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./wide_table_seal_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  WideTableTest(client);
+  WideDataFrameTest(client);
+
+  LOG(INFO) << "Passed wide table seal tests...";
+
+  client.Disconnect();
+
+  return 0;
+}